@@ -298,6 +298,11 @@ public:
 
   virtual bool processGroups();
 
+  /// Whether the entries of a group may be processed at the same time. Only
+  /// used if enabled in the configuration. Algorithms that are known to be
+  /// safe to run concurrently on different workspaces override this.
+  virtual bool canProcessGroupsInParallel() const { return false; }
+
   void copyNonWorkspaceProperties(IAlgorithm *alg, int periodNum);
 
 protected:
@@ -356,6 +361,8 @@ protected:
                                  // g_execCount
   static size_t
       g_execCount; ///< Counter to keep track of algorithm execution order
+  /// The value of g_execCount given to this execution
+  size_t m_execCount;
 
   virtual void setOtherProperties(IAlgorithm *alg,
                                   const std::string &propertyName,
@@ -398,6 +405,11 @@ private:
   // Report that the algorithm has completed.
   void reportCompleted(const double &duration,
                        const bool groupProcessing = false);
+  /// Run the algorithm for one entry of the input group(s)
+  void executeGroupEntry(IAlgorithm *alg, size_t entry);
+  /// How many group entries to process at the same time
+  int numberOfGroupEntriesInParallel(
+      const std::vector<size_t> &entryMemory) const;
 
   // --------------------- Private Members -----------------------------------
   /// Poco::ActiveMethod used to implement asynchronous execution.
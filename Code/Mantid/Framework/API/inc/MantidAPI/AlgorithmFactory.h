@@ -146,6 +146,8 @@ private:
   /// Extract the version of an algorithm
   int extractAlgVersion(const boost::shared_ptr<IAlgorithm> alg) const;
 
+  /// Open deferred plugin libraries providing the named algorithm
+  void loadDeferredVersions(const std::string &algorithmName) const;
   /// Create an algorithm object with the specified name
   boost::shared_ptr<Algorithm> createAlgorithm(const std::string &name,
                                                const int version) const;
@@ -85,6 +85,8 @@ public:
   /// Unsubscribe a named algorithm and version from the loader registration
   void unsubscribe(const std::string &name, const int version = -1);
 
+  /// Returns the names of the registered loaders
+  std::vector<std::string> getNames() const;
   /// Returns the name of an Algorithm that can load the given filename
   const boost::shared_ptr<IAlgorithm>
   chooseLoader(const std::string &filename) const;
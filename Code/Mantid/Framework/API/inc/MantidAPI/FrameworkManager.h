@@ -113,6 +113,9 @@ private:
   /// Private assignment operator - NO ASSIGNMENT ALLOWED
   FrameworkManagerImpl &operator=(const FrameworkManagerImpl &);
 
+  /// Register plugins to be opened on first use
+  void deferPluginsUsingKey(const std::string &key,
+                            const std::string &pluginDir);
   /// Set up the global locale
   void setGlobalLocaleToAscii();
   /// Silence NeXus output
@@ -68,6 +68,8 @@ public:
   /// Query available functions based on the template type
   template <typename FunctionType>
   const std::vector<std::string> &getFunctionNames() const;
+  /// The names of all registered functions
+  const std::vector<std::string> getKeys() const;
   // Unhide the base class version (to satisfy the intel compiler)
   using Kernel::DynamicFactory<IFunction>::subscribe;
   void subscribe(const std::string &className,
@@ -126,6 +128,9 @@ private:
  */
 template <typename FunctionType>
 const std::vector<std::string> &FunctionFactoryImpl::getFunctionNames() const {
+  // Listing the names may open plugin libraries, which clears the cache, so
+  // do it before taking the lock
+  const std::vector<std::string> names = this->getKeys();
   Kernel::Mutex::ScopedLock _lock(m_mutex);
 
   const std::string soughtType(typeid(FunctionType).name());
@@ -135,7 +140,6 @@ const std::vector<std::string> &FunctionFactoryImpl::getFunctionNames() const {
 
   // Create the entry in the cache and work with it directly
   std::vector<std::string> &typeNames = m_cachedFunctionNames[soughtType];
-  const std::vector<std::string> names = this->getKeys();
   for (auto it = names.begin(); it != names.end(); ++it) {
     boost::shared_ptr<IFunction> func = this->createFunction(*it);
     if (func && dynamic_cast<FunctionType *>(func.get())) {
@@ -315,7 +315,7 @@ public:
   /// Constructor
   IFunction()
       : m_isParallel(false), m_handler(NULL), m_progReporter(NULL),
-        m_chiSquared(0.0) {}
+        m_chiSquared(0.0), m_numDerivChunks(0), m_numDerivDomainSize(0) {}
   /// Virtual destructor
   virtual ~IFunction();
 
@@ -496,6 +496,8 @@ public:
 
   /// Calculate numerical derivatives
   void calNumericalDeriv(const FunctionDomain &domain, Jacobian &out);
+  /// Discard the copies used to calculate numerical derivatives in parallel
+  void clearNumericalDerivCopies();
   /// Set the covariance matrix
   void setCovarianceMatrix(boost::shared_ptr<Kernel::Matrix<double>> covar);
   /// Get the covariance matrix
@@ -567,6 +569,12 @@ private:
   boost::shared_ptr<Kernel::Matrix<double>> m_covar;
   /// The chi-squared of the last fit
   double m_chiSquared;
+  /// Copies of the function used by calNumericalDeriv(), one per thread
+  std::vector<boost::shared_ptr<IFunction>> m_numDerivCopies;
+  /// Number of domain chunks shared by the copies, 0 if they share parameters
+  size_t m_numDerivChunks;
+  /// Size of the domain the copies were checked on
+  size_t m_numDerivDomainSize;
 };
 
 /// shared pointer to the function base class
@@ -105,6 +105,13 @@ public:
                            std::vector<coord_t> &x, std::vector<signal_t> &y,
                            std::vector<signal_t> &e) const;
 
+  /// Method to render a 2D slice through a MD-workspace into an image
+  virtual void getPlanePlot(const Mantid::Kernel::VMD &origin,
+                            const Mantid::Kernel::VMD &xStep,
+                            const Mantid::Kernel::VMD &yStep, size_t numX,
+                            size_t numY, Mantid::API::MDNormalization normalize,
+                            std::vector<signal_t> &signal) const;
+
   IMDIterator *
   createIterator(Mantid::Geometry::MDImplicitFunction *function = NULL) const;
 
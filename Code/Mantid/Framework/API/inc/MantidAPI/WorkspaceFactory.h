@@ -96,8 +96,8 @@ private:
   /// Private Destructor
   virtual ~WorkspaceFactoryImpl();
 
-  // Unhide the inherited create method but make it private
-  using Kernel::DynamicFactory<Workspace>::create;
+  /// Create a workspace by name, opening a deferred plugin library if needed
+  boost::shared_ptr<Workspace> create(const std::string &className) const;
 };
 
 /// Forward declaration of a specialisation of SingletonHolder for
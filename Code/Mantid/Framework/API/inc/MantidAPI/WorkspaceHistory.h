@@ -96,6 +96,8 @@ private:
   void loadNestedHistory(
       ::NeXus::File *file,
       AlgorithmHistory_sptr parent = boost::shared_ptr<AlgorithmHistory>());
+  /// Load the property values saved as datasets for an algorithm entry
+  void loadArrayProperties(::NeXus::File *file, AlgorithmHistory_sptr history);
   /// Parse an algorithm history string loaded from file
   AlgorithmHistory_sptr parseAlgorithmHistory(const std::string &rawData);
   /// Find the history entries at this level in the file.
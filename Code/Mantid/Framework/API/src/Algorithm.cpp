@@ -12,11 +12,14 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/MemoryManager.h"
 
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/Memory.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/Tracer.h"
 
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -30,6 +33,7 @@
 #include <Poco/StringTokenizer.h>
 #include <Poco/Void.h>
 
+#include <algorithm>
 #include <map>
 
 using namespace Mantid::Kernel;
@@ -70,13 +74,14 @@ size_t Algorithm::g_execCount = 0;
 /// Constructor
 Algorithm::Algorithm()
     : PropertyManagerOwner(), m_cancel(false), m_parallelException(false),
-      m_log("Algorithm"), g_log(m_log), m_groupSize(0), m_executeAsync(NULL),
-      m_notificationCenter(NULL), m_progressObserver(NULL),
-      m_isInitialized(false), m_isExecuted(false), m_isChildAlgorithm(false),
-      m_recordHistoryForChild(false), m_alwaysStoreInADS(false),
-      m_runningAsync(false), m_running(false), m_rethrow(false),
-      m_isAlgStartupLoggingEnabled(true), m_algorithmID(this),
-      m_singleGroup(-1), m_groupsHaveSimilarNames(false) {}
+      m_execCount(0), m_log("Algorithm"), g_log(m_log), m_groupSize(0),
+      m_executeAsync(NULL), m_notificationCenter(NULL),
+      m_progressObserver(NULL), m_isInitialized(false), m_isExecuted(false),
+      m_isChildAlgorithm(false), m_recordHistoryForChild(false),
+      m_alwaysStoreInADS(false), m_runningAsync(false), m_running(false),
+      m_rethrow(false), m_isAlgStartupLoggingEnabled(true),
+      m_algorithmID(this), m_singleGroup(-1), m_groupsHaveSimilarNames(false) {
+}
 
 /// Virtual destructor
 Algorithm::~Algorithm() {
@@ -425,6 +430,8 @@ void Algorithm::unlockWorkspaces() {
 *  @return true if executed successfully.
 */
 bool Algorithm::execute() {
+  Kernel::TraceScope trace(this->name(),
+                           isChild() ? "child algorithm" : "algorithm", true);
   AlgorithmManager::Instance().notifyAlgorithmStarting(this->getAlgorithmID());
   {
     DeprecatedAlgorithm *depo = dynamic_cast<DeprecatedAlgorithm *>(this);
@@ -521,8 +528,12 @@ bool Algorithm::execute() {
     // count used for defining the algorithm execution order
     // If history is being recorded we need to count this as a separate
     // algorithm
-    // as the history compares histories by their execution number
-    ++Algorithm::g_execCount;
+    // as the history compares histories by their execution number. Group
+    // entries may be executed from several threads at once, so each
+    // execution keeps its own number.
+    PARALLEL_CRITICAL(algorithm_exec_count) {
+      m_execCount = ++Algorithm::g_execCount;
+    }
 
     // populate history record before execution so we can record child
     // algorithms in it
@@ -578,7 +589,7 @@ bool Algorithm::execute() {
       // which has failed
       if (trackingHistory() && m_history) {
         m_history->fillAlgorithmHistory(this, start_time, duration,
-                                        Algorithm::g_execCount);
+                                        m_execCount);
         fillHistory();
         linkHistoryWithLastChild();
       }
@@ -1113,9 +1124,12 @@ void Algorithm::logAlgorithmInfo() const {
       logger.notice() << " (child)";
     logger.notice() << std::endl;
     // Make use of the AlgorithmHistory class, which holds all the info we want
-    // here
-    AlgorithmHistory AH(this);
-    logger.information() << AH;
+    // here. Printing it converts large array values to text, so only do it if
+    // it will be seen.
+    if (logger.is(Logger::Priority::PRIO_INFORMATION)) {
+      AlgorithmHistory AH(this);
+      logger.information() << AH;
+    }
   }
 }
 
@@ -1268,7 +1282,11 @@ bool Algorithm::processGroups() {
     outWSGrp->observeADSNotifications(false);
   }
 
-  // Go through each entry in the input group(s)
+  // ---------- Set up an algorithm for each entry in the input group(s) ------
+  std::vector<Algorithm_sptr> entryAlgs(m_groupSize);
+  std::vector<std::vector<std::string>> entryOutputNames(m_groupSize);
+  // Memory held by the inputs of each entry, in bytes
+  std::vector<size_t> entryMemory(m_groupSize, 0);
   for (size_t entry = 0; entry < m_groupSize; entry++) {
     // use create Child Algorithm that look like this one
     Algorithm_sptr alg_sptr = this->createChildAlgorithm(
@@ -1302,6 +1320,7 @@ bool Algorithm::processGroups() {
         if (!outputBaseName.empty())
           outputBaseName += "_";
         outputBaseName += ws->name();
+        entryMemory[entry] += ws->getMemorySize();
 
         // Set the property using the name of that workspace
         Property *prop = dynamic_cast<Property *>(m_inputWorkspaceProps[iwp]);
@@ -1309,7 +1328,8 @@ bool Algorithm::processGroups() {
       } // not an empty (i.e. optional) input
     }   // for each InputWorkspace property
 
-    std::vector<std::string> outputWSNames(m_pureOutputWorkspaceProps.size());
+    std::vector<std::string> &outputWSNames = entryOutputNames[entry];
+    outputWSNames.resize(m_pureOutputWorkspaceProps.size());
     // ---------- Set all the output workspaces ----------------------------
     for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
       Property *prop =
@@ -1327,26 +1347,46 @@ bool Algorithm::processGroups() {
       outputWSNames[owp] = outName;
     } // for each OutputWorkspace property
 
-    // ------------ Execute the algo --------------
-    try {
-      alg->execute();
-    } catch (std::exception &e) {
-      std::ostringstream msg;
-      msg << "Execution of " << this->name() << " for group entry "
-          << (entry + 1) << " failed: ";
-      msg << e.what(); // Add original message
-      throw std::runtime_error(msg.str());
+    entryAlgs[entry] = alg_sptr;
+  } // for each entry in each group
+
+  // ------------ Execute the algos --------------
+  const int numThreads = numberOfGroupEntriesInParallel(entryMemory);
+  if (numThreads > 1) {
+    g_log.information() << "Processing " << m_groupSize
+                        << " group entries, " << numThreads
+                        << " at a time.\n";
+    // The entries are independent. A failure does not stop the others, but
+    // the error of the first failed entry is reported as it would have been
+    // when running them in turn.
+    std::vector<std::string> errors(m_groupSize);
+    const int numEntries = static_cast<int>(m_groupSize);
+    PRAGMA_OMP(parallel for schedule(dynamic, 1) num_threads(numThreads))
+    for (int entry = 0; entry < numEntries; entry++) {
+      try {
+        executeGroupEntry(entryAlgs[entry].get(), static_cast<size_t>(entry));
+      } catch (std::exception &e) {
+        errors[entry] = e.what();
+      }
     }
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      if (!errors[entry].empty())
+        throw std::runtime_error(errors[entry]);
+    }
+  } else {
+    for (size_t entry = 0; entry < m_groupSize; entry++)
+      executeGroupEntry(entryAlgs[entry].get(), entry);
+  }
 
-    // ------------ Fill in the output workspace group ------------------
-    // this has to be done after execute() because a workspace must exist
-    // when it is added to a group
+  // ------------ Fill in the output workspace group ------------------
+  // this has to be done after execute() because a workspace must exist
+  // when it is added to a group
+  for (size_t entry = 0; entry < m_groupSize; entry++) {
     for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
       // And add it to the output group
-      outGroups[owp]->add(outputWSNames[owp]);
+      outGroups[owp]->add(entryOutputNames[entry][owp]);
     }
-
-  } // for each entry in each group
+  }
 
   // restore group notifications
   for (size_t i = 0; i < outGroups.size(); i++) {
@@ -1361,6 +1401,71 @@ bool Algorithm::processGroups() {
   return true;
 }
 
+//--------------------------------------------------------------------------------------------
+/** Run the algorithm set up for one entry of the input group(s).
+ *
+ * @param alg :: the algorithm for the entry
+ * @param entry :: index of the entry in the group(s)
+ * @throw std::runtime_error if the algorithm fails
+ */
+void Algorithm::executeGroupEntry(IAlgorithm *alg, size_t entry) {
+  try {
+    alg->execute();
+  } catch (std::exception &e) {
+    std::ostringstream msg;
+    msg << "Execution of " << this->name() << " for group entry "
+        << (entry + 1) << " failed: ";
+    msg << e.what(); // Add original message
+    throw std::runtime_error(msg.str());
+  }
+}
+
+//--------------------------------------------------------------------------------------------
+/** Decide how many entries of the input group(s) are processed at the same
+ * time.
+ *
+ * This is 1 unless "algorithms.groups.parallel" is set in the configuration
+ * and the algorithm allows it. The number is then limited by
+ * "algorithms.groups.maxthreads" (0 or unset means the number of cores) and
+ * by the memory available to hold a copy of the inputs of each entry being
+ * processed.
+ *
+ * @param entryMemory :: the memory used by the inputs of each entry, in bytes
+ * @return the number of entries to run at once
+ */
+int Algorithm::numberOfGroupEntriesInParallel(
+    const std::vector<size_t> &entryMemory) const {
+  int parallel(0);
+  if (entryMemory.size() < 2 ||
+      ConfigService::Instance().getValue("algorithms.groups.parallel",
+                                         parallel) == 0 ||
+      parallel == 0 || !canProcessGroupsInParallel())
+    return 1;
+
+  int numThreads = PARALLEL_GET_MAX_THREADS;
+  int maxThreads(0);
+  if (ConfigService::Instance().getValue("algorithms.groups.maxthreads",
+                                         maxThreads) > 0 &&
+      maxThreads > 0)
+    numThreads = std::min(numThreads, maxThreads);
+  numThreads = std::min(numThreads, static_cast<int>(entryMemory.size()));
+
+  // Outputs are usually about the size of the inputs
+  const size_t largestEntry =
+      2 * (*std::max_element(entryMemory.begin(), entryMemory.end()));
+  if (largestEntry > 0) {
+    MemoryStats memory;
+    const size_t available = memory.availMem() * 1024;
+    const size_t fits = std::max(available / largestEntry, size_t(1));
+    if (fits < static_cast<size_t>(numThreads)) {
+      g_log.information() << "Only " << fits << " group entries fit in the "
+                          << memory.availMemStr() << " of available memory.\n";
+      numThreads = static_cast<int>(fits);
+    }
+  }
+  return numThreads;
+}
+
 //--------------------------------------------------------------------------------------------
 /** Copy all the non-workspace properties from this to alg
  *
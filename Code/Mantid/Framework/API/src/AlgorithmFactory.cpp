@@ -15,6 +15,8 @@ namespace API {
 namespace {
 /// static logger instance
 Kernel::Logger g_log("AlgorithmFactory");
+/// The kind under which algorithms are recorded in a plugin manifest
+const char *MANIFEST_KIND = "Algorithm";
 }
 
 AlgorithmFactoryImpl::AlgorithmFactoryImpl()
@@ -36,6 +38,7 @@ AlgorithmFactoryImpl::~AlgorithmFactoryImpl() {}
 boost::shared_ptr<Algorithm>
 AlgorithmFactoryImpl::create(const std::string &name,
                              const int &version) const {
+  loadDeferredVersions(name);
   int local_version = version;
   if (version < 0) {
     if (version == -1) // get latest version since not supplied
@@ -105,6 +108,7 @@ void AlgorithmFactoryImpl::unsubscribe(const std::string &algorithmName,
  */
 bool AlgorithmFactoryImpl::exists(const std::string &algorithmName,
                                   const int version) {
+  loadDeferredVersions(algorithmName);
   if (version == -1) // Find anything
   {
     return (m_vmap.find(algorithmName) != m_vmap.end());
@@ -114,6 +118,18 @@ bool AlgorithmFactoryImpl::exists(const std::string &algorithmName,
   }
 }
 
+/**
+ * Opens any plugin libraries that were deferred by the LibraryManager and
+ * provide a version of the algorithm. Does nothing if plugins are loaded
+ * eagerly.
+ * @param algorithmName :: The name of the algorithm
+ */
+void AlgorithmFactoryImpl::loadDeferredVersions(
+    const std::string &algorithmName) const {
+  Kernel::LibraryManager::Instance().loadLibrariesProviding(
+      MANIFEST_KIND, algorithmName + "|");
+}
+
 /** Creates a mangled name for interal storage
 * @param name :: the name of the Algrorithm
 * @param version :: the version of the algroithm
@@ -173,9 +189,22 @@ const std::vector<std::string>
 AlgorithmFactoryImpl::getKeys(bool includeHidden) const {
   // Start with those subscribed with the factory and add the cleanly
   // constructed algorithm keys
+  if (!includeHidden) {
+    // The categories are needed so every library has to be open
+    Kernel::LibraryManager::Instance().loadLibrariesProviding(MANIFEST_KIND);
+  }
   std::vector<std::string> names = Kernel::DynamicFactory<Algorithm>::getKeys();
 
   if (includeHidden) {
+    // Algorithms in plugin libraries that have not been opened yet. They are
+    // opened when the algorithm is created.
+    const std::vector<std::string> deferred =
+        Kernel::LibraryManager::Instance().deferredNames(MANIFEST_KIND);
+    if (!deferred.empty()) {
+      std::set<std::string> allNames(names.begin(), names.end());
+      allNames.insert(deferred.begin(), deferred.end());
+      names.assign(allNames.begin(), allNames.end());
+    }
     return names;
   } else {
     // hidden categories
@@ -224,6 +253,7 @@ AlgorithmFactoryImpl::getKeys(bool includeHidden) const {
  */
 int
 AlgorithmFactoryImpl::highestVersion(const std::string &algorithmName) const {
+  loadDeferredVersions(algorithmName);
   VersionMap::const_iterator viter = m_vmap.find(algorithmName);
   if (viter != m_vmap.end())
     return viter->second;
@@ -3,6 +3,10 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/Algorithm.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <boost/make_shared.hpp>
+
 #include <sstream>
 
 namespace Mantid {
@@ -254,7 +258,10 @@ std::ostream &operator<<(std::ostream &os, const AlgorithmHistory &AH) {
   return os;
 }
 
-/** Write out this history record to file.
+/** Write out this history record to file. If
+ * 'algorithms.history.savearraysbinary' is set, numeric arrays that were
+ * recorded lazily are written as datasets named property_<name> rather than
+ * in the text of the record.
  * @param file :: The handle to the nexus file to save to
  * @param algCount :: Counter of the number of algorithms written to file.
  */
@@ -264,12 +271,37 @@ void AlgorithmHistory::saveNexus(::NeXus::File *file, int &algCount) const {
   algNumber << "MantidAlgorithm_"
             << algCount; // history entry names start at 1 not 0
 
-  std::stringstream algData;
-  printSelf(algData);
-
   file->makeGroup(algNumber.str(), "NXnote", true);
   file->writeData("author", std::string("mantid"));
   file->writeData("description", std::string("Mantid Algorithm data"));
+
+  std::stringstream algData;
+  int saveArraysBinary(0);
+  Kernel::ConfigService::Instance().getValue(
+      "algorithms.history.savearraysbinary", saveArraysBinary);
+  if (saveArraysBinary) {
+    // Large numeric arrays are written as datasets and left empty in the text.
+    // The copy shares everything with this history apart from the replaced
+    // properties.
+    AlgorithmHistory stored(*this);
+    std::vector<double> values;
+    for (auto it = stored.m_properties.begin(); it != stored.m_properties.end();
+         ++it) {
+      const PropertyHistory &prop = **it;
+      if (!prop.lazyValue() || !prop.lazyValue()->toDoubles(values))
+        continue;
+      const std::string dataName = "property_" + prop.name();
+      file->writeData(dataName, values);
+      file->openData(dataName);
+      file->putAttr("integral", prop.lazyValue()->isIntegral() ? 1 : 0);
+      file->closeData();
+      *it = boost::make_shared<PropertyHistory>(
+          prop.name(), "", prop.type(), prop.isDefault(), prop.direction());
+    }
+    stored.printSelf(algData);
+  } else {
+    printSelf(algData);
+  }
   file->writeData("data", algData.str());
 
   // child algorithms
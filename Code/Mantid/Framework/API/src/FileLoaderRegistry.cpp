@@ -1,14 +1,25 @@
 #include "MantidAPI/FileLoaderRegistry.h"
 #include "MantidAPI/IFileLoader.h"
+#include "MantidKernel/LibraryManager.h"
 
 #include <Poco/File.h>
 
+#include <set>
+
 namespace Mantid {
 namespace API {
 namespace {
 //----------------------------------------------------------------------------------------------
 // Anonymous namespace helpers
 //----------------------------------------------------------------------------------------------
+/// The kind under which loaders are recorded in a plugin manifest
+const char *MANIFEST_KIND = "Loader";
+
+/// Open the deferred plugin libraries that provide loaders, if there are any
+void loadDeferredLoaders() {
+  Kernel::LibraryManager::Instance().loadLibrariesProviding(MANIFEST_KIND);
+}
+
 /// @cond
 template <typename T> struct DescriptorCallback {
   void apply(T &) {} // general one does nothing
@@ -87,6 +98,18 @@ void FileLoaderRegistryImpl::unsubscribe(const std::string &name,
   }
 }
 
+/**
+ * @returns The names of the registered loaders of all formats, sorted
+ */
+std::vector<std::string> FileLoaderRegistryImpl::getNames() const {
+  std::set<std::string> names;
+  for (auto format = m_names.begin(); format != m_names.end(); ++format) {
+    for (auto it = format->begin(); it != format->end(); ++it)
+      names.insert(it->first);
+  }
+  return std::vector<std::string>(names.begin(), names.end());
+}
+
 /**
  * Queries each registered algorithm and asks it how confident it is that it can
  * load the given file. The name of the one with the highest confidence is
@@ -102,6 +125,7 @@ FileLoaderRegistryImpl::chooseLoader(const std::string &filename) const {
 
   m_log.debug() << "Trying to find loader for '" << filename << "'"
                 << std::endl;
+  loadDeferredLoaders();
 
   IAlgorithm_sptr bestLoader;
   if (NexusDescriptor::isHDF(filename)) {
@@ -135,6 +159,7 @@ bool FileLoaderRegistryImpl::canLoad(const std::string &algorithmName,
                                      const std::string &filename) const {
   using Kernel::FileDescriptor;
   using Kernel::NexusDescriptor;
+  loadDeferredLoaders();
 
   // Check if it is in one of our lists
   bool nexus(false), nonHDF(false);
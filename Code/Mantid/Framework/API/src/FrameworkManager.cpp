@@ -3,20 +3,27 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/FileLoaderRegistry.h"
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/InstrumentDataService.h"
 #include "MantidAPI/MemoryManager.h"
 #include "MantidAPI/PropertyManagerDataService.h"
+#include "MantidAPI/WorkspaceFactory.h"
 #include "MantidAPI/WorkspaceGroup.h"
 
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/LibraryManager.h"
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/PluginManifest.h"
+#include "MantidKernel/Timer.h"
 
 #include <Poco/ActiveResult.h>
 
+#include <algorithm>
 #include <cstdarg>
+#include <iterator>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -33,6 +40,21 @@ namespace {
 Kernel::Logger g_log("FrameworkManager");
 /// Key that that defines the location of the framework plugins
 const char *PLUGINS_DIR_KEY = "plugins.directory";
+/// Key that switches on deferred loading of plugin libraries
+const char *PLUGINS_LAZY_KEY = "plugins.lazyload";
+
+/// The names registered with each factory, keyed by plugin manifest kind
+typedef std::map<std::string, std::vector<std::string>> RegisteredNames;
+
+/// Take a snapshot of what the factories hold
+RegisteredNames registeredNames() {
+  RegisteredNames names;
+  names["Algorithm"] = AlgorithmFactory::Instance().getKeys(true);
+  names["Function"] = FunctionFactory::Instance().getKeys();
+  names["Loader"] = FileLoaderRegistry::Instance().getNames();
+  names["Workspace"] = WorkspaceFactory::Instance().getKeys();
+  return names;
+}
 }
 
 /** This is a function called every time NeXuS raises an error.
@@ -145,12 +167,84 @@ void FrameworkManagerImpl::loadPluginsUsingKey(const std::string &key) {
   std::string pluginDir = config.getString(key);
   if (pluginDir.length() > 0) {
     g_log.debug("Loading libraries from \"" + pluginDir + "\"");
-    Kernel::LibraryManager::Instance().OpenAllLibraries(pluginDir, false);
+    Kernel::Timer timer;
+    int lazyLoad(0);
+    config.getValue(PLUGINS_LAZY_KEY, lazyLoad);
+    if (lazyLoad == 1)
+      deferPluginsUsingKey(key, pluginDir);
+    else
+      Kernel::LibraryManager::Instance().OpenAllLibraries(pluginDir, false);
+    g_log.debug() << "Plugin start up from \"" << pluginDir << "\" took "
+                  << timer.elapsed() << " seconds\n";
   } else {
     g_log.debug("No library directory found in key \"" + key + "\"");
   }
 }
 
+/**
+ * Registers the libraries in a plugin directory with the LibraryManager
+ * without opening them, using a manifest of what each one provides. The
+ * libraries are then opened on first use of one of their algorithms, fit
+ * functions, file loaders or workspace types.
+ *
+ * The manifest is kept in the user properties directory. If it is missing or
+ * any library has been added, removed or rebuilt then the libraries are opened
+ * one at a time, as in the eager case, and the manifest is written from what
+ * each of them registered.
+ * @param key :: The key whose value gave the directory, used to name the
+ * manifest
+ * @param pluginDir :: The directory holding the plugin libraries
+ */
+void FrameworkManagerImpl::deferPluginsUsingKey(const std::string &key,
+                                                const std::string &pluginDir) {
+  Kernel::LibraryManagerImpl &libraryManager =
+      Kernel::LibraryManager::Instance();
+  const std::vector<std::string> libraries =
+      libraryManager.findLibraries(pluginDir);
+  const std::string manifestFile =
+      Kernel::ConfigService::Instance().getUserPropertiesDir() + key +
+      ".manifest";
+
+  try {
+    Kernel::PluginManifest manifest =
+        Kernel::PluginManifest::load(manifestFile);
+    if (manifest.isUpToDate(libraries)) {
+      libraryManager.deferLibraries(manifest);
+      return;
+    }
+    g_log.information() << "Plugin manifest " << manifestFile
+                        << " is out of date and will be regenerated\n";
+  } catch (std::exception &exc) {
+    g_log.debug() << "No usable plugin manifest: " << exc.what() << "\n";
+  }
+
+  Kernel::PluginManifest manifest;
+  RegisteredNames before = registeredNames();
+  for (auto lib = libraries.begin(); lib != libraries.end(); ++lib) {
+    libraryManager.OpenLibrary(*lib);
+    manifest.addLibrary(*lib);
+    // A library that fails to open, was pulled in by an earlier one or
+    // registers nothing tracked here gets no entries and is opened at start up
+    RegisteredNames after = registeredNames();
+    for (auto kind = after.begin(); kind != after.end(); ++kind) {
+      const std::vector<std::string> &old = before[kind->first];
+      std::vector<std::string> added;
+      std::set_difference(kind->second.begin(), kind->second.end(),
+                          old.begin(), old.end(), std::back_inserter(added));
+      for (auto name = added.begin(); name != added.end(); ++name)
+        manifest.addEntry(*lib, kind->first, *name);
+    }
+    before.swap(after);
+  }
+
+  try {
+    manifest.save(manifestFile);
+  } catch (std::exception &exc) {
+    g_log.warning() << "Unable to save plugin manifest: " << exc.what()
+                    << "\n";
+  }
+}
+
 /**
  * Set the global locale for all C++ stream operations to use simple ASCII
  * characters.
@@ -13,6 +13,10 @@
 
 namespace Mantid {
 namespace API {
+namespace {
+/// The kind under which functions are recorded in a plugin manifest
+const char *MANIFEST_KIND = "Function";
+}
 
 FunctionFactoryImpl::FunctionFactoryImpl()
     : Kernel::DynamicFactory<IFunction>() {
@@ -26,6 +30,8 @@ FunctionFactoryImpl::~FunctionFactoryImpl() {}
 
 IFunction_sptr
 FunctionFactoryImpl::createFunction(const std::string &type) const {
+  // The function may be in a plugin library that has not been opened yet
+  Kernel::LibraryManager::Instance().loadLibraryProviding(MANIFEST_KIND, type);
   IFunction_sptr fun = create(type);
   fun->initialize();
   return fun;
@@ -297,6 +303,16 @@ void FunctionFactoryImpl::addTie(IFunction_sptr fun,
   }
 }
 
+/**
+ * Opens any deferred plugin libraries that provide functions before listing
+ * the names, see LibraryManager.
+ * @returns The names of all registered functions
+ */
+const std::vector<std::string> FunctionFactoryImpl::getKeys() const {
+  Kernel::LibraryManager::Instance().loadLibrariesProviding(MANIFEST_KIND);
+  return Kernel::DynamicFactory<IFunction>::getKeys();
+}
+
 void FunctionFactoryImpl::subscribe(
     const std::string &className, AbstractFactory *pAbstractFactory,
     Kernel::DynamicFactory<IFunction>::SubscribeAction replace) {
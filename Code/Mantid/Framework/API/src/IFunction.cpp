@@ -4,6 +4,8 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 #include "MantidAPI/IFunction.h"
+#include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/Jacobian.h"
 #include "MantidAPI/IConstraint.h"
 #include "MantidAPI/ParameterTie.h"
@@ -23,6 +25,7 @@
 #include "MantidGeometry/muParser_Silent.h"
 
 #include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
 
 #include <Poco/StringTokenizer.h>
 
@@ -641,55 +644,375 @@ std::string IFunction::descriptionOfActive(size_t i) const {
   return parameterDescription(i);
 }
 
-/** Calculate numerical derivatives.
- * @param domain :: The domain of the function
- * @param jacobian :: A Jacobian matrix. It is expected to have dimensions of
- * domain.size() by nParams().
+namespace {
+/// Domains with fewer points per thread than this are not split into chunks
+const size_t minChunkSize = 1000;
+/// Minimum number of active parameters to share between threads
+const size_t minParallelParams = 4;
+/// Minimum number of jacobian elements worth calculating in parallel
+const size_t minParallelWork = 10000;
+
+/**
+ * Shift of a parameter used to calculate a numerical derivative
+ * @param val :: The value of the parameter
+ * @return :: The value of the shifted parameter
  */
-void IFunction::calNumericalDeriv(const FunctionDomain &domain,
-                                  Jacobian &jacobian) {
+double shiftParameter(double val) {
   const double minDouble = std::numeric_limits<double>::min();
   const double epsilon = std::numeric_limits<double>::epsilon() * 100;
-  double stepPercentage = 0.001; // step percentage
-  double step;                   // real step
-  double cutoff = 100.0 * minDouble / stepPercentage;
-  size_t nParam = nParams();
-  size_t nData = domain.size();
+  const double stepPercentage = 0.001; // step percentage
+  const double cutoff = 100.0 * minDouble / stepPercentage;
+  double step; // real step
+  if (fabs(val) < cutoff) {
+    step = epsilon;
+  } else {
+    step = val * stepPercentage;
+  }
+  return val + step;
+}
 
-  FunctionValues minusStep(domain);
-  FunctionValues plusStep(domain);
+/**
+ * Copy the parameter values of a function to its copy.
+ * @param copy :: The copy of the function
+ * @param fun :: The original function
+ * @return :: False if the copy has different parameters or active parameters
+ */
+bool syncParameters(IFunction &copy, const IFunction &fun) {
+  if (copy.nParams() != fun.nParams()) {
+    return false;
+  }
+  for (size_t i = 0; i < fun.nParams(); ++i) {
+    copy.setParameter(i, fun.getParameter(i), false);
+    if (fun.isActive(i) != copy.isActive(i)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  // PARALLEL_CRITICAL(numeric_deriv)
-  {
-    applyTies(); // just in case
-    function(domain, minusStep);
+/**
+ * Make a copy of a function with exactly the same parameter values and active
+ * parameters.
+ * @param fun :: The function to copy
+ * @return :: The copy or an empty pointer if the function cannot be copied
+ */
+IFunction_sptr copyFunction(const IFunction &fun) {
+  IFunction_sptr copy;
+  try {
+    copy = fun.clone();
+  } catch (std::exception &) {
+    return IFunction_sptr();
+  }
+  if (!copy || copy->nParams() != fun.nParams()) {
+    return IFunction_sptr();
+  }
+  for (size_t i = 0; i < fun.nParams(); ++i) {
+    if (!fun.isActive(i) && copy->isActive(i)) {
+      copy->fix(i);
+    }
+  }
+  // clone() goes through a string which doesn't keep the full precision
+  if (!syncParameters(*copy, fun)) {
+    return IFunction_sptr();
   }
+  return copy;
+}
 
-  for (size_t iP = 0; iP < nParam; iP++) {
-    if (isActive(iP)) {
-      const double val = activeParameter(iP);
-      if (fabs(val) < cutoff) {
-        step = epsilon;
-      } else {
-        step = val * stepPercentage;
+/**
+ * Check that a copy of a function reproduces the values of the original.
+ * @param copy :: The copy of the function
+ * @param domain :: The domain (or a chunk of it) to evaluate the copy on
+ * @param expected :: The values of the original function on the full domain
+ * @param start :: The index of the first point of the domain in expected
+ * @return :: True if all values are the same
+ */
+bool hasSameValues(const IFunction &copy, const FunctionDomain &domain,
+                   const FunctionValues &expected, size_t start) {
+  try {
+    FunctionValues values(domain);
+    copy.function(domain, values);
+    for (size_t i = 0; i < domain.size(); ++i) {
+      if (values.getCalculated(i) != expected.getCalculated(start + i)) {
+        return false;
       }
+    }
+  } catch (std::exception &) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Split a 1D domain into chunks of equal size. The last chunk takes the
+ * remainder.
+ * @param domain :: The domain
+ * @param nChunks :: The number of chunks
+ * @return :: Views of the chunks
+ */
+std::vector<FunctionDomain_sptr> makeChunks(const FunctionDomain1D &domain,
+                                            size_t nChunks) {
+  const size_t chunkSize = domain.size() / nChunks;
+  std::vector<FunctionDomain_sptr> chunks(nChunks);
+  for (size_t c = 0; c < nChunks; ++c) {
+    const size_t start = c * chunkSize;
+    const size_t n = c + 1 < nChunks ? chunkSize : domain.size() - start;
+    chunks[c] = boost::make_shared<FunctionDomain1DView>(
+        domain.getPointerAt(start), n);
+  }
+  return chunks;
+}
 
-      double paramPstep = val + step;
+/**
+ * Make copies of a function and check that each one reproduces the values of
+ * the original on the part of the domain it will be given.
+ * @param fun :: The function
+ * @param nCopies :: The number of copies
+ * @param chunks :: The chunks of the domain, one per copy, or empty if every
+ * copy is used on the full domain
+ * @param domain :: The full domain
+ * @param values :: The values of the function on the full domain
+ * @return :: The copies or an empty vector if any copy cannot be used
+ */
+std::vector<IFunction_sptr>
+makeCheckedCopies(const IFunction &fun, size_t nCopies,
+                  const std::vector<FunctionDomain_sptr> &chunks,
+                  const FunctionDomain &domain, const FunctionValues &values) {
+  std::vector<IFunction_sptr> copies(nCopies);
+  for (size_t k = 0; k < nCopies; ++k) {
+    copies[k] = copyFunction(fun);
+    if (!copies[k]) {
+      return std::vector<IFunction_sptr>();
+    }
+  }
+  const size_t chunkSize = chunks.empty() ? 0 : domain.size() / chunks.size();
+  std::vector<char> same(nCopies);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int k = 0; k < static_cast<int>(nCopies); ++k) {
+    if (chunks.empty()) {
+      same[k] = hasSameValues(*copies[k], domain, values, 0);
+    } else {
+      same[k] = hasSameValues(*copies[k], *chunks[k], values,
+                              static_cast<size_t>(k) * chunkSize);
+    }
+  }
+  if (std::find(same.begin(), same.end(), 0) != same.end()) {
+    return std::vector<IFunction_sptr>();
+  }
+  return copies;
+}
+
+/**
+ * Set a column of the jacobian to the numerical derivative with respect to an
+ * active parameter.
+ * @param fun :: The function
+ * @param iP :: The index of the parameter
+ * @param domain :: The domain
+ * @param values :: The values of the function
+ * @param plusStep :: Buffer for the values with the shifted parameter
+ * @param jacobian :: The jacobian
+ * @param start :: The index of the first point of the domain in values and
+ * the jacobian
+ */
+void setNumericalDerivColumn(IFunction &fun, size_t iP,
+                             const FunctionDomain &domain,
+                             const FunctionValues &values,
+                             FunctionValues &plusStep, Jacobian &jacobian,
+                             size_t start = 0) {
+  const double val = fun.activeParameter(iP);
+  const double paramPstep = shiftParameter(val);
+  fun.setActiveParameter(iP, paramPstep);
+  fun.applyTies();
+  fun.function(domain, plusStep);
+  fun.setActiveParameter(iP, val);
+
+  const double step = paramPstep - val;
+  for (size_t i = 0; i < domain.size(); i++) {
+    jacobian.set(start + i, iP, (plusStep.getCalculated(i) -
+                                 values.getCalculated(start + i)) /
+                                    step);
+  }
+}
 
-      // PARALLEL_CRITICAL(numeric_deriv)
-      {
-        setActiveParameter(iP, paramPstep);
-        applyTies();
-        function(domain, plusStep);
-        setActiveParameter(iP, val);
+/**
+ * Calculate numerical derivatives sharing the active parameters between
+ * threads. Each thread uses its own copy of the function.
+ * @param copies :: The copies of the function, one per thread
+ * @param active :: Indices of the active parameters
+ * @param domain :: The domain
+ * @param values :: The values of the function
+ * @param jacobian :: The jacobian
+ */
+void calNumericalDerivByParameter(const std::vector<IFunction_sptr> &copies,
+                                  const std::vector<size_t> &active,
+                                  const FunctionDomain &domain,
+                                  const FunctionValues &values,
+                                  Jacobian &jacobian) {
+  std::string error;
+  PRAGMA_OMP(parallel for schedule(dynamic, 1)
+                 num_threads(static_cast<int>(copies.size())))
+  for (int ia = 0; ia < static_cast<int>(active.size()); ++ia) {
+    const size_t k = PARALLEL_THREAD_NUMBER;
+    try {
+      FunctionValues plusStep(domain);
+      setNumericalDerivColumn(*copies[k], active[ia], domain, values, plusStep,
+                              jacobian);
+    } catch (std::exception &e) {
+      PARALLEL_CRITICAL(numeric_deriv_error) {
+        if (error.empty()) {
+          error = e.what();
+        }
       }
+    }
+  }
+  if (!error.empty()) {
+    throw std::runtime_error(error);
+  }
+}
+
+/**
+ * Calculate numerical derivatives splitting a 1D domain into chunks. Each
+ * chunk is evaluated by its own copy of the function.
+ * @param copies :: The copies of the function, one per chunk
+ * @param chunks :: The chunks of the domain
+ * @param domain :: The full domain
+ * @param active :: Indices of the active parameters
+ * @param values :: The values of the function on the full domain
+ * @param jacobian :: The jacobian
+ */
+void calNumericalDerivByChunk(const std::vector<IFunction_sptr> &copies,
+                              const std::vector<FunctionDomain_sptr> &chunks,
+                              const FunctionDomain &domain,
+                              const std::vector<size_t> &active,
+                              const FunctionValues &values,
+                              Jacobian &jacobian) {
+  const size_t chunkSize = domain.size() / chunks.size();
+  std::vector<FunctionValues> plusStep(chunks.size());
+  for (size_t c = 0; c < chunks.size(); ++c) {
+    plusStep[c].reset(*chunks[c]);
+  }
+
+  const int n = static_cast<int>(chunks.size());
+  std::string error;
+  for (size_t ia = 0; ia < active.size(); ia++) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int c = 0; c < n; ++c) {
+      try {
+        setNumericalDerivColumn(*copies[c], active[ia], *chunks[c], values,
+                                plusStep[c], jacobian,
+                                static_cast<size_t>(c) * chunkSize);
+      } catch (std::exception &e) {
+        PARALLEL_CRITICAL(numeric_deriv_error) {
+          if (error.empty()) {
+            error = e.what();
+          }
+        }
+      }
+    }
+    if (!error.empty()) {
+      throw std::runtime_error(error);
+    }
+  }
+}
+
+} // namespace
+
+/** Calculate numerical derivatives.
+ *
+ * When several threads are available and the jacobian is large enough the
+ * function is copied for each thread and either the active parameters or,
+ * for a large FunctionDomain1D and few parameters, chunks of the domain are
+ * shared between them. The copies are used only if they reproduce the values
+ * of this function exactly, so functions that cannot be copied or are not
+ * point-wise (e.g. Convolution on a chunk) are differentiated serially. The
+ * copies are made and checked once and kept until the next fit (see
+ * clearNumericalDerivCopies()), later calls only copy the parameter values.
+ * Every element of the jacobian is calculated by a single thread so the
+ * result doesn't depend on the number of threads.
+ * @param domain :: The domain of the function
+ * @param jacobian :: A Jacobian matrix. It is expected to have dimensions of
+ * domain.size() by nParams().
+ */
+void IFunction::calNumericalDeriv(const FunctionDomain &domain,
+                                  Jacobian &jacobian) {
+  applyTies(); // just in case
+
+  std::vector<size_t> active;
+  for (size_t iP = 0; iP < nParams(); iP++) {
+    if (isActive(iP)) {
+      active.push_back(iP);
+    }
+  }
+  if (active.empty()) {
+    return;
+  }
 
-      step = paramPstep - val;
-      for (size_t i = 0; i < nData; i++) {
-        jacobian.set(i, iP,
-                     (plusStep.getCalculated(i) - minusStep.getCalculated(i)) /
-                         step);
+  FunctionValues minusStep(domain);
+  function(domain, minusStep);
+
+  IF_NOT_PARALLEL {
+    const size_t nThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+    auto domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+    if (nThreads > 1 && domain.size() * active.size() >= minParallelWork) {
+      bool valid = m_numDerivDomainSize == domain.size() &&
+                   (domain1D || m_numDerivChunks == 0);
+      for (size_t k = 0; valid && k < m_numDerivCopies.size(); ++k) {
+        valid = syncParameters(*m_numDerivCopies[k], *this);
       }
+      if (!valid) {
+        m_numDerivCopies.clear();
+        m_numDerivChunks = 0;
+        m_numDerivDomainSize = domain.size();
+        const size_t nChunks =
+            domain1D ? std::min(nThreads, domain.size() / minChunkSize) : 0;
+        if (nChunks > 1 && active.size() < nThreads) {
+          m_numDerivCopies = makeCheckedCopies(
+              *this, nChunks, makeChunks(*domain1D, nChunks), domain,
+              minusStep);
+          if (!m_numDerivCopies.empty()) {
+            m_numDerivChunks = nChunks;
+          }
+        }
+        if (m_numDerivCopies.empty() && active.size() >= minParallelParams) {
+          m_numDerivCopies = makeCheckedCopies(
+              *this, std::min(nThreads, active.size()),
+              std::vector<FunctionDomain_sptr>(), domain, minusStep);
+        }
+      }
+      if (!m_numDerivCopies.empty()) {
+        if (m_numDerivChunks > 0) {
+          calNumericalDerivByChunk(m_numDerivCopies,
+                                   makeChunks(*domain1D, m_numDerivChunks),
+                                   domain, active, minusStep, jacobian);
+        } else {
+          calNumericalDerivByParameter(m_numDerivCopies, active, domain,
+                                       minusStep, jacobian);
+        }
+        return;
+      }
+    }
+  }
+
+  FunctionValues plusStep(domain);
+  for (size_t ia = 0; ia < active.size(); ia++) {
+    setNumericalDerivColumn(*this, active[ia], domain, minusStep, plusStep,
+                            jacobian);
+  }
+}
+
+/**
+ * Discard the copies of the function used by calNumericalDeriv(). They are
+ * made again the next time the derivatives are calculated in parallel. Call
+ * it when a fit starts or the function changes in a way that doesn't show in
+ * its parameters.
+ */
+void IFunction::clearNumericalDerivCopies() {
+  m_numDerivCopies.clear();
+  m_numDerivChunks = 0;
+  m_numDerivDomainSize = 0;
+  auto composite = dynamic_cast<CompositeFunction *>(this);
+  if (composite) {
+    for (size_t i = 0; i < composite->nFunctions(); ++i) {
+      composite->getFunction(i)->clearNumericalDerivCopies();
     }
   }
 }
@@ -1070,6 +1393,8 @@ void IFunction::storeAttributeValue(const std::string &name,
                                     const API::IFunction::Attribute &value) {
   if (hasAttribute(name)) {
     m_attrs[name] = value;
+    // the copies for the numerical derivatives may have a different value
+    clearNumericalDerivCopies();
   } else {
     throw std::invalid_argument(
         "ParamFunctionAttributeHolder::setAttribute - Unknown attribute '" +
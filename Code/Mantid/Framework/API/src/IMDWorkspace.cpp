@@ -1,6 +1,7 @@
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/IPropertyManager.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/VMD.h"
 
 #include <sstream>
@@ -122,6 +123,53 @@ void IMDWorkspace::getLinePlot(const Mantid::Kernel::VMD &start,
   // And the last point
   x.push_back((end - start).norm());
 }
+
+//-----------------------------------------------------------------------------------------------
+/** Render a 2D slice through a IMDWorkspace into an image.
+ * Pixel (i, j) of the image samples the workspace at the centre of the pixel,
+ * origin + (i + 0.5) * xStep + (j + 0.5) * yStep. Rows of the image are
+ * rendered in parallel.
+ *
+ * @param origin :: coordinates of the corner of the image
+ * @param xStep :: size of a pixel along the rows of the image
+ * @param yStep :: size of a pixel along the columns of the image
+ * @param numX :: number of pixels in a row
+ * @param numY :: number of rows
+ * @param normalize :: how to normalize the signal
+ * @param signal :: is set to the normalized signal of each pixel, a row at a
+ *time. Length = numX * numY. Pixels outside the workspace are NaN.
+ * @throw std::invalid_argument if the vectors do not have one coordinate per
+ *dimension of the workspace
+ */
+void IMDWorkspace::getPlanePlot(const Mantid::Kernel::VMD &origin,
+                                const Mantid::Kernel::VMD &xStep,
+                                const Mantid::Kernel::VMD &yStep,
+                                size_t numX, size_t numY,
+                                Mantid::API::MDNormalization normalize,
+                                std::vector<signal_t> &signal) const {
+  const size_t nd = this->getNumDims();
+  if (origin.getNumDims() != nd || xStep.getNumDims() != nd ||
+      yStep.getNumDims() != nd)
+    throw std::invalid_argument("IMDWorkspace::getPlanePlot(): the origin and "
+                                "steps must have one coordinate per "
+                                "dimension of the workspace.");
+  signal.assign(numX * numY, 0.0);
+
+  const int numRows = static_cast<int>(numY);
+  PARALLEL_FOR_IF(this->threadSafe())
+  for (int j = 0; j < numRows; ++j) {
+    std::vector<coord_t> coord(nd);
+    const double y = static_cast<double>(j) + 0.5;
+    for (size_t i = 0; i < numX; ++i) {
+      const double x = static_cast<double>(i) + 0.5;
+      for (size_t d = 0; d < nd; d++)
+        coord[d] = static_cast<coord_t>(origin[d] + x * xStep[d] +
+                                        y * yStep[d]);
+      signal[static_cast<size_t>(j) * numX + i] =
+          this->getSignalAtCoord(&coord[0], normalize);
+    }
+  }
+}
 }
 }
 
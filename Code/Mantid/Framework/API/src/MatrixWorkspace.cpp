@@ -10,6 +10,7 @@
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
+#include <algorithm>
 #include <numeric>
 #include <boost/math/special_functions/fpclassify.hpp>
 
@@ -554,23 +555,29 @@ MatrixWorkspace::getIndexFromSpectrumNumber(const specid_t specNo) const {
 void MatrixWorkspace::getIndicesFromDetectorIDs(
     const std::vector<detid_t> &detIdList,
     std::vector<size_t> &indexList) const {
-  std::map<detid_t, std::set<size_t>> detectorIDtoWSIndices;
+  // Every (detector ID, workspace index) pair, sorted so that the indices of a
+  // detector are found, in increasing order, by a binary search
+  typedef std::pair<detid_t, size_t> DetectorIndexPair;
+  std::vector<DetectorIndexPair> detectorIDtoWSIndices;
+  detectorIDtoWSIndices.reserve(getNumberHistograms());
   for (size_t i = 0; i < getNumberHistograms(); ++i) {
-    auto detIDs = getSpectrum(i)->getDetectorIDs();
+    const std::set<detid_t> &detIDs = getSpectrum(i)->getDetectorIDs();
     for (auto it = detIDs.begin(); it != detIDs.end(); ++it) {
-      detectorIDtoWSIndices[*it].insert(i);
+      detectorIDtoWSIndices.push_back(std::make_pair(*it, i));
     }
   }
+  std::sort(detectorIDtoWSIndices.begin(), detectorIDtoWSIndices.end());
 
   indexList.clear();
   indexList.reserve(detIdList.size());
   for (size_t j = 0; j < detIdList.size(); ++j) {
-    auto wsIndices = detectorIDtoWSIndices.find(detIdList[j]);
-    if (wsIndices != detectorIDtoWSIndices.end()) {
-      for (auto it = wsIndices->second.begin(); it != wsIndices->second.end();
-           ++it) {
-        indexList.push_back(*it);
-      }
+    auto wsIndex = std::lower_bound(detectorIDtoWSIndices.begin(),
+                                    detectorIDtoWSIndices.end(),
+                                    DetectorIndexPair(detIdList[j], 0));
+    for (; wsIndex != detectorIDtoWSIndices.end() &&
+               wsIndex->first == detIdList[j];
+         ++wsIndex) {
+      indexList.push_back(wsIndex->second);
     }
   }
 }
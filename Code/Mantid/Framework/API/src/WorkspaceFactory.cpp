@@ -6,6 +6,7 @@
 #include "MantidAPI/WorkspaceOpOverloads.h"
 #include "MantidAPI/MemoryManager.h"
 #include "MantidKernel/ConfigService.h"
+#include "MantidKernel/LibraryManager.h"
 #include "MantidAPI/NumericAxis.h"
 #include "MantidAPI/TextAxis.h"
 #include "MantidAPI/ITableWorkspace.h"
@@ -16,6 +17,8 @@ namespace API {
 namespace {
 /// static logger object
 Kernel::Logger g_log("WorkspaceFactory");
+/// The kind under which workspaces are recorded in a plugin manifest
+const char *MANIFEST_KIND = "Workspace";
 }
 
 using std::size_t;
@@ -179,6 +182,19 @@ MatrixWorkspace_sptr WorkspaceFactoryImpl::create(const std::string &className,
   return ws;
 }
 
+/** Creates a workspace by class name. The class may be registered by a plugin
+ *  library that has not been opened yet, see LibraryManager.
+ *  @param className :: The name of the workspace class
+ *  @return A shared pointer to the new, uninitialised workspace
+ *  @throw NotFoundException If the class is not registered in the factory
+ */
+boost::shared_ptr<Workspace>
+WorkspaceFactoryImpl::create(const std::string &className) const {
+  Kernel::LibraryManager::Instance().loadLibraryProviding(MANIFEST_KIND,
+                                                          className);
+  return Kernel::DynamicFactory<Workspace>::create(className);
+}
+
 /// Create a ITableWorkspace
 ITableWorkspace_sptr
 WorkspaceFactoryImpl::createTable(const std::string &className) const {
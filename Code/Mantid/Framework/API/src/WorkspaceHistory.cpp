@@ -5,7 +5,9 @@
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/HistoryView.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/EnvironmentHistory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include <boost/algorithm/string/split.hpp>
 #include "Poco/DateTime.h"
 #include <Poco/DateTimeParser.h>
@@ -277,6 +279,7 @@ void WorkspaceHistory::loadNestedHistory(::NeXus::File *file,
 
     try {
       AlgorithmHistory_sptr history = parseAlgorithmHistory(rawData);
+      loadArrayProperties(file, history);
       loadNestedHistory(file, history);
       if (parent) {
         parent->addChildHistory(history);
@@ -294,6 +297,45 @@ void WorkspaceHistory::loadNestedHistory(::NeXus::File *file,
   }
 }
 
+/** Load the property values that AlgorithmHistory::saveNexus wrote as
+ * datasets rather than as text.
+ * @param file :: The handle to the nexus file, open at the algorithm entry
+ * @param history :: The history parsed from the text of the entry
+ */
+void WorkspaceHistory::loadArrayProperties(::NeXus::File *file,
+                                           AlgorithmHistory_sptr history) {
+  const std::string prefix("property_");
+  std::map<std::string, std::string> entries;
+  file->getEntries(entries);
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (it->first.compare(0, prefix.size(), prefix) != 0)
+      continue;
+    const std::string propName = it->first.substr(prefix.size());
+    const Kernel::PropertyHistories &props = history->getProperties();
+    for (auto prop = props.begin(); prop != props.end(); ++prop) {
+      if ((*prop)->name() != propName)
+        continue;
+      std::vector<double> values;
+      file->readData(it->first, values);
+      int integral(0);
+      file->openData(it->first);
+      file->getAttr("integral", integral);
+      file->closeData();
+      if (integral) {
+        std::vector<int64_t> intValues(values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+          intValues[i] = static_cast<int64_t>(values[i]);
+        (*prop)->setValue(
+            boost::make_shared<Kernel::ArrayHistoryValue<int64_t>>(intValues));
+      } else {
+        (*prop)->setValue(
+            boost::make_shared<Kernel::ArrayHistoryValue<double>>(values));
+      }
+      break;
+    }
+  }
+}
+
 /** Find all the algorithm entries at a particular point the the nexus file
  * @param file :: The handle to the nexus file
  * @returns set of integers. One for each algorithm at the level in the file.
@@ -378,10 +420,12 @@ WorkspaceHistory::parseAlgorithmHistory(const std::string &rawData) {
   // Convert the timestamp to time_t to DateAndTime
   utc_start.set_from_time_t(start_timedate.timestamp().epochTime());
   // Create the algorithm history
-  API::AlgorithmHistory alg_hist(algName, version, utc_start, dur,
-                                 Algorithm::g_execCount);
   // Simulate running an algorithm
-  ++Algorithm::g_execCount;
+  size_t execCount(0);
+  PARALLEL_CRITICAL(algorithm_exec_count) {
+    execCount = Algorithm::g_execCount++;
+  }
+  API::AlgorithmHistory alg_hist(algName, version, utc_start, dur, execCount);
 
   // Add property information
   for (size_t index = static_cast<size_t>(PARAMS) + 1; index < nlines;
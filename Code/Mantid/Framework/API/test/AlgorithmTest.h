@@ -13,8 +13,15 @@
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/RebinParamsValidator.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Timer.h"
 #include "FakeAlgorithms.h"
+#include <boost/lexical_cast.hpp>
+#include <Poco/Thread.h>
+#include <iostream>
 #include <map>
+#include <set>
 
 using namespace Mantid::Kernel; 
 using namespace Mantid::API;
@@ -123,6 +130,7 @@ public:
   const std::string name() const { return "FailingAlgorithm"; }
   int version() const { return 1; }
   const std::string summary() const { return "Test summary"; }
+  bool canProcessGroupsInParallel() const { return true; }
   static const std::string FAIL_MSG;
 
   void init()
@@ -147,6 +155,68 @@ const std::string FailingAlgorithm::FAIL_MSG("Algorithm failed as requested");
 
 DECLARE_ALGORITHM(FailingAlgorithm)
 
+/**
+ * Algorithm which waits a while before producing its output
+ */
+class SleepingAlgorithm : public Algorithm
+{
+public:
+  SleepingAlgorithm() : Algorithm() {}
+  virtual ~SleepingAlgorithm() {}
+  const std::string name() const { return "SleepingAlgorithm"; }
+  int version() const { return 1; }
+  const std::string summary() const { return "Test summary"; }
+  bool canProcessGroupsInParallel() const { return true; }
+
+  void init()
+  {
+    declareProperty(new WorkspaceProperty<>("InputWorkspace","",Direction::Input));
+    declareProperty(new WorkspaceProperty<>("OutputWorkspace","",Direction::Output));
+    declareProperty("Milliseconds", 20);
+  }
+
+  void exec()
+  {
+    const int milliseconds = getProperty("Milliseconds");
+    Poco::Thread::sleep(milliseconds);
+    boost::shared_ptr<WorkspaceTester> out(new WorkspaceTester());
+    out->init(1,2,1);
+    out->setTitle(getPropertyValue("InputWorkspace"));
+    setProperty("OutputWorkspace", out);
+  }
+};
+
+DECLARE_ALGORITHM(SleepingAlgorithm)
+
+/// Run a group through SleepingAlgorithm, in parallel or not
+WorkspaceGroup_sptr runSleepingAlgorithmOnGroup(const std::string & groupName, const bool parallel)
+{
+  ConfigService::Instance().setString("algorithms.groups.parallel", parallel ? "1" : "0");
+  SleepingAlgorithm alg;
+  alg.initialize();
+  alg.setRethrows(true);
+  alg.setPropertyValue("InputWorkspace", groupName);
+  alg.setPropertyValue("OutputWorkspace", "SleepingAlgorithm_out");
+  alg.execute();
+  ConfigService::Instance().setString("algorithms.groups.parallel", "0");
+  return AnalysisDataService::Instance().retrieveWS<WorkspaceGroup>("SleepingAlgorithm_out");
+}
+
+/// Make a group of WorkspaceTesters called name_1, name_2, ...
+void makeTesterGroup(const std::string & groupName, const size_t size)
+{
+  WorkspaceGroup_sptr wsGroup = WorkspaceGroup_sptr(new WorkspaceGroup());
+  AnalysisDataService::Instance().addOrReplace(groupName, wsGroup);
+  for (size_t i = 0; i < size; ++i)
+  {
+    boost::shared_ptr<WorkspaceTester> ws(new WorkspaceTester());
+    ws->init(10,10,10);
+    const std::string name = groupName + "_" + boost::lexical_cast<std::string>(i + 1);
+    AnalysisDataService::Instance().addOrReplace(name, ws);
+    wsGroup->add(name);
+  }
+}
+
 class AlgorithmTest : public CxxTest::TestSuite
 {
 public:
@@ -770,6 +840,64 @@ public:
     }
   }
 
+  void test_processGroups_inParallel_keeps_names_and_order()
+  {
+    makeTesterGroup("P", 8);
+    WorkspaceGroup_sptr group;
+    TS_ASSERT_THROWS_NOTHING( group = runSleepingAlgorithmOnGroup("P", true) );
+    TS_ASSERT( group );
+    if (!group) return;
+    TS_ASSERT_EQUALS( group->getNumberOfEntries(), 8 );
+    std::set<size_t> execCounts;
+    for (size_t i = 0; i < 8; ++i)
+    {
+      const std::string index = boost::lexical_cast<std::string>(i + 1);
+      Workspace_sptr ws = group->getItem(i);
+      TS_ASSERT_EQUALS( ws->name(), "SleepingAlgorithm_out_" + index );
+      TS_ASSERT_EQUALS( ws->getTitle(), "P_" + index );
+      // History is recorded for each entry
+      TS_ASSERT_EQUALS( ws->getHistory().size(), 1 );
+      if (ws->getHistory().size() == 1)
+        execCounts.insert(ws->getHistory().getAlgorithmHistory(0)->execCount());
+    }
+    // Every entry has its own execution number
+    TS_ASSERT_EQUALS( execCounts.size(), 8 );
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_groups_are_not_processed_in_parallel_by_default()
+  {
+    TS_ASSERT( !alg.canProcessGroupsInParallel() );
+    SleepingAlgorithm sleeping;
+    TS_ASSERT( sleeping.canProcessGroupsInParallel() );
+  }
+
+  void test_processGroups_inParallel_failOnGroupMemberErrorMessage()
+  {
+    makeWorkspaceGroup("A", "A_1,A_2,A_3");
+    ConfigService::Instance().setString("algorithms.groups.parallel", "1");
+
+    FailingAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setLogging(false);
+    alg.setPropertyValue("InputWorkspace", "A");
+    alg.setPropertyValue("WsNameToFail", "A_2");
+
+    try
+    {
+      alg.execute();
+      TS_FAIL("Exception wasn't thrown");
+    }
+    catch(std::runtime_error& e)
+    {
+      std::string msg(e.what());
+      TS_ASSERT( msg.find("group entry 2") != std::string::npos );
+      TS_ASSERT( msg.find(FailingAlgorithm::FAIL_MSG) != std::string::npos );
+    }
+    ConfigService::Instance().setString("algorithms.groups.parallel", "0");
+  }
+
 private:
   IAlgorithm_sptr runFromString(const std::string & input)
   {
@@ -790,5 +918,35 @@ private:
 };
 
  
+class AlgorithmTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static AlgorithmTestPerformance *createSuite() { return new AlgorithmTestPerformance(); }
+  static void destroySuite( AlgorithmTestPerformance *suite ) { delete suite; }
+
+  AlgorithmTestPerformance()
+  {
+    Mantid::API::FrameworkManager::Instance();
+    makeTesterGroup("Perf", 32);
+  }
+
+  ~AlgorithmTestPerformance()
+  {
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_processGroups_of_32_in_parallel_is_faster()
+  {
+    Timer timer;
+    runSleepingAlgorithmOnGroup("Perf", false);
+    const float serial = timer.elapsed();
+    runSleepingAlgorithmOnGroup("Perf", true);
+    const float parallel = timer.elapsed();
+    std::cout << "\nprocessGroups on 32 entries took " << serial
+              << " s in turn and " << parallel << " s in parallel\n";
+    if (PARALLEL_GET_MAX_THREADS > 1)
+      TS_ASSERT_LESS_THAN( parallel, serial );
+  }
+};
 
 #endif /*ALGORITHMTEST_H_*/
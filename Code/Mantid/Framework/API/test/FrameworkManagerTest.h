@@ -6,6 +6,11 @@
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/LibraryManager.h"
+#include "MantidKernel/PluginManifest.h"
+#include "MantidKernel/Timer.h"
 #include <stdexcept>
 #include <iostream>
 
@@ -80,4 +85,48 @@ public:
 
 };
 
+/** Time to first algorithm with and without plugins.lazyload. This must be
+ * the first use of the FrameworkManager in the process, as it is when the
+ * suite is run on its own. The libraries are first deferred and only those
+ * needed for Rebin are opened; the rest are then opened, which is what eager
+ * loading adds on top. The deferred time includes writing the manifest if it
+ * was missing or out of date, so time a second run.
+ */
+class FrameworkManagerTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static FrameworkManagerTestPerformance *createSuite() { return new FrameworkManagerTestPerformance(); }
+  static void destroySuite(FrameworkManagerTestPerformance *suite) { delete suite; }
+
+  void test_time_to_first_algorithm()
+  {
+    ConfigServiceImpl & config = ConfigService::Instance();
+    const std::string pluginDir = config.getString("plugins.directory");
+    const std::string manifestFile = config.getUserPropertiesDir() + "plugins.directory.manifest";
+    bool manifestUpToDate(false);
+    try
+    {
+      manifestUpToDate = PluginManifest::load(manifestFile).isUpToDate(
+          LibraryManager::Instance().findLibraries(pluginDir));
+    }
+    catch (std::exception &)
+    {
+    }
+    config.setString("plugins.lazyload", "1");
+
+    Timer timer;
+    FrameworkManager::Instance();
+    TS_ASSERT_THROWS_NOTHING( AlgorithmManager::Instance().create("Rebin") );
+    const double deferred = timer.elapsed();
+
+    LibraryManager::Instance().OpenAllLibraries(pluginDir, false);
+    const double remaining = timer.elapsed();
+
+    std::cout << "\nTime to first algorithm: " << deferred << " s deferred";
+    if (!manifestUpToDate)
+      std::cout << " (including writing the manifest)";
+    std::cout << ", " << deferred + remaining << " s with all plugins opened\n";
+  }
+};
+
 #endif /*FRAMEWORKMANAGERTEST_H_*/
@@ -85,6 +85,17 @@ public:
   int getVectorIndex(const MantidVec &vecX, double x);
 
 private:
+  /// Functions used to fit the peaks of one spectrum and the resulting rows of
+  /// the output table. Each spectrum is fitted with its own copy of the
+  /// functions so that spectra can be fitted in parallel.
+  struct SpectrumFit {
+    API::IPeakFunction_sptr peakFunction;
+    API::IBackgroundFunction_sptr backgroundFunction;
+    /// Values of the output table columns after the spectrum number, one
+    /// vector per peak
+    std::vector<std::vector<double>> rows;
+  };
+
   void init();
   void exec();
 
@@ -110,19 +121,20 @@ private:
   /// Fit peak confined in a given window (x-min, x-max)
   void fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
                        const int spectrum, const double centre,
-                       const double xmin, const double xmax);
+                       const double xmin, const double xmax, SpectrumFit &fit);
 
   /// Fit peak by given/guessed FWHM
   void fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
                         const int spectrum, const double center_guess,
                         const int fitWidth, const bool hasleftpeak,
                         const double leftpeakcentre, const bool hasrightpeak,
-                        const double rightpeakcentre);
+                        const double rightpeakcentre, SpectrumFit &fit);
 
   /// Fit peak: this is a basic peak fit function as a root function for all
   /// different type of user input
   void fitSinglePeak(const API::MatrixWorkspace_sptr &input, const int spectrum,
-                     const int i_min, const int i_max, const int i_centre);
+                     const int i_min, const int i_max, const int i_centre,
+                     SpectrumFit &fit);
 
   void fitPeakHighBackground(const API::MatrixWorkspace_sptr &input,
                              const size_t spectrum, int i_centre, int i_min,
@@ -136,17 +148,22 @@ private:
 
   /// Add a new row in output TableWorkspace containing information of the
   /// fitted peak+background
-  void addInfoRow(const size_t spectrum,
-                  const API::IPeakFunction_const_sptr &peakfunction,
-                  const API::IBackgroundFunction_sptr &bkgdfunction,
-                  const bool isoutputraw, const double mincost);
+  void addInfoRow(SpectrumFit &fit, const bool isoutputraw,
+                  const double mincost);
 
   /// Add the fit record (failure) to output workspace
-  void addNonFitRecord(const size_t spectrum);
+  void addNonFitRecord(SpectrumFit &fit);
+
+  /// Add the rows of all the fitted spectra to the output workspace
+  void addRowsToTable(const int start,
+                      const std::vector<std::vector<std::vector<double>>> &rows);
 
   /// Create peak and background functions
   void createFunctions();
 
+  /// Copy the peak and background functions to fit a spectrum with
+  void initSpectrumFit(SpectrumFit &fit) const;
+
   /// Find peak background
   bool findPeakBackground(const API::MatrixWorkspace_sptr &input, int spectrum,
                           size_t i_min, size_t i_max,
@@ -5,6 +5,7 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/TimeSeriesColumns.h"
 #include "MantidDataObjects/SplittersWorkspace.h"
 #include "MantidAPI/ISplittersWorkspace.h"
 #include "MantidAPI/ITableWorkspace.h"
@@ -107,8 +108,8 @@ private:
                                Kernel::DateAndTime stopTime, int wsindex);
 
   /// Make multiple-log-value filters in serial
-  void makeMultipleFiltersByValues(std::map<size_t, int> indexwsindexmap,
-                                   std::vector<double> logvalueranges,
+  void makeMultipleFiltersByValues(const std::map<size_t, int> &indexwsindexmap,
+                                   const std::vector<double> &logvalueranges,
                                    bool centre, bool filterIncrease,
                                    bool filterDecrease,
                                    Kernel::DateAndTime startTime,
@@ -116,17 +117,22 @@ private:
 
   /// Make multiple-log-value filters in serial in parallel
   void makeMultipleFiltersByValuesParallel(
-      std::map<size_t, int> indexwsindexmap, std::vector<double> logvalueranges,
-      bool centre, bool filterIncrease, bool filterDecrease,
-      Kernel::DateAndTime startTime, Kernel::DateAndTime stopTime);
+      const std::map<size_t, int> &indexwsindexmap,
+      const std::vector<double> &logvalueranges, bool centre,
+      bool filterIncrease, bool filterDecrease, Kernel::DateAndTime startTime,
+      Kernel::DateAndTime stopTime);
+
+  /// Find the workspace group of each log entry from its value
+  void classifyLogEntries(const std::map<size_t, int> &indexwsindexmap,
+                          const std::vector<double> &logvalueranges,
+                          std::vector<int> &entrygroups);
 
   /// Generate event splitters for partial sample log (serial)
   void makeMultipleFiltersByValuesPartialLog(
       int istart, int iend, std::vector<Kernel::DateAndTime> &vecSplitTime,
-      std::vector<int> &vecSplitGroup, std::map<size_t, int> indexwsindexmap,
-      const std::vector<double> &logvalueranges, Kernel::time_duration tol,
-      bool filterIncrease, bool filterDecrease, Kernel::DateAndTime startTime,
-      Kernel::DateAndTime stopTime);
+      std::vector<int> &vecSplitGroup, const std::vector<int> &entrygroups,
+      Kernel::time_duration tol, bool filterIncrease, bool filterDecrease,
+      Kernel::DateAndTime startTime, Kernel::DateAndTime stopTime);
 
   /// Generate event filters for integer sample log
   void processIntegerValueFilter(int minvalue, int maxvalue,
@@ -190,6 +196,8 @@ private:
 
   Kernel::TimeSeriesProperty<double> *m_dblLog;
   Kernel::TimeSeriesProperty<int> *m_intLog;
+  /// Time and value columns of the double log, read in the inner loops
+  Kernel::TimeSeriesColumns<double> m_dblLogColumns;
 
   bool m_logAtCentre;
   double m_logTimeTolerance;
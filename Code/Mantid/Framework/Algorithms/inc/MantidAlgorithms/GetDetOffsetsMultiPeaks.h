@@ -187,6 +187,10 @@ private:
   bool m_useFitWindowTable;
   /// Vector of fit windows (also in vector)
   std::vector<std::vector<double>> m_vecFitWindow;
+
+  /// FindPeaks child algorithm of each thread, reused for all the spectra
+  /// fitted by the thread
+  std::vector<API::IAlgorithm_sptr> m_findPeaks;
 };
 
 } // namespace Algorithm
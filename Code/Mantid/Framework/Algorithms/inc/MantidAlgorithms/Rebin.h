@@ -73,6 +73,8 @@ public:
   virtual const std::string category() const { return "Transforms\\Rebin"; }
   /// Algorithm's aliases
   virtual const std::string alias() const { return "rebin"; }
+  /// Each group entry only touches its own workspaces
+  virtual bool canProcessGroupsInParallel() const { return true; }
 
   static std::vector<double>
   rebinParamsFromInput(const std::vector<double> &inParams,
@@ -60,20 +60,63 @@ public:
   virtual const std::string category() const { return "Transforms\\Rebin"; }
 
 protected:
+  /// Signal, squared errors and fractions on the output grid summed by one
+  /// thread. They are either held here, with row qi, column ei at index
+  /// qi * numColumns + ei, or added straight into the output workspace.
+  struct GridSums {
+    /// Zeroed sums held here
+    GridSums(const size_t numRows, const size_t numCols)
+        : numColumns(numCols), signal(numRows * numCols, 0.0),
+          errorSq(numRows * numCols, 0.0), fraction(numRows * numCols, 0.0),
+          signalRows(), errorRows(), fractionRows() {}
+    /// Sums added straight into the rows of the output workspace
+    explicit GridSums(API::MatrixWorkspace_sptr outputWS);
+    /// True if the sums go straight into the output workspace
+    bool isDirect() const { return !signalRows.empty(); }
+    /// Add a contribution to bin (qi, ei)
+    void add(const size_t qi, const size_t ei, const double y,
+             const double eSq, const double f) {
+      if (isDirect()) {
+        signalRows[qi][ei] += y;
+        errorRows[qi][ei] += eSq;
+        if (!fractionRows.empty())
+          fractionRows[qi][ei] += f;
+      } else {
+        const size_t index = qi * numColumns + ei;
+        signal[index] += y;
+        errorSq[index] += eSq;
+        fraction[index] += f;
+      }
+    }
+    size_t numColumns;
+    std::vector<double> signal;
+    std::vector<double> errorSq;
+    std::vector<double> fraction;
+    /// Rows of the output workspace, if the sums go straight into it
+    std::vector<double *> signalRows;
+    std::vector<double *> errorRows;
+    std::vector<double *> fractionRows;
+  };
+
   /// Rebin the input quadrilateral to to output grid
   void rebinToOutput(const Geometry::Quadrilateral &inputQ,
                      API::MatrixWorkspace_const_sptr inputWS, const size_t i,
                      const size_t j, API::MatrixWorkspace_sptr outputWS,
                      const std::vector<double> &verticalAxis);
-  /// Rebin the input quadrilateral to to output grid
-  void rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
-                               API::MatrixWorkspace_const_sptr inputWS,
-                               const size_t i, const size_t j,
-                               DataObjects::RebinnedOutput_sptr outputWS,
-                               const std::vector<double> &verticalAxis);
-
+  /// Rebin the input quadrilateral into one thread's sums of the output grid
+  void rebinToSums(const Geometry::Quadrilateral &inputQ, const double signal,
+                   const double error, const bool scaleByOverlapWidth,
+                   const MantidVec &xAxis,
+                   const std::vector<double> &verticalAxis,
+                   GridSums &sums) const;
+  /// Create one set of sums for each thread that can be afforded
+  std::vector<GridSums> createGridSums(API::MatrixWorkspace_sptr outputWS,
+                                       const bool parallel) const;
+  /// Add the sums of all threads into the output workspace
+  void addGridSums(const std::vector<GridSums> &sums,
+                   API::MatrixWorkspace_sptr outputWS) const;
   /// Find the intersect region on the output grid
-  bool getIntersectionRegion(API::MatrixWorkspace_const_sptr outputWS,
+  bool getIntersectionRegion(const MantidVec &xAxis,
                              const std::vector<double> &verticalAxis,
                              const Geometry::Quadrilateral &inputQ,
                              size_t &qstart, size_t &qend, size_t &en_start,
@@ -77,6 +77,15 @@ public:
   virtual const std::string category() const { return "Transforms\\Grouping"; }
 
 private:
+  /// The spectra that take part in the sum
+  std::vector<int>
+  getContributingIndices(API::MatrixWorkspace_const_sptr localworkspace,
+                         size_t &numMasked);
+  /// Sum the contributing spectra in parallel
+  void sumSpectra(API::MatrixWorkspace_const_sptr localworkspace,
+                  const std::vector<int> &contributing,
+                  API::ISpectrum *outSpec, MantidVec *FracSum,
+                  API::Progress &progress, size_t &numZeros);
   /// Handle logic for RebinnedOutput workspaces
   void doRebinnedOutput(API::MatrixWorkspace_sptr outputWorkspace,
                         API::Progress &progress, size_t &numSpectra,
@@ -60,6 +60,8 @@ public:
     return "Supports the implementation of a Unary operation on an input "
            "workspace.";
   }
+  /// Each group entry only touches its own workspaces
+  virtual bool canProcessGroupsInParallel() const { return true; }
 
 protected:
   // Overridden Algorithm methods
@@ -1,5 +1,6 @@
 #include "MantidAlgorithms/AddLogDerivative.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/TimeSeriesColumns.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidKernel/MandatoryValidator.h"
@@ -63,45 +64,49 @@ Mantid::Kernel::TimeSeriesProperty<double> *AddLogDerivative::makeDerivative(
         Strings::toString(input->size()) + " values. Need at least " +
         Strings::toString(numDerivatives + 1) + " to make this derivative.");
 
-  std::vector<double> values, dVal;
-  std::vector<double> times, dTime;
-  values = input->valuesAsVector();
-  times = input->timesAsVectorSeconds();
+  // Work on the contiguous time (ns) and value columns. The first pass reads
+  // them directly, later passes differentiate in place: entry j of a pass only
+  // depends on entries j and j+1 of the last one.
+  const TimeSeriesColumns<double> columns(*input);
+  const std::vector<int64_t> &inTimes = columns.times();
+  const std::vector<double> &inValues = columns.values();
+  std::vector<int64_t> times(inTimes.size());
+  std::vector<double> values(inValues.size());
 
+  size_t numIn = inTimes.size();
   for (int deriv = 0; deriv < numDerivatives; deriv++) {
-    dVal.clear();
-    dTime.clear();
-    double t0 = times[0];
-    double y0 = values[0];
-    for (size_t i = 0; i < times.size() - 1; i++) {
-      double y1 = values[i + 1];
-      double t1 = times[i + 1];
-      if (t1 != t0) {
-        // Avoid repeated time values giving infinite derivatives
-        double dy = (y1 - y0) / (t1 - t0);
-        double t = (t0 + t1) / 2.0;
-        dVal.push_back(dy);
-        dTime.push_back(t);
-        // For the next time interval
-        t0 = t1;
-        y0 = y1;
+    const std::vector<int64_t> &lastTimes = deriv == 0 ? inTimes : times;
+    const std::vector<double> &lastValues = deriv == 0 ? inValues : values;
+    size_t numOut = 0;
+    if (numIn > 0) {
+      int64_t t0 = lastTimes[0];
+      double y0 = lastValues[0];
+      for (size_t i = 0; i < numIn - 1; i++) {
+        const double y1 = lastValues[i + 1];
+        const int64_t t1 = lastTimes[i + 1];
+        if (t1 != t0) {
+          // Avoid repeated time values giving infinite derivatives
+          values[numOut] =
+              (y1 - y0) / (static_cast<double>(t1 - t0) * 1.e-9);
+          times[numOut] = t0 + (t1 - t0) / 2;
+          ++numOut;
+          // For the next time interval
+          t0 = t1;
+          y0 = y1;
+        }
       }
     }
-    times = dTime;
-    values = dVal;
+    numIn = numOut;
   }
+  times.resize(numIn);
+  values.resize(numIn);
 
   if (times.empty())
     throw std::runtime_error("Log " + input->name() +
                              " did not have enough non-repeated time values to "
                              "make this derivative.");
 
-  // Convert time in sec to DateAndTime
-  DateAndTime start = input->nthTime(0);
-  std::vector<DateAndTime> timeFull;
-  timeFull.reserve(times.size());
-  for (size_t i = 0; i < times.size(); i++)
-    timeFull.push_back(start + times[i]);
+  std::vector<DateAndTime> timeFull(times.begin(), times.end());
 
   // Create the TSP out of it
   Mantid::Kernel::TimeSeriesProperty<double> *out =
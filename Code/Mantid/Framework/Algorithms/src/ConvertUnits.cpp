@@ -410,9 +410,6 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   else if (emodeStr == "Indirect")
     emode = 2;
 
-  // Not doing anything with the Y vector in to/fromTOF yet, so just pass empty
-  // vector
-  std::vector<double> emptyVec;
   const bool needEfixed =
       (outputUnit->unitID().find("DeltaE") != std::string::npos ||
        outputUnit->unitID().find("Wave") != std::string::npos);
@@ -504,23 +501,16 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
 
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
-      // Convert the input unit to time-of-flight
-      localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                           emode, efixed, delta);
-      // Convert from time-of-flight to the desired unit
-      localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                               emode, efixed, delta);
+      localFromUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      localOutputUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      // Convert the X values to the desired unit through time-of-flight
+      Unit::convertViaTOF(*localFromUnit, *localOutputUnit,
+                          outputWS->dataX(i));
 
       // EventWorkspace part, modifying the EventLists.
       if (m_inputEvents) {
         eventWS->getEventList(i)
             .convertUnitsViaTof(localFromUnit, localOutputUnit);
-
-        //        std::vector<double> tofs;
-        //        eventWS->getEventList(i).getTofs(tofs);
-        //        localFromUnit->toTOF(tofs,emptyVec,l1,l2,twoTheta,emode,efixed,delta);
-        //        localOutputUnit->fromTOF(tofs,emptyVec,l1,l2,twoTheta,emode,efixed,delta);
-        //        eventWS->getEventList(i).setTofs(tofs);
       }
       // Clear unit memory
       delete localFromUnit;
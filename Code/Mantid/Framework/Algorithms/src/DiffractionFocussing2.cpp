@@ -12,6 +12,7 @@
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidAPI/Axis.h"
+#include <algorithm>
 #include <cfloat>
 #include <fstream>
 #include <iterator>
@@ -30,6 +31,115 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(DiffractionFocussing2)
 
+namespace {
+/// Resize the events of the list's current type to the given number
+void resizeEvents(EventList &eventList, const size_t numEvents) {
+  switch (eventList.getEventType()) {
+  case TOF:
+    eventList.getEvents().resize(numEvents);
+    break;
+  case WEIGHTED:
+    eventList.getWeightedEvents().resize(numEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    eventList.getWeightedEventsNoTime().resize(numEvents);
+    break;
+  }
+}
+
+/// Copy events into a preallocated vector starting at offset, converting them
+/// to the output event type on the way
+template <class OUT, class IN>
+void copyEventsTo(const std::vector<IN> &input, std::vector<OUT> &output,
+                  const size_t offset) {
+  std::copy(input.begin(), input.end(), output.begin() + offset);
+}
+
+/**
+ * Copy all events of one list into a preallocated part of another. The
+ * output list must be of the same or a more general event type.
+ * @param input :: list to copy from
+ * @param output :: list to copy into
+ * @param offset :: index of the first event in output to write to
+ */
+void copyEvents(const EventList &input, EventList &output,
+                const size_t offset) {
+  const EventType inType = input.getEventType();
+  switch (output.getEventType()) {
+  case TOF:
+    copyEventsTo(input.getEvents(), output.getEvents(), offset);
+    break;
+  case WEIGHTED:
+    if (inType == TOF)
+      copyEventsTo(input.getEvents(), output.getWeightedEvents(), offset);
+    else
+      copyEventsTo(input.getWeightedEvents(), output.getWeightedEvents(),
+                   offset);
+    break;
+  case WEIGHTED_NOTIME:
+    if (inType == TOF)
+      copyEventsTo(input.getEvents(), output.getWeightedEventsNoTime(),
+                   offset);
+    else if (inType == WEIGHTED)
+      copyEventsTo(input.getWeightedEvents(), output.getWeightedEventsNoTime(),
+                   offset);
+    else
+      copyEventsTo(input.getWeightedEventsNoTime(),
+                   output.getWeightedEventsNoTime(), offset);
+    break;
+  }
+}
+
+/**
+ * Merge consecutive runs of TOF-sorted events pairwise until the whole vector
+ * is sorted. The merges of each round are independent of each other.
+ * @param events :: the events to sort
+ * @param bounds :: run n covers [bounds[n], bounds[n+1])
+ * @param parallel :: run the merges of a round in parallel
+ */
+template <class T>
+void mergeSortedRunsOf(std::vector<T> &events, std::vector<size_t> bounds,
+                       const bool parallel) {
+  // Empty runs need not be merged
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+  while (bounds.size() > 2) {
+    const int numPairs = static_cast<int>((bounds.size() - 1) / 2);
+    PARALLEL_FOR_IF(parallel)
+    for (int iPair = 0; iPair < numPairs; iPair++) {
+      const size_t first = 2 * static_cast<size_t>(iPair);
+      std::inplace_merge(events.begin() + bounds[first],
+                         events.begin() + bounds[first + 1],
+                         events.begin() + bounds[first + 2]);
+    }
+
+    std::vector<size_t> merged;
+    merged.reserve(bounds.size() / 2 + 2);
+    for (size_t i = 0; i < bounds.size(); i += 2)
+      merged.push_back(bounds[i]);
+    if (merged.back() != bounds.back())
+      merged.push_back(bounds.back());
+    bounds.swap(merged);
+  }
+}
+
+/// Merge the TOF-sorted runs of an event list and flag it as sorted
+void mergeSortedRuns(EventList &eventList, const std::vector<size_t> &bounds,
+                     const bool parallel) {
+  switch (eventList.getEventType()) {
+  case TOF:
+    mergeSortedRunsOf(eventList.getEvents(), bounds, parallel);
+    break;
+  case WEIGHTED:
+    mergeSortedRunsOf(eventList.getWeightedEvents(), bounds, parallel);
+    break;
+  case WEIGHTED_NOTIME:
+    mergeSortedRunsOf(eventList.getWeightedEventsNoTime(), bounds, parallel);
+    break;
+  }
+  eventList.setSortOrder(TOF_SORT);
+}
+}
+
 /// Constructor
 DiffractionFocussing2::DiffractionFocussing2()
     : API::Algorithm(), udet2group(), groupAtWorkspaceIndex(), group2xvector(),
@@ -356,31 +466,41 @@ void DiffractionFocussing2::execEvent() {
   Progress *prog;
   prog = new Progress(this, 0.2, 0.25, nGroups);
 
-  // determine precount size
-  vector<size_t> size_required(this->m_validGroups.size(), 0);
+  // ------------- Pre-count ------------------------------------------
+  // Each input spectrum is given its own slice of the event list of its group
+  // so that all of them can be copied at the same time without locking.
+  const size_t numValidGroups = this->m_validGroups.size();
+  vector<vector<size_t>> offsets(numValidGroups);
+  vector<std::pair<size_t, size_t>> copyTasks;
+  bool inputSorted = true;
   int totalHistProcess = 0;
-  for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++) {
+  for (size_t iGroup = 0; iGroup < numValidGroups; iGroup++) {
     const int group = this->m_validGroups[iGroup];
     const vector<size_t> &indices = this->m_wsIndices[group];
 
     totalHistProcess += static_cast<int>(indices.size());
-    for (vector<size_t>::const_iterator index = indices.begin();
-         index != indices.end(); ++index) {
-      size_required[iGroup] += m_eventW->getEventList(*index).getNumberEvents();
+    vector<size_t> &groupOffsets = offsets[iGroup];
+    groupOffsets.resize(indices.size() + 1, 0);
+    for (size_t i = 0; i < indices.size(); i++) {
+      const EventList &inputEL = m_eventW->getEventList(indices[i]);
+      groupOffsets[i + 1] = groupOffsets[i] + inputEL.getNumberEvents();
+      if (inputEL.getNumberEvents() > 0 && inputEL.getSortType() != TOF_SORT)
+        inputSorted = false;
+      copyTasks.push_back(std::make_pair(iGroup, i));
     }
     prog->report(1, "Pre-counting");
   }
 
   // ------------- Pre-allocate Event Lists ----------------------------
   delete prog;
-  prog = new Progress(this, 0.25, 0.3, totalHistProcess);
+  prog = new Progress(this, 0.25, 0.3, numValidGroups);
 
-  // This creates and reserves the space required
-  for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++) {
+  // This creates the event lists at their final size
+  for (size_t iGroup = 0; iGroup < numValidGroups; iGroup++) {
     const int group = this->m_validGroups[iGroup];
     EventList &groupEL = out->getOrAddEventList(iGroup);
     groupEL.switchTo(eventWtype);
-    groupEL.reserve(size_required[iGroup]);
+    resizeEvents(groupEL, offsets[iGroup].back());
     groupEL.clearDetectorIDs();
     groupEL.setSpectrumNo(group);
     prog->reportIncrement(1, "Allocating");
@@ -388,90 +508,61 @@ void DiffractionFocussing2::execEvent() {
 
   // ----------- Focus ---------------
   delete prog;
-  prog = new Progress(this, 0.3, 0.9, totalHistProcess);
+  prog = new Progress(this, 0.3, 0.9, totalHistProcess + nGroups);
+  g_log.information() << "Focussing " << totalHistProcess << " spectra onto "
+                      << numValidGroups << " groups\n";
+
+  // Every spectrum writes to a different part of the output, whatever the
+  // number of groups. When focussing in place, each input is emptied as soon
+  // as it is copied so the memory is freed as the copy goes. Its detector IDs
+  // are kept until the groups have collected them.
+  EventWorkspace_sptr inPlaceW;
+  if (inPlace)
+    inPlaceW = boost::const_pointer_cast<EventWorkspace>(m_eventW);
+  const int numTasks = static_cast<int>(copyTasks.size());
+  PRAGMA_OMP(parallel for schedule(dynamic, 16))
+  for (int iTask = 0; iTask < numTasks; iTask++) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t iGroup = copyTasks[iTask].first;
+    const size_t i = copyTasks[iTask].second;
+    const int group = this->m_validGroups[iGroup];
+    const size_t wi = this->m_wsIndices[group][i];
+    copyEvents(m_eventW->getEventList(wi), out->getEventList(iGroup),
+               offsets[iGroup][i]);
+    if (inPlace)
+      inPlaceW->getEventList(wi).clear(false);
+    prog->reportIncrement(1, "Copying events");
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
 
-  if (this->m_validGroups.size() == 1) {
-    g_log.information() << "Performing focussing on a single group\n";
-    // Special case of a single group - parallelize differently
-    EventList &groupEL = out->getOrAddEventList(0);
-    const int group = m_validGroups[0];
+  // Collect the detectors of each group. If all of the input was sorted the
+  // group lists are made of sorted runs, which are merged rather than leaving
+  // the whole list to be sorted again later.
+  const bool parallelByGroup =
+      static_cast<int>(numValidGroups) >= PARALLEL_GET_MAX_THREADS;
+  PARALLEL_FOR_IF(parallelByGroup)
+  for (int iGroup = 0; iGroup < static_cast<int>(numValidGroups); iGroup++) {
+    PARALLEL_START_INTERUPT_REGION
+    const int group = this->m_validGroups[iGroup];
     const std::vector<size_t> &indices = this->m_wsIndices[group];
-
-    int chunkSize = 200;
-
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int wiChunk = 0; wiChunk < (totalHistProcess / chunkSize) + 1;
-         wiChunk++) {
-      PARALLEL_START_INTERUPT_REGION
-
-      // Perform in chunks for more efficiency
-      int max = (wiChunk + 1) * chunkSize;
-      if (max > totalHistProcess)
-        max = totalHistProcess;
-
-      // precalculate output size
-      /* size_t numEventsInChunk(0);
-      for (int wi=wiChunk*chunkSize; wi < max; wi++)
-      {
-        const int group = groupAtWorkspaceIndex[wi];
-        if (group == 1)
-        {
-          // Accumulate the chunk
-          numEventsInChunk += eventW->getEventList(wi).getNumberEvents();
-        }
-      } */
-
-      // Make a blank EventList that will accumulate the chunk.
-      EventList chunkEL;
-      chunkEL.switchTo(eventWtype);
-      // chunkEL.reserve(numEventsInChunk);
-
-      // process the chunk
-      for (int i = wiChunk * chunkSize; i < max; i++) {
-        // Accumulate the chunk
-        size_t wi = indices[i];
-        chunkEL += m_eventW->getEventList(wi);
-      }
-
-      // Rejoin the chunk with the rest.
-      PARALLEL_CRITICAL(DiffractionFocussing2_JoinChunks) {
-        groupEL += chunkEL;
-      }
-
-      PARALLEL_END_INTERUPT_REGION
+    EventList &groupEL = out->getEventList(iGroup);
+    for (size_t i = 0; i < indices.size(); i++) {
+      size_t wi = indices[i];
+      groupEL.addDetectorIDs(m_eventW->getEventList(wi).getDetectorIDs());
+      if (inPlace)
+        inPlaceW->getEventList(wi).clearDetectorIDs();
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } else {
-    // ------ PARALLELIZE BY GROUPS -------------------------
-
-    int nValidGroups = static_cast<int>(this->m_validGroups.size());
-    PARALLEL_FOR1(m_eventW)
-    for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
-      PARALLEL_START_INTERUPT_REGION
-      const int group = this->m_validGroups[iGroup];
-      const std::vector<size_t> &indices = this->m_wsIndices[group];
-      for (size_t i = 0; i < indices.size(); i++) {
-        size_t wi = indices[i];
-
-        // In workspace index iGroup, put what was in the OLD workspace index wi
-        out->getOrAddEventList(iGroup) += m_eventW->getEventList(wi);
-
-        prog->reportIncrement(1, "Appending Lists");
-
-        // When focussing in place, you can clear out old memory from the input
-        // one!
-        if (inPlace) {
-          boost::const_pointer_cast<EventWorkspace>(m_eventW)
-              ->getEventList(wi)
-              .clear();
-          Mantid::API::MemoryManager::Instance().releaseFreeMemory();
-        }
-      }
-      PARALLEL_END_INTERUPT_REGION
+
+    if (inputSorted) {
+      mergeSortedRuns(groupEL, offsets[iGroup], !parallelByGroup);
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } // (done with parallel by groups)
+    prog->reportIncrement(1, "Merging events");
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+  if (inPlace)
+    Mantid::API::MemoryManager::Instance().releaseFreeMemory();
 
   // Now that the data is cleaned up, go through it and set the X vectors to the
   // input workspace we first talked about.
@@ -14,6 +14,7 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/ArrayProperty.h"
 
+#include <limits>
 #include <sstream>
 
 using namespace Mantid;
@@ -911,37 +912,66 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
+  // Put the output workspaces in a vector and remap the splitters' targets to
+  // positions in it, so that no spectrum needs to build a map of event lists.
+  std::vector<DataObjects::EventWorkspace_sptr> outputWorkspaces;
+  std::map<int, int> slotOfGroup;
+  for (wsiter = m_outputWS.begin(); wsiter != m_outputWS.end(); ++wsiter) {
+    slotOfGroup[wsiter->first] = static_cast<int>(outputWorkspaces.size());
+    outputWorkspaces.push_back(wsiter->second);
+  }
+  Kernel::TimeSplitterColumns splitterColumns(m_splitters);
+  for (size_t i = 0; i < splitterColumns.size(); ++i) {
+    std::map<int, int>::const_iterator slot =
+        slotOfGroup.find(splitterColumns.targets()[i]);
+    splitterColumns.setTarget(i, slot != slotOfGroup.end() ? slot->second
+                                                           : -1);
+  }
+  const int unfilteredSlot = slotOfGroup[-1];
+
+  // Splitting by full time sorts each event list once and looks every event
+  // up in the splitter columns. That needs the splitters not to overlap;
+  // otherwise fall back to walking the TimeSplitterType.
+  const bool useColumns = !mFilterByPulseTime && splitterColumns.isDisjoint();
+  if (!mFilterByPulseTime && !useColumns)
+    g_log.information("Splitters overlap. Events are split interval by "
+                      "interval.");
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (wsiter = m_outputWS.begin(); wsiter != m_outputWS.end();
-             ++wsiter) {
-          int index = wsiter->first;
-          DataObjects::EventList *output_el =
-              wsiter->second->getEventListPtr(iws);
-          outputs.insert(std::make_pair(index, output_el));
-        }
-      }
+      // Get the output event lists (should be empty)
+      std::vector<DataObjects::EventList *> outputLists(
+          outputWorkspaces.size());
+      for (size_t i = 0; i < outputWorkspaces.size(); ++i)
+        outputLists[i] = outputWorkspaces[i]->getEventListPtr(iws);
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getEventList(iws);
+      const bool docorrection = (m_tofCorrType != NoneCorrect);
+      const double toffactor = docorrection ? m_detTofOffsets[iws] : 1.0;
+      const double tofshift = docorrection ? m_detTofShifts[iws] : 0.0;
 
       // Perform the filtering (using the splitting function and just one
       // output)
-      if (mFilterByPulseTime) {
-        input_el.splitByPulseTime(m_splitters, outputs);
-      } else if (m_tofCorrType != NoneCorrect) {
-        input_el.splitByFullTime(m_splitters, outputs, true,
-                                 m_detTofOffsets[iws], m_detTofShifts[iws]);
+      if (useColumns) {
+        input_el.splitByFullTime(splitterColumns, outputLists,
+                                 outputLists[unfilteredSlot], docorrection,
+                                 toffactor, tofshift);
       } else {
-        input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
+        std::map<int, DataObjects::EventList *> outputs;
+        for (std::map<int, int>::const_iterator slot = slotOfGroup.begin();
+             slot != slotOfGroup.end(); ++slot)
+          outputs.insert(std::make_pair(slot->first, outputLists[slot->second]));
+
+        if (mFilterByPulseTime)
+          input_el.splitByPulseTime(m_splitters, outputs);
+        else
+          input_el.splitByFullTime(m_splitters, outputs, docorrection,
+                                   toffactor, tofshift);
       }
     }
 
@@ -1006,7 +1036,6 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   */
 void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
   size_t numberOfSpectra = m_eventWS->getNumberHistograms();
-  // FIXME : consider to use vector to index workspace and event list
   std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
 
   // Loop over the histograms (detector spectra) to do split from 1 event list
@@ -1014,48 +1043,90 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
+  if (mFilterByPulseTime)
+    throw runtime_error(
+        "It is not a good practice to split fast event by pulse time. ");
+
+  // Put the output workspaces in a vector, indexed by slot
+  std::vector<DataObjects::EventWorkspace_sptr> outputWorkspaces;
+  std::map<int, int> slotOfGroup;
+  for (wsiter = m_outputWS.begin(); wsiter != m_outputWS.end(); ++wsiter) {
+    slotOfGroup[wsiter->first] = static_cast<int>(outputWorkspaces.size());
+    outputWorkspaces.push_back(wsiter->second);
+  }
+  std::map<int, int>::const_iterator unfilteredIt = slotOfGroup.find(-1);
+  const int unfilteredSlot =
+      (unfilteredIt != slotOfGroup.end()) ? unfilteredIt->second : -1;
+
+  // Splitter columns with targets remapped to slots. Vector splitter i holds
+  // the times in (time[i], time[i + 1]]; events are at whole nanoseconds, so
+  // that is the interval [time[i] + 1, time[i + 1] + 1). Events before the
+  // first and after the last time are unfiltered.
+  const size_t numSplitters = m_vecSplitterGroup.size();
+  Kernel::TimeSplitterColumns splitterColumns;
+  if (numSplitters > 0) {
+    splitterColumns.reserve(numSplitters + 1);
+    for (size_t i = 0; i < numSplitters; ++i) {
+      std::map<int, int>::const_iterator slot =
+          slotOfGroup.find(m_vecSplitterGroup[i]);
+      splitterColumns.addInterval(
+          m_vecSplitterTime[i] + 1, m_vecSplitterTime[i + 1] + 1,
+          slot != slotOfGroup.end() ? slot->second : -1);
+    }
+    splitterColumns.addInterval(m_vecSplitterTime.back() + 1,
+                                std::numeric_limits<int64_t>::max(),
+                                unfilteredSlot);
+  }
+
+  // The sorted engine needs the splitter times in order; otherwise every
+  // event is looked up in the times one by one.
+  const bool useColumns = splitterColumns.isDisjoint();
+  if (!useColumns)
+    g_log.information("Splitter times are not in order. Events are split "
+                      "one at a time.");
+
+  // Get the output event lists (should be empty) of every spectrum up front,
+  // so the parallel loop only reads them
+  std::vector<std::vector<DataObjects::EventList *>> outputLists(
+      numberOfSpectra);
+  for (size_t iws = 0; iws < numberOfSpectra; ++iws) {
+    if (m_vecSkip[iws])
+      continue;
+    outputLists[iws].resize(outputWorkspaces.size());
+    for (size_t i = 0; i < outputWorkspaces.size(); ++i)
+      outputLists[iws][i] = outputWorkspaces[i]->getEventListPtr(iws);
+  }
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (wsiter = m_outputWS.begin(); wsiter != m_outputWS.end();
-             ++wsiter) {
-          int index = wsiter->first;
-          DataObjects::EventList *output_el =
-              wsiter->second->getEventListPtr(iws);
-          outputs.insert(std::make_pair(index, output_el));
-        }
-      }
+      const std::vector<DataObjects::EventList *> &outputs = outputLists[iws];
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getEventList(iws);
-
-      bool printdetail = false;
-      if (m_useDBSpectrum)
-        printdetail = (iws == static_cast<int64_t>(m_dbWSIndex));
-
-      // Perform the filtering (using the splitting function and just one
-      // output)
-      std::string logmessage("");
-      if (mFilterByPulseTime) {
-        throw runtime_error(
-            "It is not a good practice to split fast event by pulse time. ");
-      } else if (m_tofCorrType != NoneCorrect) {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, true,
-            m_detTofOffsets[iws], m_detTofShifts[iws]);
+      const bool docorrection = (m_tofCorrType != NoneCorrect);
+      const double toffactor = docorrection ? m_detTofOffsets[iws] : 1.0;
+      const double tofshift = docorrection ? m_detTofShifts[iws] : 0.0;
+
+      if (useColumns) {
+        input_el.splitByFullTime(splitterColumns, outputs,
+                                 unfilteredSlot >= 0 ? outputs[unfilteredSlot]
+                                                     : NULL,
+                                 docorrection, toffactor, tofshift);
       } else {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, false, 1.0, 0.0);
+        std::map<int, DataObjects::EventList *> outputMap;
+        for (std::map<int, int>::const_iterator slot = slotOfGroup.begin();
+             slot != slotOfGroup.end(); ++slot)
+          outputMap.insert(std::make_pair(slot->first, outputs[slot->second]));
+        std::string logmessage = input_el.splitByFullTimeMatrixSplitter(
+            m_vecSplitterTime, m_vecSplitterGroup, outputMap, docorrection,
+            toffactor, tofshift);
+        if (m_useDBSpectrum && iws == static_cast<int64_t>(m_dbWSIndex))
+          g_log.notice(logmessage);
       }
-
-      if (printdetail)
-        g_log.notice(logmessage);
     }
 
     PARALLEL_END_INTERUPT_REGION
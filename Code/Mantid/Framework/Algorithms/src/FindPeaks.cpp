@@ -11,6 +11,7 @@
 #include "MantidAPI/WorkspaceValidators.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/StartsWithValidator.h"
 #include "MantidKernel/VectorHelper.h"
 
@@ -334,10 +335,20 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
   const int end = singleSpectrum
                       ? m_wsIndex + 1
                       : static_cast<int>(m_dataWS->getNumberHistograms());
+  delete m_progress;
   m_progress = new Progress(this, 0.0, 1.0, end - start);
 
+  // Spectra are fitted independently. The rows of each spectrum are kept
+  // apart and added to the table in spectrum order at the end.
+  std::vector<std::vector<std::vector<double>>> rows(end - start);
+  const bool parallelFit = m_dataWS->threadSafe();
+
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (parallelFit))
   for (int spec = start; spec < end; ++spec) {
+    PARALLEL_START_INTERUPT_REGION
     const MantidVec &vecX = m_dataWS->readX(spec);
+    SpectrumFit fit;
+    initSpectrumFit(fit);
 
     for (std::size_t ipeak = 0; ipeak < numPeaks; ipeak++) {
       // Try to fit at this center
@@ -355,7 +366,7 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
       if (x_center > vecX.front() && x_center < vecX.back()) {
         if (useWindows)
           fitPeakInWindow(m_dataWS, spec, x_center, fitwindows[2 * ipeak],
-                          fitwindows[2 * ipeak + 1]);
+                          fitwindows[2 * ipeak + 1], fit);
         else {
           bool hasLeftPeak = (ipeak > 0);
           double leftpeakcentre = 0.;
@@ -369,7 +380,7 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
 
           fitPeakGivenFWHM(m_dataWS, spec, x_center, m_inputPeakFWHM,
                            hasLeftPeak, leftpeakcentre, hasRightPeak,
-                           rightpeakcentre);
+                           rightpeakcentre, fit);
         }
       } else {
         g_log.warning() << "Given peak centre " << x_center
@@ -379,9 +390,14 @@ FindPeaks::findPeaksGivenStartingPoints(const std::vector<double> &peakcentres,
 
     } // loop through the peaks specified
 
+    rows[spec - start].swap(fit.rows);
     m_progress->report();
 
+    PARALLEL_END_INTERUPT_REGION
   } // loop over spectra
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  addRowsToTable(start, rows);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -420,12 +436,21 @@ void FindPeaks::findPeaksUsingMariscotti() {
   const int end = singleSpectrum
                       ? m_wsIndex + 1
                       : static_cast<int>(smoothedData->getNumberHistograms());
+  delete m_progress;
   m_progress = new Progress(this, 0.0, 1.0, end - start);
   const int blocksize = static_cast<int>(smoothedData->blocksize());
 
+  // Rows of the output table for each spectrum
+  std::vector<std::vector<std::vector<double>>> rows(end - start);
+  const bool parallelFit = m_dataWS->threadSafe();
+
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (parallelFit))
   for (int k = start; k < end; ++k) {
+    PARALLEL_START_INTERUPT_REGION
     const MantidVec &S = smoothedData->readY(k);
     const MantidVec &F = smoothedData->readE(k);
+    SpectrumFit fit;
+    initSpectrumFit(fit);
 
     // This implements the flow chart given on page 320 of Mariscotti
     int i0 = 0, i1 = 0, i2 = 0, i3 = 0, i4 = 0, i5 = 0;
@@ -569,7 +594,7 @@ void FindPeaks::findPeaksUsingMariscotti() {
         if (i_max >= wssize)
           i_max = wssize - 1;
 
-        this->fitSinglePeak(m_dataWS, k, i_min, i_max, i4);
+        this->fitSinglePeak(m_dataWS, k, i_min, i_max, i4, fit);
 
         // reset and go searching for the next peak
         i1 = 0, i2 = 0, i3 = 0, i4 = 0, i5 = 0;
@@ -577,9 +602,14 @@ void FindPeaks::findPeaksUsingMariscotti() {
 
     } // loop through a single spectrum
 
+    rows[k - start].swap(fit.rows);
     m_progress->report();
 
+    PARALLEL_END_INTERUPT_REGION
   } // loop over spectra
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  addRowsToTable(start, rows);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -788,13 +818,15 @@ int FindPeaks::getVectorIndex(const MantidVec &vecX, double x) {
   *  @param hasrightpeak :: flag to show that there is a specified peak to its
   *right
   *  @param rightpeakcentre :: centre of the right peak if existed
+  *  @param fit :: functions and results of the spectrum
   */
 void FindPeaks::fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
                                  const int spectrum, const double center_guess,
                                  const int fitWidth, const bool hasleftpeak,
                                  const double leftpeakcentre,
                                  const bool hasrightpeak,
-                                 const double rightpeakcentre) {
+                                 const double rightpeakcentre,
+                                 SpectrumFit &fit) {
   // The X axis you are looking at
   const MantidVec &vecX = input->readX(spectrum);
   const MantidVec &vecY = input->readY(spectrum);
@@ -839,7 +871,7 @@ void FindPeaks::fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
         << ", " << vecX[i_max];
   g_log.information(outss.str());
 
-  fitSinglePeak(input, spectrum, i_min, i_max, i_centre);
+  fitSinglePeak(input, spectrum, i_min, i_max, i_centre, fit);
 
   return;
 }
@@ -854,17 +886,19 @@ void FindPeaks::fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input,
   *side of the peak (right side)
   *  @param xmin    Minimum x value to find the peak
   *  @param xmax    Maximum x value to find the peak
+  *  @param fit :: functions and results of the spectrum
   */
 void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
                                 const int spectrum, const double centre_guess,
-                                const double xmin, const double xmax) {
+                                const double xmin, const double xmax,
+                                SpectrumFit &fit) {
   // Check
   g_log.information() << "Fit Peak with given window:  Guessed center = "
                       << centre_guess << "  x-min = " << xmin
                       << ", x-max = " << xmax << "\n";
   if (xmin >= centre_guess || xmax <= centre_guess) {
     g_log.error("Peak centre is on the edge of Fit window. ");
-    addNonFitRecord(spectrum);
+    addNonFitRecord(fit);
     return;
   }
 
@@ -881,7 +915,7 @@ void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
                   << " is out side of minimum x = " << xmin
                   << ".  Input X ragne = " << vecX.front() << ", "
                   << vecX.back() << "\n";
-    addNonFitRecord(spectrum);
+    addNonFitRecord(fit);
     return;
   }
 
@@ -890,12 +924,12 @@ void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
   if (i_max < i_centre) {
     g_log.error() << "Input peak centre @ " << centre_guess
                   << " is out side of maximum x = " << xmax << "\n";
-    addNonFitRecord(spectrum);
+    addNonFitRecord(fit);
     return;
   }
 
   // finally do the actual fit
-  fitSinglePeak(input, spectrum, i_min, i_max, i_centre);
+  fitSinglePeak(input, spectrum, i_min, i_max, i_centre, fit);
 
   return;
 }
@@ -903,10 +937,12 @@ void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input,
 //----------------------------------------------------------------------------------------------
 /** Fit a single peak
   * This is the fundametary peak fit function used by all kinds of input
+  * @param fit :: functions and results of the spectrum
   */
 void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
                               const int spectrum, const int i_min,
-                              const int i_max, const int i_centre) {
+                              const int i_max, const int i_centre,
+                              SpectrumFit &fit) {
   const MantidVec &vecX = input->readX(spectrum);
   const MantidVec &vecY = input->readY(spectrum);
 
@@ -922,7 +958,7 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
     ess << "Peak supposed at " << vecY[i_centre]
         << " does not have enough counts as " << m_leastMaxObsY;
     g_log.debug(ess.str());
-    addNonFitRecord(spectrum);
+    addNonFitRecord(fit);
     return;
   }
 
@@ -948,7 +984,7 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
 
   for (size_t i = 0; i < vecbkgdparvalue.size(); ++i)
     if (i < m_bkgdOrder)
-      m_backgroundFunction->setParameter(i, vecbkgdparvalue[i]);
+      fit.backgroundFunction->setParameter(i, vecbkgdparvalue[i]);
 
   // Estimate peak parameters
   double est_height(0.0), est_fwhm(0.0);
@@ -967,11 +1003,11 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
 
   // Set peak parameters to
   if (m_useObsCentre)
-    m_peakFunction->setCentre(vecX[i_obscentre]);
+    fit.peakFunction->setCentre(vecX[i_obscentre]);
   else
-    m_peakFunction->setCentre(vecX[i_centre]);
-  m_peakFunction->setHeight(est_height);
-  m_peakFunction->setFwhm(est_fwhm);
+    fit.peakFunction->setCentre(vecX[i_centre]);
+  fit.peakFunction->setHeight(est_height);
+  fit.peakFunction->setFwhm(est_fwhm);
 
   if (!usefpdresult) {
     // Estimate peak range based on estimated linear background and peak
@@ -990,13 +1026,13 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
   fitwindow[1] = vecX[i_max];
 
   double costfuncvalue =
-      callFitPeak(input, spectrum, m_peakFunction, m_backgroundFunction,
+      callFitPeak(input, spectrum, fit.peakFunction, fit.backgroundFunction,
                   fitwindow, vecpeakrange, m_minGuessedPeakWidth,
                   m_maxGuessedPeakWidth, m_stepGuessedPeakWidth);
 
   bool fitsuccess = false;
   if (costfuncvalue < DBL_MAX && costfuncvalue >= 0. &&
-      m_peakFunction->height() > m_minHeight)
+      fit.peakFunction->height() > m_minHeight)
     fitsuccess = true;
 
   //-------------------------------------------------------------------------
@@ -1004,10 +1040,9 @@ void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input,
   //-------------------------------------------------------------------------
   // Update output
   if (fitsuccess)
-    addInfoRow(spectrum, m_peakFunction, m_backgroundFunction, m_rawPeaksTable,
-               costfuncvalue);
+    addInfoRow(fit, m_rawPeaksTable, costfuncvalue);
   else
-    addNonFitRecord(spectrum);
+    addNonFitRecord(fit);
 
   return;
 }
@@ -1359,28 +1394,26 @@ void FindPeaks::estimatePeakRange(const MantidVec &vecX, size_t i_centre,
 
 //----------------------------------------------------------------------------------------------
 /** Add a row to the output table workspace.
-  * @param spectrum :: spectrum number
-  * @param peakfunction :: peak function
-  * @param bkgdfunction :: background function
+  * @param fit :: fitted functions of the spectrum. The row is added to its
+  * rows.
   * @param isoutputraw :: flag to output raw function parameters
-  * @param mincost Chi2 value for this set of parameters
   * @param mincost :: minimum/best cost function value
   */
-void FindPeaks::addInfoRow(const size_t spectrum,
-                           const API::IPeakFunction_const_sptr &peakfunction,
-                           const API::IBackgroundFunction_sptr &bkgdfunction,
-                           const bool isoutputraw, const double mincost) {
+void FindPeaks::addInfoRow(SpectrumFit &fit, const bool isoutputraw,
+                           const double mincost) {
   // Check input validity
   if (mincost < 0. || mincost >= DBL_MAX - 1.0E-10)
     throw std::runtime_error("Minimum cost indicates that fit fails.  This "
                              "method should not be called "
                              "under this circumstance. ");
 
-  // Add fitted parameters to output table workspace
-  API::TableRow t = m_outPeakTableWS->appendRow();
+  API::IPeakFunction_const_sptr peakfunction = fit.peakFunction;
+  API::IBackgroundFunction_sptr bkgdfunction = fit.backgroundFunction;
 
-  // spectrum
-  t << static_cast<int>(spectrum);
+  // Add fitted parameters to output table row
+  fit.rows.push_back(std::vector<double>());
+  std::vector<double> &t = fit.rows.back();
+  t.reserve(m_numTableParams + 1);
 
   // peak and background function parameters
   if (isoutputraw) {
@@ -1394,10 +1427,10 @@ void FindPeaks::addInfoRow(const size_t spectrum,
     }
 
     for (size_t i = 0; i < nparams; ++i) {
-      t << peakfunction->getParameter(i);
+      t.push_back(peakfunction->getParameter(i));
     }
     for (size_t i = 0; i < nparamsb; ++i) {
-      t << bkgdfunction->getParameter(i);
+      t.push_back(bkgdfunction->getParameter(i));
     }
   } else {
     // Output of effective peak parameters
@@ -1406,7 +1439,9 @@ void FindPeaks::addInfoRow(const size_t spectrum,
     double fwhm = peakfunction->fwhm();
     double height = peakfunction->height();
 
-    t << peakcentre << fwhm << height;
+    t.push_back(peakcentre);
+    t.push_back(fwhm);
+    t.push_back(height);
 
     // Set up parameters to background function
 
@@ -1420,32 +1455,49 @@ void FindPeaks::addInfoRow(const size_t spectrum,
         bkgdfunction->name() != "FlatBackground")
       a2 = bkgdfunction->getParameter("A2");
 
-    t << a0 << a1 << a2;
+    t.push_back(a0);
+    t.push_back(a1);
+    t.push_back(a2);
   }
 
   // Minimum cost function value
-  t << mincost;
+  t.push_back(mincost);
 
   return;
 }
 
 //----------------------------------------------------------------------------------------------
 /** Add the fit record (failure) to output workspace
-  * @param spectrum :: spectrum where the peak is
+  * @param fit :: functions and results of the spectrum where the peak is
   */
-void FindPeaks::addNonFitRecord(const size_t spectrum) {
-  // Add a new row
-  API::TableRow t = m_outPeakTableWS->appendRow();
+void FindPeaks::addNonFitRecord(SpectrumFit &fit) {
+  // Parameters are all zero with a HUGE chi-square
+  std::vector<double> row(m_numTableParams + 1, 0.);
+  row.back() = DBL_MAX;
+  fit.rows.push_back(row);
 
-  // 1st column
-  t << static_cast<int>(spectrum);
-
-  // Parameters
-  for (std::size_t i = 0; i < m_numTableParams; i++)
-    t << 0.;
+  return;
+}
 
-  // HUGE chi-square
-  t << DBL_MAX;
+//----------------------------------------------------------------------------------------------
+/** Add the rows of the fitted spectra to the output table workspace in
+  * spectrum order
+  * @param start :: workspace index of the first spectrum
+  * @param rows :: values of the rows of each spectrum after the spectrum number
+  */
+void FindPeaks::addRowsToTable(
+    const int start,
+    const std::vector<std::vector<std::vector<double>>> &rows) {
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const int spectrum = start + static_cast<int>(i);
+    for (size_t j = 0; j < rows[i].size(); ++j) {
+      API::TableRow t = m_outPeakTableWS->appendRow();
+      t << spectrum;
+      const std::vector<double> &values = rows[i][j];
+      for (size_t k = 0; k < values.size(); ++k)
+        t << values[k];
+    }
+  }
 
   return;
 }
@@ -1481,6 +1533,19 @@ void FindPeaks::createFunctions() {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Set up the functions to fit the peaks of a spectrum with as copies of the
+  * peak and background functions created by createFunctions()
+  * @param fit :: functions and results of the spectrum
+  */
+void FindPeaks::initSpectrumFit(SpectrumFit &fit) const {
+  fit.peakFunction =
+      boost::dynamic_pointer_cast<IPeakFunction>(m_peakFunction->clone());
+  fit.backgroundFunction = boost::dynamic_pointer_cast<IBackgroundFunction>(
+      m_backgroundFunction->clone());
+  fit.rows.clear();
+}
+
 //----------------------------------------------------------------------------------------------
 /** Fit a single peak function with background by calling algorithm callFitPeak
   */
@@ -1497,7 +1562,7 @@ FindPeaks::callFitPeak(const MatrixWorkspace_sptr &dataws, int wsindex,
        << " of spectrum " << wsindex;
   g_log.information(dbss.str());
 
-  double userFWHM = m_peakFunction->fwhm();
+  double userFWHM = peakfunction->fwhm();
   bool fitwithsteppedfwhm = (guessedFWHMStep > 0);
 
   FitOneSinglePeak fitpeak;
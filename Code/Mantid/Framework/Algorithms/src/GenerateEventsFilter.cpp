@@ -10,6 +10,7 @@
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/Column.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -21,6 +22,13 @@ namespace Mantid {
 namespace Algorithms {
 DECLARE_ALGORITHM(GenerateEventsFilter)
 
+namespace {
+/// Group of a log entry whose value is outside all log value intervals
+const int OUTSIDE_RANGES = -1;
+/// Group of a log entry whose value is in a gap between two intervals
+const int BETWEEN_RANGES = -2;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -467,6 +475,7 @@ void GenerateEventsFilter::setFilterByLogValue(std::string logname) {
     if (m_runEndTime > m_dblLog->lastTime())
       m_dblLog->addValue(m_runEndTime, 0.);
     m_dblLog->eliminateDuplicates();
+    m_dblLogColumns = TimeSeriesColumns<double>(*m_dblLog);
   } else {
     g_log.debug("Attempting to remove duplicates in integer series log.");
     m_intLog->addValue(m_runEndTime, 0);
@@ -776,7 +785,8 @@ void GenerateEventsFilter::makeFilterBySingleValue(
     bool filterIncrease, bool filterDecrease, DateAndTime startTime,
     Kernel::DateAndTime stopTime, int wsindex) {
   // Do nothing if the log is empty.
-  if (m_dblLog->size() == 0) {
+  const int logsize = static_cast<int>(m_dblLogColumns.size());
+  if (logsize == 0) {
     g_log.warning() << "There is no entry in this property " << this->name()
                     << "\n";
     return;
@@ -798,10 +808,11 @@ void GenerateEventsFilter::makeFilterBySingleValue(
   size_t progslot = 0;
   string info("");
 
-  for (int i = 0; i < m_dblLog->size(); i++) {
+  const std::vector<int64_t> &logtimes = m_dblLogColumns.times();
+  for (int i = 0; i < logsize; i++) {
     lastTime = currT;
     // The new entry
-    currT = m_dblLog->nthTime(i);
+    currT = DateAndTime(logtimes[static_cast<size_t>(i)]);
 
     // A good value?
     isGood = identifyLogEntry(i, currT, lastGood, min, max, startTime, stopTime,
@@ -835,7 +846,7 @@ void GenerateEventsFilter::makeFilterBySingleValue(
     }
 
     // Progress bar..
-    size_t tmpslot = i * 90 / m_dblLog->size();
+    size_t tmpslot = static_cast<size_t>(i * 90 / logsize);
     if (tmpslot > progslot) {
       progslot = tmpslot;
       double prog = double(progslot) / 100.0 + 0.1;
@@ -872,7 +883,9 @@ bool GenerateEventsFilter::identifyLogEntry(
     const double &minvalue, const double &maxvalue,
     const Kernel::DateAndTime &startT, const Kernel::DateAndTime &stopT,
     const bool &filterIncrease, const bool &filterDecrease) {
-  double val = m_dblLog->nthValue(index);
+  const std::vector<double> &values = m_dblLogColumns.values();
+  const size_t entry = static_cast<size_t>(index);
+  double val = values[entry];
 
   // Identify by time and value
   bool isgood =
@@ -880,14 +893,17 @@ bool GenerateEventsFilter::identifyLogEntry(
 
   // Consider direction: not both (i.e., not increase or not decrease)
   if (isgood && (!filterIncrease || !filterDecrease)) {
-    int numlogentries = m_dblLog->size();
+    size_t numlogentries = values.size();
     double diff;
-    if (index < numlogentries - 1) {
+    if (entry + 1 < numlogentries) {
       // For a non-last log entry
-      diff = m_dblLog->nthValue(index + 1) - val;
-    } else {
+      diff = values[entry + 1] - val;
+    } else if (entry > 0) {
       // Last log entry: follow the last direction
-      diff = val - m_dblLog->nthValue(index - 1);
+      diff = val - values[entry - 1];
+    } else {
+      // The only log entry
+      diff = 0.;
     }
 
     if (diff > 0 && filterIncrease)
@@ -920,13 +936,13 @@ bool GenerateEventsFilter::identifyLogEntry(
  * @param stopTime :: Stop time.
  */
 void GenerateEventsFilter::makeMultipleFiltersByValues(
-    map<size_t, int> indexwsindexmap, vector<double> logvalueranges,
-    bool centre, bool filterIncrease, bool filterDecrease,
-    DateAndTime startTime, DateAndTime stopTime) {
+    const map<size_t, int> &indexwsindexmap,
+    const vector<double> &logvalueranges, bool centre, bool filterIncrease,
+    bool filterDecrease, DateAndTime startTime, DateAndTime stopTime) {
   g_log.notice("Starting method 'makeMultipleFiltersByValues'. ");
 
   // Return if the log is empty.
-  int logsize = m_dblLog->size();
+  int logsize = static_cast<int>(m_dblLogColumns.size());
   if (logsize == 0) {
     g_log.warning() << "There is no entry in this property " << m_dblLog->name()
                     << std::endl;
@@ -951,9 +967,12 @@ void GenerateEventsFilter::makeMultipleFiltersByValues(
   int istart = 0;
   int iend = static_cast<int>(logsize - 1);
 
+  vector<int> entrygroups;
+  classifyLogEntries(indexwsindexmap, logvalueranges, entrygroups);
+
   makeMultipleFiltersByValuesPartialLog(
-      istart, iend, m_vecSplitterTime, m_vecSplitterGroup, indexwsindexmap,
-      logvalueranges, tol, filterIncrease, filterDecrease, startTime, stopTime);
+      istart, iend, m_vecSplitterTime, m_vecSplitterGroup, entrygroups, tol,
+      filterIncrease, filterDecrease, startTime, stopTime);
 
   progress(1.0);
 
@@ -978,11 +997,11 @@ void GenerateEventsFilter::makeMultipleFiltersByValues(
  * @param stopTime :: Stop time.
  */
 void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(
-    map<size_t, int> indexwsindexmap, vector<double> logvalueranges,
-    bool centre, bool filterIncrease, bool filterDecrease,
-    DateAndTime startTime, DateAndTime stopTime) {
+    const map<size_t, int> &indexwsindexmap,
+    const vector<double> &logvalueranges, bool centre, bool filterIncrease,
+    bool filterDecrease, DateAndTime startTime, DateAndTime stopTime) {
   // Return if the log is empty.
-  int logsize = m_dblLog->size();
+  int logsize = static_cast<int>(m_dblLogColumns.size());
   if (logsize == 0) {
     g_log.warning() << "There is no entry in this property " << m_dblLog->name()
                     << std::endl;
@@ -1037,14 +1056,18 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(
     g_log.information(dbss.str());
   }
 
+  // Classify all log entries before they are split into partial logs
+  vector<int> entrygroups;
+  classifyLogEntries(indexwsindexmap, logvalueranges, entrygroups);
+
   // Create partial vectors
   vecSplitterTimeSet.clear();
   vecGroupIndexSet.clear();
   for (int i = 0; i < numThreads; ++i) {
     vector<DateAndTime> tempvectimes;
-    tempvectimes.reserve(m_dblLog->size());
+    tempvectimes.reserve(static_cast<size_t>(vecEnd[i] - vecStart[i] + 1));
     vector<int> tempvecgroup;
-    tempvecgroup.reserve(m_dblLog->size());
+    tempvecgroup.reserve(static_cast<size_t>(vecEnd[i] - vecStart[i] + 1));
     vecSplitterTimeSet.push_back(tempvectimes);
     vecGroupIndexSet.push_back(tempvecgroup);
   }
@@ -1059,9 +1082,8 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(
       int iend = vecEnd[i];
 
       makeMultipleFiltersByValuesPartialLog(
-          istart, iend, vecSplitterTimeSet[i], vecGroupIndexSet[i],
-          indexwsindexmap, logvalueranges, tol, filterIncrease, filterDecrease,
-          startTime, stopTime);
+          istart, iend, vecSplitterTimeSet[i], vecGroupIndexSet[i], entrygroups,
+          tol, filterIncrease, filterDecrease, startTime, stopTime);
       PARALLEL_END_INTERUPT_REGION
     }
     PARALLEL_CHECK_INTERUPT_REGION
@@ -1131,17 +1153,70 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(
     return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Look up the log value interval of every log entry in one pass over the
+ * value column. The entries are independent so this is done in parallel,
+ * leaving only the splitter state machine to walk the log serially.
+ * @param indexwsindexmap :: Workspace group of each log value interval
+ * @param logvalueranges :: A vector of double. Each 2i and 2i+1 pair is one
+ * individual log value range.
+ * @param entrygroups :: (output) the workspace group of each log entry,
+ * OUTSIDE_RANGES or BETWEEN_RANGES
+ */
+void GenerateEventsFilter::classifyLogEntries(
+    const map<size_t, int> &indexwsindexmap,
+    const vector<double> &logvalueranges, vector<int> &entrygroups) {
+  // Group of each interval as a plain vector
+  vector<int> rangegroups(logvalueranges.size() / 2, 0);
+  for (map<size_t, int>::const_iterator mit = indexwsindexmap.begin();
+       mit != indexwsindexmap.end(); ++mit) {
+    if (mit->first < rangegroups.size())
+      rangegroups[mit->first] = mit->second;
+  }
+
+  const vector<double> &values = m_dblLogColumns.values();
+  const int64_t numentries = static_cast<int64_t>(values.size());
+  entrygroups.resize(values.size());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numentries; ++i) {
+    const size_t index = searchValue(logvalueranges, values[i]);
+    int group;
+    if (index > logvalueranges.size())
+      group = OUTSIDE_RANGES;
+    else if (index % 2 == 0)
+      group = rangegroups[index / 2];
+    else
+      group = BETWEEN_RANGES;
+    entrygroups[i] = group;
+  }
+
+  return;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Make filters by multiple log values of partial log
+  * @param istart :: index of the first log entry to process
+  * @param iend :: index of the last log entry to process
+  * @param vecSplitTime :: (output) splitter boundary times
+  * @param vecSplitGroup :: (output) workspace group between the boundaries
+  * @param entrygroups :: workspace group of each log entry as found by
+  * classifyLogEntries()
+  * @param tol :: time tolerance
+  * @param filterIncrease :: include log value increasing period
+  * @param filterDecrease :: include log value decreasing period
+  * @param startTime :: start time
+  * @param stopTime :: stop time
   */
 void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
     int istart, int iend, std::vector<Kernel::DateAndTime> &vecSplitTime,
-    std::vector<int> &vecSplitGroup, map<size_t, int> indexwsindexmap,
-    const vector<double> &logvalueranges, time_duration tol,
-    bool filterIncrease, bool filterDecrease, DateAndTime startTime,
-    DateAndTime stopTime) {
+    std::vector<int> &vecSplitGroup, const vector<int> &entrygroups,
+    time_duration tol, bool filterIncrease, bool filterDecrease,
+    DateAndTime startTime, DateAndTime stopTime) {
   // Check
-  int logsize = m_dblLog->size();
+  const vector<int64_t> &logtimes = m_dblLogColumns.times();
+  const vector<double> &logvalues = m_dblLogColumns.values();
+  int logsize = static_cast<int>(logtimes.size());
   if (istart < 0 || iend >= logsize)
     throw runtime_error("Input index of makeMultipleFiltersByValuesPartialLog "
                         "is out of boundary. ");
@@ -1158,11 +1233,11 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
   // size_t progslot = 0;
 
   g_log.information() << "Log time coverage (index: " << istart << ", " << iend
-                      << ") from " << m_dblLog->nthTime(istart) << ", "
-                      << m_dblLog->nthTime(iend) << "\n";
+                      << ") from " << DateAndTime(logtimes[istart]) << ", "
+                      << DateAndTime(logtimes[iend]) << "\n";
 
   DateAndTime laststoptime(0);
-  int lastlogindex = m_dblLog->size() - 1;
+  int lastlogindex = logsize - 1;
 
   int prevDirection = determineChangingDirection(istart);
 
@@ -1172,8 +1247,8 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
     bool createsplitter = false;
 
     lastTime = currTime;
-    currTime = m_dblLog->nthTime(i);
-    double currValue = m_dblLog->nthValue(i);
+    currTime = DateAndTime(logtimes[i]);
+    double currValue = logvalues[i];
 
     // Filter out by time and direction (optional)
     bool intime = true;
@@ -1197,7 +1272,7 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
     int direction = 0;
     if (i < lastlogindex) {
       // Not the last log entry
-      double diff = m_dblLog->nthValue(i + 1) - m_dblLog->nthValue(i);
+      double diff = logvalues[i + 1] - currValue;
       if (diff > 0)
         direction = 1;
       else if (diff < 0)
@@ -1231,37 +1306,22 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
 
       // Treat the log entry based on: changing direction (+ time range)
       if (correctdir) {
-        // Check this value whether it falls into any range
-        size_t index = searchValue(logvalueranges, currValue);
+        // The range this value falls into was found by classifyLogEntries()
+        const int entrygroup = entrygroups[i];
 
         if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
           stringstream dbss;
           dbss << "[DBx257] Examine Log Index " << i
-               << ", Value = " << currValue << ", Data Range Index = " << index
-               << "; "
-               << "Group Index = " << indexwsindexmap[index / 2]
-               << " (log value range vector size = " << logvalueranges.size()
-               << "): ";
-          if (index == 0)
-            dbss << logvalueranges[index] << ", " << logvalueranges[index + 1];
-          else if (index == logvalueranges.size())
-            dbss << logvalueranges[index - 1] << ", " << logvalueranges[index];
-          else
-            dbss << logvalueranges[index - 1] << ", " << logvalueranges[index]
-                 << ", " << logvalueranges[index + 1];
+               << ", Value = " << currValue << ", Group Index = " << entrygroup;
           g_log.debug(dbss.str());
         }
 
-        bool valueWithinMinMax = true;
-        if (index > logvalueranges.size()) {
-          // Out of range
-          valueWithinMinMax = false;
-        }
+        bool valueWithinMinMax = (entrygroup != OUTSIDE_RANGES);
 
         if (valueWithinMinMax) {
-          if (index % 2 == 0) {
+          if (entrygroup != BETWEEN_RANGES) {
             // [Situation] Falls in the interval
-            currindex = indexwsindexmap[index / 2];
+            currindex = entrygroup;
 
             if (currindex != lastindex && start.totalNanoseconds() == 0) {
               // Group index is different from last and start is not set up: new
@@ -1288,13 +1348,11 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
             } else {
               // An impossible situation
               std::stringstream errmsg;
-              double lastvalue = m_dblLog->nthValue(i - 1);
+              double lastvalue = logvalues[i > 0 ? i - 1 : i];
               errmsg << "Impossible to have currindex == lastindex == "
                      << currindex
                      << ", while start is not init.  Log Index = " << i
-                     << "\t value = " << currValue << "\t, Index = " << index
-                     << " in range " << logvalueranges[index] << ", "
-                     << logvalueranges[index + 1]
+                     << "\t value = " << currValue
                      << "; Last value = " << lastvalue;
               throw std::runtime_error(errmsg.str());
             }
@@ -1304,8 +1362,8 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
             currindex = -1;
             g_log.warning()
                 << "Not likely to happen! Current value = " << currValue
-                << " is  within value range but its index = " << index
-                << " has no map to group index. "
+                << " is  within value range but falls between two log value "
+                   "intervals. "
                 << "\n";
             if (start.totalNanoseconds() > 0) {
               // Close the interval pair if it has been started.
@@ -1368,8 +1426,8 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
   // time
   // To make it non-empty
   if (vecSplitTime.size() == 0) {
-    start = m_dblLog->nthTime(istart);
-    stop = m_dblLog->nthTime(iend);
+    start = DateAndTime(logtimes[istart]);
+    stop = DateAndTime(logtimes[iend]);
     lastindex = -1;
     makeSplitterInVector(vecSplitTime, vecSplitGroup, start, stop, lastindex,
                          tol_ns, laststoptime);
@@ -1588,12 +1646,13 @@ size_t GenerateEventsFilter::searchValue(const std::vector<double> &sorteddata,
 /** Determine starting value changing direction
   */
 int GenerateEventsFilter::determineChangingDirection(int startindex) {
+  const vector<double> &values = m_dblLogColumns.values();
   int direction = 0;
 
   // Search to earlier entries
   int index = startindex;
   while (direction == 0 && index > 0) {
-    double diff = m_dblLog->nthValue(index) - m_dblLog->nthValue(index - 1);
+    double diff = values[index] - values[index - 1];
     if (diff > 0)
       direction = 1;
     else if (diff < 0)
@@ -1607,9 +1666,9 @@ int GenerateEventsFilter::determineChangingDirection(int startindex) {
 
   // Search to later entries
   index = startindex;
-  int maxindex = m_dblLog->size() - 1;
+  int maxindex = static_cast<int>(values.size()) - 1;
   while (direction == 0 && index < maxindex) {
-    double diff = m_dblLog->nthValue(index + 1) - m_dblLog->nthValue(index);
+    double diff = values[index + 1] - values[index];
     if (diff > 0)
       direction = 1;
     else if (diff < 0)
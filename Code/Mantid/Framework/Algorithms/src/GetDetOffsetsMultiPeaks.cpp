@@ -473,6 +473,7 @@ void GetDetOffsetsMultiPeaks::calculateDetectorsOffsets() {
 
   // Fit all the spectra with a gaussian
   Progress prog(this, 0, 1.0, nspec);
+  m_findPeaks.assign(PARALLEL_GET_MAX_THREADS, API::IAlgorithm_sptr());
 
   // cppcheck-suppress syntaxError
     PRAGMA_OMP(parallel for schedule(dynamic, 1) )
@@ -542,6 +543,8 @@ void GetDetOffsetsMultiPeaks::calculateDetectorsOffsets() {
     }
     PARALLEL_CHECK_INTERUPT_REGION
 
+    m_findPeaks.clear();
+
     return;
 }
 
@@ -874,9 +877,12 @@ int GetDetOffsetsMultiPeaks::fitSpectra(
     return 0;
   }
 
-  // Fit peaks
-  API::IAlgorithm_sptr findpeaks =
-      createChildAlgorithm("FindPeaks", -1, -1, false);
+  // Fit peaks. Initializing FindPeaks creates every registered function to
+  // list the peak functions, so each thread reuses its own instance rather
+  // than creating one per spectrum.
+  API::IAlgorithm_sptr &findpeaks = m_findPeaks[PARALLEL_THREAD_NUMBER];
+  if (!findpeaks)
+    findpeaks = createChildAlgorithm("FindPeaks", -1, -1, false);
   findpeaks->setProperty("InputWorkspace", inputW);
   findpeaks->setProperty<int>("FWHM", 7);
   findpeaks->setProperty<int>("Tolerance", 4);
@@ -6,6 +6,9 @@
 #include "MantidAlgorithms/MergeRuns.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
 
 namespace Mantid {
 namespace Algorithms {
@@ -98,6 +101,10 @@ void MergeRuns::exec() {
     MatrixWorkspace_sptr outWS = m_inMatrixWS.front();
     int64_t n = m_inMatrixWS.size() - 1;
     m_progress = new Progress(this, 0.0, 1.0, n);
+    // Until the first addition outWS is one of the inputs and must not be
+    // changed. After that the total is accumulated in place so that only it
+    // and the current (possibly rebinned) input are held at any one time.
+    bool outputIsInput = true;
     // Note that the iterator is incremented before first pass so that 1st
     // workspace isn't added to itself
     for (++it; it != m_inMatrixWS.end(); ++it) {
@@ -110,13 +117,20 @@ void MergeRuns::exec() {
 
         // Rebin the two workspaces in turn to the same set of bins
         outWS = this->rebinInput(outWS, rebinParams);
+        outputIsInput = false;
         addee = this->rebinInput(*it, rebinParams);
       } else {
         addee = *it;
       }
 
       // Add the current workspace to the total
-      outWS = outWS + addee;
+      if (outputIsInput) {
+        outWS = outWS + addee;
+        outputIsInput = false;
+      } else {
+        // Plus may still hand back a new workspace, e.g. if the types differ
+        outWS = (outWS += addee);
+      }
 
       m_progress->report();
     }
@@ -271,35 +285,63 @@ void MergeRuns::execEvent() {
   // You need to copy over the data as well.
   outWS->copyDataFrom((*inputWS));
 
-  int64_t n = m_inEventWS.size() - 1;
-  m_progress = new Progress(this, 0.0, 1.0, n);
-
-  // Note that we start at 1, since we already have the 0th workspace
+  // Work out which input lists go into which output list, in the order in
+  // which they are added. Lists without a match are appended as new entries.
+  typedef std::vector<std::pair<size_t, size_t>> ContributionList;
+  std::vector<ContributionList> contributions(outWS->getNumberHistograms());
   for (size_t workspaceNum = 1; workspaceNum < m_inEventWS.size();
        workspaceNum++) {
-    // You are adding this one here
-    EventWorkspace_sptr addee = m_inEventWS[workspaceNum];
-
     boost::shared_ptr<AdditionTable> table = m_tables[workspaceNum - 1];
-
-    // Add all the event lists together as the table says to do
     for (auto it = table->begin(); it != table->end(); ++it) {
-      int64_t inWI = it->first;
-      int64_t outWI = it->second;
-      if (outWI >= 0) {
-        outWS->getEventList(outWI) += addee->getEventList(inWI);
-      } else {
-        // Add an entry to list
-        outWS->getOrAddEventList(outWS->getNumberHistograms()) +=
-            addee->getEventList(inWI);
-      }
+      size_t outWI = contributions.size();
+      if (it->second >= 0)
+        outWI = static_cast<size_t>(it->second);
+      else
+        contributions.push_back(ContributionList());
+      contributions[outWI].push_back(
+          std::make_pair(workspaceNum, static_cast<size_t>(it->first)));
     }
+  }
+  // Create the new entries up front so each list can be filled on its own
+  for (size_t outWI = outWS->getNumberHistograms();
+       outWI < contributions.size(); outWI++)
+    outWS->getOrAddEventList(outWI);
+
+  const int numOutput = static_cast<int>(contributions.size());
+  m_progress = new Progress(this, 0.0, 1.0, numOutput);
+
+  // Every output list is independent, so fill them in parallel. Each one is
+  // switched to its final type and allocated once before appending.
+  PRAGMA_OMP(parallel for schedule(dynamic, 64))
+  for (int outWI = 0; outWI < numOutput; outWI++) {
+    PARALLEL_START_INTERUPT_REGION
+    EventList &outEL = outWS->getEventList(outWI);
+    const ContributionList &contribution = contributions[outWI];
+    if (!contribution.empty()) {
+      size_t numEvents = outEL.getNumberEvents();
+      int eventType = static_cast<int>(outEL.getEventType());
+      for (auto it = contribution.begin(); it != contribution.end(); ++it) {
+        const EventList &inEL =
+            m_inEventWS[it->first]->getEventList(it->second);
+        numEvents += inEL.getNumberEvents();
+        eventType = std::max(eventType, static_cast<int>(inEL.getEventType()));
+      }
+      outEL.switchTo(static_cast<EventType>(eventType));
+      outEL.reserve(numEvents);
 
-    // Now we add up the runs
-    outWS->mutableRun() += addee->mutableRun();
-
+      // Add all the event lists together as the tables say to do
+      for (auto it = contribution.begin(); it != contribution.end(); ++it)
+        outEL += m_inEventWS[it->first]->getEventList(it->second);
+    }
     m_progress->report();
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Now we add up the runs
+  for (size_t workspaceNum = 1; workspaceNum < m_inEventWS.size();
+       workspaceNum++)
+    outWS->mutableRun() += m_inEventWS[workspaceNum]->mutableRun();
 
   // Set the final workspace to the output property
   setProperty("OutputWorkspace",
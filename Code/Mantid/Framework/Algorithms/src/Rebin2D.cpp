@@ -4,6 +4,7 @@
 #include "MantidAlgorithms/Rebin2D.h"
 #include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/VectorHelper.h"
@@ -14,6 +15,7 @@
 #include "MantidGeometry/Math/LaszloIntersection.h"
 
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
 
 namespace Mantid {
 namespace Algorithms {
@@ -27,6 +29,103 @@ using Geometry::ConvexPolygon;
 using Geometry::Quadrilateral;
 using Kernel::V2D;
 
+namespace {
+/**
+ * Integrate clamp(f(x), lo, hi) over [x0, x1] where f is linear
+ * @param x0 Start of the interval
+ * @param x1 End of the interval
+ * @param f0 Value of f at x0
+ * @param f1 Value of f at x1
+ * @param lo Lower clamp value
+ * @param hi Upper clamp value
+ * @return The integral
+ */
+double integrateClamped(const double x0, const double x1, const double f0,
+                        const double f1, const double lo, const double hi) {
+  // Split the interval where f crosses lo or hi, given as fractions of it
+  double cuts[4] = {0.0, 0.0, 0.0, 1.0};
+  size_t ncuts = 1;
+  if (f0 != f1) {
+    const double tlo = (lo - f0) / (f1 - f0);
+    const double thi = (hi - f0) / (f1 - f0);
+    if (tlo > 0.0 && tlo < 1.0)
+      cuts[ncuts++] = tlo;
+    if (thi > 0.0 && thi < 1.0)
+      cuts[ncuts++] = thi;
+  }
+  cuts[ncuts++] = 1.0;
+  std::sort(cuts + 1, cuts + ncuts - 1);
+
+  double integral(0.0);
+  for (size_t k = 0; k + 1 < ncuts; ++k) {
+    const double ta = cuts[k], tb = cuts[k + 1];
+    const double fa = f0 + (f1 - f0) * ta, fb = f0 + (f1 - f0) * tb;
+    // f is entirely below lo, above hi or in between on each piece
+    const double fmid = 0.5 * (fa + fb);
+    double mean = fmid;
+    if (fmid <= lo)
+      mean = lo;
+    else if (fmid >= hi)
+      mean = hi;
+    integral += mean * (tb - ta) * (x1 - x0);
+  }
+  return integral;
+}
+
+/**
+ * Overlap of a quadrilateral whose left and right sides are vertical with an
+ * axis-aligned rectangle. The area between the lower and upper edges inside
+ * the rectangle is the difference of the integrals of the two edges clamped
+ * to the rectangle, so no polygon clipping is needed.
+ * @param ll Lower left vertex of the quadrilateral
+ * @param ul Upper left vertex, at the same x as ll
+ * @param ur Upper right vertex
+ * @param lr Lower right vertex, at the same x as ur
+ * @param xlo Left of the rectangle
+ * @param xhi Right of the rectangle
+ * @param ylo Bottom of the rectangle
+ * @param yhi Top of the rectangle
+ * @param area [out] Area of the overlap
+ * @param width [out] Extent of the overlap along x
+ * @return True if the overlap has a non-zero area
+ */
+bool overlapWithRectangle(const V2D &ll, const V2D &ul, const V2D &ur,
+                          const V2D &lr, const double xlo, const double xhi,
+                          const double ylo, const double yhi, double &area,
+                          double &width) {
+  const double x0 = std::max(ll.X(), xlo);
+  const double x1 = std::min(lr.X(), xhi);
+  if (x1 <= x0)
+    return false;
+  // Lower and upper edges at x0 and x1
+  const double lowerSlope = (lr.Y() - ll.Y()) / (lr.X() - ll.X());
+  const double upperSlope = (ur.Y() - ul.Y()) / (ur.X() - ul.X());
+  const double l0 = ll.Y() + lowerSlope * (x0 - ll.X());
+  const double l1 = ll.Y() + lowerSlope * (x1 - ll.X());
+  const double u0 = ul.Y() + upperSlope * (x0 - ul.X());
+  const double u1 = ul.Y() + upperSlope * (x1 - ul.X());
+
+  area = integrateClamped(x0, x1, u0, u1, ylo, yhi) -
+         integrateClamped(x0, x1, l0, l1, ylo, yhi);
+  if (!(area > 0.0))
+    return false;
+
+  // The overlap spans the x where the upper edge is above the rectangle's
+  // bottom and the lower edge is below its top
+  double start(x0), end(x1);
+  if (u0 < ylo && u1 > ylo)
+    start = std::max(start, x0 + (ylo - u0) / (u1 - u0) * (x1 - x0));
+  else if (u0 > ylo && u1 < ylo)
+    end = std::min(end, x0 + (ylo - u0) / (u1 - u0) * (x1 - x0));
+  if (l0 > yhi && l1 < yhi)
+    start = std::max(start, x0 + (yhi - l0) / (l1 - l0) * (x1 - x0));
+  else if (l0 < yhi && l1 > yhi)
+    end = std::min(end, x0 + (yhi - l0) / (l1 - l0) * (x1 - x0));
+  width = end - start;
+  return true;
+}
+}
+
 //--------------------------------------------------------------------------
 // Private methods
 //--------------------------------------------------------------------------
@@ -114,33 +213,46 @@ void Rebin2D::exec() {
   m_progress = boost::shared_ptr<API::Progress>(
       new API::Progress(this, 0.0, 1.0, nreports));
 
-  // PARALLEL_FOR2(inputWS, outputWS)
+  // Each thread sums into its own copy of the output grid so no locking is
+  // needed. The copies are added into the output at the end. A single thread
+  // sums straight into the output.
+  const MantidVec &newX = outputWS->readX(0);
+  std::vector<GridSums> sums =
+      createGridSums(outputWS, inputWS->threadSafe());
+  const int numSums = static_cast<int>(sums.size());
+  // Don't do the overlap removal if already RebinnedOutput.
+  // This wreaks havoc on the data.
+  const bool scaleByOverlapWidth =
+      inputWS->isDistribution() &&
+      !(this->useFractionalArea && inputWS->id() == "RebinnedOutput");
+
+  PRAGMA_OMP(parallel for schedule(dynamic) num_threads(numSums)
+             if (numSums > 1))
   for (int64_t i = 0; i < static_cast<int64_t>(numYBins);
        ++i) // signed for openmp
   {
     PARALLEL_START_INTERUPT_REGION
 
+    GridSums &threadSums = sums[PARALLEL_THREAD_NUMBER];
+    const MantidVec &Y = inputWS->readY(i);
+    const MantidVec &E = inputWS->readE(i);
     const double vlo = oldYEdges[i];
     const double vhi = oldYEdges[i + 1];
     for (size_t j = 0; j < numXBins; ++j) {
-      m_progress->report("Computing polygon intersections");
       // For each input polygon test where it intersects with
       // the output grid and assign the appropriate weights of Y/E
-      const double x_j = oldXEdges[j];
-      const double x_jp1 = oldXEdges[j + 1];
-      Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
-      if (!this->useFractionalArea) {
-        rebinToOutput(inputQ, inputWS, i, j, outputWS, newYBins);
-      } else {
-        rebinToFractionalOutput(
-            inputQ, inputWS, i, j,
-            boost::dynamic_pointer_cast<RebinnedOutput>(outputWS), newYBins);
-      }
+      if (boost::math::isnan(Y[j]))
+        continue;
+      const Quadrilateral inputQ(oldXEdges[j], oldXEdges[j + 1], vlo, vhi);
+      rebinToSums(inputQ, Y[j], E[j], scaleByOverlapWidth, newX, newYBins,
+                  threadSums);
     }
+    m_progress->reportIncrement(numXBins, "Computing polygon intersections");
 
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+  addGridSums(sums, outputWS);
   if (this->useFractionalArea) {
     boost::dynamic_pointer_cast<RebinnedOutput>(outputWS)->finalize();
   }
@@ -175,8 +287,8 @@ void Rebin2D::rebinToOutput(const Geometry::Quadrilateral &inputQ,
   const MantidVec &X = outputWS->readX(0);
   size_t qstart(0), qend(verticalAxis.size() - 1), en_start(0),
       en_end(X.size() - 1);
-  if (!getIntersectionRegion(outputWS, verticalAxis, inputQ, qstart, qend,
-                             en_start, en_end))
+  if (!getIntersectionRegion(X, verticalAxis, inputQ, qstart, qend, en_start,
+                             en_end))
     return;
 
   for (size_t qi = qstart; qi < qend; ++qi) {
@@ -215,60 +327,146 @@ void Rebin2D::rebinToOutput(const Geometry::Quadrilateral &inputQ,
 }
 
 /**
- * Rebin the input quadrilateral to the output grid
+ * Rebin the input quadrilateral into one thread's sums of the output grid.
+ * Quadrilaterals with vertical left and right sides, which is every input
+ * bin of Rebin2D and SofQW3, have their overlap with each output bin
+ * computed analytically. Any other shape goes through general polygon
+ * clipping.
  * @param inputQ The input polygon
- * @param inputWS The input workspace containing the input intensity values
- * @param i The index in the vertical axis direction that inputQ references
- * @param j The index in the horizontal axis direction that inputQ references
- * @param outputWS A pointer to the output workspace that accumulates the data
+ * @param signal The signal of the input polygon
+ * @param error The error of the input polygon
+ * @param scaleByOverlapWidth If true the contributions are multiplied by the
+ * width of the overlap, undoing a division by the input bin width
+ * @param xAxis A vector containing the output horizontal axis bin boundaries
  * @param verticalAxis A vector containing the output vertical axis bin
  * boundaries
+ * @param sums The sums to add to
  */
-void Rebin2D::rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
-                                      MatrixWorkspace_const_sptr inputWS,
-                                      const size_t i, const size_t j,
-                                      RebinnedOutput_sptr outputWS,
-                                      const std::vector<double> &verticalAxis) {
-  const MantidVec &X = outputWS->readX(0);
+void Rebin2D::rebinToSums(const Geometry::Quadrilateral &inputQ,
+                          const double signal, const double error,
+                          const bool scaleByOverlapWidth,
+                          const MantidVec &xAxis,
+                          const std::vector<double> &verticalAxis,
+                          GridSums &sums) const {
   size_t qstart(0), qend(verticalAxis.size() - 1), en_start(0),
-      en_end(X.size() - 1);
-  if (!getIntersectionRegion(outputWS, verticalAxis, inputQ, qstart, qend,
+      en_end(xAxis.size() - 1);
+  if (!getIntersectionRegion(xAxis, verticalAxis, inputQ, qstart, qend,
                              en_start, en_end))
     return;
 
+  const V2D &ll = inputQ[0];
+  const V2D &ul = inputQ[1];
+  const V2D &ur = inputQ[2];
+  const V2D &lr = inputQ[3];
+  const bool verticalSides = ll.X() == ul.X() && lr.X() == ur.X() &&
+                             ll.X() < lr.X() && ll.Y() <= ul.Y() &&
+                             lr.Y() <= ur.Y();
+  const double inputArea =
+      verticalSides
+          ? 0.5 * (lr.X() - ll.X()) * ((ul.Y() - ll.Y()) + (ur.Y() - lr.Y()))
+          : inputQ.area();
+
   for (size_t qi = qstart; qi < qend; ++qi) {
     const double vlo = verticalAxis[qi];
     const double vhi = verticalAxis[qi + 1];
     for (size_t ei = en_start; ei < en_end; ++ei) {
-      const V2D ll(X[ei], vlo);
-      const V2D lr(X[ei + 1], vlo);
-      const V2D ur(X[ei + 1], vhi);
-      const V2D ul(X[ei], vhi);
-      const Quadrilateral outputQ(ll, lr, ur, ul);
+      double overlapArea(0.0), overlapWidth(0.0);
+      if (verticalSides) {
+        if (!overlapWithRectangle(ll, ul, ur, lr, xAxis[ei], xAxis[ei + 1], vlo,
+                                  vhi, overlapArea, overlapWidth))
+          continue;
+      } else {
+        const Quadrilateral outputQ(xAxis[ei], xAxis[ei + 1], vlo, vhi);
+        try {
+          ConvexPolygon overlap = intersectionByLaszlo(outputQ, inputQ);
+          overlapArea = overlap.area();
+          overlapWidth = overlap.largestX() - overlap.smallestX();
+        } catch (Geometry::NoIntersectionException &) {
+          continue;
+        }
+      }
+      const double weight = overlapArea / inputArea;
+      double yValue = signal * weight;
+      double eValue = error * weight;
+      if (scaleByOverlapWidth) {
+        yValue *= overlapWidth;
+        eValue *= overlapWidth;
+      }
+      sums.add(qi, ei, yValue, eValue * eValue, weight);
+    }
+  }
+}
 
-      double yValue = inputWS->readY(i)[j];
-      if (boost::math::isnan(yValue)) {
+/**
+ * @param outputWS The (zeroed) output workspace the sums are added into
+ */
+Rebin2D::GridSums::GridSums(MatrixWorkspace_sptr outputWS)
+    : numColumns(outputWS->blocksize()), signal(), errorSq(), fraction(),
+      signalRows(), errorRows(), fractionRows() {
+  RebinnedOutput_sptr fractionalWS =
+      boost::dynamic_pointer_cast<RebinnedOutput>(outputWS);
+  const size_t numRows = outputWS->getNumberHistograms();
+  if (numColumns == 0)
+    return;
+  for (size_t qi = 0; qi < numRows; ++qi) {
+    signalRows.push_back(&outputWS->dataY(qi)[0]);
+    errorRows.push_back(&outputWS->dataE(qi)[0]);
+    if (fractionalWS)
+      fractionRows.push_back(&fractionalWS->dataF(qi)[0]);
+  }
+}
+
+/**
+ * Create the per-thread sums of the output grid. There is one per thread
+ * unless the copies would take too much memory, in which case fewer threads
+ * are used. A single set of sums is added straight into the output workspace.
+ * @param outputWS The output workspace
+ * @param parallel If false only one thread is used
+ * @return The zeroed sums, at least one
+ */
+std::vector<Rebin2D::GridSums>
+Rebin2D::createGridSums(MatrixWorkspace_sptr outputWS,
+                        const bool parallel) const {
+  const size_t numRows = outputWS->getNumberHistograms();
+  const size_t numCols = outputWS->blocksize();
+  // Bound the extra memory for the copies to ~250MB
+  const size_t maxTotalBins = 10000000;
+  const size_t numBins = std::max(numRows * numCols, size_t(1));
+  size_t numSums = parallel ? static_cast<size_t>(PARALLEL_GET_MAX_THREADS) : 1;
+  numSums = std::min(numSums, maxTotalBins / numBins);
+  if (numSums <= 1)
+    return std::vector<GridSums>(1, GridSums(outputWS));
+  return std::vector<GridSums>(numSums, GridSums(numRows, numCols));
+}
+
+/**
+ * Add the sums of all threads into the output workspace. The fractions are
+ * only added if the output is a RebinnedOutput workspace.
+ * @param sums The sums of each thread
+ * @param outputWS The output workspace
+ */
+void Rebin2D::addGridSums(const std::vector<GridSums> &sums,
+                          MatrixWorkspace_sptr outputWS) const {
+  RebinnedOutput_sptr fractionalWS =
+      boost::dynamic_pointer_cast<RebinnedOutput>(outputWS);
+  const int64_t numRows = static_cast<int64_t>(outputWS->getNumberHistograms());
+  PARALLEL_FOR1(outputWS)
+  for (int64_t qi = 0; qi < numRows; ++qi) {
+    MantidVec &Y = outputWS->dataY(qi);
+    MantidVec &E = outputWS->dataE(qi);
+    for (size_t s = 0; s < sums.size(); ++s) {
+      // Already in the output
+      if (sums[s].isDirect())
         continue;
+      const size_t offset = static_cast<size_t>(qi) * sums[s].numColumns;
+      for (size_t ei = 0; ei < Y.size(); ++ei) {
+        Y[ei] += sums[s].signal[offset + ei];
+        E[ei] += sums[s].errorSq[offset + ei];
       }
-      try {
-        ConvexPolygon overlap = intersectionByLaszlo(outputQ, inputQ);
-        const double weight = overlap.area() / inputQ.area();
-        yValue *= weight;
-        double eValue = inputWS->readE(i)[j] * weight;
-        const double overlapWidth = overlap.largestX() - overlap.smallestX();
-        // Don't do the overlap removal if already RebinnedOutput.
-        // This wreaks havoc on the data.
-        if (inputWS->isDistribution() && inputWS->id() != "RebinnedOutput") {
-          yValue *= overlapWidth;
-          eValue *= overlapWidth;
-        }
-        eValue *= eValue;
-        PARALLEL_CRITICAL(overlap) {
-          outputWS->dataY(qi)[ei] += yValue;
-          outputWS->dataE(qi)[ei] += eValue;
-          outputWS->dataF(qi)[ei] += weight;
-        }
-      } catch (Geometry::NoIntersectionException &) {
+      if (fractionalWS) {
+        MantidVec &F = fractionalWS->dataF(qi);
+        for (size_t ei = 0; ei < F.size(); ++ei)
+          F[ei] += sums[s].fraction[offset + ei];
       }
     }
   }
@@ -277,7 +475,7 @@ void Rebin2D::rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
 /**
  * Find the possible region of intersection on the output workspace for the
  * given polygon
- * @param outputWS A pointer to the output workspace
+ * @param xAxis A vector containing the output horizontal axis edges
  * @param verticalAxis A vector containing the output vertical axis edges
  * @param inputQ The input polygon
  * @param qstart An output giving the starting index in the Q direction
@@ -286,12 +484,11 @@ void Rebin2D::rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
  * @param en_end An output giving the end index in the dE direction
  * @return True if an intersecition is possible
  */
-bool Rebin2D::getIntersectionRegion(API::MatrixWorkspace_const_sptr outputWS,
+bool Rebin2D::getIntersectionRegion(const MantidVec &xAxis,
                                     const std::vector<double> &verticalAxis,
                                     const Geometry::Quadrilateral &inputQ,
                                     size_t &qstart, size_t &qend,
                                     size_t &en_start, size_t &en_end) const {
-  const MantidVec &xAxis = outputWS->readX(0);
   const double xn_lo(inputQ.smallestX()), xn_hi(inputQ.largestX());
   const double yn_lo(inputQ.smallestY()), yn_hi(inputQ.largestY());
 
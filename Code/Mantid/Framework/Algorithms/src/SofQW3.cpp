@@ -14,6 +14,8 @@
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <boost/math/special_functions/fpclassify.hpp>
+
 namespace Mantid {
 namespace Algorithms {
 // Setup typedef for later use
@@ -102,19 +104,42 @@ void SofQW3::exec() {
   }
 
   const MantidVec &X = inputWS->readX(0);
+  const MantidVec &outX = outputWS->readX(0);
+
+  // Each thread sums into its own copy of the output grid so no locking is
+  // needed. The copies are added into the output at the end. A single thread
+  // sums straight into the output.
+  std::vector<GridSums> sums =
+      createGridSums(outputWS, inputWS->threadSafe());
+  const int numSums = static_cast<int>(sums.size());
+  // Don't do the overlap removal if already RebinnedOutput.
+  const bool scaleByOverlapWidth =
+      inputWS->isDistribution() && inputWS->id() != "RebinnedOutput";
+  // The spectrum-detector pairs found for each input spectrum, joined in
+  // order once the loop is done
+  std::vector<std::vector<std::pair<specid_t, detid_t>>> mappings(nHistos);
+  std::vector<specid_t> outputSpecNos(outputWS->getNumberHistograms());
+  for (size_t qi = 0; qi < outputSpecNos.size(); ++qi)
+    outputSpecNos[qi] = outputWS->getSpectrum(qi)->getSpectrumNo();
 
   int emode = m_EmodeProperties.m_emode;
-  /* PARALLEL_FOR2(inputWS, outputWS) */
+  PRAGMA_OMP(parallel for schedule(dynamic) num_threads(numSums)
+             if (numSums > 1))
   for (int64_t i = 0; i < static_cast<int64_t>(nHistos);
        ++i) // signed for openmp
   {
-    /* PARALLEL_START_INTERUPT_REGION */
+    PARALLEL_START_INTERUPT_REGION
 
     DetConstPtr detector = inputWS->getDetector(i);
     if (detector->isMasked() || detector->isMonitor()) {
       continue;
     }
 
+    GridSums &threadSums = sums[PARALLEL_THREAD_NUMBER];
+    const MantidVec &Y = inputWS->readY(i);
+    const MantidVec &E = inputWS->readE(i);
+    std::vector<std::pair<specid_t, detid_t>> &mapping = mappings[i];
+
     double theta = this->m_theta[i];
     double phi = this->m_phi[i];
     double thetaWidth = this->m_thetaWidths[i];
@@ -134,7 +159,6 @@ void SofQW3::exec() {
     const specid_t specNo = inputWS->getSpectrum(i)->getSpectrumNo();
     std::stringstream logStream;
     for (size_t j = 0; j < nEnergyBins; ++j) {
-      m_progress->report("Computing polygon intersections");
       // For each input polygon test where it intersects with
       // the output grid and assign the appropriate weights of Y/E
       const double dE_j = X[j];
@@ -157,27 +181,38 @@ void SofQW3::exec() {
                   << ", lr=" << lr << ", ur=" << ur << ", ul=" << ul << "\n";
       }
 
-      Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
-
-      this->rebinToFractionalOutput(inputQ, inputWS, i, j, outputWS, m_Qout);
+      if (!boost::math::isnan(Y[j])) {
+        Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
+        this->rebinToSums(inputQ, Y[j], E[j], scaleByOverlapWidth, outX,
+                          m_Qout, threadSums);
+      }
 
       // Find which q bin this point lies in
       const MantidVec::difference_type qIndex =
           std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) - m_Qout.begin();
       if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
         // Add this spectra-detector pair to the mapping
-        specNumberMapping.push_back(
-            outputWS->getSpectrum(qIndex - 1)->getSpectrumNo());
-        detIDMapping.push_back(detector->getID());
+        mapping.push_back(
+            std::make_pair(outputSpecNos[qIndex - 1], detector->getID()));
       }
     }
     if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
       g_log.debug(logStream.str());
     }
+    m_progress->reportIncrement(nEnergyBins,
+                                "Computing polygon intersections");
 
-    /* PARALLEL_END_INTERUPT_REGION */
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  addGridSums(sums, outputWS);
+  for (size_t i = 0; i < nHistos; ++i) {
+    for (size_t k = 0; k < mappings[i].size(); ++k) {
+      specNumberMapping.push_back(mappings[i][k].first);
+      detIDMapping.push_back(mappings[i][k].second);
+    }
   }
-  /* PARALLEL_CHECK_INTERUPT_REGION */
 
   outputWS->finalize();
   this->normaliseOutput(outputWS, inputWS);
@@ -6,6 +6,9 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
 
 namespace Mantid {
 namespace Algorithms {
@@ -202,37 +205,22 @@ SumSpectra::getOutputSpecId(MatrixWorkspace_const_sptr localworkspace) {
 }
 
 /**
- * This function deals with the logic necessary for summing a Workspace2D.
+ * Find the spectra that go into the sum, in order. Monitors are skipped if
+ * they are not to be kept and masked spectra are skipped and counted. An
+ * index outside of the workspace ends the list.
  * @param localworkspace The input workspace for summing.
- * @param outSpec The spectrum for the summed output.
- * @param progress The progress indicator.
- * @param numSpectra The number of spectra contributed to the sum.
  * @param numMasked The spectra dropped from the summations because they are
  * masked.
- * @param numZeros The number of zero bins in histogram workspace or empty
- * spectra for event workspace.
+ * @return The workspace indices to sum.
  */
-void SumSpectra::doWorkspace2D(MatrixWorkspace_const_sptr localworkspace,
-                               ISpectrum *outSpec, Progress &progress,
-                               size_t &numSpectra, size_t &numMasked,
-                               size_t &numZeros) {
-  // Get references to the output workspaces's data vectors
-  MantidVec &YSum = outSpec->dataY();
-  MantidVec &YError = outSpec->dataE();
-
-  MantidVec Weight;
-  std::vector<size_t> nZeros;
-  if (m_CalculateWeightedSum) {
-    Weight.assign(YSum.size(), 0);
-    nZeros.assign(YSum.size(), 0);
-  }
-  numSpectra = 0;
+std::vector<int>
+SumSpectra::getContributingIndices(MatrixWorkspace_const_sptr localworkspace,
+                                   size_t &numMasked) {
+  std::vector<int> contributing;
+  contributing.reserve(this->indices.size());
   numMasked = 0;
-  numZeros = 0;
 
-  // Loop over spectra
   std::set<int>::iterator it;
-  // for (int i = m_MinSpec; i <= m_MaxSpec; ++i)
   for (it = this->indices.begin(); it != this->indices.end(); ++it) {
     int i = *it;
     // Don't go outside the range.
@@ -256,46 +244,166 @@ void SumSpectra::doWorkspace2D(MatrixWorkspace_const_sptr localworkspace,
     } catch (...) {
       // if the detector not found just carry on
     }
-    numSpectra++;
-
-    // Retrieve the spectrum into a vector
-    const MantidVec &YValues = localworkspace->readY(i);
-    const MantidVec &YErrors = localworkspace->readE(i);
-    if (m_CalculateWeightedSum) {
-      for (int k = 0; k < this->yLength; ++k) {
-        if (YErrors[k] != 0) {
-          double errsq = YErrors[k] * YErrors[k];
-          YError[k] += errsq;
-          Weight[k] += 1. / errsq;
-          YSum[k] += YValues[k] / errsq;
-        } else {
-          nZeros[k]++;
+    contributing.push_back(i);
+  }
+  return contributing;
+}
+
+namespace {
+/// The sums over a contiguous block of the contributing spectra
+struct PartialSums {
+  PartialSums(const size_t length, const bool weighted, const bool fractional)
+      : YSum(length, 0.0), YError(length, 0.0),
+        Weight(weighted ? length : 0, 0.0),
+        FracSum(fractional ? length : 0, 0.0),
+        nZeros(weighted ? length : 0, 0) {}
+
+  MantidVec YSum;
+  MantidVec YError;
+  MantidVec Weight;
+  MantidVec FracSum;
+  std::vector<size_t> nZeros;
+};
+}
+
+/**
+ * Sum the contributing spectra in blocks, one block per thread, and add up
+ * the blocks in order at the end. Fractional areas are taken into account if
+ * the input is a RebinnedOutput.
+ * @param localworkspace The input workspace for summing.
+ * @param contributing The workspace indices to sum.
+ * @param outSpec The spectrum for the summed output.
+ * @param FracSum The summed fractional areas, if the input has them.
+ * @param progress The progress indicator.
+ * @param numZeros The number of zero bins in histogram workspace.
+ */
+void SumSpectra::sumSpectra(MatrixWorkspace_const_sptr localworkspace,
+                            const std::vector<int> &contributing,
+                            ISpectrum *outSpec, MantidVec *FracSum,
+                            Progress &progress, size_t &numZeros) {
+  RebinnedOutput_const_sptr inWS =
+      boost::dynamic_pointer_cast<const RebinnedOutput>(localworkspace);
+  const bool fractional = (FracSum != NULL && inWS);
+  const bool weighted = m_CalculateWeightedSum;
+  const int numContributing = static_cast<int>(contributing.size());
+  const int numBlocks =
+      std::max(1, std::min(PARALLEL_GET_MAX_THREADS, numContributing));
+  const size_t length = static_cast<size_t>(this->yLength);
+  std::vector<PartialSums> blocks(numBlocks,
+                                  PartialSums(length, weighted, fractional));
+
+  PARALLEL_FOR_IF(localworkspace->threadSafe())
+  for (int block = 0; block < numBlocks; ++block) {
+    PARALLEL_START_INTERUPT_REGION
+    PartialSums &sums = blocks[block];
+    const int begin = numContributing * block / numBlocks;
+    const int end = numContributing * (block + 1) / numBlocks;
+    for (int n = begin; n < end; ++n) {
+      const int i = contributing[n];
+      // Retrieve the spectrum into a vector
+      const MantidVec &YValues = localworkspace->readY(i);
+      const MantidVec &YErrors = localworkspace->readE(i);
+      if (fractional) {
+        const MantidVec &FracArea = inWS->readF(i);
+        for (size_t k = 0; k < length; ++k) {
+          sums.FracSum[k] += FracArea[k];
+          if (weighted) {
+            if (YErrors[k] != 0) {
+              double errsq =
+                  YErrors[k] * YErrors[k] * FracArea[k] * FracArea[k];
+              sums.YError[k] += errsq;
+              sums.Weight[k] += 1. / errsq;
+              sums.YSum[k] += YValues[k] * FracArea[k] / errsq;
+            } else {
+              sums.nZeros[k]++;
+            }
+          } else {
+            sums.YSum[k] += YValues[k] * FracArea[k];
+            sums.YError[k] +=
+                YErrors[k] * YErrors[k] * FracArea[k] * FracArea[k];
+          }
+        }
+      } else if (weighted) {
+        for (size_t k = 0; k < length; ++k) {
+          if (YErrors[k] != 0) {
+            double errsq = YErrors[k] * YErrors[k];
+            sums.YError[k] += errsq;
+            sums.Weight[k] += 1. / errsq;
+            sums.YSum[k] += YValues[k] / errsq;
+          } else {
+            sums.nZeros[k]++;
+          }
+        }
+      } else {
+        for (size_t k = 0; k < length; ++k) {
+          sums.YSum[k] += YValues[k];
+          sums.YError[k] += YErrors[k] * YErrors[k];
         }
       }
-    } else {
-      for (int k = 0; k < this->yLength; ++k) {
-        YSum[k] += YValues[k];
-        YError[k] += YErrors[k] * YErrors[k];
-      }
+      progress.report();
     }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
 
-    // Map all the detectors onto the spectrum of the output
-    outSpec->addDetectorIDs(localworkspace->getSpectrum(i)->getDetectorIDs());
+  // Add up the blocks in order so the result does not depend on scheduling
+  MantidVec &YSum = outSpec->dataY();
+  MantidVec &YError = outSpec->dataE();
+  PartialSums total(length, weighted, fractional);
+  for (int block = 0; block < numBlocks; ++block) {
+    const PartialSums &sums = blocks[block];
+    for (size_t k = 0; k < length; ++k) {
+      YSum[k] += sums.YSum[k];
+      YError[k] += sums.YError[k];
+      if (fractional)
+        (*FracSum)[k] += sums.FracSum[k];
+      if (weighted) {
+        total.Weight[k] += sums.Weight[k];
+        total.nZeros[k] += sums.nZeros[k];
+      }
+    }
+  }
 
-    progress.report();
+  // Map all the detectors onto the spectrum of the output
+  for (int n = 0; n < numContributing; ++n) {
+    outSpec->addDetectorIDs(
+        localworkspace->getSpectrum(contributing[n])->getDetectorIDs());
   }
 
-  if (m_CalculateWeightedSum) {
+  if (weighted) {
     numZeros = 0;
-    for (size_t i = 0; i < Weight.size(); i++) {
-      if (nZeros[i] == 0)
-        YSum[i] *= double(numSpectra) / Weight[i];
+    for (size_t i = 0; i < length; i++) {
+      if (total.nZeros[i] == 0)
+        YSum[i] *= double(numContributing) / total.Weight[i];
       else
-        numZeros += nZeros[i];
+        numZeros += total.nZeros[i];
     }
   }
 }
 
+/**
+ * This function deals with the logic necessary for summing a Workspace2D.
+ * @param localworkspace The input workspace for summing.
+ * @param outSpec The spectrum for the summed output.
+ * @param progress The progress indicator.
+ * @param numSpectra The number of spectra contributed to the sum.
+ * @param numMasked The spectra dropped from the summations because they are
+ * masked.
+ * @param numZeros The number of zero bins in histogram workspace or empty
+ * spectra for event workspace.
+ */
+void SumSpectra::doWorkspace2D(MatrixWorkspace_const_sptr localworkspace,
+                               ISpectrum *outSpec, Progress &progress,
+                               size_t &numSpectra, size_t &numMasked,
+                               size_t &numZeros) {
+  const std::vector<int> contributing =
+      getContributingIndices(localworkspace, numMasked);
+  numSpectra = contributing.size();
+  numZeros = 0;
+
+  sumSpectra(localworkspace, contributing, outSpec, NULL, progress, numZeros);
+}
+
 /**
  * This function handles the logic for summing RebinnedOutput workspaces.
  * @param outputWorkspace the workspace to hold the summed input
@@ -325,95 +433,16 @@ void SumSpectra::doRebinnedOutput(MatrixWorkspace_sptr outputWorkspace,
   MatrixWorkspace_sptr localworkspace = alg->getProperty("OutputWorkspace");
 
   // Transform to real workspace types
-  RebinnedOutput_sptr inWS =
-      boost::dynamic_pointer_cast<RebinnedOutput>(localworkspace);
   RebinnedOutput_sptr outWS =
       boost::dynamic_pointer_cast<RebinnedOutput>(outputWorkspace);
 
-  // Get references to the output workspaces's data vectors
-  ISpectrum *outSpec = outputWorkspace->getSpectrum(0);
-  MantidVec &YSum = outSpec->dataY();
-  MantidVec &YError = outSpec->dataE();
-  MantidVec &FracSum = outWS->dataF(0);
-  MantidVec Weight;
-  std::vector<size_t> nZeros;
-  if (m_CalculateWeightedSum) {
-    Weight.assign(YSum.size(), 0);
-    nZeros.assign(YSum.size(), 0);
-  }
-  numSpectra = 0;
-  numMasked = 0;
+  const std::vector<int> contributing =
+      getContributingIndices(localworkspace, numMasked);
+  numSpectra = contributing.size();
   numZeros = 0;
 
-  // Loop over spectra
-  std::set<int>::iterator it;
-  // for (int i = m_MinSpec; i <= m_MaxSpec; ++i)
-  for (it = indices.begin(); it != indices.end(); ++it) {
-    int i = *it;
-    // Don't go outside the range.
-    if ((i >= numberOfSpectra) || (i < 0)) {
-      g_log.error() << "Invalid index " << i
-                    << " was specified. Sum was aborted.\n";
-      break;
-    }
-
-    try {
-      // Get the detector object for this spectrum
-      Geometry::IDetector_const_sptr det = localworkspace->getDetector(i);
-      // Skip monitors, if the property is set to do so
-      if (!keepMonitors && det->isMonitor())
-        continue;
-      // Skip masked detectors
-      if (det->isMasked()) {
-        numMasked++;
-        continue;
-      }
-    } catch (...) {
-      // if the detector not found just carry on
-    }
-    numSpectra++;
-
-    // Retrieve the spectrum into a vector
-    const MantidVec &YValues = localworkspace->readY(i);
-    const MantidVec &YErrors = localworkspace->readE(i);
-    const MantidVec &FracArea = inWS->readF(i);
-
-    if (m_CalculateWeightedSum) {
-      for (int k = 0; k < this->yLength; ++k) {
-        if (YErrors[k] != 0) {
-          double errsq = YErrors[k] * YErrors[k] * FracArea[k] * FracArea[k];
-          YError[k] += errsq;
-          Weight[k] += 1. / errsq;
-          YSum[k] += YValues[k] * FracArea[k] / errsq;
-          FracSum[k] += FracArea[k];
-        } else {
-          nZeros[k]++;
-          FracSum[k] += FracArea[k];
-        }
-      }
-    } else {
-      for (int k = 0; k < this->yLength; ++k) {
-        YSum[k] += YValues[k] * FracArea[k];
-        YError[k] += YErrors[k] * YErrors[k] * FracArea[k] * FracArea[k];
-        FracSum[k] += FracArea[k];
-      }
-    }
-
-    // Map all the detectors onto the spectrum of the output
-    outSpec->addDetectorIDs(localworkspace->getSpectrum(i)->getDetectorIDs());
-
-    progress.report();
-  }
-
-  if (m_CalculateWeightedSum) {
-    numZeros = 0;
-    for (size_t i = 0; i < Weight.size(); i++) {
-      if (nZeros[i] == 0)
-        YSum[i] *= double(numSpectra) / Weight[i];
-      else
-        numZeros += nZeros[i];
-    }
-  }
+  sumSpectra(localworkspace, contributing, outputWorkspace->getSpectrum(0),
+             &outWS->dataF(0), progress, numZeros);
 
   // Create the correct representation
   outWS->finalize();
@@ -440,39 +469,26 @@ void SumSpectra::execEvent(EventWorkspace_const_sptr localworkspace,
   outEL.setSpectrumNo(m_outSpecId);
   outEL.clearDetectorIDs();
 
-  // Loop over spectra
-  std::set<int>::iterator it;
-  size_t numSpectra(0);
   size_t numMasked(0);
   size_t numZeros(0);
-  // for (int i = m_MinSpec; i <= m_MaxSpec; ++i)
-  for (it = indices.begin(); it != indices.end(); ++it) {
-    int i = *it;
-    // Don't go outside the range.
-    if ((i >= numberOfSpectra) || (i < 0)) {
-      g_log.error() << "Invalid index " << i
-                    << " was specified. Sum was aborted.\n";
-      break;
-    }
-
-    try {
-      // Get the detector object for this spectrum
-      Geometry::IDetector_const_sptr det = localworkspace->getDetector(i);
-      // Skip monitors, if the property is set to do so
-      if (!keepMonitors && det->isMonitor())
-        continue;
-      // Skip masked detectors
-      if (det->isMasked()) {
-        numMasked++;
-        continue;
-      }
-    } catch (...) {
-      // if the detector not found just carry on
-    }
-    numSpectra++;
+  const std::vector<int> contributing =
+      getContributingIndices(localworkspace, numMasked);
+  const size_t numSpectra = contributing.size();
+
+  // Reserve the whole output at once rather than growing it list by list
+  size_t numEvents(0);
+  for (size_t n = 0; n < numSpectra; ++n) {
+    const EventList &inEL = localworkspace->getEventList(contributing[n]);
+    numEvents += inEL.getNumberEvents();
+    if (static_cast<int>(inEL.getEventType()) >
+        static_cast<int>(outEL.getEventType()))
+      outEL.switchTo(inEL.getEventType());
+  }
+  outEL.reserve(numEvents);
 
+  for (size_t n = 0; n < numSpectra; ++n) {
     // Add the event lists with the operator
-    const EventList &tOutEL = localworkspace->getEventList(i);
+    const EventList &tOutEL = localworkspace->getEventList(contributing[n]);
     if (tOutEL.empty()) {
       ++numZeros;
     }
@@ -116,6 +116,103 @@ public:
   }
 
 
+  void test_EventWorkspace_sorted_mixed_input_gives_sorted_output()
+  {
+    EventWorkspace_sptr inputW = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(2, 4);
+    // One weighted list makes the whole output weighted
+    inputW->getEventList(3).switchTo(WEIGHTED);
+    inputW->sortAll(TOF_SORT, NULL);
+    const size_t numEvents = inputW->getNumberEvents();
+    AnalysisDataService::Instance().addOrReplace("DiffractionFocussing2Test_sorted", inputW);
+    FrameworkManager::Instance().exec("CreateGroupingWorkspace", 6,
+        "InputWorkspace", "DiffractionFocussing2Test_sorted",
+        "GroupNames", "bank1,bank2",
+        "OutputWorkspace", "DiffractionFocussing2Test_sorted_group");
+
+    DiffractionFocussing2 focus;
+    focus.initialize();
+    focus.setChild(true);
+    TS_ASSERT_THROWS_NOTHING( focus.setProperty("InputWorkspace", boost::dynamic_pointer_cast<MatrixWorkspace>(inputW)) );
+    TS_ASSERT_THROWS_NOTHING( focus.setPropertyValue("OutputWorkspace", "DiffractionFocussing2Test_sorted_focussed") );
+    TS_ASSERT_THROWS_NOTHING( focus.setPropertyValue("GroupingWorkspace", "DiffractionFocussing2Test_sorted_group") );
+    TS_ASSERT_THROWS_NOTHING( focus.execute() );
+    TS_ASSERT( focus.isExecuted() );
+
+    MatrixWorkspace_sptr output = focus.getProperty("OutputWorkspace");
+    EventWorkspace_sptr outputEvent = boost::dynamic_pointer_cast<EventWorkspace>(output);
+    TS_ASSERT( outputEvent );
+    if (!outputEvent) return;
+    TS_ASSERT_EQUALS( outputEvent->getNumberHistograms(), 2 );
+    TS_ASSERT_EQUALS( outputEvent->getNumberEvents(), numEvents );
+    TS_ASSERT_EQUALS( outputEvent->getEventType(), WEIGHTED );
+
+    for (size_t wi = 0; wi < outputEvent->getNumberHistograms(); wi++)
+    {
+      const EventList & el = outputEvent->getEventList(wi);
+      TS_ASSERT_EQUALS( el.getSortType(), TOF_SORT );
+      TS_ASSERT_EQUALS( el.getDetectorIDs().size(), 16 );
+      const std::vector<WeightedEvent> & events = el.getWeightedEvents();
+      for (size_t i = 1; i < events.size(); i++)
+        TS_ASSERT_LESS_THAN_EQUALS( events[i-1].tof(), events[i].tof() );
+    }
+
+    AnalysisDataService::Instance().remove("DiffractionFocussing2Test_sorted");
+    AnalysisDataService::Instance().remove("DiffractionFocussing2Test_sorted_group");
+  }
+
+  void test_EventWorkspace_inPlace_empties_the_focussed_inputs()
+  {
+    const std::string wsName("DiffractionFocussing2Test_inPlace");
+    EventWorkspace_sptr inputW = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(2, 4);
+    AnalysisDataService::Instance().addOrReplace(wsName, inputW);
+    FrameworkManager::Instance().exec("CreateGroupingWorkspace", 6,
+        "InputWorkspace", wsName.c_str(),
+        "GroupNames", "bank2",
+        "OutputWorkspace", "DiffractionFocussing2Test_inPlace_group");
+    // bank1 is not focussed; bank2 is the last 16 spectra
+    const size_t numSpectra = inputW->getNumberHistograms();
+    const size_t firstFocussed = numSpectra - 16;
+    size_t numFocussedEvents(0), numOtherEvents(0);
+    for (size_t wi = 0; wi < numSpectra; wi++)
+    {
+      if (wi < firstFocussed)
+        numOtherEvents += inputW->getEventList(wi).getNumberEvents();
+      else
+        numFocussedEvents += inputW->getEventList(wi).getNumberEvents();
+    }
+    TS_ASSERT_LESS_THAN( size_t(0), numFocussedEvents );
+
+    DiffractionFocussing2 focus;
+    focus.initialize();
+    TS_ASSERT_THROWS_NOTHING( focus.setPropertyValue("InputWorkspace", wsName) );
+    TS_ASSERT_THROWS_NOTHING( focus.setPropertyValue("OutputWorkspace", wsName) );
+    TS_ASSERT_THROWS_NOTHING( focus.setPropertyValue("GroupingWorkspace", "DiffractionFocussing2Test_inPlace_group") );
+    TS_ASSERT_THROWS_NOTHING( focus.execute() );
+    TS_ASSERT( focus.isExecuted() );
+
+    EventWorkspace_sptr outputEvent;
+    TS_ASSERT_THROWS_NOTHING( outputEvent = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(wsName) );
+    TS_ASSERT( outputEvent );
+    if (!outputEvent) return;
+    TS_ASSERT_EQUALS( outputEvent->getNumberHistograms(), 1 );
+    TS_ASSERT_EQUALS( outputEvent->getNumberEvents(), numFocussedEvents );
+    TS_ASSERT_EQUALS( outputEvent->getEventList(0).getDetectorIDs().size(), 16 );
+
+    // The focussed spectra of the input have been emptied; the rest are untouched
+    size_t numLeft(0);
+    for (size_t wi = firstFocussed; wi < numSpectra; wi++)
+    {
+      TS_ASSERT_EQUALS( inputW->getEventList(wi).getNumberEvents(), 0 );
+      TS_ASSERT( inputW->getEventList(wi).getDetectorIDs().empty() );
+    }
+    for (size_t wi = 0; wi < firstFocussed; wi++)
+      numLeft += inputW->getEventList(wi).getNumberEvents();
+    TS_ASSERT_EQUALS( numLeft, numOtherEvents );
+
+    AnalysisDataService::Instance().remove(wsName);
+    AnalysisDataService::Instance().remove("DiffractionFocussing2Test_inPlace_group");
+  }
+
   void dotestEventWorkspace(bool inplace, size_t numgroups, bool preserveEvents = true, int bankWidthInPixels=16 )
   {
     std::string nxsWSname("DiffractionFocussing2Test_ws");
@@ -378,6 +378,61 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Filter events by a splitter in a MatrixWorkspace.  Splitter i takes the events in
+    * (X[i], X[i+1]]; events before the first or after the last time are unfiltered.
+    * Events lie every tofdt from the run start (10 per pulse), some exactly on the splitter times.
+    */
+  void test_FilterByMatrixSplitterBoundaries()
+  {
+    int64_t runstart_i64 = 20000000000;
+    int64_t pulsedt = 100*1000*1000;
+    int64_t tofdt = 10*1000*1000;
+    size_t numpulses = 5;
+
+    DataObjects::EventWorkspace_sptr inpWS = createEventWorkspaceElastic(runstart_i64, pulsedt, tofdt, numpulses);
+    AnalysisDataService::Instance().addOrReplace("TestMatrixSplitterEvents", inpWS);
+
+    // Splitter times at events 0, 10, 25, 30 and 40 with groups 0, 1, -1 and 0
+    MatrixWorkspace_sptr splws = boost::dynamic_pointer_cast<MatrixWorkspace>(
+          WorkspaceFactory::Instance().create("Workspace2D", 1, 5, 4));
+    const int eventindexes[5] = {0, 10, 25, 30, 40};
+    const int groups[4] = {0, 1, -1, 0};
+    for (size_t i = 0; i < 5; ++i)
+      splws->dataX(0)[i] = static_cast<double>(runstart_i64 + eventindexes[i]*tofdt);
+    for (size_t i = 0; i < 4; ++i)
+      splws->dataY(0)[i] = groups[i];
+    AnalysisDataService::Instance().addOrReplace("TestMatrixSplitter", splws);
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "TestMatrixSplitterEvents");
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredMatrixWS");
+    filter.setProperty("SplitterWorkspace", "TestMatrixSplitter");
+
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+
+    // Group 0: events 1-10 and 31-40; group 1: 11-25; unfiltered: 0, 26-30 and 41-49
+    const std::string names[3] = {"FilteredMatrixWS_0", "FilteredMatrixWS_1", "FilteredMatrixWS_unfiltered"};
+    const size_t expected[3] = {20, 15, 15};
+    for (size_t i = 0; i < 3; ++i)
+    {
+      EventWorkspace_sptr outws = boost::dynamic_pointer_cast<EventWorkspace>(
+            AnalysisDataService::Instance().retrieve(names[i]));
+      TS_ASSERT(outws);
+      if (!outws) continue;
+      for (size_t iws = 0; iws < outws->getNumberHistograms(); ++iws)
+        TS_ASSERT_EQUALS(outws->getEventList(iws).getNumberEvents(), expected[i]);
+    }
+
+    AnalysisDataService::Instance().remove("TestMatrixSplitterEvents");
+    AnalysisDataService::Instance().remove("TestMatrixSplitter");
+    std::vector<std::string> outputwsnames = filter.getProperty("OutputWorkspaceNames");
+    for (size_t i = 0; i < outputwsnames.size(); ++i)
+      AnalysisDataService::Instance().remove(outputwsnames[i]);
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Test filtering with correction to indirect geometry inelastic instrument
     */
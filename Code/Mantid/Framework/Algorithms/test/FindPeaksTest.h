@@ -110,6 +110,58 @@ public:
     AnalysisDataService::Instance().remove("FoundedSinglePeakTable");
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Test fitting the same peak in many spectra, which are fitted in parallel
+    */
+  void test_findPeakInAllSpectra()
+  {
+    MatrixWorkspace_sptr singlews = getSinglePeakData();
+    const size_t numspec = 8;
+    MatrixWorkspace_sptr dataws = WorkspaceFactory::Instance().create(
+          singlews, numspec, singlews->readX(0).size(), singlews->readY(0).size());
+    for (size_t i = 0; i < numspec; ++i)
+    {
+      dataws->dataX(i) = singlews->readX(0);
+      dataws->dataY(i) = singlews->readY(0);
+      dataws->dataE(i) = singlews->readE(0);
+    }
+
+    FindPeaks finder;
+    finder.initialize();
+    finder.setChild(true);
+    finder.setProperty("InputWorkspace", dataws);
+    finder.setProperty("FWHM", 8);
+    finder.setPropertyValue("PeakPositions", "1.2356");
+    finder.setPropertyValue("FitWindows", "1.21, 1.50");
+    finder.setProperty("BackgroundType", "Quadratic");
+    finder.setProperty("RawPeakParameters", true);
+    finder.setProperty("StartFromObservedPeakCentre", false);
+    finder.setPropertyValue("PeaksList", "FoundPeaksAllSpectra");
+    TS_ASSERT_THROWS_NOTHING( finder.execute() );
+    TS_ASSERT( finder.isExecuted() );
+
+    ITableWorkspace_sptr peakstable = finder.getProperty("PeaksList");
+    TableWorkspace_sptr outtablews = boost::dynamic_pointer_cast<TableWorkspace>(peakstable);
+    TS_ASSERT(outtablews);
+    TS_ASSERT_EQUALS(outtablews->rowCount(), numspec);
+    if (outtablews->rowCount() != numspec)
+      return;
+
+    // One row per spectrum in spectrum order, all with the same result
+    map<string, double> firstparammap;
+    getParameterMap(outtablews, 0, firstparammap);
+    TS_ASSERT_DELTA(firstparammap["PeakCentre"], 1.2356, 0.03);
+    for (size_t i = 0; i < numspec; ++i)
+    {
+      TS_ASSERT_EQUALS(outtablews->cell<int>(i, 0), static_cast<int>(i));
+      map<string, double> parammap;
+      getParameterMap(outtablews, i, parammap);
+      TS_ASSERT_EQUALS(parammap["PeakCentre"], firstparammap["PeakCentre"]);
+      TS_ASSERT_EQUALS(parammap["Height"], firstparammap["Height"]);
+      TS_ASSERT_EQUALS(parammap["chi2"], firstparammap["chi2"]);
+    }
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Test find peaks automaticallyclear
     */
@@ -973,6 +973,97 @@ public:
 };
 
 
+class GenerateEventsFilterTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static GenerateEventsFilterTestPerformance *createSuite() { return new GenerateEventsFilterTestPerformance(); }
+  static void destroySuite( GenerateEventsFilterTestPerformance *suite ) { delete suite; }
+
+  void test_slowScanLog_1e4()
+  {
+    runFastLogFilter(10000);
+  }
+
+  void test_slowScanLog_1e5()
+  {
+    runFastLogFilter(100000);
+  }
+
+  void test_slowScanLog_1e6()
+  {
+    runFastLogFilter(1000000);
+  }
+
+  void test_slowScanLog_1e7()
+  {
+    runFastLogFilter(10000000);
+  }
+
+private:
+  //----------------------------------------------------------------------------------------------
+  /** Generate matrix splitters for a log of numentries entries, 1 ms apart,
+    * slowly scanning a sine wave, into 20 log value intervals
+    */
+  void runFastLogFilter(int64_t numentries)
+  {
+    DataObjects::EventWorkspace_sptr eventws =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(2, 2, true);
+
+    const int64_t runstart_ns = 3000000000;
+    const int64_t step_ns = 1000000;
+    const int64_t runstop_ns = runstart_ns + numentries * step_ns;
+    eventws->mutableRun().addProperty("run_start", DateAndTime(runstart_ns).toISO8601String());
+
+    Kernel::TimeSeriesProperty<double> *protonchargelog =
+        new Kernel::TimeSeriesProperty<double>("proton_charge");
+    protonchargelog->addValue(DateAndTime(runstart_ns), 1.0);
+    protonchargelog->addValue(DateAndTime(runstart_ns + step_ns), 1.0);
+    protonchargelog->addValue(DateAndTime(runstop_ns), 1.0);
+    eventws->mutableRun().addProperty(protonchargelog, true);
+
+    // One full scan every 10^4 entries
+    Kernel::TimeSeriesProperty<double> *scanlog = new Kernel::TimeSeriesProperty<double>("SlowScanLog");
+    std::vector<DateAndTime> times;
+    std::vector<double> values;
+    times.reserve(static_cast<size_t>(numentries));
+    values.reserve(static_cast<size_t>(numentries));
+    for (int64_t i = 0; i < numentries; ++i)
+    {
+      times.push_back(DateAndTime(runstart_ns + i * step_ns));
+      values.push_back(sin(2 * M_PI * static_cast<double>(i % 10000) / 10000.));
+    }
+    scanlog->addValues(times, values);
+    eventws->mutableRun().addProperty(scanlog, true);
+
+    GenerateEventsFilter alg;
+    alg.initialize();
+    alg.setChild(true);
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("InputWorkspace", eventws));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("OutputWorkspace", "PerfSplitters"));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("InformationWorkspace", "PerfInfo"));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("FastLog", true));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("LogName", "SlowScanLog"));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("MinimumLogValue", -1.0));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("MaximumLogValue", 1.0));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("LogValueInterval", 0.1));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("FilterLogValueByChangingDirection", "Both"));
+
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    MatrixWorkspace_sptr splittersws = alg.getProperty("OutputWorkspace");
+    TS_ASSERT(splittersws);
+    if (splittersws)
+    {
+      // 40 splitters per scan, each of them one interval of the log value
+      TS_ASSERT_LESS_THAN(static_cast<size_t>(numentries / 10000 * 20), splittersws->readY(0).size());
+    }
+  }
+};
+
+
 #endif /* MANTID_ALGORITHMS_GENERATEEVENTSFILTERTEST_H_ */
 
 
@@ -330,6 +330,8 @@ public:
         TS_ASSERT_DELTA(outX[j], input->readX(i)[j], 1e-12);
         TS_ASSERT_DELTA(outY[j], 6.0, 1e-12);
         TS_ASSERT_DELTA(outE[j], sqrt(6.0), 1e-5);
+        // The sum is built up in place, but never in an input
+        TS_ASSERT_DELTA(input->readY(i)[j], 2.0, 1e-12);
       }
     }
 
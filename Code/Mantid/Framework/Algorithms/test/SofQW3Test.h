@@ -4,11 +4,60 @@
 #include <cxxtest/TestSuite.h>
 #include "MantidAlgorithms/SofQW3.h"
 #include "MantidDataHandling/LoadNexusProcessed.h"
+#include "MantidGeometry/Math/LaszloIntersection.h"
+#include "MantidGeometry/Math/Quadrilateral.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Timer.h"
+
+#include <boost/math/special_functions/fpclassify.hpp>
 
 #include <iomanip>
+#include <iostream>
 
 using namespace Mantid::Algorithms;
 using namespace Mantid::API;
+using Mantid::Geometry::Quadrilateral;
+using Mantid::Kernel::V2D;
+
+namespace
+{
+  /// Gives access to the rebinning steps of SofQW3
+  class SofQW3Tester : public SofQW3
+  {
+  public:
+    using Rebin2D::GridSums;
+    using Rebin2D::rebinToOutput;
+    using Rebin2D::rebinToSums;
+  };
+
+  /// A direct geometry workspace with detectors spread over 5-135 degrees
+  MatrixWorkspace_sptr makeInelasticWS(const size_t numDetectors, const size_t numBins)
+  {
+    std::vector<double> L2(numDetectors, 4.0), polar(numDetectors), azimuthal(numDetectors);
+    for (size_t i = 0; i < numDetectors; ++i)
+    {
+      polar[i] = (5.0 + 130.0 * static_cast<double>(i) / static_cast<double>(numDetectors)) * M_PI / 180.0;
+      azimuthal[i] = 2.0 * M_PI * static_cast<double>(i % 16) / 16.0;
+    }
+    return WorkspaceCreationHelper::createProcessedInelasticWS(L2, polar, azimuthal, numBins, -10.0, 10.0, 11.0);
+  }
+
+  MatrixWorkspace_sptr runSofQW3(MatrixWorkspace_sptr inputWS, const std::string & qBinning)
+  {
+    SofQW3 sqw;
+    sqw.initialize();
+    sqw.setChild(true);
+    TS_ASSERT_THROWS_NOTHING( sqw.setProperty("InputWorkspace", inputWS) );
+    TS_ASSERT_THROWS_NOTHING( sqw.setPropertyValue("OutputWorkspace", "SofQW3Test_output") );
+    TS_ASSERT_THROWS_NOTHING( sqw.setPropertyValue("QAxisBinning", qBinning) );
+    TS_ASSERT_THROWS_NOTHING( sqw.setPropertyValue("EMode", "Direct") );
+    TS_ASSERT_THROWS_NOTHING( sqw.setPropertyValue("EFixed", "11.0") );
+    TS_ASSERT_THROWS_NOTHING( sqw.execute() );
+    TS_ASSERT( sqw.isExecuted() );
+    return sqw.getProperty("OutputWorkspace");
+  }
+}
 
 class SofQW3Test : public CxxTest::TestSuite
 {
@@ -21,6 +70,120 @@ public:
     TS_ASSERT( alg.isInitialized() )
   }
 
+  void test_exec_on_generated_workspace()
+  {
+    MatrixWorkspace_sptr result = runSofQW3(makeInelasticWS(100, 40), "0,0.25,5");
+    TS_ASSERT( result );
+    if (!result) return;
+    TS_ASSERT_EQUALS( result->getNumberHistograms(), 20 );
+    TS_ASSERT_EQUALS( result->blocksize(), 40 );
+
+    double total(0.0);
+    for (size_t i = 0; i < result->getNumberHistograms(); ++i)
+    {
+      const Mantid::MantidVec & Y = result->readY(i);
+      const Mantid::MantidVec & E = result->readE(i);
+      for (size_t j = 0; j < Y.size(); ++j)
+      {
+        if (boost::math::isnan(Y[j])) continue;
+        TS_ASSERT( boost::math::isfinite(E[j]) );
+        total += Y[j];
+      }
+    }
+    TS_ASSERT_LESS_THAN( 0.0, total );
+  }
+
+  void test_parallel_and_serial_runs_give_the_same_output()
+  {
+    MatrixWorkspace_sptr inputWS = makeInelasticWS(100, 40);
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(1);
+    MatrixWorkspace_sptr serial = runSofQW3(inputWS, "0,0.25,5");
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    MatrixWorkspace_sptr parallel = runSofQW3(inputWS, "0,0.25,5");
+    TS_ASSERT( serial && parallel );
+    if (!serial || !parallel) return;
+
+    for (size_t i = 0; i < serial->getNumberHistograms(); ++i)
+    {
+      for (size_t j = 0; j < serial->blocksize(); ++j)
+      {
+        const double expected = serial->readY(i)[j];
+        if (boost::math::isnan(expected))
+        {
+          TS_ASSERT( boost::math::isnan(parallel->readY(i)[j]) );
+          continue;
+        }
+        TS_ASSERT_DELTA( parallel->readY(i)[j], expected, 1e-10 );
+        TS_ASSERT_DELTA( parallel->readE(i)[j], serial->readE(i)[j], 1e-10 );
+      }
+    }
+  }
+
+  void test_analytic_overlaps_match_polygon_clipping()
+  {
+    // A 4x3 output grid of unit bins from (0,0) to (4,3)
+    const size_t numRows(3), numCols(4);
+    const double signal(3.0), error(1.5);
+    std::vector<double> verticalAxis(numRows + 1);
+    for (size_t i = 0; i <= numRows; ++i) verticalAxis[i] = static_cast<double>(i);
+    Mantid::MantidVec xAxis(numCols + 1);
+    for (size_t i = 0; i <= numCols; ++i) xAxis[i] = static_cast<double>(i);
+
+    // Input bins with vertical sides: inside one output bin, across several,
+    // with sloped tops and bottoms and partly outside the grid
+    std::vector<Quadrilateral> inputs;
+    inputs.push_back(Quadrilateral(V2D(0.2,0.2), V2D(0.8,0.2), V2D(0.8,0.7), V2D(0.2,0.7)));
+    inputs.push_back(Quadrilateral(V2D(0.5,0.5), V2D(2.5,0.5), V2D(2.5,1.5), V2D(0.5,1.5)));
+    inputs.push_back(Quadrilateral(V2D(0.3,0.2), V2D(2.7,1.1), V2D(2.7,2.6), V2D(0.3,0.9)));
+    inputs.push_back(Quadrilateral(V2D(3.5,-0.5), V2D(4.5,0.4), V2D(4.5,1.8), V2D(3.5,1.2)));
+    inputs.push_back(Quadrilateral(V2D(1.1,0.1), V2D(1.9,2.9), V2D(1.9,2.95), V2D(1.1,0.3)));
+
+    MatrixWorkspace_sptr inputWS = WorkspaceCreationHelper::Create2DWorkspaceBinned(1, 1);
+    inputWS->dataY(0)[0] = signal;
+    inputWS->dataE(0)[0] = error;
+
+    SofQW3Tester alg;
+    for (size_t n = 0; n < inputs.size(); ++n)
+    {
+      const Quadrilateral & inputQ = inputs[n];
+      SofQW3Tester::GridSums sums(numRows, numCols);
+      alg.rebinToSums(inputQ, signal, error, false, xAxis, verticalAxis, sums);
+
+      // The same bin rebinned by clipping, straight into a workspace
+      MatrixWorkspace_sptr clipped = makeZeroedGrid(numRows, numCols);
+      alg.rebinToOutput(inputQ, inputWS, 0, 0, clipped, verticalAxis);
+
+      // The analytic sums added straight into a workspace
+      MatrixWorkspace_sptr direct = makeZeroedGrid(numRows, numCols);
+      SofQW3Tester::GridSums directSums(direct);
+      TS_ASSERT( directSums.isDirect() );
+      alg.rebinToSums(inputQ, signal, error, false, xAxis, verticalAxis, directSums);
+
+      for (size_t qi = 0; qi < numRows; ++qi)
+      {
+        for (size_t ei = 0; ei < numCols; ++ei)
+        {
+          const size_t index = qi * numCols + ei;
+          double expectedFraction(0.0);
+          try
+          {
+            const Quadrilateral outputQ(xAxis[ei], xAxis[ei + 1], verticalAxis[qi], verticalAxis[qi + 1]);
+            expectedFraction = intersectionByLaszlo(outputQ, inputQ).area() / inputQ.area();
+          }
+          catch (Mantid::Geometry::NoIntersectionException &)
+          {
+          }
+          TS_ASSERT_DELTA( sums.fraction[index], expectedFraction, 1e-10 );
+          TS_ASSERT_DELTA( sums.signal[index], clipped->readY(qi)[ei], 1e-10 );
+          TS_ASSERT_DELTA( sums.errorSq[index], clipped->readE(qi)[ei], 1e-10 );
+          TS_ASSERT_EQUALS( direct->readY(qi)[ei], sums.signal[index] );
+          TS_ASSERT_EQUALS( direct->readE(qi)[ei], sums.errorSq[index] );
+        }
+      }
+    }
+  }
+
 
   void xtest_exec()
   {
@@ -87,6 +250,45 @@ public:
     AnalysisDataService::Instance().remove(inputWS);
     AnalysisDataService::Instance().remove(outputWS);    
   }
+
+private:
+  /// A workspace of unit bins from (0,0) with zero signal and errors
+  MatrixWorkspace_sptr makeZeroedGrid(const size_t numRows, const size_t numCols)
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceBinned(
+        static_cast<int>(numRows), static_cast<int>(numCols));
+    for (size_t i = 0; i < numRows; ++i)
+    {
+      ws->dataY(i).assign(numCols, 0.0);
+      ws->dataE(i).assign(numCols, 0.0);
+    }
+    return ws;
+  }
+};
+
+
+class SofQW3TestPerformance : public CxxTest::TestSuite
+{
+public:
+  static SofQW3TestPerformance *createSuite() { return new SofQW3TestPerformance(); }
+  static void destroySuite(SofQW3TestPerformance *suite) { delete suite; }
+
+  SofQW3TestPerformance()
+  {
+    // Roughly the number of MERLIN pixels
+    m_inputWS = makeInelasticWS(69632, 200);
+  }
+
+  void test_exec_MERLIN_sized()
+  {
+    Mantid::Kernel::Timer timer;
+    runSofQW3(m_inputWS, "0,0.05,10");
+    std::cout << "\nSofQW3 on " << m_inputWS->getNumberHistograms()
+              << " spectra took " << timer.elapsed() << " s\n";
+  }
+
+private:
+  MatrixWorkspace_sptr m_inputWS;
 };
 
 
@@ -411,6 +411,55 @@ public:
     AnalysisDataService::Instance().remove(outName);
   }
 
+  void testExecManySpectraMatchesSerialSum()
+  {
+    const size_t nHist(1000), nBins(20);
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspace(static_cast<int>(nHist), static_cast<int>(nBins));
+    for (size_t i = 0; i < nHist; ++i)
+    {
+      for (size_t k = 0; k < nBins; ++k)
+      {
+        ws->dataY(i)[k] = 0.1 * static_cast<double>(i) + static_cast<double>(k);
+        ws->dataE(i)[k] = 1.0 + 0.001 * static_cast<double>(i);
+      }
+    }
+
+    for (int weighted = 0; weighted < 2; ++weighted)
+    {
+      Mantid::Algorithms::SumSpectra sum;
+      sum.initialize();
+      sum.setChild(true);
+      sum.setProperty("InputWorkspace", ws);
+      sum.setPropertyValue("OutputWorkspace", "SumSpectraTest_many");
+      sum.setProperty("WeightedSum", weighted == 1);
+      TS_ASSERT_THROWS_NOTHING( sum.execute() );
+      TS_ASSERT( sum.isExecuted() );
+      MatrixWorkspace_sptr output = sum.getProperty("OutputWorkspace");
+      TS_ASSERT_EQUALS( output->getNumberHistograms(), 1 );
+
+      for (size_t k = 0; k < nBins; ++k)
+      {
+        double ySum(0.0), eSqSum(0.0), weightSum(0.0);
+        for (size_t i = 0; i < nHist; ++i)
+        {
+          const double eSq = ws->readE(i)[k] * ws->readE(i)[k];
+          eSqSum += eSq;
+          if (weighted == 1)
+          {
+            ySum += ws->readY(i)[k] / eSq;
+            weightSum += 1.0 / eSq;
+          }
+          else
+            ySum += ws->readY(i)[k];
+        }
+        if (weighted == 1)
+          ySum *= static_cast<double>(nHist) / weightSum;
+        TS_ASSERT_DELTA( output->readY(0)[k], ySum, 1e-9 * ySum );
+        TS_ASSERT_DELTA( output->readE(0)[k], std::sqrt(eSqSum), 1e-9 );
+      }
+    }
+  }
+
 
 private:
   int nTestHist;
@@ -38,6 +38,9 @@ public:
   /// Algorithm's category for identification
   virtual const std::string category() const { return "Crystal"; }
 
+  /// Release the reflections kept for later runs of the same crystal
+  static void clearReflectionCache();
+
 private:
   /// Initialise the properties
   void init();
@@ -5,6 +5,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/functional/hash.hpp>
 #include <algorithm>
+#include <map>
 #include <set>
 #include <list>
 
@@ -27,8 +28,8 @@ public:
   /// Clusters that do not need merging
   ClusterRegister::MapCluster m_unique;
 
-  /// Type for identifying label groups
-  typedef std::list<std::set<size_t>> GroupType;
+  /// Type for the union-find forest of merged labels, child label -> parent
+  typedef std::map<size_t, size_t> GroupType;
 
   /// Groups of labels to maintain
   GroupType m_groups;
@@ -43,58 +44,46 @@ public:
   boost::hash<std::pair<int, int>> m_labelHasher;
 
   /**
-   * Inserts a pair of disjoint elements. Determines whether they can be used to
-   * reorder existing sets of lables.
+   * Find the representative label of the group containing a label, adding
+   * the label as a group of its own if it is not known yet. Compresses the
+   * path from the label to the representative.
+   * @param label : Label to look up
+   * @return : Representative label of the group.
+   */
+  size_t findGroup(size_t label) {
+    GroupType::iterator it = m_groups.find(label);
+    if (it == m_groups.end()) {
+      m_groups.insert(std::make_pair(label, label));
+      return label;
+    }
+    size_t root = label;
+    while (m_groups[root] != root) {
+      root = m_groups[root];
+    }
+    while (label != root) {
+      size_t &parent = m_groups[label];
+      label = parent;
+      parent = root;
+    }
+    return root;
+  }
+
+  /**
+   * Inserts a pair of disjoint elements. The groups containing the labels of
+   * each are joined.
    * @param a : One part of pair
    * @param b : Other part of pair
-   * @return : true if a new cluster was required for the insertion.
+   * @return : true if the two labels were not already in the same group.
    */
   bool insert(const DisjointElement &a, const DisjointElement &b) {
-    const size_t &aLabel = a.getRoot();
-    const size_t &bLabel = b.getRoot();
-    bool newItem = true;
-
-    GroupType containingAny;
-    GroupType containingNone;
-    // ------------- Find equivalent sets
-    for (GroupType::iterator i = m_groups.begin(); i != m_groups.end(); ++i) {
-      GroupType::value_type &cluster = *i;
-      if (cluster.find(aLabel) != cluster.end()) {
-        containingAny.push_back(cluster);
-      } else if (cluster.find(bLabel) != cluster.end()) {
-        containingAny.push_back(cluster);
-      } else {
-        containingNone.push_back(cluster); // Current iterated set contains
-                                           // NEITHER of these labels. It can
-                                           // therfore be ignored.
-      }
-    }
-    // ------------ Process equivalent sets
-    if (containingAny.empty()) {
-      // Neither label is yet known to any set. We must add a new set for these
-      GroupType::value_type newSet;
-      newSet.insert(aLabel);
-      newSet.insert(bLabel);
-      m_groups.push_back(newSet);
-    } else {
-      // At least one set already contains at least one label. We merge all such
-      // sets into a master set.
-
-      // implement copy and swap. Rebuild the sets.
-      GroupType temp = containingNone;
-      GroupType::value_type masterSet;
-      masterSet.insert(aLabel); // Incase it doesn't already contain a
-      masterSet.insert(bLabel); // Incase it doesn't already contain b
-      for (auto i = containingAny.begin(); i != containingAny.end(); ++i) {
-        GroupType::value_type &childSet = *i;
-        masterSet.insert(childSet.begin(),
-                         childSet.end()); // Build the master set.
-      }
-      temp.push_back(masterSet);
-      m_groups = temp; // Swap.
-      newItem = false;
+    const size_t aGroup = findGroup(a.getRoot());
+    const size_t bGroup = findGroup(b.getRoot());
+    if (aGroup == bGroup) {
+      return false;
     }
-    return newItem;
+    // The lower label represents the group
+    m_groups[std::max(aGroup, bGroup)] = std::min(aGroup, bGroup);
+    return true;
   }
 
   /**
@@ -102,9 +91,14 @@ public:
    * @return Merged composite clusters.
    */
   std::list<boost::shared_ptr<CompositeCluster>> makeCompositeClusters() {
-    std::list<boost::shared_ptr<CompositeCluster>> composites;
+    std::map<size_t, std::set<size_t>> labelSets;
     for (auto i = m_groups.begin(); i != m_groups.end(); ++i) {
-      GroupType::value_type &labelSet = *i;
+      labelSets[findGroup(i->first)].insert(i->first);
+    }
+
+    std::list<boost::shared_ptr<CompositeCluster>> composites;
+    for (auto i = labelSets.begin(); i != labelSets.end(); ++i) {
+      const std::set<size_t> &labelSet = i->second;
       auto composite = boost::make_shared<CompositeCluster>();
       for (auto j = labelSet.begin(); j != labelSet.end(); ++j) {
         boost::shared_ptr<ICluster> &cluster = m_register[(*j)];
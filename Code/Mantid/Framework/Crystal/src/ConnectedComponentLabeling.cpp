@@ -304,6 +304,7 @@ ClusterMap ConnectedComponentLabeling::calculateDisjointTree(
   const int nThreadsToUse = getNThreads();
 
   if (nThreadsToUse > 1) {
+    // Each iterator covers one slab of contiguous linear indexes
     std::vector<API::IMDIterator *> iterators =
         ws->createIterators(nThreadsToUse);
 
@@ -316,8 +317,10 @@ ClusterMap ConnectedComponentLabeling::calculateDisjointTree(
         parallelClusterMapVec(nThreadsToUse);
 
     // ------------- Stage One. Local CCL in parallel.
+    // Neighbours outside a slab are only recorded as edges, so each thread
+    // only ever reads and links the DisjointElements of its own slab.
     g_log.debug("Parallel solve local CCL");
-    // PARALLEL_FOR_NO_WSP_CHECK()
+    PARALLEL_FOR_NO_WSP_CHECK()
     for (int i = 0; i < nThreadsToUse; ++i) {
       API::IMDIterator *iterator = iterators[i];
       boost::scoped_ptr<BackgroundStrategy> strategy(
@@ -345,7 +348,7 @@ ClusterMap ConnectedComponentLabeling::calculateDisjointTree(
       // back over iterator.
       iterator->jumpTo(0); // Reset
       do {
-        if (!baseStrategy->isBackground(iterator)) {
+        if (!strategy->isBackground(iterator)) {
           // Second pass smoothing step
           const size_t currentIndex = iterator->getLinearIndex();
 
@@ -354,6 +357,7 @@ ClusterMap ConnectedComponentLabeling::calculateDisjointTree(
           localClusterMap[labelAtIndex]->addIndex(currentIndex);
         }
       } while (iterator->next());
+      delete iterator;
     }
 
     // -------------------- Stage 2 --- Preparation stage for combining
@@ -382,7 +386,9 @@ ClusterMap ConnectedComponentLabeling::calculateDisjointTree(
     clusterMap = clusterRegister.clusters(neighbourElements);
 
   } else {
-    API::IMDIterator *iterator = ws->createIterator(NULL);
+    boost::scoped_ptr<API::IMDIterator> iteratorHolder(
+        ws->createIterator(NULL));
+    API::IMDIterator *iterator = iteratorHolder.get();
     VecEdgeIndexPair edgeIndexPair; // This should never get filled in a single
                                     // threaded situation.
     size_t endLabelId = doConnectedComponentLabeling(
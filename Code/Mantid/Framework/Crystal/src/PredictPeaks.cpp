@@ -11,9 +11,13 @@
 #include "MantidKernel/ListValidator.h"
 #include "MantidAPI/WorkspaceValidators.h"
 #include "MantidGeometry/Crystal/ReflectionCondition.h"
+#include "MantidGeometry/Crystal/ReflectionGenerator.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 
+#include <Poco/Mutex.h>
+#include <boost/make_shared.hpp>
+
 using Mantid::Kernel::EnabledWhenProperty;
 
 namespace Mantid {
@@ -27,6 +31,48 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
 
+namespace {
+/// Reflections of the last crystal predicted, reused for later runs of the
+/// same crystal at other goniometer settings.
+boost::shared_ptr<const ReflectionGenerator> g_lastReflections;
+/// Guards g_lastReflections
+Poco::FastMutex g_lastReflectionsMutex;
+/// Largest list of reflections kept after a run (~50MB)
+const size_t maxCachedReflections = 2000000;
+
+/** Returns the allowed reflections of a cell in a d-range, generating them
+ * only if the previous call was for a different cell, centering or range.
+ * Lists of more than maxCachedReflections are not kept for later calls.
+ * @param cell :: unit cell of the crystal
+ * @param centering :: reflection condition of the lattice centering
+ * @param dMin :: smallest d-spacing
+ * @param dMax :: largest d-spacing
+ * @return the reflections
+ */
+boost::shared_ptr<const ReflectionGenerator>
+getReflections(const UnitCell &cell, const ReflectionCondition_sptr &centering,
+               const double dMin, const double dMax) {
+  Poco::FastMutex::ScopedLock lock(g_lastReflectionsMutex);
+  if (g_lastReflections) {
+    const UnitCell &last = g_lastReflections->getCell();
+    if (g_lastReflections->getDMin() == dMin &&
+        g_lastReflections->getDMax() == dMax &&
+        g_lastReflections->getCenteringName() == centering->getName() &&
+        last.a() == cell.a() && last.b() == cell.b() && last.c() == cell.c() &&
+        last.alpha() == cell.alpha() && last.beta() == cell.beta() &&
+        last.gamma() == cell.gamma())
+      return g_lastReflections;
+  }
+  // Release the old list before generating the new one
+  g_lastReflections.reset();
+  boost::shared_ptr<const ReflectionGenerator> reflections =
+      boost::make_shared<ReflectionGenerator>(cell, centering, dMin, dMax);
+  if (reflections->getHKLs().size() <= maxCachedReflections)
+    g_lastReflections = reflections;
+  return reflections;
+}
+}
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -37,6 +83,15 @@ PredictPeaks::PredictPeaks() { m_refConds = getAllReflectionConditions(); }
  */
 PredictPeaks::~PredictPeaks() {}
 
+//----------------------------------------------------------------------------------------------
+/** Release the reflections kept for later runs of the same crystal. The next
+ * run generates them again.
+ */
+void PredictPeaks::clearReflectionCache() {
+  Poco::FastMutex::ScopedLock lock(g_lastReflectionsMutex);
+  g_lastReflections.reset();
+}
+
 //----------------------------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------------------------
@@ -293,58 +348,29 @@ void PredictPeaks::exec() {
   } else {
     // ---------------- Determine which HKL to look for
     // -------------------------------------
-    // Inverse d-spacing that is the limit to look for.
-    double Qmax = 2. * M_PI / minD;
-    V3D hklMin(0, 0, 0);
-    V3D hklMax(0, 0, 0);
-    for (double qx = -1; qx < 2; qx += 2)
-      for (double qy = -1; qy < 2; qy += 2)
-        for (double qz = -1; qz < 2; qz += 2) {
-          // Build a q-vector for this corner of a cube
-          V3D Q(qx, qy, qz);
-          Q *= Qmax;
-          V3D hkl = crystal.hklFromQ(Q);
-          // Find the limits of each hkl
-          for (size_t i = 0; i < 3; i++) {
-            if (hkl[i] < hklMin[i])
-              hklMin[i] = hkl[i];
-            if (hkl[i] > hklMax[i])
-              hklMax[i] = hkl[i];
-          }
-        }
-    // Round to nearest int
-    hklMin.round();
-    hklMax.round();
-
-    // How many HKLs is that total?
-    V3D hklDiff = hklMax - hklMin + V3D(1, 1, 1);
-    size_t numHKLs = size_t(hklDiff[0] * hklDiff[1] * hklDiff[2]);
-
-    g_log.information() << "HKL range for d_min of " << minD << "to d_max of "
-                        << maxD << " is from " << hklMin << " to " << hklMax
-                        << ", a total of " << numHKLs << " possible HKL's\n";
-
-    if (numHKLs > 10000000000)
+    // The number of reflections is roughly the volume of the sphere of radius
+    // 1/d_min divided by the volume of the reciprocal cell.
+    double estimate =
+        4.0 * M_PI * crystal.volume() / (3.0 * minD * minD * minD);
+    g_log.information() << "Roughly " << size_t(estimate)
+                        << " possible HKL's for d_min of " << minD
+                        << " to d_max of " << maxD << "\n";
+
+    if (estimate > 1e10)
       throw std::invalid_argument("More than 10 billion HKLs to search. Is "
                                   "your d_min value too small?");
 
-    Progress prog(this, 0.0, 1.0, numHKLs);
+    boost::shared_ptr<const ReflectionGenerator> reflections =
+        getReflections(crystal, refCond, minD, maxD);
+    const std::vector<V3D> &hkls = reflections->getHKLs();
+
+    Progress prog(this, 0.0, 1.0, hkls.size());
     prog.setNotifyStep(0.01);
 
-    //      PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int h = (int)hklMin[0]; h <= (int)hklMax[0]; h++) {
-      PARALLEL_START_INTERUPT_REGION
-      for (int k = (int)hklMin[1]; k <= (int)hklMax[1]; k++) {
-        for (int l = (int)hklMin[2]; l <= (int)hklMax[2]; l++) {
-          if (refCond->isAllowed(h, k, l) && (abs(h) + abs(k) + abs(l) != 0)) {
-            doHKL(double(h), double(k), double(l), true);
-          } // refl is allowed and not 0,0,0
-          prog.report();
-        } // for each l
-      }   // for each k
-      PARALLEL_END_INTERUPT_REGION
-    } // for each h
-    PARALLEL_CHECK_INTERUPT_REGION
+    for (size_t i = 0; i < hkls.size(); ++i) {
+      doHKL(hkls[i][0], hkls[i][1], hkls[i][2], true);
+      prog.report();
+    }
 
   } // Find the HKL automatically
 
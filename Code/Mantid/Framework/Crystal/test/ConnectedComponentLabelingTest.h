@@ -609,6 +609,27 @@ public:
     TS_ASSERT(does_set_contain(uniqueEntries, size_t(1)));
   }
 
+  void testPerformance_3d_clusters_across_slabs()
+  {
+    // 100 by 100 by 100 grid. Background planes at every tenth x index cut it
+    // into ten clusters, each spanning every slab of the linear index.
+    IMDHistoWorkspace_sptr inWS = MDEventsTestHelper::makeFakeMDHistoWorkspace(1, 3, 100);
+    for (size_t i = 0; i < inWS->getNPoints(); ++i)
+    {
+      if ((i % 100) % 10 == 0)
+      {
+        inWS->setSignalAt(i, m_backgroundSignal);
+      }
+    }
+
+    ConnectedComponentLabeling ccl;
+    Progress prog;
+    auto outWS = ccl.execute(inWS, m_backgroundStrategy.get(), prog);
+
+    std::set<size_t> uniqueEntries = connection_workspace_to_set_of_labels(outWS.get());
+    TSM_ASSERT_EQUALS("Should be ten clusters and background", 11, uniqueEntries.size());
+  }
+
 };
 
 #endif /* MANTID_CRYSTAL_CONNECTEDCOMPONENTLABELINGTEST_H_ */
@@ -99,6 +99,13 @@ public:
     do_test_exec("Primitive", 10, std::vector<V3D>() );
   }
 
+  void test_exec_after_clearing_the_reflection_cache()
+  {
+    do_test_exec("Primitive", 10, std::vector<V3D>() );
+    PredictPeaks::clearReflectionCache();
+    do_test_exec("Primitive", 10, std::vector<V3D>() );
+  }
+
   /** Fewer HKLs if they are not allowed */
   void test_exec_withReflectionCondition()
   {
@@ -67,6 +67,16 @@ public:
   virtual double valDerivHessian(bool evalFunction = true,
                                  bool evalDeriv = true,
                                  bool evalHessian = true) const;
+  double calcVal(API::FunctionDomain_sptr domain,
+                 API::FunctionValues_sptr values) const;
+  void calcValDerivHessian(API::IFunction_sptr function,
+                           API::FunctionDomain_sptr domain,
+                           API::FunctionValues_sptr values, bool evalFunction,
+                           bool evalDeriv, bool evalHessian, double &value,
+                           GSLVector &der, GSLMatrix &hessian) const;
+  void addToValDerivHessian(double value, const GSLVector &der,
+                            const GSLMatrix &hessian, bool evalFunction,
+                            bool evalHessian) const;
   const GSLVector &getDeriv() const;
   const GSLMatrix &getHessian() const;
   void push();
@@ -6,6 +6,9 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/IFunction.h"
+#include "MantidAPI/ITableWorkspace.h"
+
+#include <Poco/ActiveMethod.h>
 
 namespace Mantid {
 namespace CurveFitting {
@@ -57,6 +60,8 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
   /** Structure to identify data for fitting
     */
   struct InputData {
+    /// Default constructor
+    InputData() : i(-1), spec(-1), period(1), start(0), end(0) {}
     /// Constructor
     InputData(const std::string &nam, int ix, int s, int p, double st = 0,
               double en = 0)
@@ -79,7 +84,9 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
 
 public:
   /// Default constructor
-  PlotPeakByLogValue() : API::Algorithm(){};
+  PlotPeakByLogValue()
+      : API::Algorithm(),
+        m_getWorkspaceAsync(this, &PlotPeakByLogValue::getWorkspace){};
   /// Destructor
   virtual ~PlotPeakByLogValue(){};
   /// Algorithm's name for identification overriding a virtual method
@@ -107,6 +114,28 @@ private:
 
   /// Create a list of input workspace names
   std::vector<InputData> makeNames() const;
+  /// Fit all the spectra independently on all threads
+  void fitIndividualInParallel(const std::vector<InputData> &wsNames,
+                               API::IFunction_sptr ifun,
+                               const std::vector<double> &initialParams,
+                               API::ITableWorkspace_sptr result,
+                               std::vector<std::string> &wsBaseNames);
+  /// Fit one spectrum
+  API::IAlgorithm_sptr runFit(API::IFunction_sptr fun, const InputData &data,
+                              int wsIndex, const std::string &wsBaseName);
+  /// Check that an input has spectra to fit
+  bool hasSpectraToFit(const InputData &data, const std::string &name) const;
+  /// Get the range of workspace indices to fit
+  void getSpectrumRange(const InputData &data, int &j, int &jend) const;
+  /// Get the value to plot the parameters of a spectrum against
+  double getLogValue(const InputData &data, int wsIndex,
+                     const std::string &logName) const;
+  /// Make the base name of the output workspaces of a fit
+  std::string makeBaseName(const std::string &name, int wsIndex) const;
+
+  /// Gets a workspace on a background thread
+  Poco::ActiveMethod<InputData, InputData, PlotPeakByLogValue>
+      m_getWorkspaceAsync;
 };
 
 } // namespace CurveFitting
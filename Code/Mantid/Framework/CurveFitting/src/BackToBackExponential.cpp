@@ -81,14 +81,6 @@ void BackToBackExponential::setFwhm(const double w) {
 
 void BackToBackExponential::function1D(double *out, const double *xValues,
                                        const size_t nData) const {
-  /*
-    const double& I = getParameter("I");
-    const double& a = getParameter("A");
-    const double& b = getParameter("B");
-    const double& x0 = getParameter("X0");
-    const double& s = getParameter("S");
-  */
-
   const double I = getParameter(0);
   const double a = getParameter(1);
   const double b = getParameter(2);
@@ -101,35 +93,87 @@ void BackToBackExponential::function1D(double *out, const double *xValues,
     extent = s;
   extent *= 100;
 
-  double s2 = s * s;
+  const double s2 = s * s;
+  const double invSqrt2s = 1.0 / sqrt(2 * s2);
   double normFactor = a * b / (a + b) / 2;
   // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
   if (normFactor == 0.0)
     normFactor = 1.0;
+  const double scale = I * normFactor;
   for (size_t i = 0; i < nData; i++) {
     double diff = xValues[i] - x0;
     if (fabs(diff) < extent) {
       double val = 0.0;
       double arg1 = a / 2 * (a * s2 + 2 * diff);
-      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) /
-                                        sqrt(2 * s2))); // prevent overflow
+      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) *
+                                        invSqrt2s)); // prevent overflow
       double arg2 = b / 2 * (b * s2 - 2 * diff);
-      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) /
-                                        sqrt(2 * s2))); // prevent overflow
-      out[i] = I * val * normFactor;
+      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) *
+                                        invSqrt2s)); // prevent overflow
+      out[i] = scale * val;
     } else
       out[i] = 0.0;
   }
 }
 
 /**
- * Evaluate function derivatives numerically.
+ * Evaluate the analytic derivatives. Each of the two exponential terms and
+ * the gaussian they share are computed once per point and reused for all
+ * five parameters.
  */
 void BackToBackExponential::functionDeriv1D(Jacobian *jacobian,
                                             const double *xValues,
                                             const size_t nData) {
-  FunctionDomain1DView domain(xValues, nData);
-  this->calNumericalDeriv(domain, *jacobian);
+  const double I = getParameter(0);
+  const double a = getParameter(1);
+  const double b = getParameter(2);
+  const double x0 = getParameter(3);
+  const double s = getParameter(4);
+
+  double extent = expWidth();
+  if (s > extent)
+    extent = s;
+  extent *= 100;
+
+  const double s2 = s * s;
+  const double invSqrt2s = 1.0 / sqrt(2 * s2);
+  // sqrt(2/pi) comes from the derivative of erfc
+  const double gaussFactor = M_SQRT2 / sqrt(M_PI);
+  double normFactor = a * b / (a + b) / 2;
+  // logarithmic derivatives of the normalisation factor by A and B
+  double dLogNormA = b / (a * (a + b));
+  double dLogNormB = a / (b * (a + b));
+  if (normFactor == 0.0) {
+    normFactor = 1.0;
+    dLogNormA = 0.0;
+    dLogNormB = 0.0;
+  }
+  const double scale = I * normFactor;
+
+  for (size_t i = 0; i < nData; i++) {
+    double diff = xValues[i] - x0;
+    if (fabs(diff) >= extent) {
+      for (size_t j = 0; j < 5; ++j)
+        jacobian->set(i, j, 0.0);
+      continue;
+    }
+    const double e1 = exp(a / 2 * (a * s2 + 2 * diff) +
+                          gsl_sf_log_erfc((a * s2 + diff) * invSqrt2s));
+    const double e2 = exp(b / 2 * (b * s2 - 2 * diff) +
+                          gsl_sf_log_erfc((b * s2 - diff) * invSqrt2s));
+    // Both exponentials times the gaussian part of their erfc derivatives
+    // reduce to the same gaussian
+    const double g = gaussFactor * exp(-diff * diff / (2 * s2));
+    const double sum = e1 + e2;
+
+    jacobian->set(i, 0, normFactor * sum);
+    jacobian->set(i, 1,
+                  scale * (dLogNormA * sum + e1 * (a * s2 + diff) - g * s));
+    jacobian->set(i, 2,
+                  scale * (dLogNormB * sum + e2 * (b * s2 - diff) - g * s));
+    jacobian->set(i, 3, -scale * (a * e1 - b * e2));
+    jacobian->set(i, 4, scale * (s * (a * a * e1 + b * b * e2) - g * (a + b)));
+  }
 }
 
 /**
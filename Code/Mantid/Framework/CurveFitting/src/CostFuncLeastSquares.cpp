@@ -17,6 +17,8 @@ namespace CurveFitting {
 namespace {
 /// static logger
 Kernel::Logger g_log("CostFuncLeastSquares");
+/// Minimum number of products in a sum loop worth sharing between threads
+const size_t minParallelWork = 100000;
 }
 
 DECLARE_COSTFUNCTION(CostFuncLeastSquares, Least squares)
@@ -74,6 +76,23 @@ double CostFuncLeastSquares::val() const {
  */
 void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain,
                                   API::FunctionValues_sptr values) const {
+  const double retVal = calcVal(domain, values);
+
+  PARALLEL_ATOMIC
+  m_value += retVal;
+
+  return;
+}
+
+/**
+ * Calculate the contribution to the cost function value from the fitting
+ * function evaluated on a particular domain.
+ * @param domain :: A domain
+ * @param values :: Values
+ * @return :: The contribution
+ */
+double CostFuncLeastSquares::calcVal(API::FunctionDomain_sptr domain,
+                                     API::FunctionValues_sptr values) const {
   m_function->function(*domain, *values);
   size_t ny = values->size();
 
@@ -89,10 +108,7 @@ void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain,
     retVal += val * val;
   }
 
-  PARALLEL_ATOMIC
-  m_value += m_factor * retVal;
-
-  return;
+  return m_factor * retVal;
 }
 
 /** Calculate the derivatives of the cost function
@@ -135,7 +151,8 @@ double CostFuncLeastSquares::valAndDeriv(std::vector<double> &der) const {
  */
 double CostFuncLeastSquares::valDerivHessian(bool evalFunction, bool evalDeriv,
                                              bool evalHessian) const {
-  if (m_pushed || !evalDeriv) {
+  // With no active parameters there are no derivatives to calculate
+  if (m_pushed || !evalDeriv || nParams() == 0) {
     return val();
   }
 
@@ -238,6 +255,37 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
                                               API::FunctionValues_sptr values,
                                               bool evalFunction, bool evalDeriv,
                                               bool evalHessian) const {
+  double value = 0.0;
+  GSLVector der;
+  GSLMatrix hessian;
+  calcValDerivHessian(function, domain, values, evalFunction, evalDeriv,
+                      evalHessian, value, der, hessian);
+  addToValDerivHessian(value, der, hessian, evalFunction, evalHessian);
+}
+
+/**
+ * Calculate the contributions to the cost function, derivatives and hessian
+ * from a domain without adding them to the totals.
+ *
+ * The sums over the data points are done in a fixed order, one derivative or
+ * hessian element per thread, so the results do not depend on the number of
+ * threads.
+ * @param function :: Function to use to calculate the value and the derivatives
+ * @param domain :: The domain.
+ * @param values :: The fit function values
+ * @param evalFunction :: Flag to evaluate the function
+ * @param evalDeriv :: Flag to evaluate the derivatives
+ * @param evalHessian :: Flag to evaluate the Hessian
+ * @param value :: Output contribution to the value. Set if evalFunction is
+ * true.
+ * @param der :: Output contribution to the derivatives
+ * @param hessian :: Output contribution to the hessian. Set if evalHessian is
+ * true.
+ */
+void CostFuncLeastSquares::calcValDerivHessian(
+    API::IFunction_sptr function, API::FunctionDomain_sptr domain,
+    API::FunctionValues_sptr values, bool evalFunction, bool evalDeriv,
+    bool evalHessian, double &value, GSLVector &der, GSLMatrix &hessian) const {
   UNUSED_ARG(evalDeriv);
   size_t np = function->nParams(); // number of parameters
   size_t ny = domain->size();      // number of data points
@@ -247,8 +295,6 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   }
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
-  double fVal = 0.0;
   if (g_log.is(Kernel::Logger::Priority::PRIO_DEBUG)) {
     g_log.debug() << "Jacobian:\n";
     for (size_t i = 0; i < ny; ++i) {
@@ -263,66 +309,114 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
 
   std::vector<double> weights = getFitWeights(values);
 
+  // Indices of the active parameters
+  std::vector<size_t> active;
+  active.reserve(np);
   for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
-    double d = 0.0;
+    if (function->isActive(ip))
+      active.push_back(ip);
+  }
+  const size_t na = active.size();
+  // Nothing to fit: leave der and hessian empty
+  if (na == 0) {
+    return;
+  }
+
+  std::vector<double> residuals(ny);
+  double fVal = 0.0;
+  for (size_t i = 0; i < ny; ++i) {
+    double calc = values->getCalculated(i);
+    double obs = values->getFitData(i);
+    double y = (calc - obs) * weights[i];
+    residuals[i] = y;
+    fVal += y * y;
+  }
+  if (evalFunction) {
+    value = 0.5 * fVal;
+  }
+
+  // Copy the columns of the active parameters out of the jacobian so that the
+  // sums below run over contiguous memory
+  std::vector<double> columns(na * ny);
+  PARALLEL_FOR_IF(na * ny >= minParallelWork)
+  for (int ia = 0; ia < static_cast<int>(na); ++ia) {
+    double *column = &columns[0] + static_cast<size_t>(ia) * ny;
+    const size_t ip = active[ia];
     for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0 && evalFunction) {
-        fVal += y * y;
-      }
-    }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
+      column[i] = jacobian.get(i, ip);
     }
-    // std::cerr << "der " << ip << ' ' << der[iActiveP] << std::endl;
-    ++iActiveP;
   }
 
-  if (evalFunction) {
-    PARALLEL_ATOMIC
-    m_value += 0.5 * fVal;
+  der.resize(na);
+  PARALLEL_FOR_IF(na * ny >= minParallelWork)
+  for (int ia = 0; ia < static_cast<int>(na); ++ia) {
+    const double *column = &columns[0] + static_cast<size_t>(ia) * ny;
+    double d = 0.0;
+    for (size_t i = 0; i < ny; ++i) {
+      d += residuals[i] * column[i] * weights[i];
+    }
+    der.set(ia, d);
   }
 
   if (!evalHessian)
     return;
 
-  // size_t na = m_der.size(); // number of active parameters
-
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
+  hessian.resize(na, na);
+  // Rows have different lengths so hand them out one at a time
+  PRAGMA_OMP(parallel for schedule(dynamic, 1)
+                 if (na * (na + 1) / 2 * ny >= minParallelWork))
+  for (int i1 = 0; i1 < static_cast<int>(na); ++i1) {
+    const double *column1 = &columns[0] + static_cast<size_t>(i1) * ny;
+    for (int i2 = 0; i2 <= i1; ++i2) {
+      const double *column2 = &columns[0] + static_cast<size_t>(i2) * ny;
       double d = 0.0;
       for (size_t k = 0; k < ny; ++k) // over fitting data
       {
-        // double w = values->getFitWeight(k);
         double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
+        d += column1[k] * column2[k] * w * w;
       }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        // std::cerr << "hess " << i1 << ' ' << i2 << std::endl;
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
-        }
+      hessian.set(i1, i2, d);
+      if (i1 != i2) {
+        hessian.set(i2, i1, d);
+      }
+    }
+  }
+}
+
+/**
+ * Add contributions calculated by calcValDerivHessian() to the cost function,
+ * derivatives and hessian.
+ * @param value :: The contribution to the value
+ * @param der :: The contribution to the derivatives
+ * @param hessian :: The contribution to the hessian
+ * @param evalFunction :: Flag to add the value
+ * @param evalHessian :: Flag to add the Hessian
+ */
+void CostFuncLeastSquares::addToValDerivHessian(double value,
+                                                const GSLVector &der,
+                                                const GSLMatrix &hessian,
+                                                bool evalFunction,
+                                                bool evalHessian) const {
+  PARALLEL_CRITICAL(der_set) {
+    for (size_t i = 0; i < der.size(); ++i) {
+      m_der.set(i, m_der.get(i) + der.get(i));
+    }
+  }
+
+  if (evalFunction) {
+    PARALLEL_ATOMIC
+    m_value += value;
+  }
+
+  if (!evalHessian)
+    return;
+
+  PARALLEL_CRITICAL(hessian_set) {
+    for (size_t i = 0; i < hessian.size1(); ++i) {
+      for (size_t j = 0; j < hessian.size2(); ++j) {
+        m_hessian.set(i, j, m_hessian.get(i, j) + hessian.get(i, j));
       }
-      ++i2;
     }
-    ++i1;
   }
 }
 
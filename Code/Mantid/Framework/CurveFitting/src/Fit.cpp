@@ -392,6 +392,8 @@ void Fit::exec() {
 
   // do something with the function which may depend on workspace
   m_domainCreator->initFunction(m_function);
+  // copies left over from a previous fit may not match the function any more
+  m_function->clearNumericalDerivCopies();
 
   // get the minimizer
   std::string minimizerName = getPropertyValue("Minimizer");
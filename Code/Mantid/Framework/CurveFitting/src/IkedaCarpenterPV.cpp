@@ -255,21 +255,27 @@ void IkedaCarpenterPV::constFunction(double *out, const double *xValues,
 
     std::complex<double> zs =
         std::complex<double>(-alpha * diff, 0.5 * alpha * gamma);
+    // zu and zv are the same point so the exponential integral, the most
+    // expensive part of the calculation, is evaluated once for both
     std::complex<double> zu = (1 - k) * zs;
-    std::complex<double> zv = (1 - k) * zs;
     std::complex<double> zr =
         std::complex<double>(-beta * diff, 0.5 * beta * gamma);
 
     double N = 0.25 * alpha * (1 - k * k) / (k * k);
 
+    double lorentzPart = 0.0; // skipped for a pure gaussian
+    if (eta != 0.0) {
+      const double eiu = exponentialIntegral(zu).imag();
+      lorentzPart = eta * 2.0 / M_PI *
+                    (Nu * eiu + Nv * eiu + Ns * exponentialIntegral(zs).imag() +
+                     Nr * exponentialIntegral(zr).imag());
+    }
+
     out[i] = I * N * ((1 - eta) * (Nu * exp(u + gsl_sf_log_erfc(yu)) +
                                    Nv * exp(v + gsl_sf_log_erfc(yv)) +
                                    Ns * exp(s + gsl_sf_log_erfc(ys)) +
                                    Nr * exp(r + gsl_sf_log_erfc(yr))) -
-                      eta * 2.0 / M_PI * (Nu * exponentialIntegral(zu).imag() +
-                                          Nv * exponentialIntegral(zv).imag() +
-                                          Ns * exponentialIntegral(zs).imag() +
-                                          Nr * exponentialIntegral(zr).imag()));
+                      lorentzPart);
   }
 }
 
@@ -337,21 +343,27 @@ void IkedaCarpenterPV::functionLocal(double *out, const double *xValues,
 
     std::complex<double> zs =
         std::complex<double>(-alpha * diff, 0.5 * alpha * gamma);
+    // zu and zv are the same point so the exponential integral, the most
+    // expensive part of the calculation, is evaluated once for both
     std::complex<double> zu = (1 - k) * zs;
-    std::complex<double> zv = (1 - k) * zs;
     std::complex<double> zr =
         std::complex<double>(-beta * diff, 0.5 * beta * gamma);
 
     double N = 0.25 * alpha * (1 - k * k) / (k * k);
 
+    double lorentzPart = 0.0; // skipped for a pure gaussian
+    if (eta != 0.0) {
+      const double eiu = exponentialIntegral(zu).imag();
+      lorentzPart = eta * 2.0 / M_PI *
+                    (Nu * eiu + Nv * eiu + Ns * exponentialIntegral(zs).imag() +
+                     Nr * exponentialIntegral(zr).imag());
+    }
+
     out[i] = I * N * ((1 - eta) * (Nu * exp(u + gsl_sf_log_erfc(yu)) +
                                    Nv * exp(v + gsl_sf_log_erfc(yv)) +
                                    Ns * exp(s + gsl_sf_log_erfc(ys)) +
                                    Nr * exp(r + gsl_sf_log_erfc(yr))) -
-                      eta * 2.0 / M_PI * (Nu * exponentialIntegral(zu).imag() +
-                                          Nv * exponentialIntegral(zv).imag() +
-                                          Ns * exponentialIntegral(zs).imag() +
-                                          Nr * exponentialIntegral(zr).imag()));
+                      lorentzPart);
   }
 }
 
@@ -30,6 +30,8 @@ void ParDomain::getDomainAndValues(size_t i, API::FunctionDomain_sptr &domain,
  */
 void ParDomain::leastSquaresVal(const CostFuncLeastSquares &leastSquares) {
   const int n = static_cast<int>(getNDomains());
+  // Contributions of the individual domains
+  std::vector<double> partialValues(n, 0.0);
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int i = 0; i < n; ++i) {
     API::FunctionDomain_sptr domain;
@@ -38,12 +40,17 @@ void ParDomain::leastSquaresVal(const CostFuncLeastSquares &leastSquares) {
     if (!values) {
       throw std::runtime_error("LeastSquares: undefined FunctionValues.");
     }
-    leastSquares.addVal(domain, values);
+    partialValues[i] = leastSquares.calcVal(domain, values);
     // PARALLEL_CRITICAL(printout)
     //{
     //  std::cerr << "val= " << leastSquares.m_value << std::endl;
     //}
   }
+  // Add them up in domain order so that the result doesn't depend on the
+  // order in which the threads finish
+  for (int i = 0; i < n; ++i) {
+    leastSquares.m_value += partialValues[i];
+  }
 }
 
 /**
@@ -62,6 +69,10 @@ ParDomain::leastSquaresValDerivHessian(const CostFuncLeastSquares &leastSquares,
   PARALLEL_SET_DYNAMIC(0);
   std::vector<API::IFunction_sptr> funs;
   // funs.push_back( leastSquares.getFittingFunction()->clone() );
+  // Contributions of the individual domains
+  std::vector<double> partialValues(n, 0.0);
+  std::vector<GSLVector> partialDerivs(n);
+  std::vector<GSLMatrix> partialHessians(n);
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int i = 0; i < n; ++i) {
     API::FunctionDomain_sptr domain;
@@ -82,8 +93,17 @@ ParDomain::leastSquaresValDerivHessian(const CostFuncLeastSquares &leastSquares,
       }
     }
     // std::cerr <<
-    leastSquares.addValDerivHessian(funs[k], domain, simpleValues, evalFunction,
-                                    evalDeriv, evalHessian);
+    leastSquares.calcValDerivHessian(funs[k], domain, simpleValues,
+                                     evalFunction, evalDeriv, evalHessian,
+                                     partialValues[i], partialDerivs[i],
+                                     partialHessians[i]);
+  }
+  // Add them up in domain order so that the result doesn't depend on the
+  // order in which the threads finish
+  for (int i = 0; i < n; ++i) {
+    leastSquares.addToValDerivHessian(partialValues[i], partialDerivs[i],
+                                      partialHessians[i], evalFunction,
+                                      evalHessian);
   }
 }
 
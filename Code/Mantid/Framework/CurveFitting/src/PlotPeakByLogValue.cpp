@@ -7,7 +7,9 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <Poco/ActiveResult.h>
 #include <Poco/StringTokenizer.h>
+#include <boost/scoped_ptr.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "MantidCurveFitting/PlotPeakByLogValue.h"
@@ -26,6 +28,7 @@
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -88,6 +91,12 @@ void PlotPeakByLogValue::init() {
                   "If set to 'Individual' each fit starts with the same "
                   "initial values defined in the Function property.");
 
+  declareProperty("Parallel", false,
+                  "If true and FitType is 'Individual' the spectra are "
+                  "fitted in parallel. \n"
+                  "Leave it false if the function is not thread safe, for "
+                  "example if it is written in Python.");
+
   declareProperty("PassWSIndexToFunction", false,
                   "For each spectrum in Input pass its workspace index to all "
                   "functions that"
@@ -137,10 +146,9 @@ void PlotPeakByLogValue::exec() {
   // int wi = getProperty("WorkspaceIndex");
   std::string logName = getProperty("LogValue");
   bool individual = getPropertyValue("FitType") == "Individual";
+  bool parallel = getProperty("Parallel");
   bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
   bool createFitOutput = getProperty("CreateOutput");
-  bool outputCompositeMembers = getProperty("OutputCompositeMembers");
-  bool outputConvolvedMembers = getProperty("ConvolveMembers");
   std::string baseName = getPropertyValue("OutputWorkspace");
 
   bool isDataName = false; // if true first output column is of type string and
@@ -182,139 +190,124 @@ void PlotPeakByLogValue::exec() {
   std::vector<std::string> fit_workspaces;
   std::vector<std::string> parameter_workspaces;
 
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
-  for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
-    InputData data = getWorkspace(wsNames[i]);
-
-    if (!data.ws) {
-      g_log.warning() << "Cannot access workspace " << wsNames[i].name << '\n';
-      continue;
+  if (individual && parallel) {
+    std::vector<std::string> wsBaseNames;
+    fitIndividualInParallel(wsNames, ifun, initialParams, result, wsBaseNames);
+    for (size_t k = 0; k < wsBaseNames.size(); ++k) {
+      covariance_workspaces.push_back(wsBaseNames[k] +
+                                      "_NormalisedCovarianceMatrix");
+      parameter_workspaces.push_back(wsBaseNames[k] + "_Parameters");
+      fit_workspaces.push_back(wsBaseNames[k] + "_Workspace");
     }
+  } else {
+    // The next input is fetched (and loaded, if it is a file) in the
+    // background while the current one is being fitted
+    boost::scoped_ptr<Poco::ActiveResult<InputData>> nextData;
+    if (!wsNames.empty())
+      nextData.reset(
+          new Poco::ActiveResult<InputData>(m_getWorkspaceAsync(wsNames[0])));
+
+    double dProg = 1. / static_cast<double>(wsNames.size());
+    double Prog = 0.;
+    try {
+      for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
+        nextData->wait();
+        if (nextData->failed())
+          throw std::runtime_error("Cannot access workspace " +
+                                   wsNames[i].name + ": " + nextData->error());
+        InputData data = nextData->data();
+        nextData.reset();
+        if (i + 1 < static_cast<int>(wsNames.size()))
+          nextData.reset(new Poco::ActiveResult<InputData>(
+              m_getWorkspaceAsync(wsNames[i + 1])));
+
+        if (!hasSpectraToFit(data, wsNames[i].name))
+          continue;
+
+        int j, jend;
+        getSpectrumRange(data, j, jend);
 
-    if (data.i < 0 && data.indx.empty()) {
-      g_log.warning() << "Zero spectra selected for fitting in workspace "
-                      << wsNames[i].name << '\n';
-      continue;
-    }
+        if (createFitOutput) {
+          covariance_workspaces.reserve(covariance_workspaces.size() + jend);
+          fit_workspaces.reserve(fit_workspaces.size() + jend);
+          parameter_workspaces.reserve(parameter_workspaces.size() + jend);
+        }
 
-    int j, jend;
-    if (data.i >= 0) {
-      j = data.i;
-      jend = j + 1;
-    } else { // no need to check data.indx.empty()
-      j = data.indx.front();
-      jend = data.indx.back() + 1;
-    }
+        dProg /= abs(jend - j);
+        for (; j < jend; ++j) {
 
-    if (createFitOutput) {
-      covariance_workspaces.reserve(covariance_workspaces.size() + jend);
-      fit_workspaces.reserve(fit_workspaces.size() + jend);
-      parameter_workspaces.reserve(parameter_workspaces.size() + jend);
-    }
+          // Find the log value: it is either a log-file value or simply the
+          // workspace number
+          double logValue = getLogValue(data, j, logName);
 
-    dProg /= abs(jend - j);
-    for (; j < jend; ++j) {
+          double chi2;
 
-      // Find the log value: it is either a log-file value or simply the
-      // workspace number
-      double logValue = 0;
-      if (logName.empty()) {
-        API::Axis *axis = data.ws->getAxis(1);
-        logValue = (*axis)(j);
-      } else if (logName != "SourceName") {
-        Kernel::Property *prop = data.ws->run().getLogData(logName);
-        if (!prop) {
-          throw std::invalid_argument("Log value " + logName +
-                                      " does not exist");
-        }
-        TimeSeriesProperty<double> *logp =
-            dynamic_cast<TimeSeriesProperty<double> *>(prop);
-        logValue = logp->lastValue();
-      }
+          try {
+            if (passWSIndexToFunction) {
+              setWorkspaceIndexAttribute(ifun, j);
+            }
 
-      double chi2;
+            g_log.debug() << "Fitting " << data.ws->name() << " index " << j
+                          << " with " << std::endl;
+            g_log.debug() << ifun->asString() << std::endl;
 
-      try {
-        if (passWSIndexToFunction) {
-          setWorkspaceIndexAttribute(ifun, j);
-        }
+            std::string wsBaseName = "";
+            if (createFitOutput)
+              wsBaseName = makeBaseName(wsNames[i].name, j);
 
-        g_log.debug() << "Fitting " << data.ws->name() << " index " << j
-                      << " with " << std::endl;
-        g_log.debug() << ifun->asString() << std::endl;
-
-        std::string spectrum_index = boost::lexical_cast<std::string>(j);
-        std::string wsBaseName = "";
-
-        if (createFitOutput)
-          wsBaseName = wsNames[i].name + "_" + spectrum_index;
-
-        // Fit the function
-        API::IAlgorithm_sptr fit =
-            AlgorithmManager::Instance().createUnmanaged("Fit");
-        fit->initialize();
-        fit->setProperty("Function", ifun);
-        fit->setProperty("InputWorkspace", data.ws);
-        fit->setProperty("WorkspaceIndex", j);
-        fit->setPropertyValue("StartX", getPropertyValue("StartX"));
-        fit->setPropertyValue("EndX", getPropertyValue("EndX"));
-        fit->setPropertyValue("Minimizer", getPropertyValue("Minimizer"));
-        fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
-        fit->setProperty("CalcErrors", true);
-        fit->setProperty("CreateOutput", createFitOutput);
-        fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
-        fit->setProperty("ConvolveMembers", outputConvolvedMembers);
-        fit->setProperty("Output", wsBaseName);
-        fit->execute();
-
-        if (!fit->isExecuted()) {
-          throw std::runtime_error("Fit child algorithm failed: " +
-                                   data.ws->name());
-        }
+            // Fit the function
+            API::IAlgorithm_sptr fit = runFit(ifun, data, j, wsBaseName);
 
-        ifun = fit->getProperty("Function");
-        chi2 = fit->getProperty("OutputChi2overDoF");
+            ifun = fit->getProperty("Function");
+            chi2 = fit->getProperty("OutputChi2overDoF");
 
-        if (createFitOutput) {
-          covariance_workspaces.push_back(wsBaseName +
-                                          "_NormalisedCovarianceMatrix");
-          parameter_workspaces.push_back(wsBaseName + "_Parameters");
-          fit_workspaces.push_back(wsBaseName + "_Workspace");
-        }
+            if (createFitOutput) {
+              covariance_workspaces.push_back(wsBaseName +
+                                              "_NormalisedCovarianceMatrix");
+              parameter_workspaces.push_back(wsBaseName + "_Parameters");
+              fit_workspaces.push_back(wsBaseName + "_Workspace");
+            }
 
-        g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                      << ' ' << chi2 << std::endl;
+            g_log.debug() << "Fit result "
+                          << fit->getPropertyValue("OutputStatus") << ' '
+                          << chi2 << std::endl;
 
-      } catch (...) {
-        g_log.error("Error in Fit ChildAlgorithm");
-        throw;
-      }
+          } catch (...) {
+            g_log.error("Error in Fit ChildAlgorithm");
+            throw;
+          }
 
-      // Extract the fitted parameters and put them into the result table
-      TableRow row = result->appendRow();
-      if (isDataName) {
-        row << wsNames[i].name;
-      } else {
-        row << logValue;
-      }
+          // Extract the fitted parameters and put them into the result table
+          TableRow row = result->appendRow();
+          if (isDataName) {
+            row << wsNames[i].name;
+          } else {
+            row << logValue;
+          }
 
-      for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-        row << ifun->getParameter(iPar) << ifun->getError(iPar);
-      }
-      row << chi2;
+          for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
+            row << ifun->getParameter(iPar) << ifun->getError(iPar);
+          }
+          row << chi2;
 
-      Prog += dProg;
-      progress(Prog);
-      interruption_point();
+          Prog += dProg;
+          progress(Prog);
+          interruption_point();
 
-      if (individual) {
-        for (size_t i = 0; i < initialParams.size(); ++i) {
-          ifun->setParameter(i, initialParams[i]);
-        }
-      }
+          if (individual) {
+            for (size_t i = 0; i < initialParams.size(); ++i) {
+              ifun->setParameter(i, initialParams[i]);
+            }
+          }
 
-    } // for(;j < jend;++j)
+        } // for(;j < jend;++j)
+      }
+    } catch (...) {
+      // The background thread uses this algorithm so must finish first
+      if (nextData)
+        nextData->wait();
+      throw;
+    }
   }
 
   if (createFitOutput) {
@@ -341,6 +334,225 @@ void PlotPeakByLogValue::exec() {
   }
 }
 
+/**
+ * Fit all the spectra independently of each other, starting from the same
+ * initial parameters, on all available threads. Every thread fits its own
+ * clone of the function. The rows are added to the result table in the same
+ * order as a serial run would add them.
+ * @param wsNames :: The inputs to fit
+ * @param ifun :: The fitting function with the initial parameters set
+ * @param initialParams :: The initial values of the parameters
+ * @param result :: The output table
+ * @param wsBaseNames :: Set to the base names of the output workspaces of the
+ *  fits, in the order of the rows, if CreateOutput is set
+ */
+void PlotPeakByLogValue::fitIndividualInParallel(
+    const std::vector<InputData> &wsNames, IFunction_sptr ifun,
+    const std::vector<double> &initialParams, ITableWorkspace_sptr result,
+    std::vector<std::string> &wsBaseNames) {
+  const std::string logName = getProperty("LogValue");
+  const bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
+  const bool createFitOutput = getProperty("CreateOutput");
+
+  // All the inputs must be available before the fits are handed out
+  std::vector<InputData> inputs;
+  inputs.reserve(wsNames.size());
+  std::vector<std::pair<size_t, int>> spectra;
+  for (size_t i = 0; i < wsNames.size(); ++i) {
+    inputs.push_back(getWorkspace(wsNames[i]));
+    if (!hasSpectraToFit(inputs.back(), wsNames[i].name))
+      continue;
+    int j, jend;
+    getSpectrumRange(inputs.back(), j, jend);
+    for (; j < jend; ++j) {
+      spectra.push_back(std::make_pair(i, j));
+    }
+  }
+
+  const size_t nParams = ifun->nParams();
+  const size_t nSpectra = spectra.size();
+  wsBaseNames.clear();
+  if (createFitOutput) {
+    for (size_t spec = 0; spec < nSpectra; ++spec) {
+      wsBaseNames.push_back(
+          makeBaseName(wsNames[spectra[spec].first].name, spectra[spec].second));
+    }
+  }
+  std::vector<double> logValues(nSpectra);
+  std::vector<double> values(nSpectra * nParams);
+  std::vector<double> errors(nSpectra * nParams);
+  std::vector<double> chi2(nSpectra);
+
+  // One copy of the function per thread
+  std::vector<IFunction_sptr> functions(PARALLEL_GET_MAX_THREADS);
+  for (size_t k = 0; k < functions.size(); ++k) {
+    functions[k] = ifun->clone();
+  }
+
+  Progress prog(this, 0.0, 1.0, nSpectra);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t k = 0; k < static_cast<int64_t>(nSpectra); ++k) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t spec = static_cast<size_t>(k);
+    const size_t i = spectra[spec].first;
+    const int j = spectra[spec].second;
+    const InputData &data = inputs[i];
+    logValues[spec] = getLogValue(data, j, logName);
+
+    IFunction_sptr fun = functions[PARALLEL_THREAD_NUMBER];
+    for (size_t iPar = 0; iPar < nParams; ++iPar) {
+      fun->setParameter(iPar, initialParams[iPar]);
+    }
+    if (passWSIndexToFunction) {
+      setWorkspaceIndexAttribute(fun, j);
+    }
+
+    API::IAlgorithm_sptr fit;
+    try {
+      fit = runFit(fun, data, j, createFitOutput ? wsBaseNames[spec] : "");
+    } catch (...) {
+      g_log.error("Error in Fit ChildAlgorithm");
+      throw;
+    }
+
+    IFunction_sptr fitted = fit->getProperty("Function");
+    for (size_t iPar = 0; iPar < nParams; ++iPar) {
+      values[spec * nParams + iPar] = fitted->getParameter(iPar);
+      errors[spec * nParams + iPar] = fitted->getError(iPar);
+    }
+    chi2[spec] = fit->getProperty("OutputChi2overDoF");
+
+    prog.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Extract the fitted parameters and put them into the result table
+  for (size_t spec = 0; spec < nSpectra; ++spec) {
+    TableRow row = result->appendRow();
+    if (logName == "SourceName") {
+      row << wsNames[spectra[spec].first].name;
+    } else {
+      row << logValues[spec];
+    }
+    for (size_t iPar = 0; iPar < nParams; ++iPar) {
+      row << values[spec * nParams + iPar] << errors[spec * nParams + iPar];
+    }
+    row << chi2[spec];
+  }
+}
+
+/**
+ * Fit one spectrum.
+ * @param fun :: The function to fit. Its parameters are updated by the fit.
+ * @param data :: The input to fit
+ * @param wsIndex :: The workspace index of the spectrum to fit
+ * @param wsBaseName :: Base name of the output workspaces of the fit, if it
+ *  creates any
+ * @return The executed Fit algorithm
+ */
+API::IAlgorithm_sptr PlotPeakByLogValue::runFit(IFunction_sptr fun,
+                                                const InputData &data,
+                                                int wsIndex,
+                                                const std::string &wsBaseName) {
+  API::IAlgorithm_sptr fit =
+      AlgorithmManager::Instance().createUnmanaged("Fit");
+  fit->initialize();
+  fit->setProperty("Function", fun);
+  fit->setProperty("InputWorkspace", data.ws);
+  fit->setProperty("WorkspaceIndex", wsIndex);
+  fit->setPropertyValue("StartX", getPropertyValue("StartX"));
+  fit->setPropertyValue("EndX", getPropertyValue("EndX"));
+  fit->setPropertyValue("Minimizer", getPropertyValue("Minimizer"));
+  fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
+  fit->setProperty("CalcErrors", true);
+  fit->setProperty("CreateOutput", !wsBaseName.empty());
+  fit->setPropertyValue("OutputCompositeMembers",
+                        getPropertyValue("OutputCompositeMembers"));
+  fit->setPropertyValue("ConvolveMembers", getPropertyValue("ConvolveMembers"));
+  fit->setProperty("Output", wsBaseName);
+  fit->execute();
+
+  if (!fit->isExecuted()) {
+    throw std::runtime_error("Fit child algorithm failed: " + data.ws->name());
+  }
+  return fit;
+}
+
+/**
+ * Check that an input has a workspace and spectra to fit, warning if not.
+ * @param data :: The input returned by getWorkspace()
+ * @param name :: The name of the input
+ * @return true if there is something to fit
+ */
+bool PlotPeakByLogValue::hasSpectraToFit(const InputData &data,
+                                         const std::string &name) const {
+  if (!data.ws) {
+    g_log.warning() << "Cannot access workspace " << name << '\n';
+    return false;
+  }
+
+  if (data.i < 0 && data.indx.empty()) {
+    g_log.warning() << "Zero spectra selected for fitting in workspace "
+                    << name << '\n';
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Get the range of workspace indices to fit in an input.
+ * @param data :: The input returned by getWorkspace()
+ * @param j :: Set to the first workspace index
+ * @param jend :: Set to one past the last workspace index
+ */
+void PlotPeakByLogValue::getSpectrumRange(const InputData &data, int &j,
+                                          int &jend) const {
+  if (data.i >= 0) {
+    j = data.i;
+    jend = j + 1;
+  } else { // no need to check data.indx.empty()
+    j = data.indx.front();
+    jend = data.indx.back() + 1;
+  }
+}
+
+/**
+ * Find the value to plot the fitted parameters of a spectrum against: either
+ * a log value or the value of the spectrum axis.
+ * @param data :: The input the spectrum belongs to
+ * @param wsIndex :: The workspace index of the spectrum
+ * @param logName :: The name of the log, or empty to use the axis
+ * @return The value
+ */
+double PlotPeakByLogValue::getLogValue(const InputData &data, int wsIndex,
+                                       const std::string &logName) const {
+  double logValue = 0;
+  if (logName.empty()) {
+    API::Axis *axis = data.ws->getAxis(1);
+    logValue = (*axis)(wsIndex);
+  } else if (logName != "SourceName") {
+    Kernel::Property *prop = data.ws->run().getLogData(logName);
+    if (!prop) {
+      throw std::invalid_argument("Log value " + logName + " does not exist");
+    }
+    TimeSeriesProperty<double> *logp =
+        dynamic_cast<TimeSeriesProperty<double> *>(prop);
+    logValue = logp->lastValue();
+  }
+  return logValue;
+}
+
+/**
+ * Make the base name of the output workspaces of the fit of a spectrum.
+ * @param name :: The name of the input
+ * @param wsIndex :: The workspace index of the spectrum
+ */
+std::string PlotPeakByLogValue::makeBaseName(const std::string &name,
+                                             int wsIndex) const {
+  return name + "_" + boost::lexical_cast<std::string>(wsIndex);
+}
+
 /** Get a workspace identified by an InputData structure.
   * @param data :: InputData with name and either spec or i fields defined.
   * @return InputData structure with the ws field set if everything was OK.
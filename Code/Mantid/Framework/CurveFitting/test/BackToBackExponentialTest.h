@@ -4,6 +4,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidCurveFitting/BackToBackExponential.h"
+#include "MantidCurveFitting/Jacobian.h"
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 
@@ -185,6 +186,31 @@ public:
     }
 }
 
+  // test the analytic derivatives against numerical ones
+  void test_derivatives()
+  {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 2.1);
+    b2bExp.setParameter("A", 1.5);
+    b2bExp.setParameter("B", 0.7);
+    b2bExp.setParameter("X0", 0.3);
+    b2bExp.setParameter("S", 0.8);
+
+    Mantid::API::FunctionDomain1DVector x(-6,6,40);
+
+    Mantid::CurveFitting::Jacobian analytic(x.size(), 5), numeric(x.size(), 5);
+    b2bExp.functionDeriv(x, analytic);
+    b2bExp.calNumericalDeriv(x, numeric);
+
+    for(size_t i = 0; i < x.size(); ++i)
+    {
+      for(size_t j = 0; j < 5; ++j)
+      {
+        TS_ASSERT_DELTA( analytic.get(i,j), numeric.get(i,j), 1e-3 );
+      }
+    }
+  }
 
 };
 
@@ -22,6 +22,7 @@
 #include "MantidCurveFitting/GSLJacobian.h"
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
@@ -425,6 +426,120 @@ public:
     TS_ASSERT_EQUALS(s.getError(),"success");
   }
 
+  void test_numerical_derivatives_of_many_parameters_do_not_depend_on_threads()
+  {
+    FunctionDomain1DVector domain(0.0, 10.0, 5000);
+    boost::shared_ptr<CompositeFunction> mfun(new CompositeFunction);
+    IFunction_sptr background(new CurveFittingLinear);
+    background->setParameter("a",1.0);
+    background->setParameter("b",0.1);
+    mfun->addFunction(background);
+    for(size_t i = 0; i < 10; ++i)
+    {
+      IFunction_sptr peak(new CurveFittingGauss);
+      peak->setParameter("c",0.5 + double(i));
+      peak->setParameter("h",1.0 + 0.1 * double(i));
+      peak->setParameter("s",2.0);
+      mfun->addFunction(peak);
+    }
+    mfun->fix(mfun->parameterIndex("f1.h"));
+    mfun->tie("f3.s","f2.s");
+
+    GSLJacobian serial(mfun, domain.size());
+    GSLJacobian parallel(mfun, domain.size());
+    calNumericalDeriv(mfun, domain, serial, parallel);
+    TS_ASSERT_EQUALS(countDifferences(mfun, domain, serial, parallel), 0);
+  }
+
+  void test_numerical_derivatives_of_large_domain_do_not_depend_on_threads()
+  {
+    FunctionDomain1DVector domain(0.0, 10.0, 50000);
+    IFunction_sptr peak(new CurveFittingGauss);
+    peak->setParameter("c",5.0);
+    peak->setParameter("h",2.0);
+    peak->setParameter("s",3.0);
+
+    GSLJacobian serial(peak, domain.size());
+    GSLJacobian parallel(peak, domain.size());
+    calNumericalDeriv(peak, domain, serial, parallel);
+    TS_ASSERT_EQUALS(countDifferences(peak, domain, serial, parallel), 0);
+
+    GSLJacobian analytic(peak, domain.size());
+    peak->functionDeriv(domain, analytic);
+    for(size_t i = 0; i < domain.size(); i += 100)
+    {
+      for(size_t ip = 0; ip < peak->nParams(); ++ip)
+      {
+        TS_ASSERT_DELTA(serial.get(i,ip), analytic.get(i,ip), 0.05);
+      }
+    }
+  }
+
+  void test_numerical_derivatives_follow_changes_between_calls()
+  {
+    FunctionDomain1DVector domain(0.0, 10.0, 5000);
+    boost::shared_ptr<CompositeFunction> mfun(new CompositeFunction);
+    for(size_t i = 0; i < 3; ++i)
+    {
+      IFunction_sptr peak(new CurveFittingGauss);
+      peak->setParameter("c",2.0 + 3.0 * double(i));
+      peak->setParameter("h",1.0);
+      peak->setParameter("s",1.5);
+      mfun->addFunction(peak);
+    }
+    GSLJacobian first(mfun, domain.size());
+    mfun->calNumericalDeriv(domain, first);
+
+    // the copies made by the first call must pick up the new values
+    mfun->setParameter("f1.c",4.5);
+    mfun->setParameter("f2.s",0.7);
+    GSLJacobian serial(mfun, domain.size());
+    GSLJacobian parallel(mfun, domain.size());
+    calNumericalDeriv(mfun, domain, serial, parallel);
+    TS_ASSERT_EQUALS(countDifferences(mfun, domain, serial, parallel), 0);
+
+    // and be replaced when the active parameters change
+    mfun->fix(mfun->parameterIndex("f0.h"));
+    calNumericalDeriv(mfun, domain, serial, parallel);
+    TS_ASSERT_EQUALS(countDifferences(mfun, domain, serial, parallel), 0);
+
+    mfun->clearNumericalDerivCopies();
+    calNumericalDeriv(mfun, domain, serial, parallel);
+    TS_ASSERT_EQUALS(countDifferences(mfun, domain, serial, parallel), 0);
+  }
+
+private:
+
+  /// Calculate numerical derivatives with one thread and with all threads
+  void calNumericalDeriv(IFunction_sptr fun, const FunctionDomain &domain,
+                         Jacobian &serial, Jacobian &parallel)
+  {
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    UNUSED_ARG(maxThreads);
+    PARALLEL_SET_NUM_THREADS(1);
+    fun->calNumericalDeriv(domain, serial);
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    fun->calNumericalDeriv(domain, parallel);
+  }
+
+  /// Count the elements of two jacobians which are not exactly the same
+  size_t countDifferences(IFunction_sptr fun, const FunctionDomain &domain,
+                          Jacobian &serial, Jacobian &parallel)
+  {
+    size_t count = 0;
+    for(size_t i = 0; i < domain.size(); ++i)
+    {
+      for(size_t ip = 0; ip < fun->nParams(); ++ip)
+      {
+        if (fun->isActive(ip) && serial.get(i,ip) != parallel.get(i,ip))
+        {
+          ++count;
+        }
+      }
+    }
+    return count;
+  }
+
 };
 
 #endif /*CURVEFITTING_COMPOSITEFUNCTIONTEST_H_*/
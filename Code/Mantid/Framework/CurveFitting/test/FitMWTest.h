@@ -9,6 +9,7 @@
 #include "MantidCurveFitting/UserFunction.h"
 #include "MantidCurveFitting/ExpDecay.h"
 #include "MantidCurveFitting/SeqDomain.h"
+#include "MantidCurveFitting/CostFuncLeastSquares.h"
 #include "MantidCurveFitting/Convolution.h"
 #include "MantidCurveFitting/Gaussian.h"
 #include "MantidCurveFitting/Polynomial.h"
@@ -18,6 +19,7 @@
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/AnalysisDataService.h"
 
@@ -437,6 +439,55 @@ public:
 
   }
 
+  void test_ParDomain_matches_simple_domain()
+  {
+    MatrixWorkspace_sptr ws2(new WorkspaceTester);
+    ws2->initialize(1,101,100);
+    Mantid::MantidVec& x = ws2->dataX(0);
+    Mantid::MantidVec& y = ws2->dataY(0);
+    for(size_t i = 0; i < ws2->blocksize(); ++i)
+    {
+      x[i] = 0.1 * double(i);
+      double t = x[i] - 5.0;
+      y[i] = 1.0 + 10.0 * exp( -0.5 * t * t );
+    }
+    x.back() = x[x.size()-2] + 0.1;
+
+    GSLVector simpleDeriv;
+    GSLMatrix simpleHessian;
+    const double simpleValue = calcLeastSquares(ws2, FitMW::Simple, simpleDeriv, simpleHessian);
+
+    GSLVector parDeriv;
+    GSLMatrix parHessian;
+    const double parValue = calcLeastSquares(ws2, FitMW::Parallel, parDeriv, parHessian);
+
+    TS_ASSERT_DELTA( parValue, simpleValue, 1e-10 );
+    TS_ASSERT_EQUALS( parDeriv.size(), simpleDeriv.size() );
+    TS_ASSERT_EQUALS( parHessian.size1(), simpleHessian.size1() );
+    for(size_t i = 0; i < simpleDeriv.size(); ++i)
+    {
+      TS_ASSERT_DELTA( parDeriv.get(i), simpleDeriv.get(i), 1e-10 );
+      for(size_t j = 0; j < simpleDeriv.size(); ++j)
+      {
+        TS_ASSERT_DELTA( parHessian.get(i,j), simpleHessian.get(i,j), 1e-10 );
+        TS_ASSERT_EQUALS( parHessian.get(i,j), parHessian.get(j,i) );
+      }
+    }
+
+    // The domains are summed in a fixed order so repeated evaluations agree exactly
+    GSLVector parDeriv1;
+    GSLMatrix parHessian1;
+    TS_ASSERT_EQUALS( calcLeastSquares(ws2, FitMW::Parallel, parDeriv1, parHessian1), parValue );
+    for(size_t i = 0; i < parDeriv.size(); ++i)
+    {
+      TS_ASSERT_EQUALS( parDeriv1.get(i), parDeriv.get(i) );
+      for(size_t j = 0; j < parDeriv.size(); ++j)
+      {
+        TS_ASSERT_EQUALS( parHessian1.get(i,j), parHessian.get(i,j) );
+      }
+    }
+  }
+
   void test_Composite_Function_With_SeparateMembers_Option_On_FitMW_Outputs_Composite_Values_Plus_Each_Member()
   {
     const bool histogram(true);
@@ -784,6 +835,31 @@ private:
     }
     return ws2;
   }
+
+  /// Evaluate the least squares cost function of a gaussian on a background
+  /// using a domain of the given type
+  double calcLeastSquares(MatrixWorkspace_sptr ws, FitMW::DomainType domainType,
+    GSLVector& deriv, GSLMatrix& hessian)
+  {
+    FunctionDomain_sptr domain;
+    FunctionValues_sptr values;
+    FitMW fitmw(domainType);
+    fitmw.setWorkspace( ws );
+    fitmw.setWorkspaceIndex( 0 );
+    fitmw.setMaxSize(7);
+    fitmw.createDomain( domain, values );
+
+    IFunction_sptr fun = FunctionFactory::Instance().createInitialized(
+      "name=Gaussian,Height=9.5,PeakCentre=5.1,Sigma=1.1;name=FlatBackground,A0=0.9");
+    boost::shared_ptr<CostFuncLeastSquares> costFun(new CostFuncLeastSquares);
+    costFun->setFittingFunction(fun, domain, values);
+    const double value = costFun->valDerivHessian();
+    deriv = costFun->getDeriv();
+    hessian = costFun->getHessian();
+    return value;
+  }
+
 };
 
+
 #endif /*CURVEFITTING_FITMWTEST_H_*/
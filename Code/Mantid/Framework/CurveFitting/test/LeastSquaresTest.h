@@ -233,6 +233,42 @@ public:
 
   }
 
+  void test_all_parameters_fixed()
+  {
+    std::vector<double> x(10),y(10);
+    for(size_t i = 0; i < x.size(); ++i)
+    {
+      x[i] = 0.1 * double(i);
+      y[i] =  9.9 * exp( -(x[i])/0.5 );
+    }
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(x));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitData(y);
+    values->setFitWeights(1.0);
+
+    API::IFunction_sptr fun(new ExpDecay);
+    fun->setParameter("Height",1.);
+    fun->setParameter("Lifetime",1.);
+    fun->fix(0);
+    fun->fix(1);
+
+    boost::shared_ptr<CostFuncLeastSquares> costFun(new CostFuncLeastSquares);
+    costFun->setFittingFunction(fun,domain,values);
+    TS_ASSERT_EQUALS(costFun->nParams(),0);
+
+    std::vector<double> der;
+    double value = 0.0;
+    TS_ASSERT_THROWS_NOTHING(value = costFun->valAndDeriv(der));
+    TS_ASSERT(der.empty());
+    TS_ASSERT_DELTA(value,112.0,0.1);
+
+    GSLVector d;
+    GSLMatrix h;
+    costFun->calcValDerivHessian(fun,domain,values,true,true,true,value,d,h);
+    TS_ASSERT_EQUALS(d.size(),0);
+    TS_ASSERT(h.isEmpty());
+  }
+
   void test_With_LM_Rwp()
   {
     std::vector<double> x(10),y(10), e(10);
@@ -0,0 +1,183 @@
+#ifndef MANTID_CURVEFITTING_PEAKFUNCTIONSTEST_H_
+#define MANTID_CURVEFITTING_PEAKFUNCTIONSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/BackToBackExponential.h"
+#include "MantidCurveFitting/Gaussian.h"
+#include "MantidCurveFitting/IkedaCarpenterPV.h"
+#include "MantidCurveFitting/Jacobian.h"
+#include "MantidCurveFitting/Lorentzian.h"
+#include "MantidCurveFitting/ThermalNeutronBk2BkExpConvPVoigt.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidKernel/Timer.h"
+
+#include <boost/make_shared.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <iostream>
+
+using namespace Mantid::API;
+using namespace Mantid::CurveFitting;
+
+namespace {
+/// Create the peak functions of the library with a realistic shape
+std::vector<IFunction_sptr> createPeaks() {
+  std::vector<IFunction_sptr> peaks;
+
+  auto gaussian = boost::make_shared<Gaussian>();
+  gaussian->initialize();
+  peaks.push_back(gaussian);
+
+  auto lorentzian = boost::make_shared<Lorentzian>();
+  lorentzian->initialize();
+  peaks.push_back(lorentzian);
+
+  auto b2bExp = boost::make_shared<BackToBackExponential>();
+  b2bExp->initialize();
+  b2bExp->setParameter("A", 1.5);
+  b2bExp->setParameter("B", 0.7);
+  peaks.push_back(b2bExp);
+
+  auto icpv = boost::make_shared<IkedaCarpenterPV>();
+  icpv->initialize();
+  peaks.push_back(icpv);
+
+  auto thermal = boost::make_shared<ThermalNeutronBk2BkExpConvPVoigt>();
+  thermal->initialize();
+  thermal->setMillerIndex(1, 1, 1);
+  thermal->setParameter("Dtt1", 29671.7500);
+  thermal->setParameter("Dtt1t", 29671.750);
+  thermal->setParameter("Dtt2t", 0.30);
+  thermal->setParameter("Zerot", 33.70);
+  thermal->setParameter("Alph0", 4.026);
+  thermal->setParameter("Alph1", 7.362);
+  thermal->setParameter("Beta0", 3.489);
+  thermal->setParameter("Beta1", 19.535);
+  thermal->setParameter("Alph0t", 60.683);
+  thermal->setParameter("Alph1t", 39.730);
+  thermal->setParameter("Beta0t", 96.864);
+  thermal->setParameter("Beta1t", 96.864);
+  thermal->setParameter("Sig2", sqrt(11.380));
+  thermal->setParameter("Sig1", sqrt(9.901));
+  thermal->setParameter("Sig0", sqrt(17.370));
+  thermal->setParameter("Width", 1.0055);
+  thermal->setParameter("Tcross", 0.4700);
+  thermal->setParameter("Gam0", 1.0);
+  thermal->setParameter("LatticeConstant", 4.156890);
+  thermal->setParameter("Height", 1000.0);
+  peaks.push_back(thermal);
+
+  for (size_t i = 0; i < peaks.size(); ++i) {
+    IPeakFunction_sptr peak =
+        boost::dynamic_pointer_cast<IPeakFunction>(peaks[i]);
+    if (peak) {
+      peak->setCentre(0.0);
+      peak->setFwhm(1.0);
+      peak->setHeight(10.0);
+    }
+  }
+  return peaks;
+}
+
+/// Domain covering a peak and its tails
+FunctionDomain1DVector createDomain(const IFunction_sptr &function,
+                                    const size_t nPoints) {
+  double centre(0.0), fwhm(1.0);
+  IPeakFunction_sptr peak =
+      boost::dynamic_pointer_cast<IPeakFunction>(function);
+  IPowderDiffPeakFunction_sptr powderPeak =
+      boost::dynamic_pointer_cast<IPowderDiffPeakFunction>(function);
+  if (peak) {
+    centre = peak->centre();
+    fwhm = peak->fwhm();
+  } else if (powderPeak) {
+    centre = powderPeak->centre();
+    fwhm = powderPeak->fwhm();
+  }
+  return FunctionDomain1DVector(centre - 10.0 * fwhm, centre + 10.0 * fwhm,
+                                nPoints);
+}
+}
+
+class PeakFunctionsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PeakFunctionsTest *createSuite() { return new PeakFunctionsTest(); }
+  static void destroySuite(PeakFunctionsTest *suite) { delete suite; }
+
+  void test_values_and_derivatives_are_finite() {
+    std::vector<IFunction_sptr> peaks = createPeaks();
+    for (size_t i = 0; i < peaks.size(); ++i) {
+      IFunction &peak = *peaks[i];
+      FunctionDomain1DVector domain = createDomain(peaks[i], 101);
+      FunctionValues values(domain);
+      Mantid::CurveFitting::Jacobian jacobian(domain.size(), peak.nParams());
+      peak.function(domain, values);
+      peak.functionDeriv(domain, jacobian);
+
+      TSM_ASSERT_LESS_THAN(peak.name(), 0.0, values[50]);
+      for (size_t j = 0; j < domain.size(); ++j) {
+        TSM_ASSERT(peak.name(), boost::math::isfinite(values[j]));
+        for (size_t ip = 0; ip < peak.nParams(); ++ip) {
+          TSM_ASSERT(peak.name(),
+                     boost::math::isfinite(jacobian.get(j, ip)));
+        }
+      }
+    }
+  }
+};
+
+class PeakFunctionsTestPerformance : public CxxTest::TestSuite {
+public:
+  static PeakFunctionsTestPerformance *createSuite() {
+    return new PeakFunctionsTestPerformance();
+  }
+  static void destroySuite(PeakFunctionsTestPerformance *suite) {
+    delete suite;
+  }
+
+  PeakFunctionsTestPerformance() : m_peaks(createPeaks()) {}
+
+  void test_function_throughput() {
+    std::cout << "\n";
+    for (size_t i = 0; i < m_peaks.size(); ++i) {
+      IFunction &peak = *m_peaks[i];
+      FunctionDomain1DVector domain = createDomain(m_peaks[i], nPoints);
+      FunctionValues values(domain);
+
+      Mantid::Kernel::Timer timer;
+      for (size_t n = 0; n < nRepeats; ++n)
+        peak.function(domain, values);
+      report(peak.name() + " values", timer.elapsed());
+    }
+  }
+
+  void test_derivative_throughput() {
+    std::cout << "\n";
+    for (size_t i = 0; i < m_peaks.size(); ++i) {
+      IFunction &peak = *m_peaks[i];
+      FunctionDomain1DVector domain = createDomain(m_peaks[i], nPoints);
+      Mantid::CurveFitting::Jacobian jacobian(domain.size(), peak.nParams());
+
+      Mantid::Kernel::Timer timer;
+      for (size_t n = 0; n < nRepeats; ++n)
+        peak.functionDeriv(domain, jacobian);
+      report(peak.name() + " derivatives", timer.elapsed());
+    }
+  }
+
+private:
+  /// Print the number of points evaluated per second
+  void report(const std::string &what, const float seconds) const {
+    const double points = static_cast<double>(nPoints * nRepeats);
+    std::cout << what << ": " << points / seconds << " points/second\n";
+  }
+
+  static const size_t nPoints = 100000;
+  static const size_t nRepeats = 10;
+  std::vector<IFunction_sptr> m_peaks;
+};
+
+#endif /* MANTID_CURVEFITTING_PEAKFUNCTIONSTEST_H_ */
@@ -437,10 +437,58 @@ public:
     AnalysisDataService::Instance().clear();
   }
 
+  void test_parallel_individual_fits_match_serial_fits()
+  {
+    createData();
+
+    TWS_type serial = runIndividualFits(false);
+    TWS_type parallel = runIndividualFits(true);
+    TS_ASSERT_EQUALS(parallel->rowCount(), 3);
+    TS_ASSERT_EQUALS(parallel->rowCount(), serial->rowCount());
+    TS_ASSERT_EQUALS(parallel->columnCount(), serial->columnCount());
+    for(size_t row = 0; row < serial->rowCount(); ++row)
+    {
+      for(size_t col = 0; col < serial->columnCount(); ++col)
+      {
+        TS_ASSERT_DELTA(parallel->Double(row,col), serial->Double(row,col), 1e-10);
+      }
+    }
+    // the log values stay in the input order
+    TS_ASSERT_DELTA(parallel->Double(0,0),1,1e-10);
+    TS_ASSERT_DELTA(parallel->Double(1,0),1.3,1e-10);
+    TS_ASSERT_DELTA(parallel->Double(2,0),1.6,1e-10);
+
+    auto fits = AnalysisDataService::Instance().retrieveWS<const WorkspaceGroup>("PlotPeakResult_Workspaces");
+    TS_ASSERT( fits );
+    std::vector<std::string> names = fits->getNames();
+    TS_ASSERT_EQUALS( names.size(), 3 );
+    TS_ASSERT_EQUALS( names[0], "PlotPeakGroup_0_1_Workspace" );
+    TS_ASSERT_EQUALS( names[2], "PlotPeakGroup_2_1_Workspace" );
+
+    AnalysisDataService::Instance().clear();
+  }
+
 private:
 
   WorkspaceGroup_sptr m_wsg;
 
+  TWS_type runIndividualFits(bool parallel)
+  {
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input","PlotPeakGroup");
+    alg.setPropertyValue("OutputWorkspace","PlotPeakResult");
+    alg.setPropertyValue("WorkspaceIndex","1");
+    alg.setPropertyValue("LogValue","var");
+    alg.setPropertyValue("FitType","Individual");
+    alg.setProperty("Parallel",parallel);
+    alg.setProperty("CreateOutput",parallel);
+    alg.setPropertyValue("Function","name=LinearBackground,A0=1,A1=0.3;name=Gaussian,PeakCentre=5,Height=2,Sigma=0.1");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    return WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+  }
+
   void createData()
   {
     m_wsg.reset(new WorkspaceGroup);
@@ -500,4 +548,67 @@ private:
   }
 };
 
+class PlotPeakByLogValueTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static PlotPeakByLogValueTestPerformance *createSuite() { return new PlotPeakByLogValueTestPerformance(); }
+  static void destroySuite( PlotPeakByLogValueTestPerformance *suite ) { delete suite; }
+
+  PlotPeakByLogValueTestPerformance()
+  {
+    FrameworkManager::Instance();
+  }
+
+  void setUp()
+  {
+    auto ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(GaussianSpectra(),numSpectra,0,10,0.05,false);
+    AnalysisDataService::Instance().addOrReplace( "PlotPeakPerformance", ws );
+  }
+
+  void tearDown()
+  {
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_individual_fits_serial()
+  {
+    runFits(false);
+  }
+
+  void test_individual_fits_parallel()
+  {
+    runFits(true);
+  }
+
+private:
+  static const int numSpectra = 2000;
+
+  /// A Gaussian peak on a flat background that moves with the spectrum index
+  struct GaussianSpectra
+  {
+    double operator()(double x, int spec)
+    {
+      const double c = 4. + 2.*spec/numSpectra;
+      return 0.5 + 3.*exp(-0.5*(x-c)*(x-c)/0.04);
+    }
+  };
+
+  void runFits(bool parallel)
+  {
+    std::ostringstream input;
+    input << "PlotPeakPerformance,v1:" << numSpectra;
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input",input.str());
+    alg.setPropertyValue("OutputWorkspace","PlotPeakResult");
+    alg.setPropertyValue("FitType","Individual");
+    alg.setProperty("Parallel",parallel);
+    alg.setPropertyValue("Function","name=FlatBackground,A0=0.4;name=Gaussian,PeakCentre=5,Height=2.5,Sigma=0.25");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    TWS_type result = WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+    TS_ASSERT_EQUALS(result->rowCount(), numSpectra);
+  }
+};
+
 #endif /*PLOTPEAKBYLOGVALUETEST_H_*/
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/GroupingWorkspace.h"
 
 #include <map>
+#include <set>
 
 #include <Poco/SAX/ContentHandler.h>
 
@@ -185,6 +186,18 @@ private:
   void processMatrixWorkspace(API::MatrixWorkspace_const_sptr groupWS,
                               API::MatrixWorkspace_const_sptr workspace,
                               std::vector<int64_t> &unUsedSpec);
+  /// build a table of workspace indices indexed by detector ID
+  void getDetectorIndexTable(API::MatrixWorkspace_const_sptr workspace,
+                             std::vector<size_t> &table,
+                             detid_t &offset) const;
+  /// add the workspace indices of some detectors to a group
+  void addDetectorIndices(const std::set<detid_t> &detIDs,
+                          const std::vector<size_t> &detIdToWi,
+                          const detid_t offset,
+                          std::vector<size_t> &groupIndices,
+                          std::vector<int64_t> &unUsedSpec);
+  /// sort a list of workspace indices and remove repeats
+  void sortAndRemoveDuplicates(std::vector<size_t> &indices);
   /// used while reading the file turns the string into an integer number (if
   /// possible), white space and # comments ignored
   int readInt(std::string line);
@@ -214,6 +227,16 @@ private:
   size_t formGroupsEvent(DataObjects::EventWorkspace_const_sptr inputWS,
                          DataObjects::EventWorkspace_sptr outputWS,
                          const double prog4Copy);
+  /// List the groups in order so that they can be formed in parallel
+  void getGroupList(std::vector<storage_map::const_iterator> &groups) const;
+  /// Count the spectra in a group that are not masked
+  size_t countNonMaskedSpectra(API::MatrixWorkspace_const_sptr inputWS,
+                               const std::vector<size_t> &indices) const;
+  /// Move the progress bar on after forming a number of groups
+  void reportGroupProgress(const double prog4Copy);
+  /// Divide the groups by their number of unmasked spectra if averaging
+  void averageGroups(API::MatrixWorkspace_sptr outputWS,
+                     const std::vector<size_t> &nonMaskedSpectra);
 
   /// Copy the data data in ungrouped histograms from the input workspace to the
   /// output
@@ -6,6 +6,7 @@
 #include <vector>
 #include "MantidAPI/IFileLoader.h"
 #include "MantidKernel/BinaryFile.h"
+#include "MantidKernel/MemoryMappedFile.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Events.h"
 
@@ -142,6 +143,8 @@ private:
 
   /// Handles loading from the event file
   Mantid::Kernel::BinaryFile<DasEvent> *eventfile;
+  /// Maps the event file so the events can be processed without copying
+  Mantid::Kernel::MemoryMappedFile m_eventFileMap;
   std::size_t num_events; ///< The number of events in the file
   std::size_t num_pulses; ///<the number of pulses
   uint32_t numpixel;      ///<the number of pixels
@@ -208,7 +211,7 @@ private:
 
   void procEventsLinear(DataObjects::EventWorkspace_sptr &workspace,
                         std::vector<DataObjects::TofEvent> **arrayOfVectors,
-                        DasEvent *event_buffer,
+                        const DasEvent *event_buffer,
                         size_t current_event_buffer_size, size_t fileOffset,
                         bool dbprint);
 
@@ -79,6 +79,8 @@ private:
   void init();
   void exec();
   void execPeaks(DataObjects::PeaksWorkspace_sptr WS);
+  void maskSpectra(const API::MatrixWorkspace_sptr WS,
+                   std::vector<size_t> indexList);
   void fillIndexListFromSpectra(std::vector<size_t> &indexList,
                                 const std::vector<specid_t> &spectraList,
                                 const API::MatrixWorkspace_sptr WS);
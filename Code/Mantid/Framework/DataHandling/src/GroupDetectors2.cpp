@@ -9,6 +9,7 @@
 #include "MantidAPI/FileProperty.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidDataHandling/LoadDetectorsGroupingFile.h"
 
@@ -21,6 +22,8 @@
 #include <set>
 #include <vector>
 #include <numeric>
+#include <algorithm>
+#include <limits>
 
 #include <Poco/StringTokenizer.h>
 #include <Poco/File.h>
@@ -52,6 +55,11 @@ const double GroupDetectors2::OPENINGFILE = 0.03;
 // progress > 100%
 const double GroupDetectors2::READFILE = 0.15;
 
+namespace {
+/// The entry for a detector ID that is in no spectrum of the workspace
+const size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+}
+
 void GroupDetectors2::init() {
   declareProperty(new WorkspaceProperty<MatrixWorkspace>(
                       "InputWorkspace", "", Direction::Input,
@@ -573,10 +581,12 @@ void GroupDetectors2::processGroupingWorkspace(
     GroupingWorkspace_const_sptr groupWS,
     API::MatrixWorkspace_const_sptr workspace,
     std::vector<int64_t> &unUsedSpec) {
-  detid2index_map detIdToWiMap = workspace->getDetectorIDToWorkspaceIndexMap();
+  std::vector<size_t> detIdToWi;
+  detid_t offset(0);
+  getDetectorIndexTable(workspace, detIdToWi, offset);
 
-  typedef std::map<size_t, std::set<size_t>> Group2SetMapType;
-  Group2SetMapType group2WSIndexSetmap;
+  typedef std::map<size_t, std::vector<size_t>> Group2IndicesMapType;
+  Group2IndicesMapType group2WSIndices;
 
   const size_t nspec = groupWS->getNumberHistograms();
   for (size_t i = 0; i < nspec; ++i) {
@@ -584,51 +594,18 @@ void GroupDetectors2::processGroupingWorkspace(
     size_t groupid = static_cast<int>(groupWS->readY(i)[0]);
     // group 0 is are unused spectra - don't process them
     if (groupid > 0) {
-      if (group2WSIndexSetmap.find(groupid) == group2WSIndexSetmap.end()) {
-        // not found - create an empty set
-        group2WSIndexSetmap.insert(std::make_pair(groupid, std::set<size_t>()));
-      }
-      // get a reference to the set
-      std::set<size_t> &targetWSIndexSet = group2WSIndexSetmap[groupid];
-
-      // translate to detectors
-      std::vector<detid_t> det_ids;
-      try {
-        const Geometry::IDetector_const_sptr det = groupWS->getDetector(i);
-        Geometry::DetectorGroup_const_sptr detGroup =
-            boost::dynamic_pointer_cast<const Geometry::DetectorGroup>(det);
-        if (detGroup) {
-          det_ids = detGroup->getDetectorIDs();
-
-        } else {
-          det_ids.push_back(det->getID());
-        }
-
-        for (auto dit = det_ids.begin(); dit != det_ids.end(); ++dit) {
-          // translate detectors to target det ws indexes
-          detid_t det_id = *dit;
-          size_t targetWSIndex = detIdToWiMap[det_id];
-          targetWSIndexSet.insert(targetWSIndex);
-          // mark as used
-          if (unUsedSpec[targetWSIndex] != (USED)) {
-            unUsedSpec[targetWSIndex] = (USED);
-          }
-        }
-      } catch (Mantid::Kernel::Exception::NotFoundError) {
-        // the detector was not found - don't add it
-      }
+      // translate detectors to target det ws indexes
+      addDetectorIndices(groupWS->getSpectrum(i)->getDetectorIDs(), detIdToWi,
+                         offset, group2WSIndices[groupid], unUsedSpec);
     }
   }
 
   // Build m_GroupSpecInds (group -> list of ws indices)
-  for (auto dit = group2WSIndexSetmap.begin(); dit != group2WSIndexSetmap.end();
+  for (auto dit = group2WSIndices.begin(); dit != group2WSIndices.end();
        ++dit) {
-    size_t groupid = dit->first;
-    std::set<size_t> &targetWSIndexSet = dit->second;
-    std::vector<size_t> tempv;
-    tempv.assign(targetWSIndexSet.begin(), targetWSIndexSet.end());
+    sortAndRemoveDuplicates(dit->second);
     m_GroupSpecInds.insert(
-        std::make_pair(static_cast<specid_t>(groupid), tempv));
+        std::make_pair(static_cast<specid_t>(dit->first), dit->second));
   }
 
   return;
@@ -646,65 +623,85 @@ void
 GroupDetectors2::processMatrixWorkspace(MatrixWorkspace_const_sptr groupWS,
                                         MatrixWorkspace_const_sptr workspace,
                                         std::vector<int64_t> &unUsedSpec) {
-  detid2index_map detIdToWiMap = workspace->getDetectorIDToWorkspaceIndexMap();
-
-  typedef std::map<size_t, std::set<size_t>> Group2SetMapType;
-  Group2SetMapType group2WSIndexSetmap;
+  std::vector<size_t> detIdToWi;
+  detid_t offset(0);
+  getDetectorIndexTable(workspace, detIdToWi, offset);
 
   const size_t nspec = groupWS->getNumberHistograms();
   for (size_t i = 0; i < nspec; ++i) {
-    // read spectra from groupingws
-    size_t groupid = i;
+    // Only spectra made of more than one detector define a group
+    const std::set<detid_t> &detIDs = groupWS->getSpectrum(i)->getDetectorIDs();
+    if (detIDs.size() < 2)
+      continue;
 
-    if (group2WSIndexSetmap.find(groupid) == group2WSIndexSetmap.end()) {
-      // not found - create an empty set
-      group2WSIndexSetmap.insert(std::make_pair(groupid, std::set<size_t>()));
+    // translate detectors to target det ws indexes
+    std::vector<size_t> targetWSIndices;
+    addDetectorIndices(detIDs, detIdToWi, offset, targetWSIndices, unUsedSpec);
+    if (!targetWSIndices.empty()) {
+      sortAndRemoveDuplicates(targetWSIndices);
+      m_GroupSpecInds.insert(
+          std::make_pair(static_cast<specid_t>(i), targetWSIndices));
     }
-    // get a reference to the set
-    std::set<size_t> &targetWSIndexSet = group2WSIndexSetmap[groupid];
+  }
 
-    // translate to detectors
-    std::vector<detid_t> det_ids;
-    try {
-      const Geometry::IDetector_const_sptr det = groupWS->getDetector(i);
-
-      Geometry::DetectorGroup_const_sptr detGroup =
-          boost::dynamic_pointer_cast<const Geometry::DetectorGroup>(det);
-
-      if (detGroup) {
-        det_ids = detGroup->getDetectorIDs();
-
-        for (auto dit = det_ids.begin(); dit != det_ids.end(); ++dit) {
-          // translate detectors to target det ws indexes
-          detid_t det_id = *dit;
-          size_t targetWSIndex = detIdToWiMap[det_id];
-          targetWSIndexSet.insert(targetWSIndex);
-          // mark as used
-          if (unUsedSpec[targetWSIndex] != (USED)) {
-            unUsedSpec[targetWSIndex] = (USED);
-          }
-        }
-      }
-    } catch (Mantid::Kernel::Exception::NotFoundError) {
-      // the detector was not found - don't add it
-    }
+  return;
+}
+
+/** Build a table that gives the workspace index of a detector, so that
+*  detectors can be looked up without searching a map
+*  @param workspace :: the workspace the indices refer to
+*  @param table :: filled with the workspace index of each detector ID plus
+* offset, or NOT_FOUND
+*  @param offset :: set to the value to add to a detector ID to index the table
+*/
+void GroupDetectors2::getDetectorIndexTable(
+    API::MatrixWorkspace_const_sptr workspace, std::vector<size_t> &table,
+    detid_t &offset) const {
+  try {
+    workspace->getDetectorIDToWorkspaceIndexVector(table, offset);
+  } catch (std::runtime_error &) {
+    // The instrument has no detectors, so none of them can be grouped
+    table.clear();
+    offset = 0;
   }
+}
 
-  // Build m_GroupSpecInds (group -> list of ws indices)
-  for (auto dit = group2WSIndexSetmap.begin(); dit != group2WSIndexSetmap.end();
-       ++dit) {
-    size_t groupid = dit->first;
-    std::set<size_t> &targetWSIndexSet = dit->second;
-    if (!targetWSIndexSet.empty()) {
-      std::vector<size_t> tempv;
-      tempv.assign(targetWSIndexSet.begin(), targetWSIndexSet.end());
-      m_GroupSpecInds.insert(
-          std::make_pair(static_cast<specid_t>(groupid), tempv));
-    }
+/** Add the workspace indices of the given detectors to a group and mark the
+*  spectra as used. Detectors that are not in the workspace are skipped.
+*  @param detIDs :: the detectors to add
+*  @param detIdToWi :: the table from getDetectorIndexTable()
+*  @param offset :: the offset from getDetectorIndexTable()
+*  @param groupIndices :: the workspace indices of the group, appended to
+*  @param unUsedSpec :: the list of spectra indexes that have been not included
+* in a group (so far)
+*/
+void GroupDetectors2::addDetectorIndices(const std::set<detid_t> &detIDs,
+                                         const std::vector<size_t> &detIdToWi,
+                                         const detid_t offset,
+                                         std::vector<size_t> &groupIndices,
+                                         std::vector<int64_t> &unUsedSpec) {
+  const int64_t tableSize = static_cast<int64_t>(detIdToWi.size());
+  for (auto dit = detIDs.begin(); dit != detIDs.end(); ++dit) {
+    const int64_t tableIndex = static_cast<int64_t>(*dit) + offset;
+    if (tableIndex < 0 || tableIndex >= tableSize)
+      continue;
+    const size_t targetWSIndex = detIdToWi[tableIndex];
+    if (targetWSIndex == NOT_FOUND)
+      continue;
+    groupIndices.push_back(targetWSIndex);
+    // mark as used
+    unUsedSpec[targetWSIndex] = (USED);
   }
+}
 
-  return;
+/** Sort a list of workspace indices and remove repeated entries
+*  @param indices :: the list to tidy up
+*/
+void GroupDetectors2::sortAndRemoveDuplicates(std::vector<size_t> &indices) {
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
 }
+
 /** The function expects that the string passed to it contains an integer
 * number,
 *  it reads the number and returns it
@@ -901,26 +898,21 @@ double GroupDetectors2::fileReadProg(
 size_t GroupDetectors2::formGroups(API::MatrixWorkspace_const_sptr inputWS,
                                    API::MatrixWorkspace_sptr outputWS,
                                    const double prog4Copy) {
-  // get "Behaviour" string
-  const std::string behaviour = getProperty("Behaviour");
-  int bhv = 0;
-  if (behaviour == "Average")
-    bhv = 1;
-
-  API::MatrixWorkspace_sptr beh = API::WorkspaceFactory::Instance().create(
-      "Workspace2D", static_cast<int>(m_GroupSpecInds.size()), 1, 1);
-
-  g_log.debug() << name() << ": Preparing to group spectra into "
-                << m_GroupSpecInds.size() << " groups\n";
-
-  // where we are copying spectra to, we start copying to the start of the
-  // output workspace
-  size_t outIndex = 0;
-  // Only used for averaging behaviour. We may have a 1:1 map where a Divide
-  // would be waste as it would be just dividing by 1
-  bool requireDivide(false);
-  for (storage_map::const_iterator it = m_GroupSpecInds.begin();
-       it != m_GroupSpecInds.end(); ++it) {
+  std::vector<storage_map::const_iterator> groups;
+  getGroupList(groups);
+  const int numGroups = static_cast<int>(groups.size());
+
+  g_log.debug() << name() << ": Preparing to group spectra into " << numGroups
+                << " groups\n";
+
+  // Keep track of number of detectors required for masking
+  std::vector<size_t> nonMaskedSpectra(groups.size(), 0);
+  // Each group is written to its own output spectrum, the one at the same
+  // position as the group in the list, so the groups are formed in parallel
+  PARALLEL_FOR2(inputWS, outputWS)
+  for (int outIndex = 0; outIndex < numGroups; ++outIndex) {
+    PARALLEL_START_INTERUPT_REGION
+    const storage_map::const_iterator it = groups[outIndex];
     // This is the grouped spectrum
     ISpectrum *outSpec = outputWS->getSpectrum(outIndex);
 
@@ -934,71 +926,44 @@ size_t GroupDetectors2::formGroups(API::MatrixWorkspace_const_sptr inputWS,
     outSpec->dataX() = inputWS->readX(0);
 
     // the Y values and errors from spectra being grouped are combined in the
-    // output spectrum
+    // output spectrum. The squares of the errors are summed and the square
+    // root is taken once the whole group has been added.
     MantidVec &firstY = outSpec->dataY();
-    // Keep track of number of detectors required for masking
-    size_t nonMaskedSpectra(0);
-    beh->dataX(outIndex)[0] = 0.0;
-    beh->dataE(outIndex)[0] = 0.0;
+    MantidVec &firstE = outSpec->dataE();
+    const size_t nBins = firstY.size();
     for (std::vector<size_t>::const_iterator wsIter = it->second.begin();
          wsIter != it->second.end(); ++wsIter) {
-      const size_t originalWI = *wsIter;
-
       // detectors to add to firstSpecNum
-      const ISpectrum *fromSpectrum = inputWS->getSpectrum(originalWI);
+      const ISpectrum *fromSpectrum = inputWS->getSpectrum(*wsIter);
 
       // Add up all the Y spectra and store the result in the first one
-      MantidVec::iterator fEit = outSpec->dataE().begin();
-      MantidVec::const_iterator Yit = fromSpectrum->dataY().begin();
-      MantidVec::const_iterator Eit = fromSpectrum->dataE().begin();
-      for (auto fYit = firstY.begin(); fYit != firstY.end();
-           ++fYit, ++fEit, ++Yit, ++Eit) {
-        *fYit += *Yit;
+      const MantidVec &Y = fromSpectrum->dataY();
+      const MantidVec &E = fromSpectrum->dataE();
+      for (size_t j = 0; j < nBins; ++j) {
+        firstY[j] += Y[j];
         // Assume 'normal' (i.e. Gaussian) combination of errors
-        *fEit = std::sqrt((*fEit) * (*fEit) + (*Eit) * (*Eit));
+        firstE[j] += E[j] * E[j];
       }
 
       // detectors to add to the output spectrum
       outSpec->addDetectorIDs(fromSpectrum->getDetectorIDs());
-      try {
-        Geometry::IDetector_const_sptr det = inputWS->getDetector(originalWI);
-        if (!det->isMasked())
-          ++nonMaskedSpectra;
-      } catch (Exception::NotFoundError &) {
-        // If a detector cannot be found, it cannot be masked
-        ++nonMaskedSpectra;
-      }
     }
-    if (nonMaskedSpectra == 0)
-      ++nonMaskedSpectra; // Avoid possible divide by zero
-    if (!requireDivide)
-      requireDivide = (nonMaskedSpectra > 1);
-    beh->dataY(outIndex)[0] = static_cast<double>(nonMaskedSpectra);
-
-    // make regular progress reports and check for cancelling the algorithm
-    if (outIndex % INTERVAL == 0) {
-      m_FracCompl += INTERVAL * prog4Copy;
-      if (m_FracCompl > 1.0)
-        m_FracCompl = 1.0;
-      progress(m_FracCompl);
-      interruption_point();
-    }
-    outIndex++;
+    for (size_t j = 0; j < nBins; ++j)
+      firstE[j] = std::sqrt(firstE[j]);
+    nonMaskedSpectra[outIndex] = countNonMaskedSpectra(inputWS, it->second);
+
+    // make regular progress reports
+    if (outIndex % INTERVAL == 0)
+      reportGroupProgress(prog4Copy);
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 
-  if (bhv == 1 && requireDivide) {
-    g_log.debug() << "Running Divide algorithm to perform averaging.\n";
-    Mantid::API::IAlgorithm_sptr divide = createChildAlgorithm("Divide");
-    divide->initialize();
-    divide->setProperty<API::MatrixWorkspace_sptr>("LHSWorkspace", outputWS);
-    divide->setProperty<API::MatrixWorkspace_sptr>("RHSWorkspace", beh);
-    divide->setProperty<API::MatrixWorkspace_sptr>("OutputWorkspace", outputWS);
-    divide->execute();
-  }
+  averageGroups(outputWS, nonMaskedSpectra);
 
-  g_log.debug() << name() << " created " << outIndex
+  g_log.debug() << name() << " created " << numGroups
                 << " new grouped spectra\n";
-  return outIndex;
+  return groups.size();
 }
 
 /**
@@ -1014,26 +979,21 @@ size_t
 GroupDetectors2::formGroupsEvent(DataObjects::EventWorkspace_const_sptr inputWS,
                                  DataObjects::EventWorkspace_sptr outputWS,
                                  const double prog4Copy) {
-  // get "Behaviour" string
-  const std::string behaviour = getProperty("Behaviour");
-  int bhv = 0;
-  if (behaviour == "Average")
-    bhv = 1;
-
-  API::MatrixWorkspace_sptr beh = API::WorkspaceFactory::Instance().create(
-      "Workspace2D", static_cast<int>(m_GroupSpecInds.size()), 1, 1);
-
-  g_log.debug() << name() << ": Preparing to group spectra into "
-                << m_GroupSpecInds.size() << " groups\n";
-
-  // where we are copying spectra to, we start copying to the start of the
-  // output workspace
-  size_t outIndex = 0;
-  // Only used for averaging behaviour. We may have a 1:1 map where a Divide
-  // would be waste as it would be just dividing by 1
-  bool requireDivide(false);
-  for (storage_map::const_iterator it = m_GroupSpecInds.begin();
-       it != m_GroupSpecInds.end(); ++it) {
+  std::vector<storage_map::const_iterator> groups;
+  getGroupList(groups);
+  const int numGroups = static_cast<int>(groups.size());
+
+  g_log.debug() << name() << ": Preparing to group spectra into " << numGroups
+                << " groups\n";
+
+  // Keep track of number of detectors required for masking
+  std::vector<size_t> nonMaskedSpectra(groups.size(), 0);
+  // Each group is written to its own output event list, so the groups are
+  // formed in parallel
+  PRAGMA_OMP(parallel for schedule(dynamic, 64))
+  for (int outIndex = 0; outIndex < numGroups; ++outIndex) {
+    PARALLEL_START_INTERUPT_REGION
+    const storage_map::const_iterator it = groups[outIndex];
     // This is the grouped spectrum
     EventList &outEL = outputWS->getEventList(outIndex);
 
@@ -1042,61 +1002,130 @@ GroupDetectors2::formGroupsEvent(DataObjects::EventWorkspace_const_sptr inputWS,
     // Start fresh with no detector IDs
     outEL.clearDetectorIDs();
 
-    // the Y values and errors from spectra being grouped are combined in the
-    // output spectrum
-    // Keep track of number of detectors required for masking
-    size_t nonMaskedSpectra(0);
-    beh->dataX(outIndex)[0] = 0.0;
-    beh->dataE(outIndex)[0] = 0.0;
+    // Switch the output to the final event type and allocate it once before
+    // the lists of the group are appended
+    size_t numEvents = outEL.getNumberEvents();
+    int eventType = static_cast<int>(outEL.getEventType());
     for (std::vector<size_t>::const_iterator wsIter = it->second.begin();
          wsIter != it->second.end(); ++wsIter) {
-      const size_t originalWI = *wsIter;
+      const EventList &fromEL = inputWS->getEventList(*wsIter);
+      numEvents += fromEL.getNumberEvents();
+      eventType = std::max(eventType, static_cast<int>(fromEL.getEventType()));
+    }
+    outEL.switchTo(static_cast<EventType>(eventType));
+    outEL.reserve(numEvents);
 
-      const EventList &fromEL = inputWS->getEventList(originalWI);
+    for (std::vector<size_t>::const_iterator wsIter = it->second.begin();
+         wsIter != it->second.end(); ++wsIter) {
+      const EventList &fromEL = inputWS->getEventList(*wsIter);
       // Add the event lists with the operator
       outEL += fromEL;
 
       // detectors to add to the output spectrum
       outEL.addDetectorIDs(fromEL.getDetectorIDs());
-      try {
-        Geometry::IDetector_const_sptr det = inputWS->getDetector(originalWI);
-        if (!det->isMasked())
-          ++nonMaskedSpectra;
-      } catch (Exception::NotFoundError &) {
-        // If a detector cannot be found, it cannot be masked
-        ++nonMaskedSpectra;
-      }
     }
-    if (nonMaskedSpectra == 0)
-      ++nonMaskedSpectra; // Avoid possible divide by zero
-    if (!requireDivide)
-      requireDivide = (nonMaskedSpectra > 1);
-    beh->dataY(outIndex)[0] = static_cast<double>(nonMaskedSpectra);
+    nonMaskedSpectra[outIndex] = countNonMaskedSpectra(inputWS, it->second);
 
-    // make regular progress reports and check for cancelling the algorithm
-    if (outIndex % INTERVAL == 0) {
-      m_FracCompl += INTERVAL * prog4Copy;
-      if (m_FracCompl > 1.0)
-        m_FracCompl = 1.0;
-      progress(m_FracCompl);
-      interruption_point();
+    // make regular progress reports
+    if (outIndex % INTERVAL == 0)
+      reportGroupProgress(prog4Copy);
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  averageGroups(outputWS, nonMaskedSpectra);
+
+  g_log.debug() << name() << " created " << numGroups
+                << " new grouped spectra\n";
+  return groups.size();
+}
+
+/** Make a list of the groups in m_GroupSpecInds, in order, so that they can
+*  be shared out by index between threads
+*  @param groups :: filled with one iterator per group
+*/
+void GroupDetectors2::getGroupList(
+    std::vector<storage_map::const_iterator> &groups) const {
+  groups.clear();
+  groups.reserve(m_GroupSpecInds.size());
+  for (storage_map::const_iterator it = m_GroupSpecInds.begin();
+       it != m_GroupSpecInds.end(); ++it)
+    groups.push_back(it);
+}
+
+/** Count the spectra in a group whose detectors are not masked, for use when
+*  averaging
+*  @param inputWS :: user selected input workspace for the algorithm
+*  @param indices :: the workspace indices of the group
+*  @return the number of spectra that are not masked, at least one to avoid a
+* divide by zero
+*/
+size_t GroupDetectors2::countNonMaskedSpectra(
+    API::MatrixWorkspace_const_sptr inputWS,
+    const std::vector<size_t> &indices) const {
+  size_t nonMaskedSpectra(0);
+  for (std::vector<size_t>::const_iterator wsIter = indices.begin();
+       wsIter != indices.end(); ++wsIter) {
+    try {
+      Geometry::IDetector_const_sptr det = inputWS->getDetector(*wsIter);
+      if (!det->isMasked())
+        ++nonMaskedSpectra;
+    } catch (Exception::NotFoundError &) {
+      // If a detector cannot be found, it cannot be masked
+      ++nonMaskedSpectra;
     }
-    outIndex++;
   }
+  if (nonMaskedSpectra == 0)
+    ++nonMaskedSpectra; // Avoid possible divide by zero
+  return nonMaskedSpectra;
+}
+
+/** Advance the progress bar by one interval of groups. Safe to call from
+*  several threads.
+*  @param prog4Copy :: the amount of algorithm progress to attribute to moving a
+* single spectra
+*/
+void GroupDetectors2::reportGroupProgress(const double prog4Copy) {
+  PARALLEL_CRITICAL(GroupDetectors2_progress) {
+    m_FracCompl += INTERVAL * prog4Copy;
+    if (m_FracCompl > 1.0)
+      m_FracCompl = 1.0;
+    progress(m_FracCompl);
+  }
+}
 
-  if (bhv == 1 && requireDivide) {
-    g_log.debug() << "Running Divide algorithm to perform averaging.\n";
-    Mantid::API::IAlgorithm_sptr divide = createChildAlgorithm("Divide");
-    divide->initialize();
-    divide->setProperty<API::MatrixWorkspace_sptr>("LHSWorkspace", outputWS);
-    divide->setProperty<API::MatrixWorkspace_sptr>("RHSWorkspace", beh);
-    divide->setProperty<API::MatrixWorkspace_sptr>("OutputWorkspace", outputWS);
-    divide->execute();
+/** If the Behaviour property is "Average", divide each group by the number of
+*  spectra in it that are not masked
+*  @param outputWS :: user selected output workspace for the algorithm
+*  @param nonMaskedSpectra :: the number of unmasked spectra in each group
+*/
+void GroupDetectors2::averageGroups(
+    API::MatrixWorkspace_sptr outputWS,
+    const std::vector<size_t> &nonMaskedSpectra) {
+  const std::string behaviour = getProperty("Behaviour");
+  if (behaviour != "Average")
+    return;
+  // We may have a 1:1 map where a Divide would be waste as it would be just
+  // dividing by 1
+  if (nonMaskedSpectra.empty() ||
+      *std::max_element(nonMaskedSpectra.begin(), nonMaskedSpectra.end()) < 2)
+    return;
+
+  API::MatrixWorkspace_sptr beh = API::WorkspaceFactory::Instance().create(
+      "Workspace2D", static_cast<int>(nonMaskedSpectra.size()), 1, 1);
+  for (size_t i = 0; i < nonMaskedSpectra.size(); ++i) {
+    beh->dataX(i)[0] = 0.0;
+    beh->dataE(i)[0] = 0.0;
+    beh->dataY(i)[0] = static_cast<double>(nonMaskedSpectra[i]);
   }
 
-  g_log.debug() << name() << " created " << outIndex
-                << " new grouped spectra\n";
-  return outIndex;
+  g_log.debug() << "Running Divide algorithm to perform averaging.\n";
+  Mantid::API::IAlgorithm_sptr divide = createChildAlgorithm("Divide");
+  divide->initialize();
+  divide->setProperty<API::MatrixWorkspace_sptr>("LHSWorkspace", outputWS);
+  divide->setProperty<API::MatrixWorkspace_sptr>("RHSWorkspace", beh);
+  divide->setProperty<API::MatrixWorkspace_sptr>("OutputWorkspace", outputWS);
+  divide->execute();
 }
 
 /**
@@ -20,6 +20,7 @@
 #include "MantidAPI/RegisterFileLoader.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/Tracer.h"
 
 using std::endl;
 using std::map;
@@ -745,6 +746,7 @@ public:
 
   //---------------------------------------------------------------------------------------------------
   void run() {
+    TraceScope trace("Read " + entry_name, "io");
     // The vectors we will be filling
     std::vector<uint64_t> *event_index_ptr = new std::vector<uint64_t>();
     std::vector<uint64_t> &event_index = *event_index_ptr;
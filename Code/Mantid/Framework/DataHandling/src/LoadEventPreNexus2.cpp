@@ -273,6 +273,11 @@ void LoadEventPreNexus2::init() {
   setPropertySettings("TotalChunks",
                       new VisibleWhenProperty("ChunkNumber", IS_NOT_DEFAULT));
 
+  declareProperty("UseMemoryMapping", true,
+                  "Map the event file into memory and process the events in "
+                  "place, instead of copying blocks of the file into buffers. "
+                  "Falls back to reading the file if it cannot be mapped.");
+
   std::vector<std::string> propOptions;
   propOptions.push_back("Auto");
   propOptions.push_back("Serial");
@@ -746,6 +751,13 @@ LoadEventPreNexus2::procEvents(DataObjects::EventWorkspace_sptr &workspace) {
   if (parallelProcessing)
     numThreads = size_t(PARALLEL_GET_MAX_THREADS);
 
+  // Events mapped straight from the file, or NULL to read them into buffers
+  const DasEvent *mappedEvents = NULL;
+  if (m_eventFileMap.data()) {
+    mappedEvents = reinterpret_cast<const DasEvent *>(m_eventFileMap.data());
+    m_eventFileMap.advise(MemoryMappedFile::Sequential);
+  }
+
   partWorkspaces.resize(numThreads);
   buffers.resize(numThreads);
   eventVectors = new EventVector_pt *[numThreads];
@@ -769,8 +781,8 @@ LoadEventPreNexus2::procEvents(DataObjects::EventWorkspace_sptr &workspace) {
       } else
         partWS = workspace;
 
-      // Allocate the buffers
-      buffers[i] = new DasEvent[loadBlockSize];
+      // Allocate the buffers, unless the events are read from the mapping
+      buffers[i] = mappedEvents ? NULL : new DasEvent[loadBlockSize];
 
       // For each partial workspace, make an array where index = detector ID and
       // value = pointer to the events vector
@@ -822,17 +834,33 @@ LoadEventPreNexus2::procEvents(DataObjects::EventWorkspace_sptr &workspace) {
               ? (max_events - (numBlocks - 1) * loadBlockSize)
               : loadBlockSize;
 
-      // Load this chunk of event data (critical block)
-      PARALLEL_CRITICAL(LoadEventPreNexus2_fileAccess) {
-        current_event_buffer_size = eventfile->loadBlockAt(
-            event_buffer, fileOffset, current_event_buffer_size);
+      const DasEvent *event_data;
+      if (mappedEvents) {
+        // Use the block in place
+        current_event_buffer_size =
+            std::min(current_event_buffer_size, num_events - fileOffset);
+        event_data = mappedEvents + fileOffset;
+        m_eventFileMap.willNeed(fileOffset * sizeof(DasEvent),
+                                current_event_buffer_size * sizeof(DasEvent));
+      } else {
+        // Load this chunk of event data (critical block)
+        PARALLEL_CRITICAL(LoadEventPreNexus2_fileAccess) {
+          current_event_buffer_size = eventfile->loadBlockAt(
+              event_buffer, fileOffset, current_event_buffer_size);
+        }
+        event_data = event_buffer;
       }
 
       // This processes the events. Can be done in parallel!
       bool dbprint = m_dbOutput && (blockNum == m_dbOpBlockNumber);
-      procEventsLinear(ws, theseEventVectors, event_buffer,
+      procEventsLinear(ws, theseEventVectors, event_data,
                        current_event_buffer_size, fileOffset, dbprint);
 
+      // The block is done with: let its pages go
+      if (mappedEvents)
+        m_eventFileMap.release(fileOffset * sizeof(DasEvent),
+                               current_event_buffer_size * sizeof(DasEvent));
+
       // Report progress
       prog->report("Load Event PreNeXus");
 
@@ -841,6 +869,7 @@ LoadEventPreNexus2::procEvents(DataObjects::EventWorkspace_sptr &workspace) {
     PARALLEL_CHECK_INTERUPT_REGION
 
     g_log.debug() << tim << " to load the data." << std::endl;
+    m_eventFileMap.close();
 
     //-------------------------------------------------------------------------
     // MERGE WORKSPACES BACK TOGETHER
@@ -987,7 +1016,7 @@ LoadEventPreNexus2::procEvents(DataObjects::EventWorkspace_sptr &workspace) {
   */
 void LoadEventPreNexus2::procEventsLinear(
     DataObjects::EventWorkspace_sptr & /*workspace*/,
-    std::vector<TofEvent> **arrayOfVectors, DasEvent *event_buffer,
+    std::vector<TofEvent> **arrayOfVectors, const DasEvent *event_buffer,
     size_t current_event_buffer_size, size_t fileOffset, bool dbprint) {
   // Starting pulse time
   DateAndTime pulsetime;
@@ -1019,7 +1048,7 @@ void LoadEventPreNexus2::procEventsLinear(
   std::stringstream dbss;
   // size_t numwrongpid = 0;
   for (size_t i = 0; i < current_event_buffer_size; i++) {
-    DasEvent &temp = *(event_buffer + i);
+    const DasEvent &temp = *(event_buffer + i);
     PixelType pid = temp.pid;
     bool iswrongdetid = false;
 
@@ -1291,6 +1320,18 @@ void LoadEventPreNexus2::openEventFile(const std::string &filename) {
   num_events = eventfile->getNumElements();
   g_log.debug() << "File contains " << num_events << " event records.\n";
 
+  // Map the file to process the events in place
+  m_eventFileMap.close();
+  const bool useMapping = getProperty("UseMemoryMapping");
+  if (useMapping) {
+    try {
+      m_eventFileMap.open(filename);
+    } catch (std::runtime_error &err) {
+      g_log.warning() << err.what()
+                      << ". The event file is read in blocks instead.\n";
+    }
+  }
+
   // Check if we are only loading part of the event file
   const int chunk = getProperty("ChunkNumber");
   if (isEmpty(chunk)) // We are loading the whole file
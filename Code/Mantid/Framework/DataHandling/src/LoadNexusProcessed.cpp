@@ -21,6 +21,7 @@
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Tracer.h"
 #include "MantidNexus/NexusClasses.h"
 #include "MantidNexus/NexusFileIO.h"
 
@@ -1382,6 +1383,7 @@ API::Workspace_sptr LoadNexusProcessed::loadEntry(NXRoot &root,
                                                   const std::string &entry_name,
                                                   const double &progressStart,
                                                   const double &progressRange) {
+  Kernel::TraceScope trace("Read " + entry_name, "io");
   progress(progressStart, "Opening entry " + entry_name + "...");
 
   NXEntry mtd_entry = root.openEntry(entry_name);
@@ -8,6 +8,11 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidAPI/WorkspaceValidators.h"
 #include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ParameterFactory.h"
+
+#include <algorithm>
 #include <set>
 
 namespace Mantid {
@@ -168,16 +173,7 @@ void MaskDetectors::exec() {
     return;
   }
 
-  // Get a reference to the spectra-detector map to get hold of detector ID's
-  double prog = 0.0;
-  std::vector<size_t>::const_iterator wit;
-  for (wit = indexList.begin(); wit != indexList.end(); ++wit) {
-    WS->maskWorkspaceIndex(*wit);
-
-    // Progress
-    prog += (1.0 / static_cast<int>(indexList.size()));
-    progress(prog);
-  }
+  maskSpectra(WS, indexList);
 
   if (eventWS) {
     // Also clear the MRU for event workspaces.
@@ -277,6 +273,68 @@ void MaskDetectors::execPeaks(PeaksWorkspace_sptr WS) {
     }
   }
 }
+/**
+ * Mask a list of spectra in one go: the data of each spectrum are cleared and
+ * its detectors are flagged as masked. The spectra are cleared and their
+ * detectors looked up in parallel. The flags are then added in a single pass
+ * that shares one "masked" parameter between all of the detectors.
+ * @param WS :: The workspace to be masked
+ * @param indexList :: The workspace indices to mask
+ * @throw IndexError if an index is outside of the workspace
+ */
+void MaskDetectors::maskSpectra(const API::MatrixWorkspace_sptr WS,
+                                std::vector<size_t> indexList) {
+  if (indexList.empty())
+    return;
+  // A spectrum listed twice must still be cleared by only one thread
+  std::sort(indexList.begin(), indexList.end());
+  indexList.erase(std::unique(indexList.begin(), indexList.end()),
+                  indexList.end());
+  const size_t numHistograms = WS->getNumberHistograms();
+  if (indexList.back() >= numHistograms)
+    throw Kernel::Exception::IndexError(indexList.back(), numHistograms,
+                                        "MaskDetectors::maskSpectra,index");
+
+  // The flags are attached to the unparametrized detectors
+  Instrument_const_sptr instrument = WS->getInstrument();
+  const int numIndices = static_cast<int>(indexList.size());
+  std::vector<std::vector<const Geometry::IComponent *>> detectors(
+      indexList.size());
+  Progress prog(this, 0.0, 1.0, 2 * indexList.size());
+
+  PARALLEL_FOR1(WS)
+  for (int i = 0; i < numIndices; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    ISpectrum *spec = WS->getSpectrum(indexList[i]);
+    // Virtual method clears the spectrum as appropriate
+    spec->clearData();
+
+    const std::set<detid_t> &dets = spec->getDetectorIDs();
+    std::vector<const Geometry::IComponent *> &specDetectors = detectors[i];
+    specDetectors.reserve(dets.size());
+    for (auto it = dets.begin(); it != dets.end(); ++it) {
+      if (const Geometry::Detector *det =
+              dynamic_cast<const Geometry::Detector *>(
+                  instrument->getBaseDetector(*it)))
+        specDetectors.push_back(det);
+    }
+    prog.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  Geometry::ParameterMap &pmap = WS->instrumentParameters();
+  const Geometry::Parameter_sptr maskedParam =
+      Geometry::ParameterFactory::create(Geometry::ParameterMap::pBool(),
+                                         "masked");
+  maskedParam->fromString("1");
+  for (size_t i = 0; i < detectors.size(); ++i) {
+    for (auto it = detectors[i].begin(); it != detectors[i].end(); ++it)
+      pmap.add(*it, maskedParam);
+    prog.report();
+  }
+}
+
 /**
  * Convert a list of spectra numbers into the corresponding workspace indices
  * @param indexList :: An output index list from the given spectra list
@@ -147,8 +147,7 @@ void SaveNexus::runSaveNexusProcessed() {
   // If we're tracking history, add the entry before we save it to file
   if (trackingHistory()) {
     m_history->fillAlgorithmHistory(
-        this, Mantid::Kernel::DateAndTime::getCurrentTime(), -1,
-        Algorithm::g_execCount);
+        this, Mantid::Kernel::DateAndTime::getCurrentTime(), -1, m_execCount);
     if (!isChild()) {
       m_inputWorkspace->history().addHistory(m_history);
     }
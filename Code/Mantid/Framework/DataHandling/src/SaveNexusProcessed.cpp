@@ -293,8 +293,7 @@ void SaveNexusProcessed::doExec(Workspace_sptr inputWorkspace,
   // Switch to the Cpp API for the algorithm history
   if (trackingHistory()) {
     m_history->fillAlgorithmHistory(
-        this, Mantid::Kernel::DateAndTime::getCurrentTime(), -1,
-        Algorithm::g_execCount);
+        this, Mantid::Kernel::DateAndTime::getCurrentTime(), -1, m_execCount);
     if (!isChild()) {
       inputWorkspace->history().addHistory(m_history);
     }
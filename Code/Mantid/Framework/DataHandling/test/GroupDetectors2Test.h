@@ -26,6 +26,7 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 using Mantid::detid_t;
+using Mantid::specid_t;
 
 class GroupDetectors2Test : public CxxTest::TestSuite
 {
@@ -745,6 +746,73 @@ public:
     AnalysisDataService::Instance().remove(outputws);
  }
 
+  void test_GroupingWorkspace_combines_events_and_detectors()
+  {
+    std::string nxsWSname("GroupDetectors2TestCombine_ws");
+    std::string groupWSName(nxsWSname + "_GROUP");
+    std::string outputws = nxsWSname + "_grouped";
+
+    EventWorkspace_sptr inputW = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(2, 4);
+    for (size_t pix=0; pix < inputW->getNumberHistograms(); pix++)
+    {
+      for (size_t i = 0; i <= pix; ++i)
+        inputW->getEventList(pix).addEventQuickly( TofEvent(1000.0 + static_cast<double>(i)) );
+    }
+    // One weighted list makes its whole group weighted
+    inputW->getEventList(0).switchTo(WEIGHTED);
+    AnalysisDataService::Instance().addOrReplace(nxsWSname, inputW);
+
+    // Split the detectors into two groups and work out what each should hold
+    auto groupW = boost::make_shared<GroupingWorkspace>(inputW->getInstrument());
+    AnalysisDataService::Instance().addOrReplace(groupWSName, groupW);
+    const Mantid::detid2index_map detToIndex = inputW->getDetectorIDToWorkspaceIndexMap();
+    const size_t nPixels = groupW->getNumberHistograms();
+    std::vector<size_t> expectedEvents(2, 0), expectedDets(2, 0);
+    size_t weightedGroup(0);
+    for (size_t pix=0; pix < nPixels; pix++)
+    {
+      const size_t group = (2 * pix) / nPixels;
+      groupW->dataY(pix)[0] = static_cast<double>(group + 1);
+      const std::set<detid_t> & ids = groupW->getSpectrum(pix)->getDetectorIDs();
+      for (auto it = ids.begin(); it != ids.end(); ++it)
+      {
+        const size_t index = detToIndex.find(*it)->second;
+        expectedEvents[group] += inputW->getEventList(index).getNumberEvents();
+        ++expectedDets[group];
+        if (index == 0) weightedGroup = group;
+      }
+    }
+
+    GroupDetectors2 groupAlg;
+    groupAlg.initialize();
+    TS_ASSERT_THROWS_NOTHING( groupAlg.setPropertyValue("InputWorkspace", nxsWSname) );
+    TS_ASSERT_THROWS_NOTHING( groupAlg.setPropertyValue("OutputWorkspace", outputws) );
+    TS_ASSERT_THROWS_NOTHING( groupAlg.setPropertyValue("CopyGroupingFromWorkspace", groupWSName) );
+    TS_ASSERT_THROWS_NOTHING( groupAlg.setProperty("KeepUngroupedSpectra", false) );
+    TS_ASSERT_THROWS_NOTHING( groupAlg.setProperty("PreserveEvents", true) );
+    TS_ASSERT_THROWS_NOTHING( groupAlg.execute(); );
+    TS_ASSERT( groupAlg.isExecuted() );
+
+    EventWorkspace_const_sptr output;
+    TS_ASSERT_THROWS_NOTHING( output = AnalysisDataService::Instance().retrieveWS<const EventWorkspace>(outputws) );
+    TS_ASSERT( output );
+    if (!output) return;
+
+    TS_ASSERT_EQUALS( output->getNumberHistograms(), 2 );
+    for (size_t group = 0; group < 2; ++group)
+    {
+      const EventList & el = output->getEventList(group);
+      TS_ASSERT_EQUALS( el.getSpectrumNo(), static_cast<specid_t>(group + 1) );
+      TS_ASSERT_EQUALS( el.getNumberEvents(), expectedEvents[group] );
+      TS_ASSERT_EQUALS( el.getDetectorIDs().size(), expectedDets[group] );
+      TS_ASSERT_EQUALS( el.getEventType(), group == weightedGroup ? WEIGHTED : TOF );
+    }
+
+    AnalysisDataService::Instance().remove(nxsWSname);
+    AnalysisDataService::Instance().remove(groupWSName);
+    AnalysisDataService::Instance().remove(outputws);
+  }
+
   private:
     const std::string inputWS, outputBase, inputFile;
     enum constants { NHIST = 6, NBINS = 4 };
@@ -782,4 +850,66 @@ public:
 
 };
 
+class GroupDetectors2TestPerformance : public CxxTest::TestSuite
+{
+public:
+  static GroupDetectors2TestPerformance *createSuite() { return new GroupDetectors2TestPerformance(); }
+  static void destroySuite(GroupDetectors2TestPerformance *suite) { delete suite; }
+
+  GroupDetectors2TestPerformance()
+    : inputName("GroupDetectors2TestPerformance_in"), groupName("GroupDetectors2TestPerformance_group"),
+      outputName("GroupDetectors2TestPerformance_out")
+  {
+  }
+
+  void setUp()
+  {
+    // 10 banks of 100x100 pixels with 10 events each, 100 pixels to a group
+    EventWorkspace_sptr inputW = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(10, 100);
+    for (size_t pix=0; pix < inputW->getNumberHistograms(); pix++)
+    {
+      for (int i = 0; i < 10; ++i)
+        inputW->getEventList(pix).addEventQuickly( TofEvent(1000.0 + 100.0 * i) );
+    }
+    AnalysisDataService::Instance().addOrReplace(inputName, inputW);
+
+    auto groupW = boost::make_shared<GroupingWorkspace>(inputW->getInstrument());
+    for (size_t pix=0; pix < groupW->getNumberHistograms(); pix++)
+      groupW->dataY(pix)[0] = static_cast<double>(pix / 100 + 1);
+    AnalysisDataService::Instance().addOrReplace(groupName, groupW);
+  }
+
+  void tearDown()
+  {
+    AnalysisDataService::Instance().remove(inputName);
+    AnalysisDataService::Instance().remove(groupName);
+    AnalysisDataService::Instance().remove(outputName);
+  }
+
+  void test_group_events()
+  {
+    runGrouping(true);
+  }
+
+  void test_group_histograms()
+  {
+    runGrouping(false);
+  }
+
+private:
+  void runGrouping(const bool preserveEvents)
+  {
+    GroupDetectors2 groupAlg;
+    groupAlg.initialize();
+    groupAlg.setPropertyValue("InputWorkspace", inputName);
+    groupAlg.setPropertyValue("OutputWorkspace", outputName);
+    groupAlg.setPropertyValue("CopyGroupingFromWorkspace", groupName);
+    groupAlg.setProperty("PreserveEvents", preserveEvents);
+    TS_ASSERT_THROWS_NOTHING( groupAlg.execute() );
+    TS_ASSERT( groupAlg.isExecuted() );
+  }
+
+  const std::string inputName, groupName, outputName;
+};
+
 #endif /*GROUPDETECTORS2TEST_H_*/
@@ -8,7 +8,9 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/InstrumentDataService.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/Timer.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidAPI/Algorithm.h"
@@ -1008,4 +1010,63 @@ private:
 
 };
 
+class LoadEmptyInstrumentTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static LoadEmptyInstrumentTestPerformance *createSuite() { return new LoadEmptyInstrumentTestPerformance(); }
+  static void destroySuite(LoadEmptyInstrumentTestPerformance *suite) { delete suite; }
+
+  void setUp()
+  {
+    m_cacheSetting = ConfigService::Instance().getString("instrumentDefinition.binaryCache");
+  }
+
+  void tearDown()
+  {
+    ConfigService::Instance().setString("instrumentDefinition.binaryCache", m_cacheSetting);
+    InstrumentDataService::Instance().clear();
+  }
+
+  void test_cold_load_WISH()
+  {
+    compareColdLoads("WISH_Definition.xml");
+  }
+
+  void test_cold_load_SNAP()
+  {
+    compareColdLoads("SNAP_Definition.xml");
+  }
+
+private:
+  /// Time loads that start from an empty InstrumentDataService, parsing the
+  /// definition and then reading the binary instrument cache
+  void compareColdLoads(const std::string &filename)
+  {
+    ConfigService::Instance().setString("instrumentDefinition.binaryCache", "0");
+    const double parsed = coldLoad(filename);
+    ConfigService::Instance().setString("instrumentDefinition.binaryCache", "1");
+    const double written = coldLoad(filename);
+    const double cached = coldLoad(filename);
+    std::cout << "\n" << filename << ": parsed in " << parsed << " s, parsed and cached in "
+              << written << " s, loaded from cache in " << cached << " s\n";
+  }
+
+  double coldLoad(const std::string &filename)
+  {
+    InstrumentDataService::Instance().clear();
+    LoadEmptyInstrument loader;
+    loader.initialize();
+    loader.setPropertyValue("Filename", filename);
+    loader.setPropertyValue("OutputWorkspace", "LoadEmptyInstrumentTestPerformance");
+    Timer timer;
+    TS_ASSERT_THROWS_NOTHING(loader.execute());
+    const double elapsed = timer.elapsed();
+    TS_ASSERT(loader.isExecuted());
+    AnalysisDataService::Instance().remove("LoadEmptyInstrumentTestPerformance");
+    return elapsed;
+  }
+
+  std::string m_cacheSetting;
+};
+
 #endif /*LOADEMPTYINSTRUMENTTEST_H_*/
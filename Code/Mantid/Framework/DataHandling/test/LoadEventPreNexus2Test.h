@@ -237,6 +237,35 @@ public:
   }
 
 
+  void test_LoadPreNeXus_CNCS_memory_mapping_matches_buffered_reading()
+  {
+    std::string eventfile( "CNCS_7860_neutron_event.dat" );
+    EventWorkspace_sptr outputs[2];
+    for (int mapped = 0; mapped < 2; mapped++)
+    {
+      LoadEventPreNexus2 loader;
+      loader.initialize();
+      loader.setPropertyValue("EventFilename", eventfile);
+      loader.setPropertyValue("MappingFilename", "CNCS_TS_2008_08_18.dat");
+      loader.setPropertyValue("OutputWorkspace", "LoadPreNexus2_cncs_mapping");
+      loader.setPropertyValue("UseParallelProcessing", "Parallel");
+      loader.setProperty("UseMemoryMapping", mapped == 1);
+      TS_ASSERT( loader.execute() );
+      outputs[mapped] = boost::dynamic_pointer_cast<EventWorkspace>
+            (AnalysisDataService::Instance().retrieve("LoadPreNexus2_cncs_mapping"));
+    }
+    TS_ASSERT_EQUALS( outputs[1]->getNumberEvents(), 112266);
+    TS_ASSERT_EQUALS( outputs[0]->getNumberEvents(), outputs[1]->getNumberEvents());
+
+    std::size_t wkspIndex = 4348; // a good workspace index (with events)
+    EventList el0 = outputs[0]->getEventList(wkspIndex);
+    EventList el1 = outputs[1]->getEventList(wkspIndex);
+    el0.sortPulseTimeTOF();
+    el1.sortPulseTimeTOF();
+    TS_ASSERT( el0 == el1 );
+    AnalysisDataService::Instance().remove("LoadPreNexus2_cncs_mapping");
+  }
+
   void test_LoadPreNeXus_CNCS_SkipPixels()
   {
     std::string eventfile( "CNCS_7860_neutron_event.dat" );
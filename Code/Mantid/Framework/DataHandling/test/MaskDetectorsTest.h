@@ -13,6 +13,7 @@
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidGeometry/IDetector.h"
 
 using namespace Mantid::DataHandling;
@@ -412,8 +413,93 @@ public:
     AnalysisDataService::Instance().remove(existingMaskName);
   }
 
+  //---------------------------------------------------------------------------------------------
+  void test_Repeated_WorkspaceIndices_Are_Masked_Once()
+  {
+    setUpWS(false);
+
+    MaskDetectors masker;
+    masker.initialize();
+    masker.setPropertyValue("Workspace","testSpace");
+    masker.setPropertyValue("WorkspaceIndexList","3,2,0,3,2");
+    TS_ASSERT_THROWS_NOTHING( masker.execute());
+    TS_ASSERT( masker.isExecuted() );
+
+    MatrixWorkspace_const_sptr outputWS = AnalysisDataService::Instance().retrieveWS<const MatrixWorkspace>("testSpace");
+    check_outputWS(outputWS);
+
+    AnalysisDataService::Instance().remove("testSpace");
+  }
+
+  //---------------------------------------------------------------------------------------------
+  void test_DetectorList_Masks_Spectra_Of_Those_Detectors()
+  {
+    setUpWS(true);
+
+    MaskDetectors masker;
+    masker.initialize();
+    masker.setPropertyValue("Workspace","testSpace");
+    masker.setPropertyValue("DetectorList","0,2,3");
+    TS_ASSERT_THROWS_NOTHING( masker.execute());
+    TS_ASSERT( masker.isExecuted() );
+
+    MatrixWorkspace_const_sptr outputWS = AnalysisDataService::Instance().retrieveWS<const MatrixWorkspace>("testSpace");
+    check_outputWS(outputWS);
+
+    AnalysisDataService::Instance().remove("testSpace");
+  }
+
 private:
   MaskDetectors marker;
 };
 
+class MaskDetectorsTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static MaskDetectorsTestPerformance *createSuite() { return new MaskDetectorsTestPerformance(); }
+  static void destroySuite(MaskDetectorsTestPerformance *suite) { delete suite; }
+
+  void setUp()
+  {
+    // 10 banks of 100x100 pixels
+    EventWorkspace_sptr ws = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(10, 100);
+    AnalysisDataService::Instance().addOrReplace("MaskDetectorsTestPerformance", ws);
+  }
+
+  void tearDown()
+  {
+    AnalysisDataService::Instance().remove("MaskDetectorsTestPerformance");
+  }
+
+  void test_mask_every_other_spectrum()
+  {
+    MatrixWorkspace_sptr ws = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("MaskDetectorsTestPerformance");
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < ws->getNumberHistograms(); i += 2)
+      indices.push_back(i);
+
+    MaskDetectors masker;
+    masker.initialize();
+    masker.setPropertyValue("Workspace", "MaskDetectorsTestPerformance");
+    masker.setProperty("WorkspaceIndexList", indices);
+    TS_ASSERT_THROWS_NOTHING( masker.execute() );
+    TS_ASSERT( masker.isExecuted() );
+  }
+
+  void test_mask_detector_list()
+  {
+    MatrixWorkspace_sptr ws = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("MaskDetectorsTestPerformance");
+    std::vector<detid_t> detectors;
+    for (size_t i = 0; i < ws->getNumberHistograms(); i += 2)
+      detectors.push_back(*ws->getSpectrum(i)->getDetectorIDs().begin());
+
+    MaskDetectors masker;
+    masker.initialize();
+    masker.setPropertyValue("Workspace", "MaskDetectorsTestPerformance");
+    masker.setProperty("DetectorList", detectors);
+    TS_ASSERT_THROWS_NOTHING( masker.execute() );
+    TS_ASSERT( masker.isExecuted() );
+  }
+};
+
 #endif /*MARKDEADDETECTORSTEST_H_*/
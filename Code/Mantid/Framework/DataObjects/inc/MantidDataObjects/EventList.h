@@ -328,6 +328,12 @@ public:
                        std::map<int, EventList *> outputs, bool docorrection,
                        double toffactor, double tofshift) const;
 
+  /// Split events by full time against sorted, disjoint interval columns
+  void splitByFullTime(const Kernel::TimeSplitterColumns &splitter,
+                       const std::vector<EventList *> &outputs,
+                       EventList *unfiltered, bool docorrection,
+                       double toffactor, double tofshift) const;
+
   /// Split ...
   std::string splitByFullTimeMatrixSplitter(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
@@ -476,6 +482,13 @@ private:
                              std::map<int, EventList *> outputs,
                              typename std::vector<T> &events, bool docorrection,
                              double toffactor, double tofshift) const;
+  template <class T>
+  void splitByFullTimeSortedHelper(const Kernel::TimeSplitterColumns &splitter,
+                                   const std::vector<EventList *> &outputs,
+                                   EventList *unfiltered,
+                                   const typename std::vector<T> &events,
+                                   bool docorrection, double toffactor,
+                                   double tofshift) const;
   /// Split events by pulse time
   template <class T>
   void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
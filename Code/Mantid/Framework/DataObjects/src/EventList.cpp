@@ -913,16 +913,28 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
 /** Return the MRU list for this event list */
 EventWorkspaceMRU *EventList::getMRU() { return mru; }
 
-/** Reserve a certain number of entries in the (NOT-WEIGHTED) event list. Do NOT
- *call
- * on weighted events!
+/** Reserve a certain number of entries in the event list of the current
+ * event type. Switch to the final type first, as switching copies the events
+ * into a new vector.
  *
  * Calls std::vector<>::reserve() in order to pre-allocate the length of the
  *event list vector.
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  switch (eventType) {
+  case TOF:
+    this->events.reserve(num);
+    break;
+  case WEIGHTED:
+    this->weightedEvents.reserve(num);
+    break;
+  case WEIGHTED_NOTIME:
+    this->weightedEventsNoTime.reserve(num);
+    break;
+  }
+}
 
 // ---------------------------------------------------------
 /** Lock access to the data so that it does not get deleted while reading.
@@ -3981,6 +3993,174 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
   }
 }
 
+//------------------------------------------------------------------------------------------------
+/** Split a vector of TofEvent's or WeightedEvent's, sorted by pulse time and
+ * TOF, against interval columns.
+ *
+ * The events are merge-walked against the intervals: the interval of the
+ * previous event is the starting point of the search for the next, so a
+ * time-ordered list costs O(1) per event plus O(log n) per interval boundary
+ * crossed, however many intervals there are. An event whose full time goes
+ * backwards (possible when TOFs exceed the pulse period) is found with a
+ * binary search instead of being misassigned.
+ *
+ * A first pass finds the destination of every event, so that each output can
+ * be reserved to its final size before the events are copied.
+ *
+ * @param splitter :: sorted, disjoint intervals whose targets index outputs
+ * @param outputs :: destination lists, indexed by interval target
+ * @param unfiltered :: destination of events between or before intervals
+ * @param events :: either this->events or this->weightedEvents.
+ * @param docorrection :: flag to determine whether or not to apply correction
+ * @param toffactor :: factor multiplied to TOF for correcting event time from
+ *detector to sample
+ * @param tofshift :: shift in SECOND to TOF for correcting event time from
+ *detector to sample
+ */
+template <class T>
+void EventList::splitByFullTimeSortedHelper(
+    const Kernel::TimeSplitterColumns &splitter,
+    const std::vector<EventList *> &outputs, EventList *unfiltered,
+    const typename std::vector<T> &events, bool docorrection,
+    double toffactor, double tofshift) const {
+  const size_t numEvents = events.size();
+  const size_t numIntervals = splitter.size();
+  const size_t numOutputs = outputs.size();
+  const std::vector<int64_t> &starts = splitter.starts();
+  const std::vector<int> &targets = splitter.targets();
+  // Destinations: 0..numOutputs-1 are outputs, then unfiltered, -1 is dropped
+  const int unfilteredSlot = static_cast<int>(numOutputs);
+
+  // 1. Find where every event goes
+  std::vector<int> destinations(numEvents);
+  std::vector<size_t> counts(numOutputs + 1, 0);
+  size_t interval = 0;
+  for (size_t i = 0; i < numEvents; ++i) {
+    const T &event = events[i];
+    int64_t fulltime;
+    if (docorrection)
+      fulltime = calculateCorrectedFullTime(event.m_pulsetime.totalNanoseconds(),
+                                            event.m_tof, toffactor, tofshift);
+    else
+      fulltime = event.m_pulsetime.totalNanoseconds() +
+                 static_cast<int64_t>(event.m_tof * 1000);
+
+    interval = splitter.findInterval(fulltime, interval);
+    int slot(-1);
+    if (interval == numIntervals) {
+      // After the last interval: dropped, as in splitByFullTimeHelper
+      slot = -1;
+    } else if (fulltime < starts[interval]) {
+      slot = unfilteredSlot;
+    } else {
+      slot = targets[interval];
+      if (slot < 0 || slot >= unfilteredSlot)
+        slot = -1;
+    }
+    destinations[i] = slot;
+    if (slot >= 0)
+      ++counts[static_cast<size_t>(slot)];
+  }
+
+  // 2. Reserve the outputs
+  std::vector<std::vector<T> *> slotEvents(numOutputs + 1, NULL);
+  for (size_t j = 0; j < numOutputs; ++j) {
+    if (outputs[j])
+      getEventsFrom(*outputs[j], slotEvents[j]);
+  }
+  if (unfiltered)
+    getEventsFrom(*unfiltered, slotEvents[numOutputs]);
+  for (size_t j = 0; j <= numOutputs; ++j) {
+    if (slotEvents[j])
+      slotEvents[j]->reserve(slotEvents[j]->size() + counts[j]);
+  }
+
+  // 3. Copy
+  for (size_t i = 0; i < numEvents; ++i) {
+    const int slot = destinations[i];
+    if (slot < 0)
+      continue;
+    std::vector<T> *destination = slotEvents[static_cast<size_t>(slot)];
+    if (destination)
+      destination->push_back(events[i]);
+  }
+}
+
+//------------------------------------------------------------------------------------------------
+/** Split the event list by full time (pulse + tof) into outputs given by
+ * interval columns. This is the engine for splitting against many intervals:
+ * the event list is sorted by pulse time and TOF once, merge-walked against
+ * the intervals and copied into preallocated outputs.
+ *
+ * Events inside an interval go to the output indexed by the interval's
+ * target; targets with no (or a NULL) output are dropped. Events before or
+ * between intervals go to unfiltered, which may be NULL. Events after the end
+ * of the last interval are dropped.
+ *
+ * @param splitter :: intervals, which must be sorted and disjoint
+ *                    (TimeSplitterColumns::isDisjoint()). This is not checked
+ *                    here as the same splitter is used for every spectrum.
+ * @param outputs :: destination lists, indexed by interval target
+ * @param unfiltered :: destination of events outside the intervals, or NULL
+ * @param docorrection :: a boolean to indiciate whether it is need to do
+ *correction
+ * @param toffactor:  a correction factor for each TOF to multiply with
+ * @param tofshift:  a correction shift for each TOF to add with
+ */
+void EventList::splitByFullTime(const Kernel::TimeSplitterColumns &splitter,
+                                const std::vector<EventList *> &outputs,
+                                EventList *unfiltered, bool docorrection,
+                                double toffactor, double tofshift) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+
+  // 1. Sort once by pulse time and TOF
+  this->sortPulseTimeTOF();
+
+  // 2. Initialize all the outputs
+  std::vector<EventList *> initialize(outputs);
+  initialize.push_back(unfiltered);
+  for (auto it = initialize.begin(); it != initialize.end(); ++it) {
+    EventList *opeventlist = *it;
+    if (!opeventlist)
+      continue;
+    opeventlist->clear();
+    opeventlist->detectorIDs = this->detectorIDs;
+    opeventlist->refX = this->refX;
+    // Match the output event type.
+    opeventlist->switchTo(eventType);
+  }
+
+  if (splitter.empty()) {
+    // 3A. Copy all events to the unfiltered output
+    if (unfiltered)
+      (*unfiltered) = (*this);
+    return;
+  }
+
+  // 3B. Split
+  switch (eventType) {
+  case TOF:
+    splitByFullTimeSortedHelper(splitter, outputs, unfiltered, this->events,
+                                docorrection, toffactor, tofshift);
+    break;
+  case WEIGHTED:
+    splitByFullTimeSortedHelper(splitter, outputs, unfiltered,
+                                this->weightedEvents, docorrection, toffactor,
+                                tofshift);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+
+  // 4. Events were copied in order, so the outputs are still sorted
+  for (auto it = initialize.begin(); it != initialize.end(); ++it) {
+    if (*it)
+      (*it)->setSortOrder(PULSETIMETOF_SORT);
+  }
+}
+
 //------------------------------------------------------------------------------------------------
 /** Split the event list into n outputs, operating on a vector of either
  *TofEvent's or WeightedEvent's
@@ -4449,14 +4629,11 @@ template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
                                          Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  typename std::vector<T>::iterator itev = events.begin();
-  typename std::vector<T>::iterator itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
-  }
+  if (events.empty())
+    return;
+  // Convert the TOFs in place, stepping over the rest of each event
+  Mantid::Kernel::Unit::convertViaTOF(*fromUnit, *toUnit, &events[0].m_tof,
+                                      events.size(), sizeof(T));
 }
 
 //--------------------------------------------------------------------------
@@ -1818,6 +1818,78 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Splitting against TimeSplitterColumns gives the same result as the map-based splitter
+   */
+  void test_splitByFullTime_TimeSplitterColumns()
+  {
+    fake_uniform_time_sns_data();
+
+    TimeSplitterType split;
+    for (int i = 1; i < 10; i++)
+    {
+      if ((i % 2) == 0)
+        split.push_back(SplittingInterval(i * 1000000, (i + 1) * 1000000, i));
+      else
+        split.push_back(SplittingInterval(i * 1000000, (i + 1) * 1000000, -1));
+    }
+
+    // Reference: the map-based version
+    std::map<int, EventList *> expected;
+    for (int i = -1; i < 10; i++)
+      expected.insert(std::make_pair(i, new EventList()));
+    el.splitByFullTime(split, expected, false, 1.0, 0.0);
+
+    // Interval target -1 goes to slot 10, which is also the unfiltered list
+    TimeSplitterColumns columns(split);
+    TS_ASSERT( columns.isDisjoint() );
+    for (size_t i = 0; i < columns.size(); ++i)
+      if (columns.targets()[i] < 0)
+        columns.setTarget(i, 10);
+    std::vector<EventList *> outputs;
+    for (int i = 0; i < 11; i++)
+      outputs.push_back(new EventList());
+    el.splitByFullTime(columns, outputs, outputs[10], false, 1.0, 0.0);
+
+    for (int i = -1; i < 10; i++)
+    {
+      EventList * out = (i < 0) ? outputs[10] : outputs[i];
+      TS_ASSERT_EQUALS( out->getNumberEvents(), expected[i]->getNumberEvents() );
+      TS_ASSERT( *out == *expected[i] );
+      TS_ASSERT_EQUALS( out->getSortType(), PULSETIMETOF_SORT );
+    }
+
+    for (int i = 0; i < 11; i++)
+      delete outputs[i];
+    for (std::map<int, EventList*>::iterator im = expected.begin(); im != expected.end(); ++im)
+      delete im->second;
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  /** Events whose full time goes backwards in pulse time order still land in the right interval
+   */
+  void test_splitByFullTime_TimeSplitterColumns_longTOF()
+  {
+    el = EventList();
+    // Pulse 0 with a TOF of 1.5 ms lands after the event of pulse 1 ms with TOF 0
+    el += TofEvent(1500., DateAndTime(int64_t(0)));
+    el += TofEvent(0., DateAndTime(int64_t(1000000)));
+    el += TofEvent(100., DateAndTime(int64_t(1000000)));
+
+    TimeSplitterColumns columns;
+    columns.addInterval(0, 1050000, 0);
+    columns.addInterval(1050000, 2000000, 1);
+    std::vector<EventList *> outputs;
+    outputs.push_back(new EventList());
+    outputs.push_back(new EventList());
+    el.splitByFullTime(columns, outputs, NULL, false, 1.0, 0.0);
+
+    TS_ASSERT_EQUALS( outputs[0]->getNumberEvents(), 1 );
+    TS_ASSERT_EQUALS( outputs[1]->getNumberEvents(), 2 );
+    delete outputs[0];
+    delete outputs[1];
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test method to split events by full time (pulse + tof) withtout correction on TOF
    * and with vector splitter
@@ -2743,6 +2815,29 @@ public:
     TS_ASSERT_DELTA( integ, 5e6, 1);
   }
 
+  void test_splitByFullTime_TimeSplitterColumns_manyIntervals()
+  {
+    // 10,001 intervals of 10 microseconds covering all the full times
+    TimeSplitterColumns columns;
+    for (int64_t i = 0; i <= 10000; i++)
+      columns.addInterval(i * 10000, (i + 1) * 10000, static_cast<int>(i % 10));
+    std::vector<EventList *> outputs;
+    for (int i = 0; i < 10; i++)
+      outputs.push_back(new EventList());
+
+    CPUTimer tim;
+    el_sorted.splitByFullTime(columns, outputs, NULL, false, 1.0, 0.0);
+    std::cout << std::endl << tim << " to split 10^7 events against 10^4 intervals. " << std::endl;
+
+    size_t total = 0;
+    for (int i = 0; i < 10; i++)
+    {
+      total += outputs[i]->getNumberEvents();
+      delete outputs[i];
+    }
+    TS_ASSERT_EQUALS(total, el_sorted.getNumberEvents());
+  }
+
 };
 
 #endif /// EVENTLISTTEST_H_
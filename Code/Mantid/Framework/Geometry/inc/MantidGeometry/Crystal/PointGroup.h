@@ -46,6 +46,9 @@ public:
 
   /// Returns a vector with all equivalent hkls
   std::vector<Kernel::V3D> getEquivalents(const Kernel::V3D &hkl) const;
+  /// Returns all equivalents of each hkl in a list
+  std::vector<Kernel::V3D>
+  getAllEquivalents(const std::vector<Kernel::V3D> &hkls) const;
   /// Returns the same hkl for all equivalent hkls
   Kernel::V3D getReflectionFamily(const Kernel::V3D &hkl) const;
 
@@ -0,0 +1,87 @@
+#ifndef MANTID_GEOMETRY_REFLECTIONGENERATOR_H_
+#define MANTID_GEOMETRY_REFLECTIONGENERATOR_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Crystal/PointGroup.h"
+#include "MantidGeometry/Crystal/ReflectionCondition.h"
+#include "MantidGeometry/Crystal/UnitCell.h"
+#include "MantidKernel/V3D.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** ReflectionGenerator : Enumerates the allowed reflections of a unit cell
+    within a d-range.
+
+    The list is generated once on construction and can then be reused, for
+    example to predict peak positions for many goniometer settings of the same
+    crystal. Only the (h, k) columns that intersect the sphere of radius
+    1/dMin in reciprocal space are visited, and for each of them the range of
+    l is solved from the metric tensor directly, so no time is spent on the
+    corners of the bounding box of hkl.
+
+    The reflections are ordered by h, then k, then l, all ascending. 000 is
+    never included.
+
+    For powder-like problems the list can be reduced to one reflection per
+    family of a point group with getUniqueHKLs, and such a list can be turned
+    back into all reflections with PointGroup::getAllEquivalents.
+
+    Copyright &copy; 2015 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL ReflectionGenerator {
+public:
+  ReflectionGenerator(const UnitCell &cell,
+                      const ReflectionCondition_sptr &centering, double dMin,
+                      double dMax);
+
+  /// Lower limit of the d-range
+  double getDMin() const { return m_dMin; }
+  /// Upper limit of the d-range
+  double getDMax() const { return m_dMax; }
+  /// Lattice parameters of the cell the reflections were generated for
+  const UnitCell &getCell() const { return m_cell; }
+  /// Name of the reflection condition applied
+  const std::string &getCenteringName() const { return m_centeringName; }
+
+  /// All allowed reflections with dMin <= d <= dMax
+  const std::vector<Kernel::V3D> &getHKLs() const { return m_hkls; }
+  /// One reflection of each family of the point group
+  std::vector<Kernel::V3D> getUniqueHKLs(const PointGroup &pointGroup) const;
+
+private:
+  void generate(const ReflectionCondition_sptr &centering);
+
+  UnitCell m_cell;
+  std::string m_centeringName;
+  double m_dMin;
+  double m_dMax;
+  std::vector<Kernel::V3D> m_hkls;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_REFLECTIONGENERATOR_H_ */
@@ -23,6 +23,7 @@ namespace Geometry {
 //------------------------------------------------------------------
 // Forward declarations
 //------------------------------------------------------------------
+class InstrumentBinaryCache;
 class XMLInstrumentParameter;
 class ParameterMap;
 class ReferenceFrame;
@@ -253,6 +254,9 @@ public:
   ContainsState containsRectDetectors() const;
 
 private:
+  /// Reads and writes the private caches directly
+  friend class InstrumentBinaryCache;
+
   /// Save information about a set of detectors to Nexus
   void saveDetectorSetInfoToNexus(::NeXus::File *file,
                                   std::vector<detid_t> detIDs) const;
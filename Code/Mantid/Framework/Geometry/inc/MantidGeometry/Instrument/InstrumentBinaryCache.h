@@ -0,0 +1,71 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_
+#define MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_
+
+#include "MantidGeometry/DllConfig.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+class Instrument;
+class Object;
+
+/** InstrumentBinaryCache : Reads and writes a binary image of an instrument
+    built by the InstrumentDefinitionParser, so that an instrument can be
+    rebuilt without parsing its definition file again.
+
+    The file holds the component tree (names, positions, rotations, detector
+    IDs and the parameters of rectangular detectors), the shapes as the XML
+    they were created from, the detector, monitor, source, sample and chopper
+    markers, the parameters from the definition file and the instrument-wide
+    settings such as the reference frame and validity dates. It is stamped
+    with a key, normally a checksum of the definition, and with the Mantid
+    version that wrote it; a file with a different stamp is ignored. Files are
+    read through a memory map.
+
+    Only instruments made of the component types the parser creates can be
+    written. Anything else, e.g. an indirect geometry instrument with a
+    separate physical instrument, is refused so that the definition is parsed
+    as before.
+
+    Copyright &copy; 2015 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL InstrumentBinaryCache {
+public:
+  /// Shapes keyed by the name of the type they were created for
+  typedef std::map<std::string, boost::shared_ptr<Object>> ShapeMap;
+
+  /// Write an instrument to a cache file
+  static void save(const std::string &filename, const std::string &key,
+                   const Instrument &instrument, const ShapeMap &typeShapes);
+  /// Fill an empty instrument from a cache file
+  static bool load(const std::string &filename, const std::string &key,
+                   Instrument &instrument, ShapeMap &typeShapes);
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_ */
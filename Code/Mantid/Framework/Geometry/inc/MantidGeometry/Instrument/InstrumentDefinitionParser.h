@@ -227,6 +227,18 @@ private:
   /// Write out a cache file.
   CachingOption writeAndApplyCache(IDFObject_const_sptr usedCache);
 
+  /// Parse the XML text into the DOM tree if that has not been done
+  void loadDocument();
+
+  /// Path of the binary instrument cache file
+  std::string binaryCacheFilename(bool adjacent, const std::string &key) const;
+
+  /// Replace the instrument with one from the binary cache
+  bool loadBinaryCache(const std::string &key);
+
+  /// Write the instrument to the binary cache
+  void saveBinaryCache(const std::string &key);
+
   /// This method returns the parent appended which its child components and
   /// also name of type of the last child component
   std::string getShapeCoorSysComp(
@@ -1,5 +1,6 @@
 #include "MantidGeometry/Crystal/IndexingUtils.h"
 #include "MantidGeometry/Crystal/NiggliCell.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Quat.h"
 #include <boost/math/special_functions/fpclassify.hpp>
 #include "MantidGeometry/Crystal/OrientedLattice.h"
@@ -924,7 +925,10 @@ double IndexingUtils::ScanFor_UB(DblMatrix &UB,
 
   std::vector<V3D> a_dir_list = MakeHemisphereDirections(num_a_steps);
 
-  std::vector<V3D> b_dir_list;
+  // MakeCircleDirections() throws on invalid arguments. Call it once here so
+  // that it cannot throw inside the parallel loop below.
+  if (!a_dir_list.empty())
+    MakeCircleDirections(num_b_steps, a_dir_list[0] * a, gamma);
 
   V3D a_dir_temp;
   V3D b_dir_temp;
@@ -933,46 +937,47 @@ double IndexingUtils::ScanFor_UB(DblMatrix &UB,
   double error;
   double dot_prod;
   int nearest_int;
-  int max_indexed = 0;
   V3D q_vec;
-  // first select those directions
-  // that index the most peaks
-  std::vector<V3D> selected_a_dirs;
-  std::vector<V3D> selected_b_dirs;
-  std::vector<V3D> selected_c_dirs;
-
-  for (size_t a_dir_num = 0; a_dir_num < a_dir_list.size(); a_dir_num++) {
-    a_dir_temp = a_dir_list[a_dir_num];
-    a_dir_temp = V3D(a_dir_temp);
-    a_dir_temp *= a;
 
-    b_dir_list = MakeCircleDirections(num_b_steps, a_dir_temp, gamma);
+  std::vector<V3D> scaled_qs(q_vectors.size());
+  for (size_t q_num = 0; q_num < q_vectors.size(); q_num++)
+    scaled_qs[q_num] = q_vectors[q_num] / (2.0 * M_PI);
+
+  // first select those directions that index the most peaks. The "a"
+  // directions are scanned in parallel, each keeping the b and c directions
+  // that index the most peaks for that "a". The overall best are then
+  // gathered in scan order so the result does not depend on the threads.
+  const int num_a_dirs = static_cast<int>(a_dir_list.size());
+  std::vector<int> a_max_indexed(a_dir_list.size(), 0);
+  std::vector<std::vector<V3D>> a_selected_b_dirs(a_dir_list.size());
+  std::vector<std::vector<V3D>> a_selected_c_dirs(a_dir_list.size());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int a_dir_num = 0; a_dir_num < num_a_dirs; a_dir_num++) {
+    const V3D a_dir_i = a_dir_list[a_dir_num] * a;
+    const std::vector<V3D> b_dir_list =
+        MakeCircleDirections(num_b_steps, a_dir_i, gamma);
+    int &max_for_a = a_max_indexed[a_dir_num];
+    std::vector<V3D> &selected_b_for_a = a_selected_b_dirs[a_dir_num];
+    std::vector<V3D> &selected_c_for_a = a_selected_c_dirs[a_dir_num];
 
     for (size_t b_dir_num = 0; b_dir_num < b_dir_list.size(); b_dir_num++) {
-      b_dir_temp = b_dir_list[b_dir_num];
-      b_dir_temp = V3D(b_dir_temp);
-      b_dir_temp *= b;
-      c_dir_temp = Make_c_dir(a_dir_temp, b_dir_temp, c, alpha, beta, gamma);
+      const V3D b_dir_i = b_dir_list[b_dir_num] * b;
+      const V3D c_dir_i = Make_c_dir(a_dir_i, b_dir_i, c, alpha, beta, gamma);
       int num_indexed = 0;
-      for (size_t q_num = 0; q_num < q_vectors.size(); q_num++) {
+      for (size_t q_num = 0; q_num < scaled_qs.size(); q_num++) {
+        const V3D &q_i = scaled_qs[q_num];
         bool indexes_peak = true;
-        q_vec = q_vectors[q_num] / (2.0 * M_PI);
-        dot_prod = a_dir_temp.scalar_prod(q_vec);
-        nearest_int = round(dot_prod);
-        error = fabs(dot_prod - nearest_int);
-        if (error > required_tolerance)
+        double proj = a_dir_i.scalar_prod(q_i);
+        if (fabs(proj - round(proj)) > required_tolerance)
           indexes_peak = false;
         else {
-          dot_prod = b_dir_temp.scalar_prod(q_vec);
-          nearest_int = round(dot_prod);
-          error = fabs(dot_prod - nearest_int);
-          if (error > required_tolerance)
+          proj = b_dir_i.scalar_prod(q_i);
+          if (fabs(proj - round(proj)) > required_tolerance)
             indexes_peak = false;
           else {
-            dot_prod = c_dir_temp.scalar_prod(q_vec);
-            nearest_int = round(dot_prod);
-            error = fabs(dot_prod - nearest_int);
-            if (error > required_tolerance)
+            proj = c_dir_i.scalar_prod(q_i);
+            if (fabs(proj - round(proj)) > required_tolerance)
               indexes_peak = false;
           }
         }
@@ -980,20 +985,39 @@ double IndexingUtils::ScanFor_UB(DblMatrix &UB,
           num_indexed++;
       }
 
-      if (num_indexed > max_indexed) // only keep those directions that
-      {                              // index the max number of peaks
-        selected_a_dirs.clear();
-        selected_b_dirs.clear();
-        selected_c_dirs.clear();
-        max_indexed = num_indexed;
+      if (num_indexed > max_for_a) // only keep those directions that
+      {                            // index the max number of peaks
+        selected_b_for_a.clear();
+        selected_c_for_a.clear();
+        max_for_a = num_indexed;
       }
-      if (num_indexed == max_indexed) {
-        selected_a_dirs.push_back(a_dir_temp);
-        selected_b_dirs.push_back(b_dir_temp);
-        selected_c_dirs.push_back(c_dir_temp);
+      if (num_indexed == max_for_a) {
+        selected_b_for_a.push_back(b_dir_i);
+        selected_c_for_a.push_back(c_dir_i);
       }
     }
   }
+
+  int max_indexed = 0;
+  for (size_t a_dir_num = 0; a_dir_num < a_dir_list.size(); a_dir_num++)
+    if (a_max_indexed[a_dir_num] > max_indexed)
+      max_indexed = a_max_indexed[a_dir_num];
+
+  std::vector<V3D> selected_a_dirs;
+  std::vector<V3D> selected_b_dirs;
+  std::vector<V3D> selected_c_dirs;
+  for (size_t a_dir_num = 0; a_dir_num < a_dir_list.size(); a_dir_num++) {
+    if (a_max_indexed[a_dir_num] != max_indexed)
+      continue;
+    const std::vector<V3D> &b_dirs = a_selected_b_dirs[a_dir_num];
+    selected_a_dirs.insert(selected_a_dirs.end(), b_dirs.size(),
+                           a_dir_list[a_dir_num] * a);
+    selected_b_dirs.insert(selected_b_dirs.end(), b_dirs.begin(),
+                           b_dirs.end());
+    selected_c_dirs.insert(selected_c_dirs.end(),
+                           a_selected_c_dirs[a_dir_num].begin(),
+                           a_selected_c_dirs[a_dir_num].end());
+  }
   // now, for each such direction, find
   // the one that indexes closes to
   // integer values
@@ -1004,8 +1028,8 @@ double IndexingUtils::ScanFor_UB(DblMatrix &UB,
     c_dir_temp = selected_c_dirs[dir_num];
 
     double sum_sq_error = 0;
-    for (size_t q_num = 0; q_num < q_vectors.size(); q_num++) {
-      q_vec = q_vectors[q_num] / (2.0 * M_PI);
+    for (size_t q_num = 0; q_num < scaled_qs.size(); q_num++) {
+      q_vec = scaled_qs[q_num];
       dot_prod = a_dir_temp.scalar_prod(q_vec);
       nearest_int = round(dot_prod);
       error = dot_prod - nearest_int;
@@ -1066,12 +1090,7 @@ size_t IndexingUtils::ScanFor_Directions(std::vector<V3D> &directions,
                                          double min_d, double max_d,
                                          double required_tolerance,
                                          double degrees_per_step) {
-  double error;
   double fit_error;
-  double dot_prod;
-  int nearest_int;
-  int max_indexed = 0;
-  V3D q_vec;
   // first, make hemisphere of possible directions
   // with specified resolution.
   int num_steps = round(90.0 / degrees_per_step);
@@ -1084,36 +1103,55 @@ size_t IndexingUtils::ScanFor_Directions(std::vector<V3D> &directions,
   double delta_d = 0.1f;
   int n_steps = round(1 + (max_d - min_d) / delta_d);
 
-  std::vector<V3D> selected_dirs;
-  V3D dir_temp;
+  std::vector<V3D> scaled_qs(q_vectors.size());
+  for (size_t q_num = 0; q_num < q_vectors.size(); q_num++)
+    scaled_qs[q_num] = q_vectors[q_num] / (2.0 * M_PI);
 
-  for (size_t dir_num = 0; dir_num < full_list.size(); dir_num++) {
-    V3D current_dir = full_list[dir_num];
+  // The directions are scanned in parallel, each keeping the lengths that
+  // index the most peaks in that direction. The overall best are then
+  // gathered in scan order so the result does not depend on the threads.
+  const int num_dirs = static_cast<int>(full_list.size());
+  std::vector<int> dir_max_indexed(full_list.size(), 0);
+  std::vector<std::vector<V3D>> dir_selected(full_list.size());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < num_dirs; dir_num++) {
+    const V3D &current_dir = full_list[dir_num];
+    int &max_for_dir = dir_max_indexed[dir_num];
+    std::vector<V3D> &selected_for_dir = dir_selected[dir_num];
 
     for (int step = 0; step <= n_steps; step++) {
-      dir_temp = current_dir;
-      dir_temp *= (min_d + step * delta_d); // increasing size
+      // increasing size
+      const V3D dir_i = current_dir * (min_d + step * delta_d);
 
       int num_indexed = 0;
-      for (size_t q_num = 0; q_num < q_vectors.size(); q_num++) {
-        q_vec = q_vectors[q_num] / (2.0 * M_PI);
-        dot_prod = dir_temp.scalar_prod(q_vec);
-        nearest_int = round(dot_prod);
-        error = fabs(dot_prod - nearest_int);
-        if (error <= required_tolerance)
+      for (size_t q_num = 0; q_num < scaled_qs.size(); q_num++) {
+        const double proj = dir_i.scalar_prod(scaled_qs[q_num]);
+        if (fabs(proj - round(proj)) <= required_tolerance)
           num_indexed++;
       }
 
-      if (num_indexed > max_indexed) // only keep those directions that
+      if (num_indexed > max_for_dir) // only keep those directions that
       {                              // index the max number of peaks
-        selected_dirs.clear();
-        max_indexed = num_indexed;
+        selected_for_dir.clear();
+        max_for_dir = num_indexed;
       }
-      if (num_indexed >= max_indexed) {
-        selected_dirs.push_back(V3D(dir_temp));
+      if (num_indexed >= max_for_dir) {
+        selected_for_dir.push_back(dir_i);
       }
     }
   }
+
+  int max_indexed = 0;
+  for (size_t dir_num = 0; dir_num < full_list.size(); dir_num++)
+    if (dir_max_indexed[dir_num] > max_indexed)
+      max_indexed = dir_max_indexed[dir_num];
+
+  std::vector<V3D> selected_dirs;
+  for (size_t dir_num = 0; dir_num < full_list.size(); dir_num++)
+    if (dir_max_indexed[dir_num] == max_indexed)
+      selected_dirs.insert(selected_dirs.end(), dir_selected[dir_num].begin(),
+                           dir_selected[dir_num].end());
   // Now, optimize each direction and discard possible
   // unit cell edges that are duplicates, putting the
   // new smaller list in the vector "directions"
@@ -1124,6 +1162,7 @@ size_t IndexingUtils::ScanFor_Directions(std::vector<V3D> &directions,
 
   directions.clear();
   V3D current_dir;
+  V3D dir_temp;
   V3D diff;
   for (size_t dir_num = 0; dir_num < selected_dirs.size(); dir_num++) {
     current_dir = selected_dirs[dir_num];
@@ -1193,7 +1232,6 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
 #define N_FFT_STEPS 512
 #define HALF_FFT_STEPS 256
 
-  double fit_error;
   int max_indexed = 0;
 
   // first, make hemisphere of possible directions
@@ -1213,22 +1251,22 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
   max_mag_Q *= 1.1f; // allow for a little "headroom" for FFT range
 
   // apply the FFT to each of the directions, and
-  // keep track of their maximum magnitude past DC
+  // keep track of their maximum magnitude past DC.
+  // Each thread works on its own FFT arrays.
   double max_mag_fft;
   std::vector<double> max_fft_val;
   max_fft_val.resize(full_list.size());
 
-  double projections[N_FFT_STEPS];
-  double magnitude_fft[HALF_FFT_STEPS];
-
   double index_factor = N_FFT_STEPS / max_mag_Q; // maps |proj Q| to index
 
-  for (size_t dir_num = 0; dir_num < full_list.size(); dir_num++) {
-    V3D current_dir = full_list[dir_num];
-    max_mag_fft = GetMagFFT(q_vectors, current_dir, N_FFT_STEPS, projections,
-                            index_factor, magnitude_fft);
-
-    max_fft_val[dir_num] = max_mag_fft;
+  const int num_dirs = static_cast<int>(full_list.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < num_dirs; dir_num++) {
+    double projections[N_FFT_STEPS];
+    double magnitude_fft[HALF_FFT_STEPS];
+    max_fft_val[dir_num] =
+        GetMagFFT(q_vectors, full_list[dir_num], N_FFT_STEPS, projections,
+                  index_factor, magnitude_fft);
   }
   // find the directions with the 500 largest
   // fft values, and place them in temp_dirs vector
@@ -1262,23 +1300,28 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
   // FFT to find the cell edge length that
   // corresponds to the max_mag_fft.  Only keep
   // directions with length nearly in bounds
-  V3D temp;
-  std::vector<V3D> temp_dirs_2;
-
-  for (size_t i = 0; i < temp_dirs.size(); i++) {
+  const int num_temp_dirs = static_cast<int>(temp_dirs.size());
+  std::vector<double> temp_d_vals(temp_dirs.size(), 0.0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < num_temp_dirs; i++) {
+    double projections[N_FFT_STEPS];
+    double magnitude_fft[HALF_FFT_STEPS];
     GetMagFFT(q_vectors, temp_dirs[i], N_FFT_STEPS, projections, index_factor,
               magnitude_fft);
 
     double position = GetFirstMaxIndex(magnitude_fft, N_FFT_STEPS, threshold);
     if (position > 0) {
       double q_val = max_mag_Q / position;
-      double d_val = 1 / q_val;
-      if (d_val >= 0.8 * min_d && d_val <= 1.2 * max_d) {
-        temp = temp_dirs[i] * d_val;
-        temp_dirs_2.push_back(temp);
-      }
+      temp_d_vals[i] = 1 / q_val;
     }
   }
+
+  std::vector<V3D> temp_dirs_2;
+  for (size_t i = 0; i < temp_dirs.size(); i++) {
+    double d_val = temp_d_vals[i];
+    if (d_val > 0 && d_val >= 0.8 * min_d && d_val <= 1.2 * max_d)
+      temp_dirs_2.push_back(temp_dirs[i] * d_val);
+  }
   // look at how many peaks were indexed
   // for each of the initial directions
   max_indexed = 0;
@@ -1302,25 +1345,27 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
   }
   // refine directions and again find the
   // max number indexed, for the optimized
-  // directions
-  max_indexed = 0;
-  std::vector<int> index_vals;
-  std::vector<V3D> indexed_qs;
-  for (size_t dir_num = 0; dir_num < temp_dirs.size(); dir_num++) {
-    num_indexed =
-        GetIndexedPeaks_1D(temp_dirs[dir_num], q_vectors, required_tolerance,
-                           index_vals, indexed_qs, fit_error);
+  // directions, each in its own thread
+  const int num_refine_dirs = static_cast<int>(temp_dirs.size());
+  std::vector<int> refined_max_indexed(temp_dirs.size(), 0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int dir_num = 0; dir_num < num_refine_dirs; dir_num++) {
+    std::vector<int> index_vals;
+    std::vector<V3D> indexed_qs;
+    double dir_fit_error;
+    GetIndexedPeaks_1D(temp_dirs[dir_num], q_vectors, required_tolerance,
+                       index_vals, indexed_qs, dir_fit_error);
     try {
       int count = 0;
       while (count < 5) // 5 iterations should be enough for
       {                 // the optimization to stabilize
         Optimize_Direction(temp_dirs[dir_num], index_vals, indexed_qs);
 
-        num_indexed = GetIndexedPeaks_1D(temp_dirs[dir_num], q_vectors,
-                                         required_tolerance, index_vals,
-                                         indexed_qs, fit_error);
-        if (num_indexed > max_indexed)
-          max_indexed = num_indexed;
+        int dir_num_indexed = GetIndexedPeaks_1D(
+            temp_dirs[dir_num], q_vectors, required_tolerance, index_vals,
+            indexed_qs, dir_fit_error);
+        if (dir_num_indexed > refined_max_indexed[dir_num])
+          refined_max_indexed[dir_num] = dir_num_indexed;
 
         count++;
       }
@@ -1328,6 +1373,10 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
       // don't continue to refine if the direction fails to optimize properly
     }
   }
+  max_indexed = 0;
+  for (size_t dir_num = 0; dir_num < temp_dirs.size(); dir_num++)
+    if (refined_max_indexed[dir_num] > max_indexed)
+      max_indexed = refined_max_indexed[dir_num];
   // discard those with length out of bounds
   temp_dirs_2.clear();
   for (size_t i = 0; i < temp_dirs.size(); i++) {
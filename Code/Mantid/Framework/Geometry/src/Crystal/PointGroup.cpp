@@ -1,4 +1,5 @@
 #include "MantidGeometry/Crystal/PointGroup.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 
 #include <set>
@@ -35,6 +36,39 @@ std::vector<V3D> PointGroup::getEquivalents(const V3D &hkl) const {
   return std::vector<V3D>(equivalents.rbegin(), equivalents.rend());
 }
 
+/**
+ * Returns the equivalents of all hkls in a list.
+ *
+ * The result is the concatenation of PointGroup::getEquivalents for each hkl,
+ * in the order of the input. When the input contains one hkl per family, for
+ * example from ReflectionGenerator::getUniqueHKLs, this expands it to the full
+ * list of reflections. The families are generated in parallel.
+ *
+ * @param hkls :: List of hkls
+ * @return :: std::vector containing the equivalents of every hkl.
+ */
+std::vector<V3D>
+PointGroup::getAllEquivalents(const std::vector<V3D> &hkls) const {
+  const int numHKLs = static_cast<int>(hkls.size());
+  std::vector<std::vector<V3D>> families(hkls.size());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < numHKLs; ++i)
+    families[i] = getEquivalents(hkls[i]);
+
+  size_t total = 0;
+  for (size_t i = 0; i < families.size(); ++i)
+    total += families[i].size();
+
+  std::vector<V3D> equivalents;
+  equivalents.reserve(total);
+  for (size_t i = 0; i < families.size(); ++i)
+    equivalents.insert(equivalents.end(), families[i].begin(),
+                       families[i].end());
+
+  return equivalents;
+}
+
 /**
  * Returns the same V3D for all equivalent hkls.
  *
@@ -0,0 +1,123 @@
+#include "MantidGeometry/Crystal/ReflectionGenerator.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <cmath>
+#include <set>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::V3D;
+
+//----------------------------------------------------------------------------------------------
+/** Constructor. Generates the list of reflections.
+ *
+ * @param cell :: unit cell of the crystal
+ * @param centering :: reflection condition of the lattice centering
+ * @param dMin :: smallest d-spacing to include
+ * @param dMax :: largest d-spacing to include
+ * @throw std::invalid_argument if the d-range is not valid or there is no
+ *        centering
+ */
+ReflectionGenerator::ReflectionGenerator(
+    const UnitCell &cell, const ReflectionCondition_sptr &centering,
+    double dMin, double dMax)
+    : m_cell(cell), m_centeringName(), m_dMin(dMin), m_dMax(dMax), m_hkls() {
+  if (!centering)
+    throw std::invalid_argument("ReflectionGenerator needs a centering.");
+  if (dMin <= 0.0)
+    throw std::invalid_argument("dMin must be strictly positive.");
+  if (dMax <= dMin)
+    throw std::invalid_argument("dMax must be larger than dMin.");
+
+  m_centeringName = centering->getName();
+  generate(centering);
+}
+
+/** Returns one reflection of each family of equivalent reflections, ordered
+ * as std::set<V3D> orders them. The representative of each family is the one
+ * PointGroup::getReflectionFamily picks.
+ *
+ * @param pointGroup :: point group defining the families
+ * @return the symmetry independent reflections
+ */
+std::vector<V3D>
+ReflectionGenerator::getUniqueHKLs(const PointGroup &pointGroup) const {
+  const int numHKLs = static_cast<int>(m_hkls.size());
+  std::vector<V3D> families(m_hkls.size());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < numHKLs; ++i)
+    families[i] = pointGroup.getReflectionFamily(m_hkls[i]);
+
+  std::set<V3D> unique(families.begin(), families.end());
+  return std::vector<V3D>(unique.begin(), unique.end());
+}
+
+/** Fill m_hkls with the allowed reflections in the d-range.
+ *
+ * In reciprocal space a reflection is at Q = h*b1 + k*b2 + l*b3, where the
+ * b's are the columns of the B matrix, and it is in range if
+ * 1/dMax^2 <= |Q|^2 <= 1/dMin^2. For a fixed h and k, |Q|^2 is a quadratic
+ * in l so the l values inside the outer sphere are found directly.
+ *
+ * @param centering :: reflection condition of the lattice centering
+ */
+void ReflectionGenerator::generate(const ReflectionCondition_sptr &centering) {
+  const Kernel::DblMatrix &B = m_cell.getB();
+  const V3D b1(B[0][0], B[1][0], B[2][0]);
+  const V3D b2(B[0][1], B[1][1], B[2][1]);
+  const V3D b3(B[0][2], B[1][2], B[2][2]);
+  const double b3b3 = b3.scalar_prod(b3);
+
+  const double qSqMax = 1.0 / (m_dMin * m_dMin);
+  const double qSqMin = 1.0 / (m_dMax * m_dMax);
+
+  // |h| <= a/dMin and so on
+  const int hMax = static_cast<int>(m_cell.a() / m_dMin);
+  const int kMax = static_cast<int>(m_cell.b() / m_dMin);
+  const int numH = 2 * hMax + 1;
+
+  // One list per h so that the result is ordered independent of threading
+  std::vector<std::vector<V3D>> hklsPerH(numH);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int ih = 0; ih < numH; ++ih) {
+    const int h = ih - hMax;
+    std::vector<V3D> &hkls = hklsPerH[ih];
+    for (int k = -kMax; k <= kMax; ++k) {
+      const V3D base = b1 * h + b2 * k;
+      const double baseb3 = base.scalar_prod(b3);
+      const double basebase = base.scalar_prod(base);
+
+      // Solve b3b3 * l^2 + 2 * baseb3 * l + basebase = qSqMax for l
+      const double discriminant = baseb3 * baseb3 - b3b3 * (basebase - qSqMax);
+      if (discriminant < 0.0)
+        continue;
+      const double root = std::sqrt(discriminant);
+      // Widen by one so rounding errors never lose a reflection
+      const int lLow = static_cast<int>(std::floor((-baseb3 - root) / b3b3)) - 1;
+      const int lHigh = static_cast<int>(std::ceil((-baseb3 + root) / b3b3)) + 1;
+
+      for (int l = lLow; l <= lHigh; ++l) {
+        if (h == 0 && k == 0 && l == 0)
+          continue;
+        const double ld = static_cast<double>(l);
+        const double qSq = basebase + ld * (2.0 * baseb3 + ld * b3b3);
+        if (qSq <= qSqMax && qSq >= qSqMin && centering->isAllowed(h, k, l))
+          hkls.push_back(V3D(h, k, l));
+      }
+    }
+  }
+
+  size_t total = 0;
+  for (size_t i = 0; i < hklsPerH.size(); ++i)
+    total += hklsPerH[i].size();
+  m_hkls.reserve(total);
+  for (size_t i = 0; i < hklsPerH.size(); ++i)
+    m_hkls.insert(m_hkls.end(), hklsPerH[i].begin(), hklsPerH[i].end());
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -0,0 +1,824 @@
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ObjCompAssembly.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/RectangularDetectorPixel.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/Object.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/MantidVersion.h"
+
+#include <Poco/File.h>
+#include <Poco/Process.h>
+#include <Poco/SharedMemory.h>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace Mantid {
+namespace Geometry {
+using Kernel::Quat;
+using Kernel::V3D;
+
+namespace {
+/// Identifies a cache file
+const char START_MARKER[] = "MANTIDIC";
+/// Written last, so that a partly written file is recognised
+const char END_MARKER[] = "ENDCACHE";
+/// Length of the markers, without the terminating null
+const size_t MARKER_LENGTH = 8;
+/// Changed whenever the layout of the file changes
+const uint32_t FORMAT_VERSION = 1;
+/// Written in native byte order so files from other architectures are ignored
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// Index used for a missing shape or component
+const int32_t NO_INDEX = -1;
+
+/// The component classes that can be stored. The pixels of a rectangular
+/// detector are created by the detector itself.
+enum ComponentKind {
+  LogicalKind = 0,
+  PhysicalKind = 1,
+  DetectorKind = 2,
+  AssemblyKind = 3,
+  ObjAssemblyKind = 4,
+  RectangularKind = 5
+};
+
+/// The error thrown for anything the file cannot hold
+std::runtime_error unsupported(const std::string &what) {
+  return std::runtime_error("The instrument cannot be cached: " + what);
+}
+
+/// The error thrown for a file that does not read back
+std::runtime_error corrupt(const std::string &what) {
+  return std::runtime_error("Corrupt instrument cache file: " + what);
+}
+
+/// The same address for a component whichever base it is seen through
+const void *identity(const IComponent *comp) {
+  return dynamic_cast<const void *>(comp);
+}
+
+/// True if the rotation is exactly the identity
+bool isIdentity(const Quat &rot) {
+  return rot.real() == 1.0 && rot.imagI() == 0.0 && rot.imagJ() == 0.0 &&
+         rot.imagK() == 0.0;
+}
+
+/// Writes values in native byte order
+class CacheWriter {
+public:
+  explicit CacheWriter(std::ostream &os) : m_os(os) {}
+
+  template <typename T> void write(const T &value) {
+    m_os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void writeBytes(const char *data, size_t size) {
+    m_os.write(data, static_cast<std::streamsize>(size));
+  }
+  void writeString(const std::string &str) {
+    write(static_cast<uint32_t>(str.size()));
+    writeBytes(str.data(), str.size());
+  }
+  void writeV3D(const V3D &vec) {
+    write(vec.X());
+    write(vec.Y());
+    write(vec.Z());
+  }
+  /// A flag followed by the rotation unless it is the identity
+  void writeRotation(const Quat &rot) {
+    const uint8_t hasRotation = isIdentity(rot) ? 0 : 1;
+    write(hasRotation);
+    if (hasRotation) {
+      write(rot.real());
+      write(rot.imagI());
+      write(rot.imagJ());
+      write(rot.imagK());
+    }
+  }
+
+private:
+  std::ostream &m_os;
+};
+
+/// Reads the values written by a CacheWriter from a block of memory
+class CacheReader {
+public:
+  CacheReader(const char *begin, const char *end) : m_pos(begin), m_end(end) {}
+
+  template <typename T> T read() {
+    T value;
+    require(sizeof(T));
+    std::memcpy(&value, m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+  /// Compares the next bytes with the given ones and skips them
+  bool match(const char *data, size_t size) {
+    require(size);
+    const bool same = std::memcmp(m_pos, data, size) == 0;
+    m_pos += size;
+    return same;
+  }
+  std::string readString() {
+    const uint32_t size = read<uint32_t>();
+    require(size);
+    std::string str(m_pos, size);
+    m_pos += size;
+    return str;
+  }
+  V3D readV3D() {
+    const double x = read<double>();
+    const double y = read<double>();
+    const double z = read<double>();
+    return V3D(x, y, z);
+  }
+  Quat readRotation() {
+    if (read<uint8_t>() == 0)
+      return Quat();
+    const double w = read<double>();
+    const double a = read<double>();
+    const double b = read<double>();
+    const double c = read<double>();
+    return Quat(w, a, b, c);
+  }
+  bool atEnd() const { return m_pos == m_end; }
+
+private:
+  void require(size_t size) const {
+    if (static_cast<size_t>(m_end - m_pos) < size)
+      throw corrupt("the file is truncated");
+  }
+
+  const char *m_pos;
+  const char *const m_end;
+};
+
+/**
+ * Writes the component tree in pre-order, numbering the components as it
+ * goes. Names and shapes are collected into tables that are written ahead of
+ * the tree.
+ */
+class TreeWriter {
+public:
+  explicit TreeWriter(const InstrumentBinaryCache::ShapeMap &typeShapes)
+      : m_shapes(), m_shapeIndex(), m_typeShapes(), m_names(), m_nameIndex(),
+        m_componentIndex() {
+    for (auto it = typeShapes.begin(); it != typeShapes.end(); ++it) {
+      if (it->second)
+        m_typeShapes.push_back(
+            std::make_pair(it->first, shapeIndex(it->second.get())));
+    }
+  }
+
+  /// Writes the children of the instrument, which is itself component 0
+  void writeInstrument(CacheWriter &out, const Instrument &instrument) {
+    m_componentIndex[identity(&instrument)] = 0;
+    out.writeV3D(instrument.getRelativePos());
+    out.writeRotation(instrument.getRelativeRot());
+    writeChildren(out, instrument);
+  }
+
+  /// Writes the name and shape tables
+  void writeTables(CacheWriter &out) const {
+    out.write(static_cast<uint32_t>(m_names.size()));
+    for (auto it = m_names.begin(); it != m_names.end(); ++it)
+      out.writeString(*it);
+
+    out.write(static_cast<uint32_t>(m_shapes.size()));
+    for (auto it = m_shapes.begin(); it != m_shapes.end(); ++it) {
+      const Object &shape = **it;
+      const std::string xml = shape.getShapeXML();
+      if (xml.empty() && shape.hasValidShape())
+        throw unsupported("a shape was not created from XML");
+      out.write(static_cast<int32_t>(shape.getName()));
+      out.writeString(xml);
+    }
+    out.write(static_cast<uint32_t>(m_typeShapes.size()));
+    for (auto it = m_typeShapes.begin(); it != m_typeShapes.end(); ++it) {
+      out.writeString(it->first);
+      out.write(it->second);
+    }
+  }
+
+  /// The index of a component written to the tree, or NO_INDEX for NULL
+  int32_t componentIndex(const IComponent *comp) const {
+    if (!comp)
+      return NO_INDEX;
+    auto it = m_componentIndex.find(identity(comp));
+    if (it == m_componentIndex.end())
+      throw unsupported("component " + comp->getName() +
+                        " is not part of the instrument tree");
+    return static_cast<int32_t>(it->second);
+  }
+
+private:
+  void writeChildren(CacheWriter &out, const ICompAssembly &assembly) {
+    const int count = assembly.nelements();
+    out.write(static_cast<uint32_t>(count));
+    for (int i = 0; i < count; ++i)
+      writeComponent(out, assembly.getChild(i).get());
+  }
+
+  void writeComponent(CacheWriter &out, const IComponent *comp) {
+    // Derived classes the file knows nothing about must not be stored as
+    // their base class, so the exact type is checked
+    const std::type_info &type = typeid(*comp);
+    ComponentKind kind;
+    if (type == typeid(Component))
+      kind = LogicalKind;
+    else if (type == typeid(ObjComponent))
+      kind = PhysicalKind;
+    else if (type == typeid(Detector))
+      kind = DetectorKind;
+    else if (type == typeid(CompAssembly))
+      kind = AssemblyKind;
+    else if (type == typeid(ObjCompAssembly))
+      kind = ObjAssemblyKind;
+    else if (type == typeid(RectangularDetector))
+      kind = RectangularKind;
+    else
+      throw unsupported("component " + comp->getName() + " of type " +
+                        comp->type());
+
+    addComponent(comp);
+    out.write(static_cast<uint8_t>(kind));
+    out.write(nameIndex(comp->getName()));
+    out.writeV3D(comp->getRelativePos());
+    out.writeRotation(comp->getRelativeRot());
+
+    switch (kind) {
+    case PhysicalKind:
+      out.write(objectShapeIndex(dynamic_cast<const ObjComponent &>(*comp)));
+      break;
+    case DetectorKind: {
+      const Detector &det = dynamic_cast<const Detector &>(*comp);
+      out.write(objectShapeIndex(det));
+      out.write(static_cast<int32_t>(det.getID()));
+      break;
+    }
+    case AssemblyKind:
+      writeChildren(out, dynamic_cast<const CompAssembly &>(*comp));
+      break;
+    case ObjAssemblyKind: {
+      const ObjCompAssembly &assembly =
+          dynamic_cast<const ObjCompAssembly &>(*comp);
+      out.write(objectShapeIndex(assembly));
+      writeChildren(out, assembly);
+      break;
+    }
+    case RectangularKind:
+      writeRectangular(out, dynamic_cast<const RectangularDetector &>(*comp));
+      break;
+    default:
+      break;
+    }
+  }
+
+  /// Writes the arguments of RectangularDetector::initialize, then the pixel
+  /// columns it creates, which only need their placement
+  void writeRectangular(CacheWriter &out, const RectangularDetector &bank) {
+    if (bank.xpixels() <= 0 || bank.ypixels() <= 0)
+      throw unsupported("rectangular detector " + bank.getName() +
+                        " has no pixels");
+    out.write(shapeIndex(bank.getAtXY(0, 0)->shape().get()));
+    out.write(static_cast<int32_t>(bank.xpixels()));
+    out.write(bank.xstart());
+    out.write(bank.xstep());
+    out.write(static_cast<int32_t>(bank.ypixels()));
+    out.write(bank.ystart());
+    out.write(bank.ystep());
+    out.write(static_cast<int32_t>(bank.idstart()));
+    out.write(static_cast<uint8_t>(bank.idfillbyfirst_y() ? 1 : 0));
+    out.write(static_cast<int32_t>(bank.idstepbyrow()));
+    out.write(static_cast<int32_t>(bank.idstep()));
+
+    const int nColumns = bank.nelements();
+    out.write(static_cast<uint32_t>(nColumns));
+    for (int x = 0; x < nColumns; ++x) {
+      boost::shared_ptr<const IComponent> column = bank.getChild(x);
+      const CompAssembly *assembly =
+          dynamic_cast<const CompAssembly *>(column.get());
+      if (!assembly)
+        throw unsupported("unexpected component in rectangular detector " +
+                          bank.getName());
+      addComponent(assembly);
+      out.writeV3D(assembly->getRelativePos());
+      out.writeRotation(assembly->getRelativeRot());
+      const int nPixels = assembly->nelements();
+      out.write(static_cast<uint32_t>(nPixels));
+      for (int y = 0; y < nPixels; ++y) {
+        boost::shared_ptr<const IComponent> child = assembly->getChild(y);
+        const RectangularDetectorPixel *pixel =
+            dynamic_cast<const RectangularDetectorPixel *>(child.get());
+        if (!pixel)
+          throw unsupported("unexpected component in rectangular detector " +
+                            bank.getName());
+        addComponent(pixel);
+        out.write(static_cast<int32_t>(pixel->getID()));
+        out.writeRotation(pixel->getRelativeRot());
+      }
+    }
+  }
+
+  void addComponent(const IComponent *comp) {
+    const uint32_t index = static_cast<uint32_t>(m_componentIndex.size());
+    m_componentIndex[identity(comp)] = index;
+  }
+
+  int32_t objectShapeIndex(const ObjComponent &comp) {
+    if (comp.material())
+      throw unsupported("component " + comp.getName() + " has a material");
+    return shapeIndex(comp.shape().get());
+  }
+
+  int32_t shapeIndex(const Object *shape) {
+    if (!shape)
+      return NO_INDEX;
+    auto it = m_shapeIndex.find(shape);
+    if (it != m_shapeIndex.end())
+      return it->second;
+    const int32_t index = static_cast<int32_t>(m_shapes.size());
+    m_shapes.push_back(shape);
+    m_shapeIndex[shape] = index;
+    return index;
+  }
+
+  uint32_t nameIndex(const std::string &name) {
+    auto it = m_nameIndex.find(name);
+    if (it != m_nameIndex.end())
+      return it->second;
+    const uint32_t index = static_cast<uint32_t>(m_names.size());
+    m_names.push_back(name);
+    m_nameIndex[name] = index;
+    return index;
+  }
+
+  std::vector<const Object *> m_shapes;
+  std::map<const Object *, int32_t> m_shapeIndex;
+  std::vector<std::pair<std::string, int32_t>> m_typeShapes;
+  std::vector<std::string> m_names;
+  std::map<std::string, uint32_t> m_nameIndex;
+  std::map<const void *, uint32_t> m_componentIndex;
+};
+
+/**
+ * Rebuilds the component tree written by a TreeWriter, keeping the
+ * components in the same pre-order so that the markers can refer to them by
+ * index.
+ */
+class TreeReader {
+public:
+  explicit TreeReader(CacheReader &in)
+      : m_in(in), m_names(), m_shapes(), m_components() {}
+
+  /// Reads the name and shape tables, returning the shapes of the types
+  void readTables(InstrumentBinaryCache::ShapeMap &typeShapes) {
+    const uint32_t nNames = m_in.read<uint32_t>();
+    m_names.reserve(nNames);
+    for (uint32_t i = 0; i < nNames; ++i)
+      m_names.push_back(m_in.readString());
+
+    const uint32_t nShapes = m_in.read<uint32_t>();
+    ShapeFactory shapeCreator;
+    for (uint32_t i = 0; i < nShapes; ++i) {
+      const int32_t objName = m_in.read<int32_t>();
+      const std::string xml = m_in.readString();
+      boost::shared_ptr<Object> shape =
+          xml.empty() ? boost::make_shared<Object>()
+                      : shapeCreator.createShape(xml, false);
+      shape->setName(objName);
+      m_shapes.push_back(shape);
+    }
+    const uint32_t nTypes = m_in.read<uint32_t>();
+    for (uint32_t i = 0; i < nTypes; ++i) {
+      const std::string typeName = m_in.readString();
+      typeShapes[typeName] = readShape();
+    }
+  }
+
+  void readInstrument(Instrument &instrument) {
+    m_components.push_back(&instrument);
+    instrument.setPos(m_in.readV3D());
+    instrument.setRot(m_in.readRotation());
+    readChildren(&instrument);
+  }
+
+  /// The component with the index read next, or NULL for NO_INDEX
+  IComponent *readComponentIndex() {
+    const int32_t index = m_in.read<int32_t>();
+    if (index == NO_INDEX)
+      return NULL;
+    if (index < 0 || static_cast<size_t>(index) >= m_components.size())
+      throw corrupt("component index out of range");
+    return m_components[index];
+  }
+
+  /// The detector with the index read next
+  Detector *readDetectorIndex() {
+    Detector *det = dynamic_cast<Detector *>(readComponentIndex());
+    if (!det)
+      throw corrupt("detector index does not refer to a detector");
+    return det;
+  }
+
+private:
+  void readChildren(ICompAssembly *parent) {
+    const uint32_t count = m_in.read<uint32_t>();
+    for (uint32_t i = 0; i < count; ++i)
+      readComponent(parent);
+  }
+
+  void readComponent(ICompAssembly *parent) {
+    const uint8_t kind = m_in.read<uint8_t>();
+    const std::string &name = readName();
+    const V3D pos = m_in.readV3D();
+    const Quat rot = m_in.readRotation();
+
+    // Assemblies add themselves to their parent
+    IComponent *comp(NULL);
+    switch (kind) {
+    case LogicalKind:
+      comp = new Component(name, parent);
+      parent->add(comp);
+      break;
+    case PhysicalKind:
+      comp = new ObjComponent(name, readShape(), parent);
+      parent->add(comp);
+      break;
+    case DetectorKind: {
+      boost::shared_ptr<Object> shape = readShape();
+      const int32_t id = m_in.read<int32_t>();
+      comp = new Detector(name, id, shape, parent);
+      parent->add(comp);
+      break;
+    }
+    case AssemblyKind: {
+      CompAssembly *assembly = new CompAssembly(name, parent);
+      place(assembly, pos, rot);
+      readChildren(assembly);
+      return;
+    }
+    case ObjAssemblyKind: {
+      ObjCompAssembly *assembly = new ObjCompAssembly(name, parent);
+      place(assembly, pos, rot);
+      boost::shared_ptr<Object> outline = readShape();
+      if (outline)
+        assembly->setOutline(outline);
+      readChildren(assembly);
+      return;
+    }
+    case RectangularKind: {
+      RectangularDetector *bank = new RectangularDetector(name, parent);
+      place(bank, pos, rot);
+      readRectangular(bank);
+      return;
+    }
+    default:
+      throw corrupt("unknown component kind");
+    }
+    place(comp, pos, rot);
+  }
+
+  void readRectangular(RectangularDetector *bank) {
+    boost::shared_ptr<Object> shape = readShape();
+    const int32_t xpixels = m_in.read<int32_t>();
+    const double xstart = m_in.read<double>();
+    const double xstep = m_in.read<double>();
+    const int32_t ypixels = m_in.read<int32_t>();
+    const double ystart = m_in.read<double>();
+    const double ystep = m_in.read<double>();
+    const int32_t idstart = m_in.read<int32_t>();
+    const bool idfillbyfirst_y = m_in.read<uint8_t>() != 0;
+    const int32_t idstepbyrow = m_in.read<int32_t>();
+    const int32_t idstep = m_in.read<int32_t>();
+    if (!shape || xpixels <= 0 || ypixels <= 0)
+      throw corrupt("invalid rectangular detector " + bank->getName());
+    bank->initialize(shape, xpixels, xstart, xstep, ypixels, ystart, ystep,
+                     idstart, idfillbyfirst_y, idstepbyrow, idstep);
+
+    const uint32_t nColumns = m_in.read<uint32_t>();
+    if (nColumns != static_cast<uint32_t>(bank->nelements()))
+      throw corrupt("pixel columns do not match " + bank->getName());
+    for (uint32_t x = 0; x < nColumns; ++x) {
+      CompAssembly *column =
+          dynamic_cast<CompAssembly *>(bank->getChild(static_cast<int>(x)).get());
+      if (!column)
+        throw corrupt("pixel columns do not match " + bank->getName());
+      m_components.push_back(column);
+      column->setPos(m_in.readV3D());
+      column->setRot(m_in.readRotation());
+
+      const uint32_t nPixels = m_in.read<uint32_t>();
+      if (nPixels != static_cast<uint32_t>(column->nelements()))
+        throw corrupt("pixels do not match " + bank->getName());
+      for (uint32_t y = 0; y < nPixels; ++y) {
+        Detector *pixel =
+            dynamic_cast<Detector *>(column->getChild(static_cast<int>(y)).get());
+        const int32_t id = m_in.read<int32_t>();
+        if (!pixel || pixel->getID() != id)
+          throw corrupt("pixel IDs do not match " + bank->getName());
+        m_components.push_back(pixel);
+        pixel->setRot(m_in.readRotation());
+      }
+    }
+  }
+
+  /// Sets the placement and numbers the component
+  void place(IComponent *comp, const V3D &pos, const Quat &rot) {
+    comp->setPos(pos);
+    comp->setRot(rot);
+    m_components.push_back(comp);
+  }
+
+  const std::string &readName() {
+    const uint32_t index = m_in.read<uint32_t>();
+    if (index >= m_names.size())
+      throw corrupt("name index out of range");
+    return m_names[index];
+  }
+
+  boost::shared_ptr<Object> readShape() {
+    const int32_t index = m_in.read<int32_t>();
+    if (index == NO_INDEX)
+      return boost::shared_ptr<Object>();
+    if (index < 0 || static_cast<size_t>(index) >= m_shapes.size())
+      throw corrupt("shape index out of range");
+    return m_shapes[index];
+  }
+
+  CacheReader &m_in;
+  std::vector<std::string> m_names;
+  std::vector<boost::shared_ptr<Object>> m_shapes;
+  std::vector<IComponent *> m_components;
+};
+
+/// Writes a parameter from the definition file
+void writeParameter(CacheWriter &out, const TreeWriter &tree,
+                    const XMLInstrumentParameter &param) {
+  out.writeString(param.m_logfileID);
+  out.writeString(param.m_value);
+  out.write(static_cast<uint8_t>(param.m_interpolation ? 1 : 0));
+  if (param.m_interpolation) {
+    std::ostringstream interpolation;
+    interpolation.precision(17);
+    interpolation << *param.m_interpolation;
+    out.writeString(interpolation.str());
+  }
+  out.writeString(param.m_formula);
+  out.writeString(param.m_formulaUnit);
+  out.writeString(param.m_resultUnit);
+  out.writeString(param.m_paramName);
+  out.writeString(param.m_type);
+  out.writeString(param.m_tie);
+  out.write(static_cast<uint32_t>(param.m_constraint.size()));
+  for (auto it = param.m_constraint.begin(); it != param.m_constraint.end();
+       ++it)
+    out.writeString(*it);
+  out.writeString(param.m_penaltyFactor);
+  out.writeString(param.m_fittingFunction);
+  out.writeString(param.m_extractSingleValueAs);
+  out.writeString(param.m_eq);
+  out.write(tree.componentIndex(param.m_component));
+  out.write(param.m_angleConvertConst);
+}
+
+/// Reads a parameter written by writeParameter
+boost::shared_ptr<XMLInstrumentParameter> readParameter(CacheReader &in,
+                                                        TreeReader &tree) {
+  const std::string logfileID = in.readString();
+  const std::string value = in.readString();
+  boost::shared_ptr<Kernel::Interpolation> interpolation;
+  if (in.read<uint8_t>() != 0) {
+    interpolation = boost::make_shared<Kernel::Interpolation>();
+    std::istringstream text(in.readString());
+    text >> *interpolation;
+  }
+  const std::string formula = in.readString();
+  const std::string formulaUnit = in.readString();
+  const std::string resultUnit = in.readString();
+  const std::string paramName = in.readString();
+  const std::string type = in.readString();
+  const std::string tie = in.readString();
+  std::vector<std::string> constraint;
+  const uint32_t nConstraints = in.read<uint32_t>();
+  for (uint32_t i = 0; i < nConstraints; ++i)
+    constraint.push_back(in.readString());
+  std::string penaltyFactor = in.readString();
+  const std::string fitFunc = in.readString();
+  const std::string extractSingleValueAs = in.readString();
+  const std::string eq = in.readString();
+  const IComponent *comp = tree.readComponentIndex();
+  const double angleConvertConst = in.read<double>();
+  return boost::make_shared<XMLInstrumentParameter>(
+      logfileID, value, interpolation, formula, formulaUnit, resultUnit,
+      paramName, type, tie, constraint, penaltyFactor, fitFunc,
+      extractSingleValueAs, eq, comp, angleConvertConst);
+}
+}
+
+/**
+ * The file is written under a temporary name and renamed into place, so a
+ * reader never sees a partly written file.
+ *
+ * @param filename :: The cache file to write
+ * @param key :: Stamp identifying the definition, checked by load()
+ * @param instrument :: A complete, unparametrized instrument
+ * @param typeShapes :: The shapes created for each type in the definition
+ * @throw std::runtime_error if the instrument holds anything the file cannot
+ * represent or the file cannot be written
+ */
+void InstrumentBinaryCache::save(const std::string &filename,
+                                 const std::string &key,
+                                 const Instrument &instrument,
+                                 const ShapeMap &typeShapes) {
+  if (instrument.isParametrized())
+    throw unsupported("it is parametrized");
+  if (instrument.m_physicalInstrument)
+    throw unsupported("it has a separate physical instrument");
+  if (instrument.m_map_nonconst && !instrument.m_map_nonconst->empty())
+    throw unsupported("it has parameters from <component-link> elements");
+
+  // The tables are filled while the tree is written but go ahead of it
+  TreeWriter tree(typeShapes);
+  std::ostringstream treeBuffer(std::ios::out | std::ios::binary);
+  CacheWriter treeOut(treeBuffer);
+  tree.writeInstrument(treeOut, instrument);
+
+  const std::string tmpFilename =
+      filename + "." + boost::lexical_cast<std::string>(Poco::Process::id()) +
+      ".tmp";
+  std::ofstream file(tmpFilename.c_str(), std::ios::out | std::ios::binary);
+  if (!file)
+    throw std::runtime_error("Unable to open instrument cache file " +
+                             tmpFilename);
+  try {
+    CacheWriter out(file);
+    out.writeBytes(START_MARKER, MARKER_LENGTH);
+    out.write(FORMAT_VERSION);
+    out.write(BYTE_ORDER_MARK);
+    out.writeString(Kernel::MantidVersion::version());
+    out.writeString(key);
+
+    tree.writeTables(out);
+    const std::string treeBytes = treeBuffer.str();
+    out.writeBytes(treeBytes.data(), treeBytes.size());
+
+    // Markers
+    out.write(static_cast<uint32_t>(instrument.m_detectorCache.size()));
+    for (auto it = instrument.m_detectorCache.begin();
+         it != instrument.m_detectorCache.end(); ++it)
+      out.write(tree.componentIndex(it->second.get()));
+    out.write(static_cast<uint32_t>(instrument.m_monitorCache.size()));
+    for (auto it = instrument.m_monitorCache.begin();
+         it != instrument.m_monitorCache.end(); ++it) {
+      auto det = instrument.m_detectorCache.find(*it);
+      if (det == instrument.m_detectorCache.end())
+        throw unsupported("monitor " + boost::lexical_cast<std::string>(*it) +
+                          " is not a detector");
+      out.write(tree.componentIndex(det->second.get()));
+    }
+    out.write(tree.componentIndex(instrument.m_sourceCache));
+    out.write(tree.componentIndex(instrument.m_sampleCache));
+    out.write(static_cast<uint32_t>(instrument.m_chopperPoints->size()));
+    for (auto it = instrument.m_chopperPoints->begin();
+         it != instrument.m_chopperPoints->end(); ++it)
+      out.write(tree.componentIndex(*it));
+
+    // Instrument-wide settings
+    out.writeString(instrument.m_defaultView);
+    out.writeString(instrument.m_defaultViewAxis);
+    out.write(static_cast<int64_t>(instrument.m_ValidFrom.totalNanoseconds()));
+    out.write(static_cast<int64_t>(instrument.m_ValidTo.totalNanoseconds()));
+    const ReferenceFrame &frame = *instrument.m_referenceFrame;
+    out.write(static_cast<int32_t>(frame.pointingUp()));
+    out.write(static_cast<int32_t>(frame.pointingAlongBeam()));
+    out.write(static_cast<int32_t>(frame.getHandedness()));
+    out.writeString(frame.origin());
+    out.write(static_cast<uint32_t>(instrument.m_logfileUnit.size()));
+    for (auto it = instrument.m_logfileUnit.begin();
+         it != instrument.m_logfileUnit.end(); ++it) {
+      out.writeString(it->first);
+      out.writeString(it->second);
+    }
+
+    // Parameters from the definition file
+    out.write(static_cast<uint32_t>(instrument.m_logfileCache.size()));
+    for (auto it = instrument.m_logfileCache.begin();
+         it != instrument.m_logfileCache.end(); ++it) {
+      out.writeString(it->first.first);
+      out.write(tree.componentIndex(it->first.second));
+      writeParameter(out, tree, *it->second);
+    }
+
+    out.writeBytes(END_MARKER, MARKER_LENGTH);
+    file.close();
+    if (!file)
+      throw std::runtime_error("Error writing instrument cache file " +
+                               tmpFilename);
+    Poco::File(tmpFilename).renameTo(filename);
+  } catch (...) {
+    if (file.is_open())
+      file.close();
+    Poco::File tmpFile(tmpFilename);
+    if (tmpFile.exists())
+      tmpFile.remove();
+    throw;
+  }
+}
+
+/**
+ * @param filename :: The cache file to read
+ * @param key :: The stamp the file must have been written with
+ * @param instrument :: A newly constructed instrument to fill
+ * @param typeShapes :: Filled with the shapes created for each type
+ * @return False if the file does not exist or was written for a different key,
+ * Mantid version or architecture, in which case nothing is changed
+ * @throw std::runtime_error if the file cannot be read back
+ */
+bool InstrumentBinaryCache::load(const std::string &filename,
+                                 const std::string &key, Instrument &instrument,
+                                 ShapeMap &typeShapes) {
+  Poco::File file(filename);
+  if (!file.exists() || file.getSize() == 0)
+    return false;
+
+  Poco::SharedMemory memory(file, Poco::SharedMemory::AM_READ);
+  CacheReader in(memory.begin(), memory.end());
+  if (!in.match(START_MARKER, MARKER_LENGTH))
+    throw corrupt(filename + " is not an instrument cache file");
+  if (in.read<uint32_t>() != FORMAT_VERSION ||
+      in.read<uint32_t>() != BYTE_ORDER_MARK ||
+      in.readString() != Kernel::MantidVersion::version() ||
+      in.readString() != key)
+    return false;
+
+  TreeReader tree(in);
+  ShapeMap shapes;
+  tree.readTables(shapes);
+  tree.readInstrument(instrument);
+
+  // Markers. Monitors are marked as detectors first, as when parsing.
+  const uint32_t nDetectors = in.read<uint32_t>();
+  for (uint32_t i = 0; i < nDetectors; ++i)
+    instrument.markAsDetector(tree.readDetectorIndex());
+  const uint32_t nMonitors = in.read<uint32_t>();
+  for (uint32_t i = 0; i < nMonitors; ++i)
+    instrument.markAsMonitor(tree.readDetectorIndex());
+  instrument.m_sourceCache = tree.readComponentIndex();
+  instrument.m_sampleCache = tree.readComponentIndex();
+  const uint32_t nChoppers = in.read<uint32_t>();
+  for (uint32_t i = 0; i < nChoppers; ++i) {
+    const ObjComponent *chopper =
+        dynamic_cast<const ObjComponent *>(tree.readComponentIndex());
+    if (!chopper)
+      throw corrupt("chopper point is not a physical component");
+    instrument.m_chopperPoints->push_back(chopper);
+  }
+
+  // Instrument-wide settings
+  instrument.m_defaultView = in.readString();
+  instrument.m_defaultViewAxis = in.readString();
+  instrument.m_ValidFrom = Kernel::DateAndTime(in.read<int64_t>());
+  instrument.m_ValidTo = Kernel::DateAndTime(in.read<int64_t>());
+  const int32_t up = in.read<int32_t>();
+  const int32_t alongBeam = in.read<int32_t>();
+  const int32_t handedness = in.read<int32_t>();
+  const std::string origin = in.readString();
+  instrument.m_referenceFrame = boost::make_shared<ReferenceFrame>(
+      static_cast<PointingAlong>(up), static_cast<PointingAlong>(alongBeam),
+      static_cast<Handedness>(handedness), origin);
+  const uint32_t nUnits = in.read<uint32_t>();
+  for (uint32_t i = 0; i < nUnits; ++i) {
+    const std::string name = in.readString();
+    instrument.m_logfileUnit[name] = in.readString();
+  }
+
+  // Parameters from the definition file
+  const uint32_t nParams = in.read<uint32_t>();
+  for (uint32_t i = 0; i < nParams; ++i) {
+    const std::string name = in.readString();
+    const IComponent *comp = tree.readComponentIndex();
+    instrument.m_logfileCache[std::make_pair(name, comp)] =
+        readParameter(in, tree);
+  }
+
+  if (!in.match(END_MARKER, MARKER_LENGTH) || !in.atEnd())
+    throw corrupt(filename + " does not end where expected");
+  typeShapes.swap(shapes);
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
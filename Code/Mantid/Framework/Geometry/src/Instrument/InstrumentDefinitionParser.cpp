@@ -1,5 +1,6 @@
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -7,6 +8,7 @@
 #include "MantidGeometry/Objects/ShapeFactory.h"
 #include "MantidGeometry/Rendering/vtkGeometryCacheReader.h"
 #include "MantidGeometry/Rendering/vtkGeometryCacheWriter.h"
+#include "MantidKernel/ChecksumHelper.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/ProgressBase.h"
@@ -43,6 +45,14 @@ namespace Geometry {
 namespace {
 // initialize the static logger
 Kernel::Logger g_log("InstrumentDefinitionParser");
+
+/// True unless the binary instrument cache has been switched off
+bool useBinaryCache() {
+  int enabled(1);
+  ConfigService::Instance().getValue("instrumentDefinition.binaryCache",
+                                     enabled);
+  return enabled != 0;
+}
 }
 
 //----------------------------------------------------------------------------------------------
@@ -110,11 +120,40 @@ void InstrumentDefinitionParser::initialize(
   m_instName = instName;
   m_xmlFile = xmlFile;
   m_cacheFile = expectedCacheFile;
+  // The XML is parsed when it is first needed, which is never if the
+  // instrument is already loaded or can be read from the binary cache
+  pDoc = Poco::AutoPtr<Document>();
+  pRootElem = NULL;
+
+  // Create our new instrument
+  // We don't want the instrument name taken out of the XML file itself, it
+  // should come from the filename (or the property)
+  m_instrument = boost::make_shared<Instrument>(m_instName);
+
+  // Save the XML file path and contents
+  m_instrument->setFilename(filename);
+  m_instrument->setXmlText(xmlText);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Parse the XML contents given to initialize() into the DOM tree, unless
+ * that has already been done.
+ *
+ * @throw FileError if the XML cannot be parsed
+ * @throw InstrumentDefinitionError if there is no root element
+ */
+void InstrumentDefinitionParser::loadDocument() {
+  if (pDoc)
+    return;
+  if (!m_instrument)
+    throw std::runtime_error(
+        "Call InstrumentDefinitionParser::initialize() before parsing.");
 
   // Set up the DOM parser and parse xml file
+  const std::string filename = m_xmlFile->getFileFullPathStr();
   DOMParser pParser;
   try {
-    pDoc = pParser.parseString(xmlText);
+    pDoc = pParser.parseString(m_instrument->getXmlText());
   } catch (Poco::Exception &exc) {
     throw Kernel::Exception::FileError(
         exc.displayText() + ". Unable to parse XML", filename);
@@ -128,15 +167,6 @@ void InstrumentDefinitionParser::initialize(
     throw Kernel::Exception::InstrumentDefinitionError(
         "No root element in XML instrument file", filename);
   }
-
-  // Create our new instrument
-  // We don't want the instrument name taken out of the XML file itself, it
-  // should come from the filename (or the property)
-  m_instrument = boost::make_shared<Instrument>(m_instName);
-
-  // Save the XML file path and contents
-  m_instrument->setFilename(filename);
-  m_instrument->setXmlText(xmlText);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -154,7 +184,8 @@ std::string InstrumentDefinitionParser::getMangledName() {
   // Use the file in preference if possible.
   if (this->m_xmlFile->exists()) {
     return m_xmlFile->getMangledName();
-  } else if (!pDoc.isNull()) {
+  } else if (m_instrument) {
+    loadDocument();
     std::string lastModified = pRootElem->getAttribute("last-modified");
     if (lastModified.empty()) {
       g_log.warning() << "The IDF that you are using doesn't contain a "
@@ -171,6 +202,10 @@ std::string InstrumentDefinitionParser::getMangledName() {
 
 //----------------------------------------------------------------------------------------------
 /** Fully parse the IDF XML contents and returns the instrument thus created
+ *
+ * If the same XML has been parsed before and the 'instrumentDefinition.
+ *binaryCache' setting is on, the instrument is read from the binary cache
+ *written then instead.
  *
  * @param prog :: Optional Progress reporter object. If NULL, no progress
  *reporting.
@@ -178,10 +213,23 @@ std::string InstrumentDefinitionParser::getMangledName() {
  */
 Instrument_sptr
 InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *prog) {
-  if (!pDoc)
+  if (!m_instrument)
     throw std::runtime_error(
         "Call InstrumentDefinitionParser::initialize() before parseXML.");
 
+  // An earlier parse of the same definition may have been cached
+  const bool binaryCache = useBinaryCache();
+  std::string cacheKey;
+  if (binaryCache) {
+    cacheKey = ChecksumHelper::sha1FromString(m_instrument->getXmlText());
+    if (loadBinaryCache(cacheKey)) {
+      // The shapes are still rendered through the geometry cache
+      m_cachingOption = setupGeometryCache();
+      return m_instrument;
+    }
+  }
+
+  loadDocument();
   setValidityRange(pRootElem);
   readDefaults(pRootElem->getChildElement("defaults"));
   // create maps: isTypeAssembly and mapTypeNameToShape
@@ -436,6 +484,9 @@ InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *prog) {
   if (m_indirectPositions)
     createNeutronicInstrument();
 
+  if (binaryCache)
+    saveBinaryCache(cacheKey);
+
   // And give back what we created
   return m_instrument;
 }
@@ -505,6 +556,7 @@ void InstrumentDefinitionParser::appendLocations(
  *  @param outFilename :: Output filename
  */
 void InstrumentDefinitionParser::saveDOM_Tree(std::string &outFilename) {
+  loadDocument();
   Poco::XML::DOMWriter writer;
   writer.setNewLine("\n");
   writer.setOptions(Poco::XML::XMLWriter::PRETTY_PRINT);
@@ -2263,6 +2315,90 @@ InstrumentDefinitionParser::getAppliedCachingOption() const {
   return m_cachingOption;
 }
 
+/**
+Get the name of the binary instrument cache file. It is named after the IDF
+file, so that the dated definitions of one instrument do not share a file, or
+after the checksum of the definition if it was not read from a file.
+@param adjacent : If true the file next to the IDF, otherwise the one in the
+temporary directory
+@param key : Checksum of the IDF contents
+@return the full path of the cache file
+*/
+std::string
+InstrumentDefinitionParser::binaryCacheFilename(bool adjacent,
+                                                const std::string &key) const {
+  static const char *cacheExt = ".idfcache";
+  std::string filename = m_instName + "_" + key + cacheExt;
+  if (m_xmlFile->exists()) {
+    filename = adjacent ? m_xmlFile->getFileFullPathStr()
+                        : m_xmlFile->getFileNameOnly();
+    const std::string idfExt = m_xmlFile->getExtension();
+    if (idfExt.empty())
+      filename += cacheExt;
+    else
+      boost::replace_last(filename, idfExt, cacheExt);
+  }
+  if (adjacent)
+    return filename;
+  return Poco::Path(ConfigService::Instance().getTempDir())
+      .append(filename)
+      .toString();
+}
+
+/**
+Replace the instrument with one read from the binary cache, trying the file
+next to the IDF and then the one in the temporary directory.
+@param key : Checksum of the IDF contents the cache must have been written for
+@return true if a cache file was read
+*/
+bool InstrumentDefinitionParser::loadBinaryCache(const std::string &key) {
+  std::vector<std::string> candidates;
+  if (m_xmlFile->exists())
+    candidates.push_back(binaryCacheFilename(true, key));
+  candidates.push_back(binaryCacheFilename(false, key));
+
+  for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+    Instrument_sptr instrument = boost::make_shared<Instrument>(m_instName);
+    instrument->setFilename(m_instrument->getFilename());
+    instrument->setXmlText(m_instrument->getXmlText());
+    InstrumentBinaryCache::ShapeMap shapes;
+    try {
+      if (InstrumentBinaryCache::load(*it, key, *instrument, shapes)) {
+        g_log.information("Loading instrument from binary cache " + *it);
+        m_instrument = instrument;
+        mapTypeNameToShape.swap(shapes);
+        return true;
+      }
+    } catch (std::exception &exc) {
+      g_log.warning() << "Unable to read instrument cache " << *it << ": "
+                      << exc.what() << "\n";
+    }
+  }
+  return false;
+}
+
+/**
+Write the parsed instrument to the binary cache, next to the IDF if that
+directory is writable and to the temporary directory otherwise. Failure is
+not an error as the IDF is simply parsed again next time.
+@param key : Checksum of the IDF contents
+*/
+void InstrumentDefinitionParser::saveBinaryCache(const std::string &key) {
+  try {
+    bool adjacent = m_xmlFile->exists();
+    if (adjacent) {
+      Poco::File dir = m_xmlFile->getParentDirectory();
+      adjacent = !dir.path().empty() && dir.exists() && dir.canWrite();
+    }
+    const std::string filename = binaryCacheFilename(adjacent, key);
+    InstrumentBinaryCache::save(filename, key, *m_instrument,
+                                mapTypeNameToShape);
+    g_log.information("Created binary instrument cache " + filename);
+  } catch (std::exception &exc) {
+    g_log.information() << "Instrument not cached: " << exc.what() << "\n";
+  }
+}
+
 void InstrumentDefinitionParser::createNeutronicInstrument() {
   // Create a copy of the instrument
   Instrument_sptr physical(new Instrument(*m_instrument));
@@ -996,4 +996,50 @@ public:
 
 };
 
+class IndexingUtilsTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static IndexingUtilsTestPerformance *createSuite() { return new IndexingUtilsTestPerformance(); }
+  static void destroySuite( IndexingUtilsTestPerformance *suite ) { delete suite; }
+
+  IndexingUtilsTestPerformance()
+  {
+    // About 10^4 natrolite peaks
+    Matrix<double> UB = IndexingUtilsTest::getNatroliteUB();
+    for ( int h = -3; h <= 3; h++ )
+      for ( int k = -20; k <= 20; k++ )
+        for ( int l = -20; l <= 20; l++ )
+        {
+          if ( h == 0 && k == 0 && l == 0 )
+            continue;
+          q_vectors.push_back( UB * V3D(h, k, l) * (2.0 * M_PI) );
+        }
+  }
+
+  void test_Find_UB_using_FFT()
+  {
+    Matrix<double> UB(3,3,false);
+    double required_tolerance = 0.08;
+    IndexingUtils::Find_UB( UB, q_vectors, 6, 10, required_tolerance, 1 );
+
+    int num_indexed = IndexingUtils::NumberIndexed( UB,
+                                                    q_vectors,
+                                                    required_tolerance );
+    TS_ASSERT_EQUALS( num_indexed, static_cast<int>(q_vectors.size()) );
+  }
+
+  void test_ScanFor_Directions()
+  {
+    std::vector<V3D> directions;
+    size_t num_indexed = IndexingUtils::ScanFor_Directions( directions,
+                                                            q_vectors,
+                                                            6, 10, 0.08, 3 );
+    TS_ASSERT( num_indexed > 0 );
+    TS_ASSERT( !directions.empty() );
+  }
+
+private:
+  std::vector<V3D> q_vectors;
+};
+
 #endif  /* MANTID_GEOMETRY_INDEXING_UTILS_TEST_H_ */
@@ -0,0 +1,257 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_
+#define MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/Object.h"
+#include "MantidKernel/ChecksumHelper.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Strings.h"
+#include "MantidTestHelpers/ScopedFileHelper.h"
+
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/make_shared.hpp>
+#include <Poco/File.h>
+
+#include <fstream>
+
+using namespace Mantid;
+using namespace Mantid::Geometry;
+using namespace Mantid::Kernel;
+using ScopedFileHelper::ScopedFile;
+
+class InstrumentBinaryCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static InstrumentBinaryCacheTest *createSuite() {
+    return new InstrumentBinaryCacheTest();
+  }
+  static void destroySuite(InstrumentBinaryCacheTest *suite) { delete suite; }
+
+  InstrumentBinaryCacheTest()
+      : m_instName("BinaryCacheTest"),
+        m_idfName("InstrumentBinaryCacheTest_Definition.xml") {}
+
+  void setUp() {
+    ConfigServiceImpl &config = ConfigService::Instance();
+    m_cacheSetting = config.getString("instrumentDefinition.binaryCache");
+    config.setString("instrumentDefinition.binaryCache", "1");
+  }
+
+  void tearDown() {
+    ConfigService::Instance().setString("instrumentDefinition.binaryCache",
+                                        m_cacheSetting);
+  }
+
+  void test_round_trip_of_simple_instrument() {
+    checkRoundTrip("IDF_for_UNIT_TESTING.xml");
+  }
+
+  void test_round_trip_of_monitors_and_parameters() {
+    checkRoundTrip("HRPD_for_UNIT_TESTING.xml");
+  }
+
+  void test_round_trip_of_rectangular_detectors() {
+    checkRoundTrip("IDF_for_RECTANGULAR_UNIT_TESTING.xml");
+  }
+
+  void test_cache_for_different_definition_is_ignored() {
+    const std::string xmlText = loadIDF("IDF_for_UNIT_TESTING.xml");
+    ScopedFile idf(xmlText, m_idfName);
+    parse(idf.getFileName(), xmlText);
+
+    Instrument instrument(m_instName);
+    InstrumentBinaryCache::ShapeMap shapes;
+    TS_ASSERT(!InstrumentBinaryCache::load(cacheFilename(idf), "other key",
+                                           instrument, shapes));
+    TS_ASSERT_EQUALS(instrument.nelements(), 0);
+    TS_ASSERT(shapes.empty());
+    TS_ASSERT(!InstrumentBinaryCache::load("InstrumentBinaryCacheTest.missing",
+                                           "other key", instrument, shapes));
+    removeGeneratedFiles(idf);
+  }
+
+  void test_truncated_cache_throws() {
+    const std::string xmlText = loadIDF("IDF_for_UNIT_TESTING.xml");
+    ScopedFile idf(xmlText, m_idfName);
+    parse(idf.getFileName(), xmlText);
+
+    const std::string contents = Strings::loadFile(cacheFilename(idf));
+    ScopedFile truncated(contents.substr(0, contents.size() / 2),
+                         "InstrumentBinaryCacheTest_truncated.idfcache");
+    Instrument instrument(m_instName);
+    InstrumentBinaryCache::ShapeMap shapes;
+    TS_ASSERT_THROWS(
+        InstrumentBinaryCache::load(truncated.getFileName(),
+                                    ChecksumHelper::sha1FromString(xmlText),
+                                    instrument, shapes),
+        std::runtime_error);
+    removeGeneratedFiles(idf);
+  }
+
+  void test_instrument_with_component_links_is_not_cached() {
+    const std::string xmlText = loadIDF("IDF_for_UNIT_TESTING2.xml");
+    ScopedFile idf(xmlText, m_idfName);
+    parse(idf.getFileName(), xmlText);
+
+    TS_ASSERT(!Poco::File(cacheFilename(idf)).exists());
+    removeGeneratedFiles(idf);
+  }
+
+  void test_parametrized_instrument_cannot_be_saved() {
+    Instrument_const_sptr base = boost::make_shared<Instrument>(m_instName);
+    Instrument parametrized(base, boost::make_shared<ParameterMap>());
+    const std::string filename("InstrumentBinaryCacheTest.idfcache");
+
+    TS_ASSERT_THROWS(
+        InstrumentBinaryCache::save(filename, "key", parametrized,
+                                    InstrumentBinaryCache::ShapeMap()),
+        std::runtime_error);
+    TS_ASSERT(!Poco::File(filename).exists());
+  }
+
+private:
+  void checkRoundTrip(const std::string &idfName) {
+    const std::string xmlText = loadIDF(idfName);
+    ScopedFile idf(xmlText, m_idfName);
+    Instrument_sptr parsed = parse(idf.getFileName(), xmlText);
+    TS_ASSERT(Poco::File(cacheFilename(idf)).exists());
+
+    Instrument cached(m_instName);
+    InstrumentBinaryCache::ShapeMap shapes;
+    TS_ASSERT(InstrumentBinaryCache::load(
+        cacheFilename(idf), ChecksumHelper::sha1FromString(xmlText), cached,
+        shapes));
+    TS_ASSERT(!shapes.empty());
+    compareInstruments(*parsed, cached);
+
+    // The parser now reads the same instrument back from the cache
+    Instrument_sptr reloaded = parse(idf.getFileName(), xmlText);
+    compareInstruments(*parsed, *reloaded);
+
+    removeGeneratedFiles(idf);
+  }
+
+  void compareInstruments(const Instrument &expected, const Instrument &actual) {
+    TS_ASSERT_EQUALS(actual.nelements(), expected.nelements());
+
+    detid2det_map expectedDets, actualDets;
+    expected.getDetectors(expectedDets);
+    actual.getDetectors(actualDets);
+    TS_ASSERT_EQUALS(actualDets.size(), expectedDets.size());
+    size_t mismatches(0);
+    for (auto it = expectedDets.begin(); it != expectedDets.end(); ++it) {
+      auto found = actualDets.find(it->first);
+      if (found == actualDets.end()) {
+        ++mismatches;
+        continue;
+      }
+      const IDetector &det = *found->second;
+      const IDetector &expectedDet = *it->second;
+      if (det.getName() != expectedDet.getName() ||
+          !(det.getPos() == expectedDet.getPos()) ||
+          !(det.getRotation() == expectedDet.getRotation()) ||
+          det.isMonitor() != expectedDet.isMonitor() ||
+          det.shape()->getShapeXML() != expectedDet.shape()->getShapeXML() ||
+          det.shape()->getName() != expectedDet.shape()->getName())
+        ++mismatches;
+    }
+    TS_ASSERT_EQUALS(mismatches, 0);
+    TS_ASSERT_EQUALS(actual.getMonitors(), expected.getMonitors());
+
+    TS_ASSERT_EQUALS(actual.getSource()->getName(),
+                     expected.getSource()->getName());
+    TS_ASSERT_EQUALS(actual.getSource()->getPos(),
+                     expected.getSource()->getPos());
+    TS_ASSERT_EQUALS(actual.getSample()->getName(),
+                     expected.getSample()->getName());
+    TS_ASSERT_EQUALS(actual.getSample()->getPos(),
+                     expected.getSample()->getPos());
+    TS_ASSERT_EQUALS(actual.getNumberOfChopperPoints(),
+                     expected.getNumberOfChopperPoints());
+
+    TS_ASSERT_EQUALS(actual.getValidFromDate(), expected.getValidFromDate());
+    TS_ASSERT_EQUALS(actual.getValidToDate(), expected.getValidToDate());
+    TS_ASSERT_EQUALS(actual.getDefaultView(), expected.getDefaultView());
+    TS_ASSERT_EQUALS(actual.getDefaultAxis(), expected.getDefaultAxis());
+    TS_ASSERT_EQUALS(actual.getReferenceFrame()->pointingUp(),
+                     expected.getReferenceFrame()->pointingUp());
+    TS_ASSERT_EQUALS(actual.getReferenceFrame()->pointingAlongBeam(),
+                     expected.getReferenceFrame()->pointingAlongBeam());
+    TS_ASSERT_EQUALS(actual.getReferenceFrame()->getHandedness(),
+                     expected.getReferenceFrame()->getHandedness());
+
+    const InstrumentParameterCache &expectedParams =
+        expected.getLogfileCache();
+    const InstrumentParameterCache &actualParams = actual.getLogfileCache();
+    TS_ASSERT_EQUALS(actualParams.size(), expectedParams.size());
+    // Keyed by component address, so compare by component name instead
+    for (auto it = actualParams.begin(); it != actualParams.end(); ++it) {
+      const XMLInstrumentParameter &param = *it->second;
+      TS_ASSERT_EQUALS(it->first.second, param.m_component);
+      TS_ASSERT_EQUALS(countParameters(actualParams, param),
+                       countParameters(expectedParams, param));
+    }
+  }
+
+  /// Count the parameters with the same name, value and component name
+  size_t countParameters(const InstrumentParameterCache &params,
+                         const XMLInstrumentParameter &param) {
+    size_t count(0);
+    for (auto it = params.begin(); it != params.end(); ++it) {
+      const XMLInstrumentParameter &other = *it->second;
+      if (other.m_paramName == param.m_paramName &&
+          other.m_value == param.m_value &&
+          other.m_logfileID == param.m_logfileID &&
+          fullName(other.m_component) == fullName(param.m_component))
+        ++count;
+    }
+    return count;
+  }
+
+  std::string fullName(const IComponent *comp) {
+    return comp ? comp->getFullName() : "";
+  }
+
+  Instrument_sptr parse(const std::string &filename,
+                        const std::string &xmlText) {
+    InstrumentDefinitionParser parser;
+    parser.initialize(filename, m_instName, xmlText);
+    Instrument_sptr instrument;
+    TS_ASSERT_THROWS_NOTHING(instrument = parser.parseXML(NULL));
+    return instrument;
+  }
+
+  std::string loadIDF(const std::string &idfName) {
+    return Strings::loadFile(ConfigService::Instance().getInstrumentDirectory() +
+                             "/IDFs_for_UNIT_TESTING/" + idfName);
+  }
+
+  std::string cacheFilename(const ScopedFile &idf) {
+    return boost::replace_last_copy(idf.getFileName(), ".xml", ".idfcache");
+  }
+
+  /// Remove the binary and geometry caches written next to the IDF
+  void removeGeneratedFiles(const ScopedFile &idf) {
+    const std::string vtpFilename =
+        boost::replace_last_copy(idf.getFileName(), ".xml", ".vtp");
+    const std::string files[] = {cacheFilename(idf), vtpFilename};
+    for (size_t i = 0; i < 2; ++i) {
+      Poco::File file(files[i]);
+      if (file.exists())
+        file.remove();
+    }
+  }
+
+  const std::string m_instName;
+  const std::string m_idfName;
+  std::string m_cacheSetting;
+};
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_ */
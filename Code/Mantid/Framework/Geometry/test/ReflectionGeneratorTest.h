@@ -0,0 +1,144 @@
+#ifndef MANTID_GEOMETRY_REFLECTIONGENERATORTEST_H_
+#define MANTID_GEOMETRY_REFLECTIONGENERATORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Crystal/ReflectionGenerator.h"
+#include "MantidGeometry/Crystal/PointGroupFactory.h"
+#include "MantidKernel/Timer.h"
+
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <iostream>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class ReflectionGeneratorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ReflectionGeneratorTest *createSuite() {
+    return new ReflectionGeneratorTest();
+  }
+  static void destroySuite(ReflectionGeneratorTest *suite) { delete suite; }
+
+  void test_invalid_arguments_throw() {
+    UnitCell cell(5.0, 6.0, 7.0);
+    ReflectionCondition_sptr primitive =
+        boost::make_shared<ReflectionConditionPrimitive>();
+    TS_ASSERT_THROWS(ReflectionGenerator(cell, ReflectionCondition_sptr(), 1.0,
+                                         2.0),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(ReflectionGenerator(cell, primitive, 0.0, 2.0),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(ReflectionGenerator(cell, primitive, 2.0, 1.0),
+                     std::invalid_argument);
+  }
+
+  void test_matches_brute_force_triclinic() {
+    UnitCell cell(5.3, 6.1, 7.7, 83.0, 101.0, 95.0);
+    ReflectionCondition_sptr centering =
+        boost::make_shared<ReflectionConditionBodyCentred>();
+    ReflectionGenerator generator(cell, centering, 0.9, 4.0);
+
+    std::vector<V3D> expected = bruteForce(cell, *centering, 0.9, 4.0);
+    const std::vector<V3D> &hkls = generator.getHKLs();
+    TS_ASSERT(!hkls.empty());
+    TS_ASSERT_EQUALS(hkls.size(), expected.size());
+    // Ordered by h, k, l like the brute force loop
+    TS_ASSERT(hkls == expected);
+  }
+
+  void test_no_origin() {
+    UnitCell cell(3.0, 3.0, 3.0);
+    ReflectionGenerator generator(
+        cell, boost::make_shared<ReflectionConditionPrimitive>(), 1.0, 1e6);
+    const std::vector<V3D> &hkls = generator.getHKLs();
+    TS_ASSERT(std::find(hkls.begin(), hkls.end(), V3D(0, 0, 0)) == hkls.end());
+    TS_ASSERT(std::find(hkls.begin(), hkls.end(), V3D(1, 0, 0)) != hkls.end());
+  }
+
+  void test_unique_hkls_expand_to_all() {
+    // Silicon, F-centred cubic
+    UnitCell cell(5.43, 5.43, 5.43);
+    ReflectionGenerator generator(
+        cell, boost::make_shared<ReflectionConditionAllFaceCentred>(), 1.0,
+        10.0);
+    PointGroup_sptr pg = PointGroupFactory::Instance().createPointGroup("m-3m");
+
+    std::vector<V3D> unique = generator.getUniqueHKLs(*pg);
+    // 111, 200, 220, 311, 222, 400, 331, 420, 422, 511/333
+    TS_ASSERT_EQUALS(unique.size(), 11);
+
+    std::vector<V3D> all = pg->getAllEquivalents(unique);
+    std::vector<V3D> hkls = generator.getHKLs();
+    TS_ASSERT_EQUALS(all.size(), hkls.size());
+    std::sort(all.begin(), all.end());
+    std::sort(hkls.begin(), hkls.end());
+    TS_ASSERT(all == hkls);
+  }
+
+  void test_getAllEquivalents_keeps_order_of_families() {
+    PointGroup_sptr pg = PointGroupFactory::Instance().createPointGroup("-1");
+    std::vector<V3D> hkls;
+    hkls.push_back(V3D(1, 2, 3));
+    hkls.push_back(V3D(0, 0, 1));
+
+    std::vector<V3D> all = pg->getAllEquivalents(hkls);
+    TS_ASSERT_EQUALS(all.size(), 4);
+    TS_ASSERT_EQUALS(all[0], pg->getEquivalents(V3D(1, 2, 3))[0]);
+    TS_ASSERT_EQUALS(all[2], pg->getEquivalents(V3D(0, 0, 1))[0]);
+  }
+
+private:
+  /// All allowed reflections in the hkl box enclosing the d-range
+  std::vector<V3D> bruteForce(const UnitCell &cell, ReflectionCondition &rc,
+                              double dMin, double dMax) {
+    std::vector<V3D> hkls;
+    int hMax = static_cast<int>(cell.a() / dMin);
+    int kMax = static_cast<int>(cell.b() / dMin);
+    int lMax = static_cast<int>(cell.c() / dMin) + 1;
+    for (int h = -hMax; h <= hMax; ++h)
+      for (int k = -kMax; k <= kMax; ++k)
+        for (int l = -lMax; l <= lMax; ++l) {
+          if (h == 0 && k == 0 && l == 0)
+            continue;
+          double d = cell.d(h, k, l);
+          if (d >= dMin && d <= dMax && rc.isAllowed(h, k, l))
+            hkls.push_back(V3D(h, k, l));
+        }
+    return hkls;
+  }
+};
+
+class ReflectionGeneratorTestPerformance : public CxxTest::TestSuite {
+public:
+  static ReflectionGeneratorTestPerformance *createSuite() {
+    return new ReflectionGeneratorTestPerformance();
+  }
+  static void destroySuite(ReflectionGeneratorTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_large_cell() {
+    // A protein-sized cell gives several million reflections
+    UnitCell cell(80.0, 90.0, 120.0, 90.0, 105.0, 90.0);
+    Mantid::Kernel::Timer timer;
+    ReflectionGenerator generator(
+        cell, boost::make_shared<ReflectionConditionCFaceCentred>(), 1.0,
+        100.0);
+    std::cout << "\nGenerated " << generator.getHKLs().size()
+              << " reflections in " << timer.elapsed() << " s\n";
+
+    PointGroup_sptr pg =
+        PointGroupFactory::Instance().createPointGroup("2/m");
+    std::vector<V3D> unique = generator.getUniqueHKLs(*pg);
+    std::vector<V3D> all = pg->getAllEquivalents(unique);
+    std::cout << unique.size() << " unique reflections expanded to "
+              << all.size() << " in " << timer.elapsed() << " s\n";
+    TS_ASSERT_EQUALS(all.size(), generator.getHKLs().size());
+  }
+};
+
+#endif /* MANTID_GEOMETRY_REFLECTIONGENERATORTEST_H_ */
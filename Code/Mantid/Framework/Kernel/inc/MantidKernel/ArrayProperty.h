@@ -5,9 +5,73 @@
 // Includes
 //----------------------------------------------------------------------
 #include "PropertyWithValue.h"
+#include "MantidKernel/PropertyHistory.h"
+
+#include <boost/functional/hash.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_integral.hpp>
 
 namespace Mantid {
 namespace Kernel {
+
+/// Copies numeric array elements to doubles
+template <typename T, bool = boost::is_arithmetic<T>::value>
+struct ArrayHistoryConversion {
+  static bool toDoubles(const std::vector<T> &in, std::vector<double> &out) {
+    out.assign(in.begin(), in.end());
+    return true;
+  }
+};
+
+/// Elements that are not numbers cannot be copied to doubles
+template <typename T> struct ArrayHistoryConversion<T, false> {
+  static bool toDoubles(const std::vector<T> &, std::vector<double> &) {
+    return false;
+  }
+};
+
+/** The value of an ArrayProperty as recorded in its history. The elements are
+    copied rather than converted to a string, which is only done if the
+    history is printed or saved.
+ */
+template <typename T> class ArrayHistoryValue : public LazyPropertyValue {
+public:
+  /// Constructor
+  explicit ArrayHistoryValue(const std::vector<T> &values)
+      : m_values(values) {}
+  /// The values as the ArrayProperty gives them
+  std::string toString() const { return Kernel::toString(m_values); }
+  /// The number of elements
+  size_t size() const { return m_values.size(); }
+  /// A hash of the elements
+  size_t hash() const {
+    return boost::hash_range(m_values.begin(), m_values.end());
+  }
+  /// True if the elements are integers
+  bool isIntegral() const { return boost::is_integral<T>::value; }
+  /// Copies the elements to doubles if they are numbers
+  bool toDoubles(std::vector<double> &values) const {
+    return ArrayHistoryConversion<T>::toDoubles(m_values, values);
+  }
+  /// True if the other value holds the same elements. Elements of a different
+  /// type are compared as numbers.
+  bool equals(const LazyPropertyValue &other) const {
+    if (other.size() != size())
+      return false;
+    const ArrayHistoryValue<T> *same =
+        dynamic_cast<const ArrayHistoryValue<T> *>(&other);
+    if (same)
+      return same->m_values == m_values;
+    std::vector<double> mine, theirs;
+    return toDoubles(mine) && other.toDoubles(theirs) && mine == theirs;
+  }
+
+private:
+  /// The recorded elements
+  const std::vector<T> m_values;
+};
+
 /** Support for a property that holds an array of values.
     Implemented as a PropertyWithValue that holds a vector of the desired type.
     This class is really a convenience class to aid in the declaration of the
@@ -130,6 +194,30 @@ public:
     // method.
     return PropertyWithValue<std::vector<T>>::setValue(value);
   }
+  /** Creates the history of the property. Arrays longer than
+   *  'algorithms.history.arraythreshold' are not converted to a string here,
+   *  see PropertyHistory::largeArrayMode().
+   *  @return The history of the property
+   */
+  const PropertyHistory createHistory() const {
+    const std::vector<T> &values = this->operator()();
+    switch (PropertyHistory::largeArrayMode(values.size())) {
+    case PropertyHistory::StoreLazy:
+      return PropertyHistory(this->name(),
+                             boost::make_shared<ArrayHistoryValue<T>>(values),
+                             this->type(), this->isDefault(),
+                             this->direction());
+    case PropertyHistory::StoreHash:
+      return PropertyHistory(
+          this->name(),
+          PropertyHistory::hashSummary(
+              values.size(), boost::hash_range(values.begin(), values.end())),
+          this->type(), this->isDefault(), this->direction());
+    default:
+      return PropertyWithValue<std::vector<T>>::createHistory();
+    }
+  }
+
   // May want to add specialisation the the class later, e.g. setting just one
   // element of the vector
 };
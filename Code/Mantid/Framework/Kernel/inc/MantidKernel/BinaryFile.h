@@ -2,6 +2,8 @@
 #define BINARYFILE_H_
 
 #include <fstream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include "MantidKernel/DllConfig.h"
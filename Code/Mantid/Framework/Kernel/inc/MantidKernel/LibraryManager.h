@@ -6,12 +6,15 @@
 //----------------------------------------------------------------------
 #include <string>
 #include <map>
+#include <vector>
 #ifndef Q_MOC_RUN
 #include <boost/shared_ptr.hpp>
 #endif
 
 #include "MantidKernel/SingletonHolder.h"
 #include "MantidKernel/DllConfig.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/PluginManifest.h"
 
 namespace Mantid {
 namespace Kernel {
@@ -20,6 +23,10 @@ class LibraryWrapper;
 /**
 Class for opening shared libraries.
 
+Libraries can also be deferred: given a PluginManifest of what they provide,
+they are only opened once something asks for one of their items through
+loadLibraryProviding() or loadLibrariesProviding().
+
 @author ISIS, STFC
 @date 15/10/2007
 
@@ -48,6 +55,20 @@ class MANTID_KERNEL_DLL LibraryManagerImpl {
 public:
   // opens all suitable libraries on a given path
   int OpenAllLibraries(const std::string &, bool isRecursive = false);
+  /// opens a single library
+  bool OpenLibrary(const std::string &filepath);
+  /// the libraries on a given path that OpenAllLibraries would try to open
+  std::vector<std::string> findLibraries(const std::string &filePath);
+
+  /// put off opening the libraries in the manifest until they are needed
+  void deferLibraries(const PluginManifest &manifest);
+  /// opens the deferred library providing the named item, if any
+  bool loadLibraryProviding(const std::string &kind, const std::string &name);
+  /// opens the deferred libraries providing items of a kind
+  int loadLibrariesProviding(const std::string &kind,
+                             const std::string &prefix = "");
+  /// the names of the items of a kind that deferred libraries provide
+  std::vector<std::string> deferredNames(const std::string &kind) const;
 
 private:
   friend struct Mantid::Kernel::CreateUsingNew<LibraryManagerImpl>;
@@ -68,6 +89,10 @@ private:
   /// Storage for the LibraryWrappers.
   std::map<const std::string, boost::shared_ptr<Mantid::Kernel::LibraryWrapper>>
       OpenLibs;
+  /// Libraries that have not been opened yet and what they provide
+  PluginManifest m_deferred;
+  /// Guards m_deferred. Recursive as opening a library runs arbitrary code.
+  mutable RecursiveMutex m_mutex;
 };
 
 /// Forward declaration of a specialisation of SingletonHolder for
@@ -0,0 +1,98 @@
+#ifndef MANTID_KERNEL_MEMORYMAPPEDFILE_H_
+#define MANTID_KERNEL_MEMORYMAPPEDFILE_H_
+
+#include "MantidKernel/DllConfig.h"
+#include <cstddef>
+#include <string>
+
+namespace Mantid {
+namespace Kernel {
+
+/** MemoryMappedFile : A read-only memory mapping of a whole file.
+
+    The contents are accessed in place through data(), so large binary files
+    can be processed without reading them into intermediate buffers. The
+    operating system pages the file in on demand and may drop clean pages at
+    any time, so the mapping does not count towards the heap.
+
+    Access hints (madvise on POSIX, a no-op on Windows) can be given for the
+    whole file or for a byte range, and release() tells the system a range
+    will not be needed again so its pages can be reclaimed straight away.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL MemoryMappedFile {
+public:
+  /// Expected order in which the mapping will be read
+  enum AccessPattern { Normal, Sequential, Random };
+
+  MemoryMappedFile();
+  explicit MemoryMappedFile(const std::string &filename);
+  ~MemoryMappedFile();
+
+  /// Map a file, closing any previous mapping
+  void open(const std::string &filename);
+  /// Unmap the file
+  void close();
+  /// True if a file is mapped
+  bool isOpen() const { return m_open; }
+
+  /// Start of the mapped contents. NULL for an empty file.
+  const char *data() const { return m_data; }
+  /// Size of the file in bytes
+  size_t size() const { return m_size; }
+
+  /// Hint how the whole mapping will be read
+  void advise(const AccessPattern pattern) const;
+  /// Ask for a byte range to be read ahead
+  void willNeed(const size_t offset, const size_t length) const;
+  /// Allow the pages of a byte range that is no longer needed to be reclaimed
+  void release(const size_t offset, const size_t length) const;
+
+private:
+  /// Disabled copy constructor
+  MemoryMappedFile(const MemoryMappedFile &);
+  /// Disabled assignment operator
+  MemoryMappedFile &operator=(const MemoryMappedFile &);
+
+  /// Apply an madvise flag to the whole pages covering a byte range
+  void adviseRange(const size_t offset, const size_t length,
+                   const int advice) const;
+
+  /// True if a file is mapped
+  bool m_open;
+  /// Start of the mapping
+  const char *m_data;
+  /// Size of the mapping in bytes
+  size_t m_size;
+#ifdef _WIN32
+  /// File handle
+  void *m_fileHandle;
+  /// File mapping object handle
+  void *m_mappingHandle;
+#endif
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_MEMORYMAPPEDFILE_H_ */
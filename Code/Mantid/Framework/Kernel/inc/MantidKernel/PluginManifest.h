@@ -0,0 +1,98 @@
+#ifndef MANTID_KERNEL_PLUGINMANIFEST_H_
+#define MANTID_KERNEL_PLUGINMANIFEST_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** PluginManifest : Records what each plugin library registers with the
+    framework factories, so that opening a library can be put off until one of
+    the things it provides is asked for.
+
+    An entry is a (kind, name) pair, e.g. ("Algorithm", "Rebin|1") or
+    ("Function", "Gaussian"); the kinds are defined by whoever fills the
+    manifest. Each library is stored with a stamp of its size and modification
+    time, and isUpToDate() compares these against the libraries currently on
+    disk so that a rebuilt or added plugin invalidates the manifest.
+
+    Copyright &copy; 2015 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL PluginManifest {
+public:
+  /// Read a manifest written by save()
+  static PluginManifest load(const std::string &filename);
+  /// Stamp identifying the current state of a library file
+  static std::string stamp(const std::string &libraryPath);
+
+  /// Add a library, stamped with its current state on disk
+  void addLibrary(const std::string &libraryPath);
+  /// Add a library with a given stamp
+  void addLibrary(const std::string &libraryPath, const std::string &stamp);
+  /// Record that a library provides the named item
+  void addEntry(const std::string &libraryPath, const std::string &kind,
+                const std::string &name);
+  /// Add the libraries and entries of another manifest
+  void merge(const PluginManifest &other);
+  /// Remove a library and everything it provides
+  void removeLibrary(const std::string &libraryPath);
+
+  /// True if there are no libraries in the manifest
+  bool empty() const { return m_libraries.empty(); }
+  /// The paths of all libraries in the manifest
+  std::vector<std::string> libraries() const;
+  /// The paths of the libraries that provide no items
+  std::vector<std::string> librariesWithoutEntries() const;
+  /// The library providing an item, or an empty string if there is none
+  std::string libraryProviding(const std::string &kind,
+                               const std::string &name) const;
+  /// The libraries providing items of a kind whose names start with prefix
+  std::set<std::string>
+  librariesProviding(const std::string &kind,
+                     const std::string &prefix = "") const;
+  /// The names of all items of a kind, sorted
+  std::vector<std::string> names(const std::string &kind) const;
+
+  /// True if the manifest covers exactly these libraries in their current state
+  bool isUpToDate(const std::vector<std::string> &libraryPaths) const;
+  /// Write the manifest to a file
+  void save(const std::string &filename) const;
+
+private:
+  typedef std::pair<std::string, std::string> Entry;
+
+  /// Library path -> stamp
+  std::map<std::string, std::string> m_libraries;
+  /// (kind, name) -> library path
+  std::map<Entry, std::string> m_providers;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_PLUGINMANIFEST_H_ */
@@ -16,6 +16,29 @@ namespace Kernel {
 //----------------------------------------------------------------------
 class Property;
 
+/** A property value kept in its native form by a PropertyHistory and only
+    turned into a string when it is asked for. Used for large arrays, where
+    building the string would dominate the cost of recording the history.
+*/
+class MANTID_KERNEL_DLL LazyPropertyValue {
+public:
+  virtual ~LazyPropertyValue() {}
+  /// The value as the property itself would give it
+  virtual std::string toString() const = 0;
+  /// The number of elements
+  virtual size_t size() const = 0;
+  /// A hash of the elements
+  virtual size_t hash() const = 0;
+  /// True if the elements are integers
+  virtual bool isIntegral() const = 0;
+  /// Copies the elements to doubles. Returns false if they are not numbers.
+  virtual bool toDoubles(std::vector<double> &values) const = 0;
+  /// True if the other value holds the same elements
+  virtual bool equals(const LazyPropertyValue &other) const = 0;
+};
+
+typedef boost::shared_ptr<const LazyPropertyValue> LazyPropertyValue_const_sptr;
+
 /** @class PropertyHistory PropertyHistory.h API/MAntidAPI/PropertyHistory.h
 
     This class stores information about the parameters used by an algorithm.
@@ -50,6 +73,12 @@ public:
                   const std::string &type, const bool isdefault,
                   const unsigned int direction = 99);
 
+  /// construct a property history whose value is converted to a string on
+  /// first use
+  PropertyHistory(const std::string &name,
+                  const LazyPropertyValue_const_sptr &value,
+                  const std::string &type, const bool isdefault,
+                  const unsigned int direction = 99);
   /// construct a property history from a property object
   PropertyHistory(Property const *const prop);
   PropertyHistory(const PropertyHistory &);
@@ -58,9 +87,19 @@ public:
   /// get name of algorithm parameter const
   const std::string &name() const { return m_name; };
   /// get value of algorithm parameter const
-  const std::string &value() const { return m_value; };
+  const std::string &value() const;
   /// set value of algorithm parameter
-  void setValue(const std::string &value) { m_value = value; };
+  void setValue(const std::string &value) {
+    m_value = value;
+    m_lazyValue.reset();
+  };
+  /// set a value that is converted to a string on first use
+  void setValue(const LazyPropertyValue_const_sptr &value) {
+    m_value.clear();
+    m_lazyValue = value;
+  };
+  /// the unconverted value, if there is one
+  const LazyPropertyValue_const_sptr &lazyValue() const { return m_lazyValue; }
   /// get type of algorithm parameter const
   const std::string &type() const { return m_type; };
   /// get isdefault flag of algorithm parameter const
@@ -70,20 +109,26 @@ public:
   /// print contents of object
   void printSelf(std::ostream &, const int indent = 0) const;
 
+  /// How arrays of a given size are recorded, see largeArrayMode()
+  enum LargeArrayMode { StoreString, StoreLazy, StoreHash };
+  /// How an array of the given size should be recorded
+  static LargeArrayMode largeArrayMode(const size_t numElements);
+  /// The value recorded for an array in StoreHash mode
+  static std::string hashSummary(const size_t numElements, const size_t hash);
+
   /// this is required for boost.python
-  bool operator==(const PropertyHistory &other) const {
-    if (name() == other.name() && value() == other.value() &&
-        type() == other.type() && isDefault() == other.isDefault()) {
-      return true;
-    }
-    return false;
-  }
+  bool operator==(const PropertyHistory &other) const;
 
 private:
+  /// Copy the string value of another history
+  void copyValue(const PropertyHistory &other);
+
   /// The name of the parameter
   std::string m_name;
-  /// The value of the parameter
-  std::string m_value;
+  /// The value of the parameter. Filled from m_lazyValue on first use.
+  mutable std::string m_value;
+  /// The value of the parameter if it has not been converted to a string
+  LazyPropertyValue_const_sptr m_lazyValue;
   /// The type of the parameter
   std::string m_type;
   /// flag defining if the parameter is a default or a user-defined parameter
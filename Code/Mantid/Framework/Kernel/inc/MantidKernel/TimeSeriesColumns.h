@@ -0,0 +1,163 @@
+#ifndef MANTID_KERNEL_TIMESERIESCOLUMNS_H_
+#define MANTID_KERNEL_TIMESERIESCOLUMNS_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/TimeSplitter.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+//----------------------------------------------------------------------
+// Forward declarations
+//----------------------------------------------------------------------
+template <typename TYPE> class TimeSeriesProperty;
+
+/** A columnar, read-optimised copy of a numeric TimeSeriesProperty.
+
+    Times are held as a contiguous column of int64 nanoseconds (since the
+    DateAndTime epoch) and values in a second, parallel column. The log is
+    always kept sorted by time. On top of the columns two indices are built
+    lazily:
+      - a prefix sum of the time-weighted integral, giving time averages over
+        any time range in O(log n);
+      - a segment tree of the values, giving the minimum/maximum over any
+        index or time range in O(log n).
+
+    The columns may optionally be run-length compressed: only the first and
+    last samples of a run of identical values are kept. This preserves every
+    quantity this class (and TimeSeriesProperty::makeFilterByValue) can
+    compute while shrinking slowly varying logs such as set-points or
+    proton_charge by orders of magnitude.
+
+    The value at a time t is the value of the last entry with time <= t, or
+    the first value if t is before the start of the log, exactly as in
+    TimeSeriesProperty::getSingleValue.
+
+    The const query methods build the indices on first use; call buildIndex()
+    before sharing an instance between threads.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename TYPE> class DLLExport TimeSeriesColumns {
+public:
+  /// Default constructor: an empty series
+  TimeSeriesColumns();
+  /// Construct from an existing time series property
+  explicit TimeSeriesColumns(const TimeSeriesProperty<TYPE> &property,
+                             const bool compress = false);
+  /// Construct from a time column in nanoseconds and a value column
+  TimeSeriesColumns(const std::vector<int64_t> &times,
+                    const std::vector<TYPE> &values,
+                    const bool compress = false);
+
+  /// Append an entry. Time must not be earlier than the last entry.
+  void append(const int64_t time, const TYPE value);
+  /// Append an entry. Time must not be earlier than the last entry.
+  void append(const DateAndTime &time, const TYPE value);
+  /// Reserve memory for n entries
+  void reserve(const size_t n);
+  /// Remove all entries
+  void clear();
+  /// Drop the interior samples of runs of identical values
+  void compress();
+  /// Build the integral and min/max indices
+  void buildIndex() const;
+
+  /// Number of entries held
+  size_t size() const { return m_times.size(); }
+  /// True if there are no entries
+  bool empty() const { return m_times.empty(); }
+  /// The time column, in nanoseconds
+  const std::vector<int64_t> &times() const { return m_times; }
+  /// The value column
+  const std::vector<TYPE> &values() const { return m_values; }
+  /// Time of the i-th entry
+  DateAndTime time(const size_t i) const { return DateAndTime(m_times[i]); }
+  /// Value of the i-th entry
+  TYPE value(const size_t i) const { return m_values[i]; }
+  /// Memory used by the columns and indices, in bytes
+  size_t getMemorySize() const;
+
+  /// Index of the entry in effect at time t
+  size_t indexAt(const int64_t time) const;
+  /// Value in effect at time t
+  TYPE valueAt(const DateAndTime &time) const;
+
+  /// Time-weighted integral of the log between two times (value * seconds)
+  double integral(const DateAndTime &start, const DateAndTime &stop) const;
+  /// Time-weighted average of the log between two times
+  double timeAverage(const DateAndTime &start, const DateAndTime &stop) const;
+  /// Time-weighted average of the log over all intervals of a filter
+  double averageValueInFilter(const TimeSplitterType &filter) const;
+
+  /// Minimum value of the entries [first, last]
+  TYPE minInIndexRange(const size_t first, const size_t last) const;
+  /// Maximum value of the entries [first, last]
+  TYPE maxInIndexRange(const size_t first, const size_t last) const;
+  /// Minimum value in effect during [start, stop)
+  TYPE minInTimeRange(const DateAndTime &start, const DateAndTime &stop) const;
+  /// Maximum value in effect during [start, stop)
+  TYPE maxInTimeRange(const DateAndTime &start, const DateAndTime &stop) const;
+
+  /// Fill a TimeSplitterType with the intervals where min <= value <= max
+  void makeFilterByValue(TimeSplitterType &split, double min, double max,
+                         double timeTolerance = 0.0,
+                         bool centre = false) const;
+
+private:
+  /// Sort both columns by time if they are not already in order
+  void sortByTime();
+  /// Index range of the entries in effect during [start, stop)
+  void indexRange(const DateAndTime &start, const DateAndTime &stop,
+                  size_t &first, size_t &last) const;
+  /// Integral from the first entry up to the given time
+  double integralTo(const int64_t time) const;
+  /// Throw if the series is empty
+  void throwIfEmpty(const std::string &method) const;
+
+  /// Entry times in nanoseconds, sorted
+  std::vector<int64_t> m_times;
+  /// Entry values
+  std::vector<TYPE> m_values;
+
+  /// True if the indices below match the columns
+  mutable bool m_indexValid;
+  /// m_cumulative[i] = integral from m_times[0] to m_times[i], value*seconds
+  mutable std::vector<double> m_cumulative;
+  /// Number of leaves of the segment trees (a power of two)
+  mutable size_t m_leaves;
+  /// Segment tree holding the minima of the value column
+  mutable std::vector<TYPE> m_minTree;
+  /// Segment tree holding the maxima of the value column
+  mutable std::vector<TYPE> m_maxTree;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_TIMESERIESCOLUMNS_H_ */
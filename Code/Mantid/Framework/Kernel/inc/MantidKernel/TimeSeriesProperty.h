@@ -273,6 +273,8 @@ public:
   std::string toString() const;
 
 private:
+  /// Reads the entries directly when copying them into columns
+  template <typename T> friend class TimeSeriesColumns;
   /// Sort the property into increasing times
   void sort() const;
   ///  Find the index of the entry of time t in the mP vector (sorted)
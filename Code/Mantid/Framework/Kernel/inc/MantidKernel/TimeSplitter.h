@@ -3,6 +3,8 @@
 
 #include "MantidKernel/DateAndTime.h"
 
+#include <vector>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -57,6 +59,53 @@ private:
  */
 typedef std::vector<SplittingInterval> TimeSplitterType;
 
+/**
+ * A TimeSplitterType held as three parallel columns (start and stop times in
+ * nanoseconds and the target index), sorted by start time.
+ *
+ * Once sorted, and provided the intervals do not overlap, the interval
+ * containing any time can be found in O(log n) and a time-ordered stream of
+ * events can be merge-walked against it, so this is the form used by the
+ * event splitting code when there are many (thousands of) intervals.
+ */
+class MANTID_KERNEL_DLL TimeSplitterColumns {
+public:
+  TimeSplitterColumns();
+  explicit TimeSplitterColumns(const TimeSplitterType &splitter);
+
+  void addInterval(const int64_t start, const int64_t stop, const int target);
+  void reserve(const size_t n);
+  void clear();
+  void sortByStart();
+
+  /// Number of intervals
+  size_t size() const { return m_starts.size(); }
+  /// True if there are no intervals
+  bool empty() const { return m_starts.empty(); }
+  /// Start times in nanoseconds
+  const std::vector<int64_t> &starts() const { return m_starts; }
+  /// Stop times in nanoseconds
+  const std::vector<int64_t> &stops() const { return m_stops; }
+  /// Target index of each interval
+  const std::vector<int> &targets() const { return m_targets; }
+  /// Replace the target of the i-th interval
+  void setTarget(const size_t i, const int target) { m_targets[i] = target; }
+
+  bool isSorted() const;
+  bool isDisjoint() const;
+  size_t findInterval(const int64_t time, const size_t hint = 0) const;
+  int targetAt(const int64_t time, const int outside = -1) const;
+  TimeSplitterType toTimeSplitter() const;
+
+private:
+  /// Start times in nanoseconds
+  std::vector<int64_t> m_starts;
+  /// Stop times in nanoseconds
+  std::vector<int64_t> m_stops;
+  /// Target index of each interval
+  std::vector<int> m_targets;
+};
+
 // -------------- Operators ---------------------
 MANTID_KERNEL_DLL TimeSplitterType
 operator+(const TimeSplitterType &a, const TimeSplitterType &b);
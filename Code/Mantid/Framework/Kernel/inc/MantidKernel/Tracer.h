@@ -0,0 +1,173 @@
+#ifndef MANTID_KERNEL_TRACER_H_
+#define MANTID_KERNEL_TRACER_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#include <Poco/Thread.h>
+#include <Poco/Timestamp.h>
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** TracerImpl : Records timed, nested spans of work and writes them out in
+    the Chrome trace event format, which chrome://tracing and Perfetto
+    (ui.perfetto.dev) can display.
+
+    Spans are recorded with a TraceScope, which measures the lifetime of the
+    object. Spans on the same thread nest by time, so an algorithm, the child
+    algorithms it runs and the thread pool tasks or file reads they do show up
+    as a hierarchy. The resident memory of the process is sampled at the start
+    and end of every algorithm and the peak is stored with the trace.
+
+    Tracing is off unless the 'tracing.filename' key is set, in which case the
+    trace is written to that file when the process exits. When it is off a
+    TraceScope only checks a flag.
+
+    Copyright &copy; 2015 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL TracerImpl {
+public:
+  /// True if spans are being recorded
+  bool isEnabled() const { return m_enabled; }
+  /// Start recording, to be written to the given file on exit
+  void enable(const std::string &filename = "");
+  /// Stop recording. Spans already recorded are kept.
+  void disable();
+  /// Forget all recorded spans
+  void clear();
+
+  /// Microseconds since the tracer was created
+  int64_t now() const;
+  /// Record a completed span
+  void addSpan(const std::string &name, const std::string &category,
+               int64_t start, int64_t duration);
+  /// Record the current resident memory of the process
+  void addMemorySample();
+
+  /// Number of recorded events
+  size_t size() const;
+  /// Largest resident memory sampled, in kiB
+  size_t peakMemory() const;
+  /// Write the trace in the Chrome trace event format
+  void save(const std::string &filename) const;
+
+private:
+  friend struct Mantid::Kernel::CreateUsingNew<TracerImpl>;
+
+  /// A span (phase 'X') or memory sample (phase 'C')
+  struct Event {
+    std::string name;
+    std::string category;
+    char phase;
+    int64_t start;
+    int64_t duration;
+    int thread;
+    size_t value;
+  };
+
+  /// Small, stable number for the calling thread
+  int threadNumber();
+
+  /// Private Constructor
+  TracerImpl();
+  /// Private copy constructor - NO COPY ALLOWED
+  TracerImpl(const TracerImpl &);
+  /// Private assignment operator - NO ASSIGNMENT ALLOWED
+  TracerImpl &operator=(const TracerImpl &);
+  /// Private Destructor. Writes the trace if a file was given.
+  ~TracerImpl();
+
+  /// Checked before anything is recorded
+  volatile bool m_enabled;
+  /// Where the trace is written on exit
+  std::string m_filename;
+  /// Time origin of the trace
+  Poco::Timestamp m_origin;
+  /// The recorded events
+  std::vector<Event> m_events;
+  /// Thread ids in the order they were first seen
+  std::map<Poco::Thread::TID, int> m_threads;
+  /// Largest memory sample, in kiB
+  size_t m_peakMemory;
+  /// Guards everything above
+  mutable Mutex m_mutex;
+};
+
+/// Forward declaration of a specialisation of SingletonHolder for TracerImpl
+/// (needed for dllexport/dllimport) and a typedef for it.
+#if defined(__APPLE__) && defined(__INTEL_COMPILER)
+inline
+#endif
+    template class MANTID_KERNEL_DLL Mantid::Kernel::SingletonHolder<TracerImpl>;
+typedef MANTID_KERNEL_DLL Mantid::Kernel::SingletonHolder<TracerImpl> Tracer;
+
+/** Records a span from its construction to its destruction if tracing is
+ * enabled, e.g.
+ *
+ *   Kernel::TraceScope trace("LoadBank " + name, "io");
+ */
+class MANTID_KERNEL_DLL TraceScope {
+public:
+  /**
+   * @param name :: What is being done
+   * @param category :: The kind of work, e.g. algorithm, task or io
+   * @param sampleMemory :: If true, record the resident memory at the start
+   * and end of the span
+   */
+  TraceScope(const std::string &name, const char *category,
+             bool sampleMemory = false)
+      : m_enabled(Tracer::Instance().isEnabled()), m_start(0),
+        m_category(category), m_sampleMemory(sampleMemory) {
+    if (m_enabled)
+      begin(name);
+  }
+  /// Records the span
+  ~TraceScope() {
+    if (m_enabled)
+      end();
+  }
+
+private:
+  TraceScope(const TraceScope &);
+  TraceScope &operator=(const TraceScope &);
+
+  void begin(const std::string &name);
+  void end();
+
+  const bool m_enabled;
+  std::string m_name;
+  int64_t m_start;
+  const char *m_category;
+  const bool m_sampleMemory;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_TRACER_H_ */
@@ -201,6 +201,16 @@ public:
    * reversible*/
   virtual std::pair<double, double> conversionRange() const;
 
+  /// Convert values from one initialized unit to another through TOF
+  static void convertViaTOF(const Unit &fromUnit, const Unit &toUnit,
+                            double *values, const size_t count,
+                            const size_t stride = sizeof(double));
+  /// Convert a vector from one initialized unit to another through TOF
+  static void convertViaTOF(const Unit &fromUnit, const Unit &toUnit,
+                            std::vector<double> &values);
+  /// True if convertViaTOF has a fused kernel for the pair of units
+  static bool hasFusedConversion(const Unit &fromUnit, const Unit &toUnit);
+
 protected:
   // Add a 'quick conversion' for a unit pair
   void addConversion(std::string to, const double &factor,
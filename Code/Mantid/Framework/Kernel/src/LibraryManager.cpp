@@ -9,8 +9,11 @@
 #include <Poco/Path.h>
 #include <Poco/File.h>
 #include <Poco/DirectoryIterator.h>
+#include <Poco/Exception.h>
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace Kernel {
 namespace {
@@ -67,8 +70,123 @@ int LibraryManagerImpl::OpenAllLibraries(const std::string &filePath,
   return libCount;
 }
 
-//-------------------------------------------------------------------------
-// Private members
+/** Opens a single library.
+*  @param filepath :: The full path to the library.
+*  @return True if the library was opened, false if it could not be or was
+*  already open.
+*/
+bool LibraryManagerImpl::OpenLibrary(const std::string &filepath) {
+  Poco::Path directory(filepath);
+  directory.makeParent();
+  DllOpen::addSearchDirectory(directory.toString());
+  return loadLibrary(filepath);
+}
+
+/** Lists the libraries in a directory, leaving out those excluded by
+*  'plugins.exclude'. Subdirectories are not searched.
+*  @param filePath :: The filepath to the directory where the libraries are.
+*  @return The full paths of the libraries, sorted.
+*/
+std::vector<std::string>
+LibraryManagerImpl::findLibraries(const std::string &filePath) {
+  std::vector<std::string> libraries;
+  try {
+    Poco::File libPath(filePath);
+    if (!libPath.exists() || !libPath.isDirectory())
+      return libraries;
+    Poco::DirectoryIterator end_itr;
+    for (Poco::DirectoryIterator itr(libPath); itr != end_itr; ++itr) {
+      const Poco::Path &item = itr.path();
+      if (itr->isDirectory() || skip(item.toString()) ||
+          DllOpen::ConvertToLibName(item.getFileName()).empty())
+        continue;
+      libraries.push_back(item.toString());
+    }
+  } catch (Poco::Exception &exc) {
+    g_log.error() << "In findLibraries: " << exc.displayText() << "\n";
+  }
+  std::sort(libraries.begin(), libraries.end());
+  return libraries;
+}
+
+/** Records the libraries of a manifest without opening them. They are opened
+*  when one of the items they provide is asked for. Libraries that provide no
+*  recorded items, such as one that only registers workspace types with a
+*  factory the manifest does not track, are opened straight away as nothing
+*  would ever ask for them.
+*  @param manifest :: What each library provides.
+*/
+void LibraryManagerImpl::deferLibraries(const PluginManifest &manifest) {
+  RecursiveMutex::ScopedLock lock(m_mutex);
+  m_deferred.merge(manifest);
+  // Nothing to defer for libraries that are open already
+  const std::vector<std::string> libraries = manifest.libraries();
+  for (auto lib = libraries.begin(); lib != libraries.end(); ++lib) {
+    const std::string libName = boost::algorithm::to_lower_copy(
+        DllOpen::ConvertToLibName(Poco::Path(*lib).getFileName()));
+    if (OpenLibs.find(libName) != OpenLibs.end())
+      m_deferred.removeLibrary(*lib);
+  }
+  const std::vector<std::string> eager = manifest.librariesWithoutEntries();
+  for (auto lib = eager.begin(); lib != eager.end(); ++lib) {
+    m_deferred.removeLibrary(*lib);
+    OpenLibrary(*lib);
+  }
+}
+
+/** Opens the deferred library that provides an item, if there is one.
+*  @param kind :: The kind of item, e.g. Algorithm.
+*  @param name :: The name of the item.
+*  @return True if a library was opened.
+*/
+bool LibraryManagerImpl::loadLibraryProviding(const std::string &kind,
+                                              const std::string &name) {
+  RecursiveMutex::ScopedLock lock(m_mutex);
+  if (m_deferred.empty())
+    return false;
+  const std::string library = m_deferred.libraryProviding(kind, name);
+  if (library.empty())
+    return false;
+  // Forget it first so that nothing the library does on loading sends us here
+  // again
+  m_deferred.removeLibrary(library);
+  g_log.debug() << "Opening " << library << " for " << kind << " " << name
+                << "\n";
+  return OpenLibrary(library);
+}
+
+/** Opens all deferred libraries that provide items of a kind.
+*  @param kind :: The kind of item, e.g. Algorithm.
+*  @param prefix :: Only consider items whose names start with this.
+*  @return The number of libraries opened.
+*/
+int LibraryManagerImpl::loadLibrariesProviding(const std::string &kind,
+                                               const std::string &prefix) {
+  RecursiveMutex::ScopedLock lock(m_mutex);
+  if (m_deferred.empty())
+    return 0;
+  const std::set<std::string> libraries =
+      m_deferred.librariesProviding(kind, prefix);
+  int libCount = 0;
+  for (auto lib = libraries.begin(); lib != libraries.end(); ++lib) {
+    m_deferred.removeLibrary(*lib);
+    if (OpenLibrary(*lib))
+      ++libCount;
+  }
+  return libCount;
+}
+
+/**
+*  @param kind :: The kind of item, e.g. Algorithm.
+*  @return The names of the items of that kind provided by libraries that have
+*  not been opened yet.
+*/
+std::vector<std::string>
+LibraryManagerImpl::deferredNames(const std::string &kind) const {
+  RecursiveMutex::ScopedLock lock(m_mutex);
+  return m_deferred.names(kind);
+}
+
 //-------------------------------------------------------------------------
 /**
  * Returns true if the name contains one of the strings given in the
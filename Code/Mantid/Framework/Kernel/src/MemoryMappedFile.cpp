@@ -0,0 +1,218 @@
+#include "MantidKernel/MemoryMappedFile.h"
+#include "MantidKernel/System.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else /* linux & mac */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Build the message of an exception about a file
+std::string fileError(const std::string &what, const std::string &filename) {
+  std::string msg("MemoryMappedFile: " + what + " " + filename);
+#ifndef _WIN32
+  msg += ": ";
+  msg += std::strerror(errno);
+#endif
+  return msg;
+}
+}
+
+//----------------------------------------------------------------------------------------------
+/** Constructor
+ */
+MemoryMappedFile::MemoryMappedFile()
+    : m_open(false), m_data(NULL), m_size(0)
+#ifdef _WIN32
+      ,
+      m_fileHandle(NULL), m_mappingHandle(NULL)
+#endif
+{
+}
+
+/** Constructor mapping a file
+ * @param filename :: full path of the file to map
+ */
+MemoryMappedFile::MemoryMappedFile(const std::string &filename)
+    : m_open(false), m_data(NULL), m_size(0)
+#ifdef _WIN32
+      ,
+      m_fileHandle(NULL), m_mappingHandle(NULL)
+#endif
+{
+  this->open(filename);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Destructor
+ */
+MemoryMappedFile::~MemoryMappedFile() { this->close(); }
+
+//----------------------------------------------------------------------------------------------
+/** Map the whole of a file read-only
+ * @param filename :: full path of the file to map
+ * @throw std::runtime_error if the file cannot be opened or mapped
+ */
+void MemoryMappedFile::open(const std::string &filename) {
+  this->close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    throw std::runtime_error(fileError("cannot open", filename));
+  LARGE_INTEGER filesize;
+  if (!GetFileSizeEx(file, &filesize)) {
+    CloseHandle(file);
+    throw std::runtime_error(fileError("cannot get the size of", filename));
+  }
+  m_size = static_cast<size_t>(filesize.QuadPart);
+  m_fileHandle = file;
+  m_open = true;
+  if (m_size == 0)
+    return;
+
+  HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) {
+    this->close();
+    throw std::runtime_error(fileError("cannot map", filename));
+  }
+  m_mappingHandle = mapping;
+  m_data =
+      static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_data == NULL) {
+    this->close();
+    throw std::runtime_error(fileError("cannot map", filename));
+  }
+#else
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error(fileError("cannot open", filename));
+  struct stat filestat;
+  if (fstat(fd, &filestat) != 0) {
+    ::close(fd);
+    throw std::runtime_error(fileError("cannot get the size of", filename));
+  }
+  m_size = static_cast<size_t>(filestat.st_size);
+  m_open = true;
+  if (m_size == 0) {
+    ::close(fd);
+    return;
+  }
+
+  void *addr = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    m_open = false;
+    m_size = 0;
+    throw std::runtime_error(fileError("cannot map", filename));
+  }
+  m_data = static_cast<const char *>(addr);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------
+/** Unmap the file. Does nothing if no file is mapped.
+ */
+void MemoryMappedFile::close() {
+#ifdef _WIN32
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mappingHandle)
+    CloseHandle(m_mappingHandle);
+  if (m_fileHandle)
+    CloseHandle(m_fileHandle);
+  m_mappingHandle = NULL;
+  m_fileHandle = NULL;
+#else
+  if (m_data)
+    munmap(const_cast<char *>(m_data), m_size);
+#endif
+  m_data = NULL;
+  m_size = 0;
+  m_open = false;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Hint to the operating system how the whole mapping will be read, so that
+ * it can tune read-ahead.
+ * @param pattern :: the expected access pattern
+ */
+void MemoryMappedFile::advise(const AccessPattern pattern) const {
+#ifdef _WIN32
+  UNUSED_ARG(pattern);
+#else
+  int advice = MADV_NORMAL;
+  if (pattern == Sequential)
+    advice = MADV_SEQUENTIAL;
+  else if (pattern == Random)
+    advice = MADV_RANDOM;
+  adviseRange(0, m_size, advice);
+#endif
+}
+
+/** Ask for a byte range to be read in ahead of its use.
+ * @param offset :: first byte of the range
+ * @param length :: number of bytes in the range
+ */
+void MemoryMappedFile::willNeed(const size_t offset,
+                                const size_t length) const {
+#ifdef _WIN32
+  UNUSED_ARG(offset);
+  UNUSED_ARG(length);
+#else
+  adviseRange(offset, length, MADV_WILLNEED);
+#endif
+}
+
+/** Tell the operating system a byte range has been processed. Its pages are
+ * dropped from memory and are read from the file again if ever accessed.
+ * @param offset :: first byte of the range
+ * @param length :: number of bytes in the range
+ */
+void MemoryMappedFile::release(const size_t offset, const size_t length) const {
+#ifdef _WIN32
+  UNUSED_ARG(offset);
+  UNUSED_ARG(length);
+#else
+  adviseRange(offset, length, MADV_DONTNEED);
+#endif
+}
+
+/** Apply an madvise flag to the whole pages overlapping a byte range. Hints
+ * are best effort so failures are ignored.
+ * @param offset :: first byte of the range
+ * @param length :: number of bytes in the range
+ * @param advice :: the madvise flag
+ */
+void MemoryMappedFile::adviseRange(const size_t offset, const size_t length,
+                                   const int advice) const {
+#ifdef _WIN32
+  UNUSED_ARG(offset);
+  UNUSED_ARG(length);
+  UNUSED_ARG(advice);
+#else
+  if (!m_data || offset >= m_size || length == 0)
+    return;
+  const size_t end = (length > m_size - offset) ? m_size : offset + length;
+  // madvise needs a page aligned start
+  const size_t pagesize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t start = offset - offset % pagesize;
+  madvise(const_cast<char *>(m_data) + start, end - start, advice);
+#endif
+}
+
+} // namespace Kernel
+} // namespace Mantid
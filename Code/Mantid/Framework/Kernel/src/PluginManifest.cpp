@@ -0,0 +1,264 @@
+#include "MantidKernel/PluginManifest.h"
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Process.h>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// First line of every manifest file. Change it if the format changes.
+const char *MANIFEST_HEADER = "# Mantid plugin manifest v2";
+/// Line tags
+const char *LIBRARY_TAG = "library";
+const char *ENTRY_TAG = "entry";
+
+/// Split a line at tabs
+std::vector<std::string> splitFields(const std::string &line) {
+  std::vector<std::string> fields;
+  std::string::size_type start = 0;
+  while (true) {
+    const std::string::size_type end = line.find('\t', start);
+    fields.push_back(line.substr(start, end - start));
+    if (end == std::string::npos)
+      break;
+    start = end + 1;
+  }
+  return fields;
+}
+}
+
+//----------------------------------------------------------------------------------------------
+/** Read a manifest written by save()
+ * @param filename :: The path to the manifest file
+ * @return The manifest
+ * @throw std::runtime_error if the file cannot be read or is not a manifest
+ */
+PluginManifest PluginManifest::load(const std::string &filename) {
+  std::ifstream file(filename.c_str());
+  if (!file)
+    throw std::runtime_error("Cannot open plugin manifest " + filename);
+
+  std::string line;
+  if (!std::getline(file, line) || line != MANIFEST_HEADER)
+    throw std::runtime_error(filename + " is not a plugin manifest");
+
+  PluginManifest manifest;
+  std::string currentLibrary;
+  while (std::getline(file, line)) {
+    if (line.empty())
+      continue;
+    const std::vector<std::string> fields = splitFields(line);
+    if (fields.size() == 3 && fields[0] == LIBRARY_TAG) {
+      currentLibrary = fields[1];
+      manifest.addLibrary(currentLibrary, fields[2]);
+    } else if (fields.size() == 3 && fields[0] == ENTRY_TAG &&
+               !currentLibrary.empty()) {
+      manifest.addEntry(currentLibrary, fields[1], fields[2]);
+    } else {
+      throw std::runtime_error("Malformed line in plugin manifest " +
+                               filename + ": " + line);
+    }
+  }
+  return manifest;
+}
+
+/** A library is identified by its size and modification time, which is cheap
+ * to check and changes whenever it is rebuilt or replaced.
+ * @param libraryPath :: The path to the library
+ * @return The stamp, or an empty string if the file does not exist
+ */
+std::string PluginManifest::stamp(const std::string &libraryPath) {
+  try {
+    Poco::File file(libraryPath);
+    std::ostringstream os;
+    os << file.getSize() << ":" << file.getLastModified().epochMicroseconds();
+    return os.str();
+  } catch (Poco::Exception &) {
+    return "";
+  }
+}
+
+/**
+ * @param libraryPath :: The path to the library
+ */
+void PluginManifest::addLibrary(const std::string &libraryPath) {
+  addLibrary(libraryPath, stamp(libraryPath));
+}
+
+/**
+ * @param libraryPath :: The path to the library
+ * @param stamp :: The stamp of the library, see stamp()
+ */
+void PluginManifest::addLibrary(const std::string &libraryPath,
+                                const std::string &stamp) {
+  m_libraries[libraryPath] = stamp;
+}
+
+/** If another library already provides the item it keeps it, as the first
+ * library to register a name is the one the factories end up with.
+ * @param libraryPath :: The path to a library already in the manifest
+ * @param kind :: The kind of item, e.g. Algorithm
+ * @param name :: The name of the item
+ * @throw std::invalid_argument if the library has not been added
+ */
+void PluginManifest::addEntry(const std::string &libraryPath,
+                              const std::string &kind,
+                              const std::string &name) {
+  if (m_libraries.find(libraryPath) == m_libraries.end())
+    throw std::invalid_argument("PluginManifest::addEntry - unknown library " +
+                                libraryPath);
+  m_providers.insert(std::make_pair(Entry(kind, name), libraryPath));
+}
+
+/** Libraries and entries already present are kept.
+ * @param other :: The manifest to add
+ */
+void PluginManifest::merge(const PluginManifest &other) {
+  m_libraries.insert(other.m_libraries.begin(), other.m_libraries.end());
+  m_providers.insert(other.m_providers.begin(), other.m_providers.end());
+}
+
+/**
+ * @param libraryPath :: The path to the library
+ */
+void PluginManifest::removeLibrary(const std::string &libraryPath) {
+  m_libraries.erase(libraryPath);
+  for (auto it = m_providers.begin(); it != m_providers.end();) {
+    if (it->second == libraryPath)
+      m_providers.erase(it++);
+    else
+      ++it;
+  }
+}
+
+/**
+ * @return The paths of all libraries in the manifest, sorted
+ */
+std::vector<std::string> PluginManifest::libraries() const {
+  std::vector<std::string> paths;
+  paths.reserve(m_libraries.size());
+  for (auto it = m_libraries.begin(); it != m_libraries.end(); ++it)
+    paths.push_back(it->first);
+  return paths;
+}
+
+/**
+ * @return The paths of the libraries that provide no items, sorted
+ */
+std::vector<std::string> PluginManifest::librariesWithoutEntries() const {
+  std::set<std::string> providers;
+  for (auto it = m_providers.begin(); it != m_providers.end(); ++it)
+    providers.insert(it->second);
+  std::vector<std::string> paths;
+  for (auto it = m_libraries.begin(); it != m_libraries.end(); ++it) {
+    if (providers.find(it->first) == providers.end())
+      paths.push_back(it->first);
+  }
+  return paths;
+}
+
+/**
+ * @param kind :: The kind of item, e.g. Algorithm
+ * @param name :: The name of the item
+ * @return The library path, or an empty string if nothing provides the item
+ */
+std::string PluginManifest::libraryProviding(const std::string &kind,
+                                             const std::string &name) const {
+  auto it = m_providers.find(Entry(kind, name));
+  if (it == m_providers.end())
+    return "";
+  return it->second;
+}
+
+/**
+ * @param kind :: The kind of item, e.g. Algorithm
+ * @param prefix :: Only items whose names start with this are considered
+ * @return The paths of the libraries providing matching items
+ */
+std::set<std::string>
+PluginManifest::librariesProviding(const std::string &kind,
+                                   const std::string &prefix) const {
+  std::set<std::string> paths;
+  for (auto it = m_providers.lower_bound(Entry(kind, prefix));
+       it != m_providers.end() && it->first.first == kind &&
+           it->first.second.compare(0, prefix.size(), prefix) == 0;
+       ++it) {
+    paths.insert(it->second);
+  }
+  return paths;
+}
+
+/**
+ * @param kind :: The kind of item, e.g. Algorithm
+ * @return The names of all items of that kind, sorted
+ */
+std::vector<std::string>
+PluginManifest::names(const std::string &kind) const {
+  std::vector<std::string> result;
+  for (auto it = m_providers.lower_bound(Entry(kind, ""));
+       it != m_providers.end() && it->first.first == kind; ++it) {
+    result.push_back(it->first.second);
+  }
+  return result;
+}
+
+/**
+ * @param libraryPaths :: The libraries currently available
+ * @return True if the manifest holds exactly these libraries and none of them
+ * has changed since it was added
+ */
+bool PluginManifest::isUpToDate(
+    const std::vector<std::string> &libraryPaths) const {
+  if (libraryPaths.size() != m_libraries.size())
+    return false;
+  for (auto it = libraryPaths.begin(); it != libraryPaths.end(); ++it) {
+    auto lib = m_libraries.find(*it);
+    if (lib == m_libraries.end() || lib->second.empty() ||
+        lib->second != stamp(*it))
+      return false;
+  }
+  return true;
+}
+
+/** The file is written under a temporary name and then renamed so that other
+ * processes starting at the same time never read a partial manifest.
+ * @param filename :: The path of the file to write
+ * @throw std::runtime_error if the file cannot be written
+ */
+void PluginManifest::save(const std::string &filename) const {
+  const std::string tmpName =
+      filename + "." + boost::lexical_cast<std::string>(Poco::Process::id());
+  {
+    std::ofstream file(tmpName.c_str());
+    if (!file)
+      throw std::runtime_error("Cannot write plugin manifest " + tmpName);
+    file << MANIFEST_HEADER << "\n";
+    for (auto lib = m_libraries.begin(); lib != m_libraries.end(); ++lib) {
+      file << LIBRARY_TAG << "\t" << lib->first << "\t" << lib->second << "\n";
+      for (auto it = m_providers.begin(); it != m_providers.end(); ++it) {
+        if (it->second == lib->first)
+          file << ENTRY_TAG << "\t" << it->first.first << "\t"
+               << it->first.second << "\n";
+      }
+    }
+    if (!file)
+      throw std::runtime_error("Error writing plugin manifest " + tmpName);
+  }
+  try {
+    Poco::File(tmpName).renameTo(filename);
+  } catch (Poco::Exception &exc) {
+    Poco::File(tmpName).remove();
+    throw std::runtime_error("Cannot write plugin manifest " + filename +
+                             ": " + exc.displayText());
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
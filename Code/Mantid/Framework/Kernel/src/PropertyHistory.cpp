@@ -2,6 +2,8 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidKernel/PropertyHistory.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Property.h"
 
 #include <iostream>
@@ -9,6 +11,11 @@
 
 namespace Mantid {
 namespace Kernel {
+namespace {
+/// Serialises the conversion of lazy values, which may be asked for from
+/// several threads at once
+Mutex g_lazyValueMutex;
+}
 
 /// Constructor
 PropertyHistory::PropertyHistory(const std::string &name,
@@ -25,6 +32,22 @@ PropertyHistory::PropertyHistory(Property const *const prop)
       m_value(prop->value()), m_type(prop->type()),
       m_isDefault(prop->isDefault()), m_direction(prop->direction()) {}
 
+/**
+ * Constructor for a value that is only converted to a string when value() is
+ * first called
+ * @param name :: The name of the property
+ * @param value :: The value of the property in its native form
+ * @param type :: The type of the property
+ * @param isdefault :: True if the property has its default value
+ * @param direction :: The direction of the property
+ */
+PropertyHistory::PropertyHistory(const std::string &name,
+                                 const LazyPropertyValue_const_sptr &value,
+                                 const std::string &type, const bool isdefault,
+                                 const unsigned int direction)
+    : m_name(name), m_value(), m_lazyValue(value), m_type(type),
+      m_isDefault(isdefault), m_direction(direction) {}
+
 /// Destructor
 PropertyHistory::~PropertyHistory() {}
 
@@ -33,8 +56,11 @@ PropertyHistory::~PropertyHistory() {}
  * @param A :: PropertyHistory Item to copy
  */
 PropertyHistory::PropertyHistory(const PropertyHistory &A)
-    : m_name(A.m_name), m_value(A.m_value), m_type(A.m_type),
-      m_isDefault(A.m_isDefault), m_direction(A.m_direction) {}
+    : m_name(A.m_name), m_value(), m_lazyValue(A.m_lazyValue),
+      m_type(A.m_type), m_isDefault(A.m_isDefault),
+      m_direction(A.m_direction) {
+  copyValue(A);
+}
 
 /**
  * Standard Assignment operator
@@ -44,7 +70,8 @@ PropertyHistory::PropertyHistory(const PropertyHistory &A)
 PropertyHistory &PropertyHistory::operator=(const PropertyHistory &A) {
   if (this != &A) {
     m_name = A.m_name;
-    m_value = A.m_value;
+    m_lazyValue = A.m_lazyValue;
+    copyValue(A);
     m_type = A.m_type;
     m_isDefault = A.m_isDefault;
     m_direction = A.m_direction;
@@ -52,6 +79,91 @@ PropertyHistory &PropertyHistory::operator=(const PropertyHistory &A) {
   return *this;
 }
 
+/**
+ * The value is converted from its native form the first time this is called,
+ * if it was given as a LazyPropertyValue.
+ * @returns The value of the property as a string
+ */
+const std::string &PropertyHistory::value() const {
+  if (m_lazyValue) {
+    // m_value may be being filled by another thread so it is only looked at
+    // under the lock
+    Mutex::ScopedLock lock(g_lazyValueMutex);
+    if (m_value.empty())
+      m_value = m_lazyValue->toString();
+  }
+  return m_value;
+}
+
+/**
+ * Two histories are equal if they have the same name, value, type and default
+ * flag. Values that have not been converted to strings are compared element by
+ * element.
+ * @param other :: The history to compare with
+ * @returns True if the histories are equal
+ */
+bool PropertyHistory::operator==(const PropertyHistory &other) const {
+  if (name() != other.name() || type() != other.type() ||
+      isDefault() != other.isDefault())
+    return false;
+  if (m_lazyValue && other.m_lazyValue)
+    return m_lazyValue == other.m_lazyValue ||
+           m_lazyValue->equals(*other.m_lazyValue);
+  return value() == other.value();
+}
+
+/**
+ * Copies the string value of another history without converting a lazy value
+ * that has not been converted yet
+ * @param other :: The history to copy from
+ */
+void PropertyHistory::copyValue(const PropertyHistory &other) {
+  if (other.m_lazyValue) {
+    Mutex::ScopedLock lock(g_lazyValueMutex);
+    m_value = other.m_value;
+  } else {
+    m_value = other.m_value;
+  }
+}
+
+/**
+ * Arrays with more elements than 'algorithms.history.arraythreshold' are
+ * recorded according to 'algorithms.history.arraymode':
+ *   - lazy (the default): the elements are kept and only converted to a string
+ *     when the value is asked for
+ *   - hash: only the number of elements and a hash are kept
+ *   - string: the value is converted to a string straight away
+ * @param numElements :: The number of elements in the array
+ * @returns How the array should be recorded
+ */
+PropertyHistory::LargeArrayMode
+PropertyHistory::largeArrayMode(const size_t numElements) {
+  ConfigServiceImpl &config = ConfigService::Instance();
+  int threshold(1000);
+  config.getValue("algorithms.history.arraythreshold", threshold);
+  if (threshold < 0 || numElements <= static_cast<size_t>(threshold))
+    return StoreString;
+
+  const std::string mode = config.getString("algorithms.history.arraymode");
+  if (mode == "string")
+    return StoreString;
+  else if (mode == "hash")
+    return StoreHash;
+  return StoreLazy;
+}
+
+/**
+ * @param numElements :: The number of elements in the array
+ * @param hash :: A hash of the elements
+ * @returns The text recorded in place of the value of the array
+ */
+std::string PropertyHistory::hashSummary(const size_t numElements,
+                                         const size_t hash) {
+  std::ostringstream os;
+  os << "[" << numElements << " values, hash " << std::hex << hash << "]";
+  return os.str();
+}
+
 /** Prints a text representation of itself
  *  @param os :: The ouput stream to write to
  *  @param indent :: an indentation value to make pretty printing of object and
@@ -59,7 +171,7 @@ PropertyHistory &PropertyHistory::operator=(const PropertyHistory &A) {
  */
 void PropertyHistory::printSelf(std::ostream &os, const int indent) const {
   os << std::string(indent, ' ') << "Name: " << m_name;
-  os << ", Value: " << m_value;
+  os << ", Value: " << value();
   os << ", Default?: " << (m_isDefault ? "Yes" : "No");
   os << ", Direction: " << Kernel::Direction::asText(m_direction) << std::endl;
 }
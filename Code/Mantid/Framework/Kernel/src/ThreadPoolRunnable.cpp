@@ -1,8 +1,13 @@
 #include "MantidKernel/ThreadPoolRunnable.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/Tracer.h"
 
 namespace Mantid {
 namespace Kernel {
+namespace {
+/// Name of the trace span of a task
+const std::string TASK_SPAN_NAME("ThreadPool task");
+}
 
 //-----------------------------------------------------------------------------------
 /** Constructor
@@ -60,6 +65,7 @@ void ThreadPoolRunnable::run() {
 
       try {
         // Run the task (synchronously within this thread)
+        TraceScope trace(TASK_SPAN_NAME, "task");
         task->run();
       } catch (std::exception &e) {
         // The task threw an exception!
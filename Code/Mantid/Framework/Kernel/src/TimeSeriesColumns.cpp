@@ -0,0 +1,559 @@
+#include "MantidKernel/TimeSeriesColumns.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Number of entries summarised by one leaf of the min/max trees
+const size_t BLOCK_SIZE = 64;
+/// Conversion from nanoseconds to seconds
+const double SECONDS_PER_NANOSECOND = 1.e-9;
+
+/// Orders a permutation by the time column it indexes
+struct TimeIndexLess {
+  explicit TimeIndexLess(const std::vector<int64_t> &times) : m_times(times) {}
+  bool operator()(const size_t lhs, const size_t rhs) const {
+    return m_times[lhs] < m_times[rhs];
+  }
+  const std::vector<int64_t> &m_times;
+};
+
+/**
+ * Build a segment tree over blocks of the value column.
+ * @param values :: The value column
+ * @param leaves :: The number of leaves (a power of two)
+ * @param better :: Returns true if its first argument should be preferred
+ * @param tree :: Output tree, 2*leaves long. Node i has children 2i, 2i+1.
+ */
+template <typename TYPE, typename Compare>
+void buildTree(const std::vector<TYPE> &values, const size_t leaves,
+               Compare better, std::vector<TYPE> &tree) {
+  tree.assign(2 * leaves, values.back());
+  const size_t nvalues = values.size();
+  for (size_t i = 0; i < nvalues; ++i) {
+    TYPE &leaf = tree[leaves + i / BLOCK_SIZE];
+    if (i % BLOCK_SIZE == 0 || better(values[i], leaf))
+      leaf = values[i];
+  }
+  for (size_t node = leaves - 1; node > 0; --node) {
+    const TYPE &left = tree[2 * node];
+    const TYPE &right = tree[2 * node + 1];
+    tree[node] = better(right, left) ? right : left;
+  }
+}
+
+/**
+ * Find the preferred value of the entries [first, last] using the block tree.
+ * The partial blocks at either end are scanned, the whole blocks in between
+ * come from the tree in O(log n).
+ */
+template <typename TYPE, typename Compare>
+TYPE queryTree(const std::vector<TYPE> &values, const std::vector<TYPE> &tree,
+               const size_t leaves, const size_t first, const size_t last,
+               Compare better) {
+  TYPE result = values[first];
+  const size_t firstBlock = first / BLOCK_SIZE;
+  const size_t lastBlock = last / BLOCK_SIZE;
+  if (lastBlock - firstBlock < 2) {
+    for (size_t i = first + 1; i <= last; ++i)
+      if (better(values[i], result))
+        result = values[i];
+    return result;
+  }
+
+  // Partial blocks at the ends
+  const size_t firstEnd = (firstBlock + 1) * BLOCK_SIZE;
+  for (size_t i = first + 1; i < firstEnd; ++i)
+    if (better(values[i], result))
+      result = values[i];
+  for (size_t i = lastBlock * BLOCK_SIZE; i <= last; ++i)
+    if (better(values[i], result))
+      result = values[i];
+
+  // Whole blocks in between
+  size_t lo = firstBlock + 1 + leaves;
+  size_t hi = lastBlock + leaves;
+  while (lo < hi) {
+    if (lo & 1) {
+      if (better(tree[lo], result))
+        result = tree[lo];
+      ++lo;
+    }
+    if (hi & 1) {
+      --hi;
+      if (better(tree[hi], result))
+        result = tree[hi];
+    }
+    lo >>= 1;
+    hi >>= 1;
+  }
+  return result;
+}
+}
+
+/// Default constructor: an empty series
+template <typename TYPE>
+TimeSeriesColumns<TYPE>::TimeSeriesColumns()
+    : m_times(), m_values(), m_indexValid(false), m_cumulative(),
+      m_leaves(0), m_minTree(), m_maxTree() {}
+
+/**
+ * Construct from an existing time series property. Any filter on the
+ * property is ignored; all entries are copied.
+ * @param property :: The log to copy
+ * @param compress :: If true drop the interior samples of constant runs
+ */
+template <typename TYPE>
+TimeSeriesColumns<TYPE>::TimeSeriesColumns(
+    const TimeSeriesProperty<TYPE> &property, const bool compress)
+    : m_times(), m_values(), m_indexValid(false), m_cumulative(), m_leaves(0),
+      m_minTree(), m_maxTree() {
+  // Fill both columns in one pass over the entries rather than through
+  // timesAsVector() and valuesAsVector(), which copy the log twice more
+  property.sort();
+  const std::vector<TimeValueUnit<TYPE>> &entries = property.m_values;
+  m_times.reserve(entries.size());
+  m_values.reserve(entries.size());
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    m_times.push_back(it->time().totalNanoseconds());
+    m_values.push_back(it->value());
+  }
+  if (compress)
+    this->compress();
+}
+
+/**
+ * Construct from columns. The columns are sorted by time if necessary.
+ * @param times :: Entry times in nanoseconds since the DateAndTime epoch
+ * @param values :: Entry values, the same length as times
+ * @param compress :: If true drop the interior samples of constant runs
+ * @throws std::invalid_argument if the columns have different lengths
+ */
+template <typename TYPE>
+TimeSeriesColumns<TYPE>::TimeSeriesColumns(const std::vector<int64_t> &times,
+                                           const std::vector<TYPE> &values,
+                                           const bool compress)
+    : m_times(times), m_values(values), m_indexValid(false), m_cumulative(),
+      m_leaves(0), m_minTree(), m_maxTree() {
+  if (m_times.size() != m_values.size())
+    throw std::invalid_argument(
+        "TimeSeriesColumns: times and values must have the same length.");
+  sortByTime();
+  if (compress)
+    this->compress();
+}
+
+/**
+ * Append an entry at the end of the series.
+ * @param time :: Time in nanoseconds since the DateAndTime epoch
+ * @param value :: The value
+ * @throws std::invalid_argument if time is earlier than the last entry
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::append(const int64_t time, const TYPE value) {
+  if (!m_times.empty() && time < m_times.back())
+    throw std::invalid_argument("TimeSeriesColumns::append: entries must be "
+                                "appended in time order.");
+  m_times.push_back(time);
+  m_values.push_back(value);
+  m_indexValid = false;
+}
+
+/**
+ * Append an entry at the end of the series.
+ * @param time :: The time of the entry
+ * @param value :: The value
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::append(const DateAndTime &time,
+                                     const TYPE value) {
+  append(time.totalNanoseconds(), value);
+}
+
+/// @param n :: Number of entries to reserve memory for
+template <typename TYPE> void TimeSeriesColumns<TYPE>::reserve(const size_t n) {
+  m_times.reserve(n);
+  m_values.reserve(n);
+}
+
+/// Remove all entries and indices
+template <typename TYPE> void TimeSeriesColumns<TYPE>::clear() {
+  m_times.clear();
+  m_values.clear();
+  m_cumulative.clear();
+  m_minTree.clear();
+  m_maxTree.clear();
+  m_leaves = 0;
+  m_indexValid = false;
+}
+
+/**
+ * Run-length compress the columns. Of every run of consecutive identical
+ * values only the first and the last sample are kept, so the start of each
+ * step, the last time it was seen and the end of the log are all preserved.
+ */
+template <typename TYPE> void TimeSeriesColumns<TYPE>::compress() {
+  const size_t nvalues = m_values.size();
+  if (nvalues < 3)
+    return;
+
+  size_t kept = 1;
+  for (size_t i = 1; i < nvalues; ++i) {
+    const bool sameAsPrevious = !(m_values[i] < m_values[i - 1]) &&
+                                !(m_values[i - 1] < m_values[i]);
+    const bool sameAsNext = (i + 1 < nvalues) &&
+                            !(m_values[i] < m_values[i + 1]) &&
+                            !(m_values[i + 1] < m_values[i]);
+    if (sameAsPrevious && sameAsNext)
+      continue;
+    m_times[kept] = m_times[i];
+    m_values[kept] = m_values[i];
+    ++kept;
+  }
+  m_times.resize(kept);
+  m_values.resize(kept);
+  std::vector<int64_t>(m_times).swap(m_times);
+  std::vector<TYPE>(m_values).swap(m_values);
+  m_indexValid = false;
+}
+
+/**
+ * Build the time-weighted integral and the min/max block trees. Called
+ * implicitly by the queries that need them.
+ */
+template <typename TYPE> void TimeSeriesColumns<TYPE>::buildIndex() const {
+  if (m_indexValid)
+    return;
+  const size_t nvalues = m_values.size();
+  if (nvalues == 0) {
+    m_cumulative.clear();
+    m_minTree.clear();
+    m_maxTree.clear();
+    m_leaves = 0;
+    m_indexValid = true;
+    return;
+  }
+
+  m_cumulative.resize(nvalues);
+  m_cumulative[0] = 0.0;
+  for (size_t i = 1; i < nvalues; ++i) {
+    m_cumulative[i] =
+        m_cumulative[i - 1] + static_cast<double>(m_times[i] - m_times[i - 1]) *
+                                  SECONDS_PER_NANOSECOND *
+                                  static_cast<double>(m_values[i - 1]);
+  }
+
+  const size_t nblocks = (nvalues + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  m_leaves = 1;
+  while (m_leaves < nblocks)
+    m_leaves <<= 1;
+  buildTree(m_values, m_leaves, std::less<TYPE>(), m_minTree);
+  buildTree(m_values, m_leaves, std::greater<TYPE>(), m_maxTree);
+  m_indexValid = true;
+}
+
+/**
+ * @return The memory used by the columns and indices, in bytes
+ */
+template <typename TYPE>
+size_t TimeSeriesColumns<TYPE>::getMemorySize() const {
+  return m_times.capacity() * sizeof(int64_t) +
+         m_values.capacity() * sizeof(TYPE) +
+         m_cumulative.capacity() * sizeof(double) +
+         (m_minTree.capacity() + m_maxTree.capacity()) * sizeof(TYPE);
+}
+
+/**
+ * @param time :: Time in nanoseconds since the DateAndTime epoch
+ * @return The index of the last entry at or before time, or 0 if time is
+ * before the first entry
+ */
+template <typename TYPE>
+size_t TimeSeriesColumns<TYPE>::indexAt(const int64_t time) const {
+  throwIfEmpty("indexAt");
+  const size_t upper = static_cast<size_t>(
+      std::upper_bound(m_times.begin(), m_times.end(), time) - m_times.begin());
+  return (upper == 0) ? 0 : upper - 1;
+}
+
+/**
+ * @param time :: A time
+ * @return The value in effect at the given time
+ */
+template <typename TYPE>
+TYPE TimeSeriesColumns<TYPE>::valueAt(const DateAndTime &time) const {
+  return m_values[indexAt(time.totalNanoseconds())];
+}
+
+/**
+ * Integral of the step function defined by the log between two times. The
+ * first value is assumed to extend back before the first entry and the last
+ * to extend forever.
+ * @param start :: The start of the range
+ * @param stop :: The end of the range
+ * @return The integral in units of value * seconds
+ */
+template <typename TYPE>
+double TimeSeriesColumns<TYPE>::integral(const DateAndTime &start,
+                                         const DateAndTime &stop) const {
+  throwIfEmpty("integral");
+  buildIndex();
+  return integralTo(stop.totalNanoseconds()) -
+         integralTo(start.totalNanoseconds());
+}
+
+/**
+ * @param start :: The start of the range
+ * @param stop :: The end of the range
+ * @return The time-weighted average in the range, or the value at start if
+ * the range is empty
+ */
+template <typename TYPE>
+double TimeSeriesColumns<TYPE>::timeAverage(const DateAndTime &start,
+                                            const DateAndTime &stop) const {
+  const double duration = DateAndTime::secondsFromDuration(stop - start);
+  if (duration <= 0.0)
+    return static_cast<double>(valueAt(start));
+  return integral(start, stop) / duration;
+}
+
+/**
+ * Equivalent of TimeSeriesProperty::averageValueInFilter, costing O(log n)
+ * per filter interval instead of a walk through the entries.
+ * @param filter :: The intervals to average over
+ * @return The time-weighted average, NaN if the log or filter is empty
+ */
+template <typename TYPE>
+double TimeSeriesColumns<TYPE>::averageValueInFilter(
+    const TimeSplitterType &filter) const {
+  if (m_values.empty() || filter.empty())
+    return std::numeric_limits<double>::quiet_NaN();
+  if (m_values.size() == 1)
+    return static_cast<double>(m_values.front());
+
+  buildIndex();
+  double numerator(0.0), totalTime(0.0);
+  for (auto it = filter.begin(); it != filter.end(); ++it) {
+    totalTime += it->duration();
+    numerator += integralTo(it->stop().totalNanoseconds()) -
+                 integralTo(it->start().totalNanoseconds());
+  }
+  return numerator / totalTime;
+}
+
+/**
+ * @param first :: Index of the first entry
+ * @param last :: Index of the last entry, inclusive
+ * @return The minimum value in the index range
+ */
+template <typename TYPE>
+TYPE TimeSeriesColumns<TYPE>::minInIndexRange(const size_t first,
+                                              const size_t last) const {
+  throwIfEmpty("minInIndexRange");
+  if (first > last || last >= m_values.size())
+    throw std::out_of_range("TimeSeriesColumns::minInIndexRange: invalid "
+                            "index range.");
+  buildIndex();
+  return queryTree(m_values, m_minTree, m_leaves, first, last,
+                   std::less<TYPE>());
+}
+
+/**
+ * @param first :: Index of the first entry
+ * @param last :: Index of the last entry, inclusive
+ * @return The maximum value in the index range
+ */
+template <typename TYPE>
+TYPE TimeSeriesColumns<TYPE>::maxInIndexRange(const size_t first,
+                                              const size_t last) const {
+  throwIfEmpty("maxInIndexRange");
+  if (first > last || last >= m_values.size())
+    throw std::out_of_range("TimeSeriesColumns::maxInIndexRange: invalid "
+                            "index range.");
+  buildIndex();
+  return queryTree(m_values, m_maxTree, m_leaves, first, last,
+                   std::greater<TYPE>());
+}
+
+/**
+ * @param start :: The start of the range
+ * @param stop :: The end of the range
+ * @return The minimum of the values in effect during [start, stop)
+ */
+template <typename TYPE>
+TYPE TimeSeriesColumns<TYPE>::minInTimeRange(const DateAndTime &start,
+                                             const DateAndTime &stop) const {
+  size_t first(0), last(0);
+  indexRange(start, stop, first, last);
+  return minInIndexRange(first, last);
+}
+
+/**
+ * @param start :: The start of the range
+ * @param stop :: The end of the range
+ * @return The maximum of the values in effect during [start, stop)
+ */
+template <typename TYPE>
+TYPE TimeSeriesColumns<TYPE>::maxInTimeRange(const DateAndTime &start,
+                                             const DateAndTime &stop) const {
+  size_t first(0), last(0);
+  indexRange(start, stop, first, last);
+  return maxInIndexRange(first, last);
+}
+
+/**
+ * Fill a TimeSplitterType with the intervals where the log is within
+ * [min, max]. Produces the same splitter as
+ * TimeSeriesProperty::makeFilterByValue, with a single pass over contiguous
+ * columns. Compressing the columns does not change the result.
+ * @param split :: Splitter that will be filled.
+ * @param min :: min value; EMPTY_DBL() means the minimum of the log
+ * @param max :: max value; EMPTY_DBL() means the maximum of the log
+ * @param timeTolerance :: offset added to times in seconds (default: 0)
+ * @param centre :: Whether the log value time is considered centred or at the
+ * beginning (the default).
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::makeFilterByValue(TimeSplitterType &split,
+                                                double min, double max,
+                                                double timeTolerance,
+                                                bool centre) const {
+  const bool emptyMin = (min == EMPTY_DBL());
+  const bool emptyMax = (max == EMPTY_DBL());
+  if (!emptyMin && !emptyMax && max < min) {
+    std::stringstream ss;
+    ss << "TimeSeriesColumns::makeFilterByValue: 'max' argument must be "
+          "greater than 'min' "
+       << "(got min=" << min << " max=" << max << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  split.clear();
+  const size_t nvalues = m_values.size();
+  if (nvalues == 0)
+    return;
+
+  if (emptyMin)
+    min = static_cast<double>(minInIndexRange(0, nvalues - 1));
+  if (emptyMax)
+    max = static_cast<double>(maxInIndexRange(0, nvalues - 1));
+
+  const int64_t tol = DateAndTime::nanosecondsFromSeconds(timeTolerance);
+  bool lastGood(false);
+  bool anyGood(false);
+  int64_t t(0), start(0);
+  for (size_t i = 0; i < nvalues; ++i) {
+    const int64_t lastTime = t;
+    t = m_times[i];
+    const double val = static_cast<double>(m_values[i]);
+    const bool isGood = (val >= min) && (val <= max);
+    if (isGood)
+      anyGood = true;
+    if (isGood == lastGood)
+      continue;
+
+    if (isGood) {
+      start = centre ? t - tol : t;
+    } else {
+      const int64_t stop = centre ? lastTime + tol : t;
+      split.push_back(SplittingInterval(start, stop, 0));
+      anyGood = false;
+    }
+    lastGood = isGood;
+  }
+
+  if (anyGood)
+    split.push_back(SplittingInterval(start, t + tol, 0));
+}
+
+/// Sort both columns by time, keeping equal times in their original order
+template <typename TYPE> void TimeSeriesColumns<TYPE>::sortByTime() {
+  if (std::is_sorted(m_times.begin(), m_times.end()))
+    return;
+
+  const size_t nvalues = m_times.size();
+  std::vector<size_t> order(nvalues);
+  for (size_t i = 0; i < nvalues; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), TimeIndexLess(m_times));
+
+  std::vector<int64_t> times(nvalues);
+  std::vector<TYPE> values(nvalues);
+  for (size_t i = 0; i < nvalues; ++i) {
+    times[i] = m_times[order[i]];
+    values[i] = m_values[order[i]];
+  }
+  m_times.swap(times);
+  m_values.swap(values);
+  m_indexValid = false;
+}
+
+/**
+ * @param start :: The start of the range
+ * @param stop :: The end of the range
+ * @param first :: Set to the entry in effect at start
+ * @param last :: Set to the last entry starting before stop (at least first)
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::indexRange(const DateAndTime &start,
+                                         const DateAndTime &stop, size_t &first,
+                                         size_t &last) const {
+  first = indexAt(start.totalNanoseconds());
+  const size_t lower = static_cast<size_t>(
+      std::lower_bound(m_times.begin(), m_times.end(),
+                       stop.totalNanoseconds()) -
+      m_times.begin());
+  last = (lower == 0) ? first : std::max(first, lower - 1);
+}
+
+/**
+ * @param time :: Time in nanoseconds
+ * @return The integral of the log from the first entry to time. Negative if
+ * time is before the first entry.
+ */
+template <typename TYPE>
+double TimeSeriesColumns<TYPE>::integralTo(const int64_t time) const {
+  if (time <= m_times.front()) {
+    return static_cast<double>(time - m_times.front()) *
+           SECONDS_PER_NANOSECOND * static_cast<double>(m_values.front());
+  }
+  const size_t index = indexAt(time);
+  return m_cumulative[index] + static_cast<double>(time - m_times[index]) *
+                                   SECONDS_PER_NANOSECOND *
+                                   static_cast<double>(m_values[index]);
+}
+
+/**
+ * @param method :: Name of the calling method, for the error message
+ * @throws std::runtime_error if there are no entries
+ */
+template <typename TYPE>
+void TimeSeriesColumns<TYPE>::throwIfEmpty(const std::string &method) const {
+  if (m_times.empty())
+    throw std::runtime_error("TimeSeriesColumns::" + method +
+                             "(): the series is empty");
+}
+
+/// @cond
+// -------------------------- Concrete instantiation
+// -----------------------------------------------
+template class MANTID_KERNEL_DLL TimeSeriesColumns<int>;
+template class MANTID_KERNEL_DLL TimeSeriesColumns<long>;
+template class MANTID_KERNEL_DLL TimeSeriesColumns<long long>;
+template class MANTID_KERNEL_DLL TimeSeriesColumns<unsigned int>;
+template class MANTID_KERNEL_DLL TimeSeriesColumns<unsigned long>;
+template class MANTID_KERNEL_DLL TimeSeriesColumns<unsigned long long>;
+template class MANTID_KERNEL_DLL TimeSeriesColumns<float>;
+template class MANTID_KERNEL_DLL TimeSeriesColumns<double>;
+/// @endcond
+
+} // namespace Kernel
+} // namespace Mantid
@@ -1,5 +1,6 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/TimeSplitter.h"
+#include <algorithm>
 #include <ctime>
 #include <ostream>
 
@@ -273,5 +274,151 @@ TimeSplitterType operator~(const TimeSplitterType &a) {
   }
   return out;
 }
+
+//------------------------------------------------------------------------------------------------
+namespace {
+/// Orders a permutation of intervals by their start time
+struct StartIndexLess {
+  explicit StartIndexLess(const std::vector<int64_t> &starts)
+      : m_starts(starts) {}
+  bool operator()(const size_t lhs, const size_t rhs) const {
+    return m_starts[lhs] < m_starts[rhs];
+  }
+  const std::vector<int64_t> &m_starts;
+};
+}
+
+/// Default constructor: no intervals
+TimeSplitterColumns::TimeSplitterColumns()
+    : m_starts(), m_stops(), m_targets() {}
+
+/** Construct from a TimeSplitterType. The intervals are sorted by start time.
+ * @param splitter :: The splitter to copy
+ */
+TimeSplitterColumns::TimeSplitterColumns(const TimeSplitterType &splitter)
+    : m_starts(), m_stops(), m_targets() {
+  reserve(splitter.size());
+  for (auto it = splitter.begin(); it != splitter.end(); ++it)
+    addInterval(it->start().totalNanoseconds(), it->stop().totalNanoseconds(),
+                it->index());
+  sortByStart();
+}
+
+/** Append an interval. Call sortByStart() afterwards if the intervals may
+ * not have been added in time order.
+ * @param start :: Start time in nanoseconds, inclusive
+ * @param stop :: Stop time in nanoseconds, exclusive
+ * @param target :: Index of the destination
+ */
+void TimeSplitterColumns::addInterval(const int64_t start, const int64_t stop,
+                                      const int target) {
+  m_starts.push_back(start);
+  m_stops.push_back(stop);
+  m_targets.push_back(target);
+}
+
+/// @param n :: Number of intervals to reserve memory for
+void TimeSplitterColumns::reserve(const size_t n) {
+  m_starts.reserve(n);
+  m_stops.reserve(n);
+  m_targets.reserve(n);
+}
+
+/// Remove all intervals
+void TimeSplitterColumns::clear() {
+  m_starts.clear();
+  m_stops.clear();
+  m_targets.clear();
+}
+
+/// Sort the intervals by start time, keeping equal starts in order
+void TimeSplitterColumns::sortByStart() {
+  if (isSorted())
+    return;
+
+  const size_t numIntervals = m_starts.size();
+  std::vector<size_t> order(numIntervals);
+  for (size_t i = 0; i < numIntervals; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), StartIndexLess(m_starts));
+
+  std::vector<int64_t> starts(numIntervals), stops(numIntervals);
+  std::vector<int> targets(numIntervals);
+  for (size_t i = 0; i < numIntervals; ++i) {
+    starts[i] = m_starts[order[i]];
+    stops[i] = m_stops[order[i]];
+    targets[i] = m_targets[order[i]];
+  }
+  m_starts.swap(starts);
+  m_stops.swap(stops);
+  m_targets.swap(targets);
+}
+
+/// @return True if the intervals are in order of start time
+bool TimeSplitterColumns::isSorted() const {
+  return std::is_sorted(m_starts.begin(), m_starts.end());
+}
+
+/** @return True if the intervals are sorted, each has start <= stop and none
+ * overlaps the next. findInterval() and targetAt() require this.
+ */
+bool TimeSplitterColumns::isDisjoint() const {
+  const size_t numIntervals = m_starts.size();
+  for (size_t i = 0; i < numIntervals; ++i) {
+    if (m_stops[i] < m_starts[i])
+      return false;
+    if (i > 0 && m_starts[i] < m_stops[i - 1])
+      return false;
+  }
+  return true;
+}
+
+/** Find the first interval that ends after the given time. With disjoint
+ * intervals that is the one containing time, if any.
+ * @param time :: Time in nanoseconds
+ * @param hint :: Result of the previous call when walking through times in
+ * order. The search starts from here, so an ordered walk is linear overall.
+ * @return The index of the interval, or size() if time is after all of them
+ */
+size_t TimeSplitterColumns::findInterval(const int64_t time,
+                                         const size_t hint) const {
+  const size_t numIntervals = m_stops.size();
+  const std::vector<int64_t>::const_iterator begin = m_stops.begin();
+  if (hint < numIntervals && time >= m_stops[hint]) {
+    // Later than the hint
+    return static_cast<size_t>(
+        std::upper_bound(begin + hint + 1, m_stops.end(), time) - begin);
+  }
+  // At or before the hint
+  const size_t limit = std::min(hint, numIntervals);
+  if (limit == 0 || m_stops[limit - 1] <= time)
+    return limit;
+  return static_cast<size_t>(
+      std::upper_bound(begin, begin + (limit - 1), time) - begin);
+}
+
+/**
+ * @param time :: Time in nanoseconds
+ * @param outside :: Value returned if time is not inside any interval
+ * @return The target of the interval containing time
+ */
+int TimeSplitterColumns::targetAt(const int64_t time, const int outside) const {
+  const size_t index = findInterval(time);
+  if (index < m_starts.size() && m_starts[index] <= time)
+    return m_targets[index];
+  return outside;
+}
+
+/// @return The intervals as a TimeSplitterType
+TimeSplitterType TimeSplitterColumns::toTimeSplitter() const {
+  TimeSplitterType splitter;
+  const size_t numIntervals = m_starts.size();
+  splitter.reserve(numIntervals);
+  for (size_t i = 0; i < numIntervals; ++i)
+    splitter.push_back(SplittingInterval(DateAndTime(m_starts[i]),
+                                         DateAndTime(m_stops[i]),
+                                         m_targets[i]));
+  return splitter;
+}
 }
 }
@@ -0,0 +1,201 @@
+#include "MantidKernel/Tracer.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Memory.h"
+
+#include <Poco/Process.h>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// static logger
+Logger g_log("Tracer");
+
+/// Write a string as a JSON string literal
+void writeJSONString(std::ostream &os, const std::string &str) {
+  os << '"';
+  for (std::string::const_iterator it = str.begin(); it != str.end(); ++it) {
+    const char c = *it;
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      static const char *hex = "0123456789abcdef";
+      os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+}
+
+//----------------------------------------------------------------------------------------------
+/** Constructor. Starts recording if 'tracing.filename' is set.
+ */
+TracerImpl::TracerImpl()
+    : m_enabled(false), m_filename(), m_origin(), m_events(), m_threads(),
+      m_peakMemory(0), m_mutex() {
+  const std::string filename =
+      ConfigService::Instance().getString("tracing.filename");
+  if (!filename.empty())
+    enable(filename);
+}
+
+/** Destructor. Writes the trace to the file given to enable(), if any.
+ */
+TracerImpl::~TracerImpl() {
+  if (m_filename.empty() || m_events.empty())
+    return;
+  try {
+    save(m_filename);
+  } catch (std::exception &) {
+    // Nowhere left to report this
+  }
+}
+
+/**
+ * @param filename :: If not empty, the trace is written to this file when the
+ * process exits
+ */
+void TracerImpl::enable(const std::string &filename) {
+  Mutex::ScopedLock lock(m_mutex);
+  if (!filename.empty()) {
+    m_filename = filename;
+    g_log.notice() << "Tracing enabled. The trace will be written to "
+                   << filename << "\n";
+  }
+  m_enabled = true;
+}
+
+void TracerImpl::disable() { m_enabled = false; }
+
+void TracerImpl::clear() {
+  Mutex::ScopedLock lock(m_mutex);
+  m_events.clear();
+  m_peakMemory = 0;
+}
+
+/**
+ * @return The number of microseconds since the tracer was created
+ */
+int64_t TracerImpl::now() const {
+  return static_cast<int64_t>(Poco::Timestamp() - m_origin);
+}
+
+/**
+ * @param name :: What was done
+ * @param category :: The kind of work
+ * @param start :: When the span started, from now()
+ * @param duration :: The length of the span in microseconds
+ */
+void TracerImpl::addSpan(const std::string &name, const std::string &category,
+                         int64_t start, int64_t duration) {
+  Mutex::ScopedLock lock(m_mutex);
+  Event event = {name, category, 'X', start, duration, threadNumber(), 0};
+  m_events.push_back(event);
+}
+
+/** Reads the resident memory of the process from MemoryStats and records it
+ * as a counter.
+ */
+void TracerImpl::addMemorySample() {
+  MemoryStats stats(MEMORY_STATS_IGNORE_SYSTEM);
+  const size_t resident = stats.residentMem();
+  const int64_t time = now();
+
+  Mutex::ScopedLock lock(m_mutex);
+  Event event = {"Memory", "memory", 'C', time, 0, threadNumber(), resident};
+  m_events.push_back(event);
+  if (resident > m_peakMemory)
+    m_peakMemory = resident;
+}
+
+size_t TracerImpl::size() const {
+  Mutex::ScopedLock lock(m_mutex);
+  return m_events.size();
+}
+
+size_t TracerImpl::peakMemory() const {
+  Mutex::ScopedLock lock(m_mutex);
+  return m_peakMemory;
+}
+
+/** Writes the events in the JSON object form of the Chrome trace event
+ * format. Each thread is named after the order it was first seen in.
+ * @param filename :: The file to write
+ * @throw std::runtime_error if the file cannot be written
+ */
+void TracerImpl::save(const std::string &filename) const {
+  std::ofstream file(filename.c_str());
+  if (!file)
+    throw std::runtime_error("Unable to open trace file " + filename);
+
+  Mutex::ScopedLock lock(m_mutex);
+  const long pid = static_cast<long>(Poco::Process::id());
+  file << "{\"traceEvents\":[\n";
+  for (auto it = m_threads.begin(); it != m_threads.end(); ++it) {
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+         << ",\"tid\":" << it->second << ",\"args\":{\"name\":\"Thread "
+         << it->second << "\"}},\n";
+  }
+  for (auto it = m_events.begin(); it != m_events.end(); ++it) {
+    file << "{\"name\":";
+    writeJSONString(file, it->name);
+    file << ",\"cat\":";
+    writeJSONString(file, it->category);
+    file << ",\"ph\":\"" << it->phase << "\",\"ts\":" << it->start
+         << ",\"pid\":" << pid << ",\"tid\":" << it->thread;
+    if (it->phase == 'X')
+      file << ",\"dur\":" << it->duration;
+    else
+      file << ",\"args\":{\"resident (kiB)\":" << it->value << "}";
+    file << "},\n";
+  }
+  // Closes the list without a trailing comma
+  file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"args\":{\"name\":\"Mantid\"}}\n],\n";
+  file << "\"displayTimeUnit\":\"ms\",\n";
+  file << "\"otherData\":{\"peak resident memory (kiB)\":" << m_peakMemory
+       << "}\n}\n";
+  if (!file)
+    throw std::runtime_error("Error writing trace file " + filename);
+}
+
+/** Must be called with the mutex held.
+ * @return A number for the calling thread, starting at 0 for the first thread
+ * that records anything
+ */
+int TracerImpl::threadNumber() {
+  const Poco::Thread::TID tid = Poco::Thread::currentTid();
+  auto it = m_threads.find(tid);
+  if (it != m_threads.end())
+    return it->second;
+  const int number = static_cast<int>(m_threads.size());
+  m_threads[tid] = number;
+  return number;
+}
+
+//----------------------------------------------------------------------------------------------
+// TraceScope
+//----------------------------------------------------------------------------------------------
+void TraceScope::begin(const std::string &name) {
+  m_name = name;
+  TracerImpl &tracer = Tracer::Instance();
+  if (m_sampleMemory)
+    tracer.addMemorySample();
+  m_start = tracer.now();
+}
+
+void TraceScope::end() {
+  TracerImpl &tracer = Tracer::Instance();
+  tracer.addSpan(m_name, m_category, m_start, tracer.now() - m_start);
+  if (m_sampleMemory)
+    tracer.addMemorySample();
+}
+
+} // namespace Kernel
+} // namespace Mantid
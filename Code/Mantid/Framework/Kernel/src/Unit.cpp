@@ -9,6 +9,7 @@
 #include <cmath>
 #include <cfloat>
 #include <limits>
+#include <typeinfo>
 
 namespace Mantid {
 namespace Kernel {
@@ -1128,5 +1129,155 @@ const UnitLabel Degrees::label() const { return m_label; }
 
 } // namespace Units
 
+//----------------------------------------------------------------------------------------------
+// Fused conversions
+//----------------------------------------------------------------------------------------------
+namespace {
+/// Signature of a conversion of a strided array between two units
+typedef void (*FusedConversion)(const Unit &, const Unit &, char *,
+                                const size_t, const size_t);
+
+/// A kernel together with the exact unit types it was compiled for
+struct FusedKernel {
+  const std::type_info *from;
+  const std::type_info *to;
+  FusedConversion convert;
+};
+
+/// Kernels keyed by the unit IDs of the source and destination
+typedef std::map<std::pair<std::string, std::string>, FusedKernel> FusedKernels;
+
+/**
+ * Convert each value to TOF and straight on to the destination unit. The
+ * qualified calls are not virtual, so the conversion formulas of both units
+ * are inlined into one loop that the compiler can vectorize.
+ * @param fromUnit :: initialized source unit, of type From
+ * @param toUnit :: initialized destination unit, of type To
+ * @param values :: first value
+ * @param count :: number of values
+ * @param stride :: distance in bytes between values
+ */
+template <class From, class To>
+void convertFused(const Unit &fromUnit, const Unit &toUnit, char *values,
+                  const size_t count, const size_t stride) {
+  const From &from = static_cast<const From &>(fromUnit);
+  const To &to = static_cast<const To &>(toUnit);
+  if (stride == sizeof(double)) {
+    double *x = reinterpret_cast<double *>(values);
+    for (size_t i = 0; i < count; ++i)
+      x[i] = to.To::singleFromTOF(from.From::singleToTOF(x[i]));
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      double &x = *reinterpret_cast<double *>(values + i * stride);
+      x = to.To::singleFromTOF(from.From::singleToTOF(x));
+    }
+  }
+}
+
+/// Register the kernel converting From to To
+template <class From, class To> void addFusedKernel(FusedKernels &kernels) {
+  const From from;
+  const To to;
+  FusedKernel kernel = {&typeid(From), &typeid(To), &convertFused<From, To>};
+  kernels[std::make_pair(from.unitID(), to.unitID())] = kernel;
+}
+
+/// Register the kernels converting From to each unit with a closed form
+template <class From> void addFusedKernelsFrom(FusedKernels &kernels) {
+  using namespace Units;
+  addFusedKernel<From, TOF>(kernels);
+  addFusedKernel<From, Wavelength>(kernels);
+  addFusedKernel<From, Energy>(kernels);
+  addFusedKernel<From, Energy_inWavenumber>(kernels);
+  addFusedKernel<From, dSpacing>(kernels);
+  addFusedKernel<From, MomentumTransfer>(kernels);
+  addFusedKernel<From, QSquared>(kernels);
+  addFusedKernel<From, DeltaE>(kernels);
+  addFusedKernel<From, DeltaE_inWavenumber>(kernels);
+  addFusedKernel<From, Momentum>(kernels);
+}
+
+/// Build the table of all fused kernels
+FusedKernels createFusedKernels() {
+  using namespace Units;
+  FusedKernels kernels;
+  addFusedKernelsFrom<TOF>(kernels);
+  addFusedKernelsFrom<Wavelength>(kernels);
+  addFusedKernelsFrom<Energy>(kernels);
+  addFusedKernelsFrom<Energy_inWavenumber>(kernels);
+  addFusedKernelsFrom<dSpacing>(kernels);
+  addFusedKernelsFrom<MomentumTransfer>(kernels);
+  addFusedKernelsFrom<QSquared>(kernels);
+  addFusedKernelsFrom<DeltaE>(kernels);
+  addFusedKernelsFrom<DeltaE_inWavenumber>(kernels);
+  addFusedKernelsFrom<Momentum>(kernels);
+  return kernels;
+}
+
+/// The fused kernels, built when the library is loaded
+const FusedKernels g_fusedKernels = createFusedKernels();
+
+/// Returns the fused kernel for a pair of units or NULL if there is none
+const FusedKernel *findFusedKernel(const Unit &fromUnit, const Unit &toUnit) {
+  FusedKernels::const_iterator it =
+      g_fusedKernels.find(std::make_pair(fromUnit.unitID(), toUnit.unitID()));
+  if (it == g_fusedKernels.end())
+    return NULL;
+  // A subclass reusing a unit ID has its own formulas
+  if (typeid(fromUnit) != *it->second.from || typeid(toUnit) != *it->second.to)
+    return NULL;
+  return &it->second;
+}
+}
+
+/**
+ * Convert values from one unit to another by going through TOF. Both units
+ * must have been initialized. Common pairs of units use a kernel with the two
+ * conversions fused into one loop, others fall back to calling singleToTOF
+ * and singleFromTOF through the virtual interface.
+ * @param fromUnit :: the unit of the values
+ * @param toUnit :: the unit to convert to
+ * @param values :: first value to convert
+ * @param count :: number of values
+ * @param stride :: distance in bytes between values, so that for example the
+ * TOFs of a vector of events can be converted in place
+ */
+void Unit::convertViaTOF(const Unit &fromUnit, const Unit &toUnit,
+                         double *values, const size_t count,
+                         const size_t stride) {
+  char *start = reinterpret_cast<char *>(values);
+  const FusedKernel *kernel = findFusedKernel(fromUnit, toUnit);
+  if (kernel) {
+    kernel->convert(fromUnit, toUnit, start, count, stride);
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    double &x = *reinterpret_cast<double *>(start + i * stride);
+    x = toUnit.singleFromTOF(fromUnit.singleToTOF(x));
+  }
+}
+
+/**
+ * Convert a vector of values from one unit to another by going through TOF.
+ * Both units must have been initialized.
+ * @param fromUnit :: the unit of the values
+ * @param toUnit :: the unit to convert to
+ * @param values :: the values to convert in place
+ */
+void Unit::convertViaTOF(const Unit &fromUnit, const Unit &toUnit,
+                         std::vector<double> &values) {
+  if (!values.empty())
+    convertViaTOF(fromUnit, toUnit, &values[0], values.size());
+}
+
+/**
+ * @param fromUnit :: the unit to convert from
+ * @param toUnit :: the unit to convert to
+ * @return true if convertViaTOF has a fused kernel for the pair of units
+ */
+bool Unit::hasFusedConversion(const Unit &fromUnit, const Unit &toUnit) {
+  return findFusedKernel(fromUnit, toUnit) != NULL;
+}
+
 } // namespace Kernel
 } // namespace Mantid
@@ -4,6 +4,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/ConfigService.h"
 
 using namespace Mantid::Kernel;
 
@@ -280,10 +281,115 @@ public:
     TS_ASSERT_DIFFERS( dynamic_cast<Property*>(sProp), static_cast<Property*>(0) )
   }
   
+  void testCreateHistoryOfSmallArrayIsText()
+  {
+    ArrayProperty<double> prop("Params", "1,0.5,10");
+    PropertyHistory history = prop.createHistory();
+    TS_ASSERT( !history.lazyValue() )
+    TS_ASSERT_EQUALS( history.value(), "1,0.5,10" )
+  }
+
+  void testCreateHistoryOfLargeArrayIsLazy()
+  {
+    ConfigServiceImpl &config = ConfigService::Instance();
+    const std::string oldThreshold = config.getString("algorithms.history.arraythreshold");
+    const std::string oldMode = config.getString("algorithms.history.arraymode");
+    config.setString("algorithms.history.arraythreshold", "2");
+    config.setString("algorithms.history.arraymode", "lazy");
+
+    ArrayProperty<int> prop("DetectorList", "1,2,3,4");
+    PropertyHistory history = prop.createHistory();
+    TS_ASSERT( history.lazyValue() )
+    TS_ASSERT_EQUALS( history.value(), prop.value() )
+    TS_ASSERT_EQUALS( history.name(), "DetectorList" )
+    TS_ASSERT( !history.isDefault() )
+    std::vector<double> values;
+    TS_ASSERT( history.lazyValue()->toDoubles(values) )
+    TS_ASSERT_EQUALS( values.size(), 4 )
+    TS_ASSERT( history.lazyValue()->isIntegral() )
+
+    // A copy renders the same text
+    PropertyHistory copy(history);
+    TS_ASSERT_EQUALS( copy.value(), "1,2,3,4" )
+    TS_ASSERT( copy == history )
+
+    ArrayProperty<std::string> names("Names", "a,b,c");
+    history = names.createHistory();
+    TS_ASSERT_EQUALS( history.value(), "a,b,c" )
+    TS_ASSERT( !history.lazyValue()->toDoubles(values) )
+
+    config.setString("algorithms.history.arraythreshold", oldThreshold);
+    config.setString("algorithms.history.arraymode", oldMode);
+  }
+
+  void testLazyHistoriesCompareTheElements()
+  {
+    std::vector<int> ints(3000, 1);
+    ints[5] = 2;
+    const std::vector<double> doubles(ints.begin(), ints.end());
+    PropertyHistory intHistory("List", boost::make_shared<ArrayHistoryValue<int> >(ints), "int list", false);
+    PropertyHistory doubleHistory("List", boost::make_shared<ArrayHistoryValue<double> >(doubles), "int list", false);
+    TS_ASSERT( intHistory == doubleHistory )
+
+    ints[6] = 3;
+    PropertyHistory otherHistory("List", boost::make_shared<ArrayHistoryValue<int> >(ints), "int list", false);
+    TS_ASSERT( !(intHistory == otherHistory) )
+    ints.pop_back();
+    PropertyHistory shorterHistory("List", boost::make_shared<ArrayHistoryValue<int> >(ints), "int list", false);
+    TS_ASSERT( !(otherHistory == shorterHistory) )
+
+    // A lazy value and a string with the same text
+    PropertyHistory textHistory("List", intHistory.value(), "int list", false);
+    TS_ASSERT( textHistory == intHistory )
+  }
+
+  void testCreateHistoryOfLargeArrayInHashMode()
+  {
+    ConfigServiceImpl &config = ConfigService::Instance();
+    const std::string oldThreshold = config.getString("algorithms.history.arraythreshold");
+    const std::string oldMode = config.getString("algorithms.history.arraymode");
+    config.setString("algorithms.history.arraythreshold", "2");
+    config.setString("algorithms.history.arraymode", "hash");
+
+    ArrayProperty<int> prop("DetectorList", "1,2,3,4");
+    PropertyHistory history = prop.createHistory();
+    TS_ASSERT( !history.lazyValue() )
+    TS_ASSERT_EQUALS( history.value().find("[4 values, hash "), 0 )
+    ArrayProperty<int> other("DetectorList", "1,2,3,5");
+    TS_ASSERT_DIFFERS( other.createHistory().value(), history.value() )
+
+    config.setString("algorithms.history.arraythreshold", oldThreshold);
+    config.setString("algorithms.history.arraymode", oldMode);
+  }
+
 private:
   ArrayProperty<int> *iProp;
   ArrayProperty<double> *dProp;
   ArrayProperty<std::string> *sProp;
 };
 
+class ArrayPropertyTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static ArrayPropertyTestPerformance *createSuite() { return new ArrayPropertyTestPerformance(); }
+  static void destroySuite( ArrayPropertyTestPerformance *suite ) { delete suite; }
+
+  ArrayPropertyTestPerformance()
+    : m_prop("DataY", std::vector<double>(1000000, 1.5))
+  {
+  }
+
+  void testCreateHistoryOfLargeArray()
+  {
+    for(int i = 0; i < 10; ++i)
+    {
+      PropertyHistory history = m_prop.createHistory();
+      TS_ASSERT_EQUALS( history.name(), "DataY" )
+    }
+  }
+
+private:
+  ArrayProperty<double> m_prop;
+};
+
 #endif /*ARRAYPROPERTYTEST_H_*/
@@ -0,0 +1,86 @@
+#ifndef MANTID_KERNEL_MEMORYMAPPEDFILETEST_H_
+#define MANTID_KERNEL_MEMORYMAPPEDFILETEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidKernel/MemoryMappedFile.h"
+#include "MantidKernel/BinaryFile.h"
+
+#include <Poco/File.h>
+#include <fstream>
+
+using namespace Mantid::Kernel;
+
+class MemoryMappedFileTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MemoryMappedFileTest *createSuite() {
+    return new MemoryMappedFileTest();
+  }
+  static void destroySuite(MemoryMappedFileTest *suite) { delete suite; }
+
+  MemoryMappedFileTest() : m_filename("MemoryMappedFileTest.bin") {}
+
+  void test_file_not_found_throws() {
+    MemoryMappedFile file;
+    TS_ASSERT_THROWS(file.open("nonexistentfile.dat"), std::runtime_error);
+    TS_ASSERT(!file.isOpen());
+  }
+
+  void test_contents_match_BinaryFile() {
+    // A few pages worth of 32-bit integers
+    const size_t numValues = 10000;
+    makeFile(numValues);
+
+    BinaryFile<uint32_t> binary(m_filename);
+    std::vector<uint32_t> expected;
+    binary.loadAllInto(expected);
+
+    MemoryMappedFile file(m_filename);
+    TS_ASSERT(file.isOpen());
+    TS_ASSERT_EQUALS(file.size(), numValues * sizeof(uint32_t));
+    file.advise(MemoryMappedFile::Sequential);
+    file.willNeed(100, 20000);
+
+    const uint32_t *values = reinterpret_cast<const uint32_t *>(file.data());
+    for (size_t i = 0; i < numValues; ++i)
+      TS_ASSERT_EQUALS(values[i], expected[i]);
+
+    // Released pages are read back from the file
+    file.release(0, 4096 * 3 + 5);
+    TS_ASSERT_EQUALS(values[0], expected[0]);
+    TS_ASSERT_EQUALS(values[2000], expected[2000]);
+    // Ranges past the end are ignored
+    TS_ASSERT_THROWS_NOTHING(file.release(file.size() - 1, 100000));
+    TS_ASSERT_THROWS_NOTHING(file.willNeed(file.size() + 1, 10));
+
+    file.close();
+    TS_ASSERT(!file.isOpen());
+    TS_ASSERT(!file.data());
+    Poco::File(m_filename).remove();
+  }
+
+  void test_empty_file() {
+    makeFile(0);
+    MemoryMappedFile file(m_filename);
+    TS_ASSERT(file.isOpen());
+    TS_ASSERT_EQUALS(file.size(), 0);
+    TS_ASSERT(!file.data());
+    TS_ASSERT_THROWS_NOTHING(file.advise(MemoryMappedFile::Random));
+    file.close();
+    Poco::File(m_filename).remove();
+  }
+
+private:
+  /// Write numValues 32-bit integers 0, 1, 2... to the test file
+  void makeFile(const size_t numValues) {
+    std::ofstream out(m_filename.c_str(), std::ios::out | std::ios::binary);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(numValues); ++i)
+      out.write(reinterpret_cast<const char *>(&i), sizeof(i));
+    out.close();
+  }
+
+  std::string m_filename;
+};
+
+#endif /* MANTID_KERNEL_MEMORYMAPPEDFILETEST_H_ */
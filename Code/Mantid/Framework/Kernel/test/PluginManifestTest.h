@@ -0,0 +1,170 @@
+#ifndef MANTID_KERNEL_PLUGINMANIFESTTEST_H_
+#define MANTID_KERNEL_PLUGINMANIFESTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/PluginManifest.h"
+
+#include <Poco/File.h>
+
+#include <fstream>
+
+using Mantid::Kernel::PluginManifest;
+
+class PluginManifestTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PluginManifestTest *createSuite() { return new PluginManifestTest(); }
+  static void destroySuite(PluginManifestTest *suite) { delete suite; }
+
+  PluginManifestTest()
+      : m_libA("PluginManifestTest_libA.so"),
+        m_libB("PluginManifestTest_libB.so"),
+        m_manifestFile("PluginManifestTest.manifest") {}
+
+  void setUp() {
+    writeFile(m_libA, "library A");
+    writeFile(m_libB, "library B");
+  }
+
+  void tearDown() {
+    removeFile(m_libA);
+    removeFile(m_libB);
+    removeFile(m_manifestFile);
+  }
+
+  void test_lookup() {
+    PluginManifest manifest = createManifest();
+
+    TS_ASSERT(!manifest.empty());
+    TS_ASSERT_EQUALS(manifest.libraryProviding("Algorithm", "Rebin|1"), m_libA);
+    TS_ASSERT_EQUALS(manifest.libraryProviding("Function", "Gaussian"), m_libB);
+    TS_ASSERT_EQUALS(manifest.libraryProviding("Function", "Rebin|1"), "");
+    TS_ASSERT_EQUALS(manifest.libraryProviding("Algorithm", "Fit|1"), "");
+
+    std::vector<std::string> algorithms = manifest.names("Algorithm");
+    TS_ASSERT_EQUALS(algorithms.size(), 3);
+    // Sorted as strings
+    TS_ASSERT_EQUALS(algorithms[0], "RebinToWorkspace|1");
+    TS_ASSERT_EQUALS(algorithms[1], "Rebin|1");
+    TS_ASSERT_EQUALS(algorithms[2], "Rebin|2");
+  }
+
+  void test_librariesProviding_matches_prefix() {
+    PluginManifest manifest = createManifest();
+
+    std::set<std::string> libs = manifest.librariesProviding("Algorithm");
+    TS_ASSERT_EQUALS(libs.size(), 2);
+    libs = manifest.librariesProviding("Algorithm", "Rebin|");
+    TS_ASSERT_EQUALS(libs.size(), 2);
+    libs = manifest.librariesProviding("Algorithm", "RebinToWorkspace|");
+    TS_ASSERT_EQUALS(libs.size(), 1);
+    TS_ASSERT_EQUALS(*libs.begin(), m_libA);
+    libs = manifest.librariesProviding("Loader");
+    TS_ASSERT(libs.empty());
+  }
+
+  void test_librariesWithoutEntries() {
+    PluginManifest manifest = createManifest();
+    TS_ASSERT(manifest.librariesWithoutEntries().empty());
+
+    const std::string libC("PluginManifestTest_libC.so");
+    manifest.addLibrary(libC, "stamp");
+    std::vector<std::string> libs = manifest.librariesWithoutEntries();
+    TS_ASSERT_EQUALS(libs.size(), 1);
+    TS_ASSERT_EQUALS(libs[0], libC);
+  }
+
+  void test_removeLibrary_removes_its_entries() {
+    PluginManifest manifest = createManifest();
+    manifest.removeLibrary(m_libA);
+
+    TS_ASSERT_EQUALS(manifest.libraries().size(), 1);
+    TS_ASSERT_EQUALS(manifest.libraryProviding("Algorithm", "Rebin|1"), "");
+    TS_ASSERT_EQUALS(manifest.names("Algorithm").size(), 1);
+    manifest.removeLibrary(m_libB);
+    TS_ASSERT(manifest.empty());
+  }
+
+  void test_addEntry_for_unknown_library_throws() {
+    PluginManifest manifest;
+    TS_ASSERT_THROWS(manifest.addEntry("unknown", "Algorithm", "Rebin|1"),
+                     std::invalid_argument);
+  }
+
+  void test_save_and_load_round_trip() {
+    createManifest().save(m_manifestFile);
+
+    PluginManifest loaded;
+    TS_ASSERT_THROWS_NOTHING(loaded = PluginManifest::load(m_manifestFile));
+    TS_ASSERT_EQUALS(loaded.libraries().size(), 2);
+    TS_ASSERT_EQUALS(loaded.libraryProviding("Algorithm", "Rebin|2"), m_libB);
+    TS_ASSERT_EQUALS(loaded.names("Function").size(), 1);
+
+    std::vector<std::string> libraries;
+    libraries.push_back(m_libA);
+    libraries.push_back(m_libB);
+    TS_ASSERT(loaded.isUpToDate(libraries));
+  }
+
+  void test_manifest_is_out_of_date_if_libraries_change() {
+    PluginManifest manifest = createManifest();
+    std::vector<std::string> libraries;
+    libraries.push_back(m_libA);
+    libraries.push_back(m_libB);
+    TS_ASSERT(manifest.isUpToDate(libraries));
+
+    // A library missing from the manifest
+    libraries.push_back("PluginManifestTest_libC.so");
+    TS_ASSERT(!manifest.isUpToDate(libraries));
+    libraries.pop_back();
+
+    // A rebuilt library
+    writeFile(m_libB, "library B, rebuilt");
+    TS_ASSERT(!manifest.isUpToDate(libraries));
+  }
+
+  void test_load_rejects_files_that_are_not_manifests() {
+    TS_ASSERT_THROWS(PluginManifest::load("PluginManifestTest.missing"),
+                     std::runtime_error);
+
+    writeFile(m_manifestFile, "library\tA\t1:1\n");
+    TS_ASSERT_THROWS(PluginManifest::load(m_manifestFile), std::runtime_error);
+
+    createManifest().save(m_manifestFile);
+    std::ofstream file(m_manifestFile.c_str(), std::ios::app);
+    file << "garbage\n";
+    file.close();
+    TS_ASSERT_THROWS(PluginManifest::load(m_manifestFile), std::runtime_error);
+  }
+
+private:
+  PluginManifest createManifest() const {
+    PluginManifest manifest;
+    manifest.addLibrary(m_libA);
+    manifest.addEntry(m_libA, "Algorithm", "Rebin|1");
+    manifest.addEntry(m_libA, "Algorithm", "RebinToWorkspace|1");
+    manifest.addLibrary(m_libB);
+    manifest.addEntry(m_libB, "Algorithm", "Rebin|2");
+    manifest.addEntry(m_libB, "Function", "Gaussian");
+    return manifest;
+  }
+
+  void writeFile(const std::string &filename, const std::string &contents) {
+    std::ofstream file(filename.c_str());
+    file << contents;
+  }
+
+  void removeFile(const std::string &filename) {
+    Poco::File file(filename);
+    if (file.exists())
+      file.remove();
+  }
+
+  const std::string m_libA;
+  const std::string m_libB;
+  const std::string m_manifestFile;
+};
+
+#endif /* MANTID_KERNEL_PLUGINMANIFESTTEST_H_ */
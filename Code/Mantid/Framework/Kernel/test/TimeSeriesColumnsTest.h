@@ -0,0 +1,264 @@
+#ifndef MANTID_KERNEL_TIMESERIESCOLUMNSTEST_H_
+#define MANTID_KERNEL_TIMESERIESCOLUMNSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidKernel/TimeSeriesColumns.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/EmptyValues.h"
+
+#include <boost/math/special_functions/fpclassify.hpp>
+
+using namespace Mantid::Kernel;
+using Mantid::EMPTY_DBL;
+
+class TimeSeriesColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TimeSeriesColumnsTest *createSuite() {
+    return new TimeSeriesColumnsTest();
+  }
+  static void destroySuite(TimeSeriesColumnsTest *suite) { delete suite; }
+
+  void test_construct_from_property_copies_all_entries_in_order() {
+    TimeSeriesProperty<double> *log = createLog();
+    TimeSeriesColumns<double> columns(*log);
+
+    TS_ASSERT_EQUALS(columns.size(), 8);
+    TS_ASSERT_EQUALS(columns.time(0), DateAndTime("2007-11-30T16:17:00"));
+    TS_ASSERT_EQUALS(columns.time(7), DateAndTime("2007-11-30T16:18:10"));
+    TS_ASSERT_EQUALS(columns.value(0), 1.0);
+    TS_ASSERT_EQUALS(columns.value(7), 2.0);
+    delete log;
+  }
+
+  void test_construct_from_unsorted_property_sorts_by_time() {
+    TimeSeriesProperty<int> log("unsorted");
+    log.addValue("2007-11-30T16:17:20", 3);
+    log.addValue("2007-11-30T16:17:00", 1);
+    log.addValue("2007-11-30T16:17:10", 2);
+    TimeSeriesColumns<int> columns(log);
+
+    TS_ASSERT_EQUALS(columns.size(), 3);
+    for (size_t i = 0; i < columns.size(); ++i) {
+      TS_ASSERT_EQUALS(columns.value(i), static_cast<int>(i) + 1);
+    }
+    TS_ASSERT_EQUALS(columns.time(0), DateAndTime("2007-11-30T16:17:00"));
+  }
+
+  void test_construct_from_columns_sorts_by_time() {
+    std::vector<int64_t> times(3);
+    times[0] = 30;
+    times[1] = 10;
+    times[2] = 20;
+    std::vector<int> values(3);
+    values[0] = 3;
+    values[1] = 1;
+    values[2] = 2;
+    TimeSeriesColumns<int> columns(times, values);
+    TS_ASSERT_EQUALS(columns.times()[0], 10);
+    TS_ASSERT_EQUALS(columns.values()[0], 1);
+    TS_ASSERT_EQUALS(columns.values()[2], 3);
+
+    values.pop_back();
+    TS_ASSERT_THROWS(TimeSeriesColumns<int>(times, values),
+                     std::invalid_argument);
+  }
+
+  void test_append_out_of_order_throws() {
+    TimeSeriesColumns<double> columns;
+    columns.append(int64_t(10), 1.0);
+    TS_ASSERT_THROWS_NOTHING(columns.append(int64_t(10), 2.0));
+    TS_ASSERT_THROWS(columns.append(int64_t(5), 3.0), std::invalid_argument);
+    TS_ASSERT_EQUALS(columns.size(), 2);
+  }
+
+  void test_compress_keeps_first_and_last_of_each_run() {
+    TimeSeriesProperty<double> *log = createLog();
+    TimeSeriesColumns<double> columns(*log, true);
+
+    // 1,1,1,5,5,5,5,2 -> 1,1,5,5,2
+    TS_ASSERT_EQUALS(columns.size(), 5);
+    TS_ASSERT_EQUALS(columns.time(1), DateAndTime("2007-11-30T16:17:20"));
+    TS_ASSERT_EQUALS(columns.time(3), DateAndTime("2007-11-30T16:18:00"));
+    TS_ASSERT_EQUALS(columns.value(4), 2.0);
+    delete log;
+  }
+
+  void test_valueAt_matches_getSingleValue() {
+    TimeSeriesProperty<double> *log = createLog();
+    TimeSeriesColumns<double> columns(*log, true);
+
+    const char *times[] = {"2007-11-30T16:16:00", "2007-11-30T16:17:00",
+                           "2007-11-30T16:17:25", "2007-11-30T16:17:30",
+                           "2007-11-30T16:18:05", "2007-11-30T16:19:00"};
+    for (size_t i = 0; i < 6; ++i) {
+      DateAndTime t(times[i]);
+      TS_ASSERT_EQUALS(columns.valueAt(t), log->getSingleValue(t));
+    }
+    delete log;
+  }
+
+  void test_averageValueInFilter_matches_property() {
+    TimeSeriesProperty<double> *log = createLog();
+    TimeSeriesColumns<double> columns(*log);
+    TimeSeriesColumns<double> compressed(*log, true);
+
+    TimeSplitterType filter;
+    filter.push_back(SplittingInterval(DateAndTime("2007-11-30T16:16:50"),
+                                       DateAndTime("2007-11-30T16:17:35")));
+    filter.push_back(SplittingInterval(DateAndTime("2007-11-30T16:17:55"),
+                                       DateAndTime("2007-11-30T16:18:30")));
+
+    const double expected = log->averageValueInFilter(filter);
+    TS_ASSERT_DELTA(columns.averageValueInFilter(filter), expected, 1e-10);
+    TS_ASSERT_DELTA(compressed.averageValueInFilter(filter), expected, 1e-10);
+
+    TS_ASSERT(boost::math::isnan(
+        columns.averageValueInFilter(TimeSplitterType())));
+    delete log;
+  }
+
+  void test_timeAverage_over_whole_log_matches_property() {
+    TimeSeriesProperty<double> *log = createLog();
+    TimeSeriesColumns<double> columns(*log, true);
+    TS_ASSERT_DELTA(columns.timeAverage(log->firstTime(), log->lastTime()),
+                    log->timeAverageValue(), 1e-10);
+    // 1.0 for 30s, then 5.0 for 40s
+    TS_ASSERT_DELTA(columns.integral(log->firstTime(), log->lastTime()),
+                    230.0, 1e-10);
+    delete log;
+  }
+
+  void test_min_and_max_over_ranges() {
+    std::vector<int64_t> times;
+    std::vector<double> values;
+    // Long enough to span several blocks of the index
+    for (int i = 0; i < 1000; ++i) {
+      times.push_back(i * 1000);
+      values.push_back(static_cast<double>((i * 37) % 101));
+    }
+    TimeSeriesColumns<double> columns(times, values);
+
+    const size_t ranges[][2] = {{0, 999}, {3, 3}, {10, 70}, {63, 64},
+                                {100, 900}, {511, 777}};
+    for (size_t r = 0; r < 6; ++r) {
+      double expectedMin(values[ranges[r][0]]), expectedMax(expectedMin);
+      for (size_t i = ranges[r][0]; i <= ranges[r][1]; ++i) {
+        expectedMin = std::min(expectedMin, values[i]);
+        expectedMax = std::max(expectedMax, values[i]);
+      }
+      TS_ASSERT_EQUALS(columns.minInIndexRange(ranges[r][0], ranges[r][1]),
+                       expectedMin);
+      TS_ASSERT_EQUALS(columns.maxInIndexRange(ranges[r][0], ranges[r][1]),
+                       expectedMax);
+    }
+
+    // Value in effect at 2.5us is entry 2: 74
+    TS_ASSERT_EQUALS(columns.minInTimeRange(DateAndTime(int64_t(2500)),
+                                            DateAndTime(int64_t(3000))),
+                     74.0);
+    TS_ASSERT_THROWS(columns.minInIndexRange(5, 1000), std::out_of_range);
+    TS_ASSERT_THROWS(TimeSeriesColumns<double>().minInIndexRange(0, 0),
+                     std::runtime_error);
+  }
+
+  void test_makeFilterByValue_matches_property() {
+    TimeSeriesProperty<double> *log = createLog();
+    TimeSeriesColumns<double> compressed(*log, true);
+
+    for (int centre = 0; centre < 2; ++centre) {
+      TimeSplitterType expected, filter;
+      log->makeFilterByValue(expected, 4.0, 6.0, 1.0, centre == 1);
+      compressed.makeFilterByValue(filter, 4.0, 6.0, 1.0, centre == 1);
+      TS_ASSERT_EQUALS(filter.size(), expected.size());
+      for (size_t i = 0; i < std::min(filter.size(), expected.size()); ++i) {
+        TS_ASSERT_EQUALS(filter[i].start(), expected[i].start());
+        TS_ASSERT_EQUALS(filter[i].stop(), expected[i].stop());
+      }
+    }
+
+    TimeSplitterType all;
+    compressed.makeFilterByValue(all, EMPTY_DBL(), EMPTY_DBL());
+    TS_ASSERT_EQUALS(all.size(), 1);
+    TS_ASSERT_THROWS(compressed.makeFilterByValue(all, 2.0, 1.0),
+                     std::invalid_argument);
+    delete log;
+  }
+
+  void test_compression_reduces_memory() {
+    TimeSeriesProperty<double> *log = createLog();
+    TimeSeriesColumns<double> columns(*log);
+    TimeSeriesColumns<double> compressed(*log, true);
+    TS_ASSERT_LESS_THAN(compressed.getMemorySize(), columns.getMemorySize());
+    delete log;
+  }
+
+private:
+  /// Values 1,1,1,5,5,5,5,2 at 10s intervals. Caller owns the result.
+  TimeSeriesProperty<double> *createLog() {
+    TimeSeriesProperty<double> *log = new TimeSeriesProperty<double>("log");
+    const double values[] = {1., 1., 1., 5., 5., 5., 5., 2.};
+    DateAndTime start("2007-11-30T16:17:00");
+    for (int i = 0; i < 8; ++i)
+      log->addValue(start + i * 10.0, values[i]);
+    return log;
+  }
+};
+
+class TimeSeriesColumnsTestPerformance : public CxxTest::TestSuite {
+public:
+  static TimeSeriesColumnsTestPerformance *createSuite() {
+    return new TimeSeriesColumnsTestPerformance();
+  }
+  static void destroySuite(TimeSeriesColumnsTestPerformance *suite) {
+    delete suite;
+  }
+
+  TimeSeriesColumnsTestPerformance() : m_columns() {
+    // A 10^7 point 'fast' log stepping between a few set-points
+    const int64_t numPoints = 10000000;
+    m_columns.reserve(static_cast<size_t>(numPoints));
+    const int64_t start = DateAndTime("2010-01-01T00:00:00").totalNanoseconds();
+    for (int64_t i = 0; i < numPoints; ++i)
+      m_columns.append(start + i * 1000000,
+                       static_cast<double>((i / 10000) % 7));
+    m_columns.buildIndex();
+
+    for (int64_t i = 0; i < 10000; ++i) {
+      const int64_t begin = start + i * 1000000000;
+      m_filter.push_back(
+          SplittingInterval(DateAndTime(begin), DateAndTime(begin + 500000000)));
+    }
+  }
+
+  void test_averageValueInFilter() {
+    TS_ASSERT_DELTA(m_columns.averageValueInFilter(m_filter), 3.0, 0.05);
+  }
+
+  void test_makeFilterByValue() {
+    TimeSplitterType split;
+    m_columns.makeFilterByValue(split, 2.0, 4.0);
+    TS_ASSERT(!split.empty());
+  }
+
+  void test_min_max_in_time_ranges() {
+    for (size_t i = 0; i < m_filter.size(); ++i) {
+      TS_ASSERT_LESS_THAN_EQUALS(
+          m_columns.minInTimeRange(m_filter[i].start(), m_filter[i].stop()),
+          m_columns.maxInTimeRange(m_filter[i].start(), m_filter[i].stop()));
+    }
+  }
+
+  void test_compress() {
+    TimeSeriesColumns<double> copy(m_columns);
+    copy.compress();
+    TS_ASSERT_LESS_THAN(copy.size(), m_columns.size() / 1000);
+  }
+
+private:
+  TimeSeriesColumns<double> m_columns;
+  TimeSplitterType m_filter;
+};
+
+#endif /* MANTID_KERNEL_TIMESERIESCOLUMNSTEST_H_ */
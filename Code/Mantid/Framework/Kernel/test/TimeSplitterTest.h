@@ -558,6 +558,61 @@ public:
     TS_ASSERT_EQUALS(index2, 2);
   }
 
+
+  void test_TimeSplitterColumns_sorts_intervals()
+  {
+    TimeSplitterType b;
+    b.push_back( SplittingInterval(DateAndTime(int64_t(300)), DateAndTime(int64_t(400)), 3) );
+    b.push_back( SplittingInterval(DateAndTime(int64_t(100)), DateAndTime(int64_t(200)), 1) );
+    b.push_back( SplittingInterval(DateAndTime(int64_t(200)), DateAndTime(int64_t(250)), 2) );
+
+    TimeSplitterColumns columns(b);
+    TS_ASSERT_EQUALS( columns.size(), 3 );
+    TS_ASSERT( columns.isSorted() );
+    TS_ASSERT( columns.isDisjoint() );
+    TS_ASSERT_EQUALS( columns.starts()[0], 100 );
+    TS_ASSERT_EQUALS( columns.stops()[1], 250 );
+    TS_ASSERT_EQUALS( columns.targets()[2], 3 );
+
+    TimeSplitterType back = columns.toTimeSplitter();
+    TS_ASSERT_EQUALS( back.size(), 3 );
+    TS_ASSERT_EQUALS( back[0].start(), DateAndTime(int64_t(100)) );
+    TS_ASSERT_EQUALS( back[0].index(), 1 );
+
+    columns.addInterval(350, 500, 4);
+    TS_ASSERT( !columns.isDisjoint() );
+  }
+
+  void test_TimeSplitterColumns_findInterval_and_targetAt()
+  {
+    TimeSplitterColumns columns;
+    columns.addInterval(100, 200, 1);
+    columns.addInterval(200, 250, 2);
+    columns.addInterval(300, 400, 3);
+
+    TS_ASSERT_EQUALS( columns.findInterval(50), 0 );
+    TS_ASSERT_EQUALS( columns.findInterval(199), 0 );
+    TS_ASSERT_EQUALS( columns.findInterval(200), 1 );
+    TS_ASSERT_EQUALS( columns.findInterval(260), 2 );
+    TS_ASSERT_EQUALS( columns.findInterval(400), 3 );
+
+    // The hint must not change the answer, whichever side of it the time is
+    for (size_t hint = 0; hint < 5; ++hint)
+    {
+      TS_ASSERT_EQUALS( columns.findInterval(50, hint), 0 );
+      TS_ASSERT_EQUALS( columns.findInterval(220, hint), 1 );
+      TS_ASSERT_EQUALS( columns.findInterval(399, hint), 2 );
+      TS_ASSERT_EQUALS( columns.findInterval(1000, hint), 3 );
+    }
+
+    TS_ASSERT_EQUALS( columns.targetAt(50), -1 );
+    TS_ASSERT_EQUALS( columns.targetAt(100), 1 );
+    TS_ASSERT_EQUALS( columns.targetAt(249), 2 );
+    TS_ASSERT_EQUALS( columns.targetAt(250, -7), -7 );
+    TS_ASSERT_EQUALS( columns.targetAt(300), 3 );
+    TS_ASSERT_EQUALS( columns.targetAt(400), -1 );
+  }
+
 };
 
 
@@ -0,0 +1,115 @@
+#ifndef MANTID_KERNEL_TRACERTEST_H_
+#define MANTID_KERNEL_TRACERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/Tracer.h"
+#include "MantidKernel/Timer.h"
+
+#include <Poco/File.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+using namespace Mantid::Kernel;
+
+class TracerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TracerTest *createSuite() { return new TracerTest(); }
+  static void destroySuite(TracerTest *suite) { delete suite; }
+
+  void setUp() {
+    m_wasEnabled = Tracer::Instance().isEnabled();
+    Tracer::Instance().clear();
+  }
+
+  void tearDown() {
+    TracerImpl &tracer = Tracer::Instance();
+    tracer.clear();
+    if (m_wasEnabled)
+      tracer.enable();
+    else
+      tracer.disable();
+  }
+
+  void test_nothing_is_recorded_when_disabled() {
+    Tracer::Instance().disable();
+    { TraceScope trace("Span", "test", true); }
+    TS_ASSERT_EQUALS(Tracer::Instance().size(), 0);
+  }
+
+  void test_scope_records_a_span() {
+    Tracer::Instance().enable();
+    { TraceScope trace("Span", "test"); }
+    TS_ASSERT_EQUALS(Tracer::Instance().size(), 1);
+  }
+
+  void test_memory_is_sampled_at_both_ends() {
+    TracerImpl &tracer = Tracer::Instance();
+    tracer.enable();
+    { TraceScope trace("Span", "test", true); }
+    TS_ASSERT_EQUALS(tracer.size(), 3);
+    TS_ASSERT_LESS_THAN(0, tracer.peakMemory());
+  }
+
+  void test_save_writes_chrome_trace() {
+    TracerImpl &tracer = Tracer::Instance();
+    tracer.enable();
+    {
+      TraceScope outer("Outer \"quoted\"", "algorithm");
+      TraceScope inner("Inner", "child algorithm");
+    }
+    const std::string filename("TracerTest.json");
+    tracer.save(filename);
+
+    std::ifstream file(filename.c_str());
+    const std::string contents((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+    file.close();
+    Poco::File(filename).remove();
+
+    TS_ASSERT_EQUALS(contents.find("{\"traceEvents\":["), 0);
+    TS_ASSERT_DIFFERS(contents.find("\"name\":\"Outer \\\"quoted\\\"\""),
+                      std::string::npos);
+    TS_ASSERT_DIFFERS(contents.find("\"cat\":\"child algorithm\""),
+                      std::string::npos);
+    TS_ASSERT_DIFFERS(contents.find("\"ph\":\"X\""), std::string::npos);
+    TS_ASSERT_DIFFERS(contents.find("\"thread_name\""), std::string::npos);
+  }
+
+private:
+  bool m_wasEnabled;
+};
+
+class TracerTestPerformance : public CxxTest::TestSuite {
+public:
+  static TracerTestPerformance *createSuite() {
+    return new TracerTestPerformance();
+  }
+  static void destroySuite(TracerTestPerformance *suite) { delete suite; }
+
+  void test_disabled_scope_overhead() {
+    TracerImpl &tracer = Tracer::Instance();
+    const bool wasEnabled = tracer.isEnabled();
+    tracer.disable();
+
+    const std::string name("Span");
+    Timer timer;
+    for (size_t i = 0; i < nScopes; ++i) {
+      TraceScope trace(name, "test");
+    }
+    std::cout << "\n" << nScopes << " disabled trace scopes took "
+              << timer.elapsed() << " s\n";
+
+    if (wasEnabled)
+      tracer.enable();
+  }
+
+private:
+  static const size_t nScopes = 10000000;
+};
+
+#endif /* MANTID_KERNEL_TRACERTEST_H_ */
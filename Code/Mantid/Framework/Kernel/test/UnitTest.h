@@ -6,8 +6,10 @@
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitLabelTypes.h"
+#include "MantidKernel/Timer.h"
 #include <boost/lexical_cast.hpp>
 #include <cfloat>
+#include <iostream>
 #include <limits>
 
 using namespace Mantid::Kernel;
@@ -97,6 +99,45 @@ std::string convert_units_check_range(const Unit &aUnit,std::vector<double> &sam
   return error_mess;
 }
 
+/// A value followed by other data, like the TOF of an event
+struct StridedEvent { double tof; int64_t pulse; };
+
+/// Initialized instances of the units with fused conversions, for an
+/// indirect geometry so that energy transfer is valid
+std::vector<Unit*> createFusedUnits()
+{
+  std::vector<Unit*> units;
+  units.push_back(new Units::TOF());
+  units.push_back(new Units::Wavelength());
+  units.push_back(new Units::Energy());
+  units.push_back(new Units::Energy_inWavenumber());
+  units.push_back(new Units::dSpacing());
+  units.push_back(new Units::MomentumTransfer());
+  units.push_back(new Units::QSquared());
+  units.push_back(new Units::DeltaE());
+  units.push_back(new Units::DeltaE_inWavenumber());
+  units.push_back(new Units::Momentum());
+  for (size_t i = 0; i < units.size(); i++)
+    units[i]->initialize(10.0, 1.5, 1.2, 2, 3.5, 0.0);
+  return units;
+}
+
+void deleteUnits(std::vector<Unit*> &units)
+{
+  for (size_t i = 0; i < units.size(); i++)
+    delete units[i];
+  units.clear();
+}
+
+/// Values of a unit that correspond to TOFs spread over a typical range
+std::vector<double> createValues(const Unit &unit, const size_t count)
+{
+  std::vector<double> values(count);
+  for (size_t i = 0; i < count; i++)
+    values[i] = unit.singleFromTOF(5000.0 + 15000.0 * static_cast<double>(i) / static_cast<double>(count));
+  return values;
+}
+
 class UnitTest : public CxxTest::TestSuite
 {
 
@@ -251,6 +292,70 @@ public:
     TS_ASSERT( dynamic_cast<Momentum*>( unit ) );
     delete unit;
   }
+
+  //----------------------------------------------------------------------
+  // Fused conversions
+  //----------------------------------------------------------------------
+
+  void test_convertViaTOF_matches_singleToTOF_singleFromTOF()
+  {
+    std::vector<Unit*> units = createFusedUnits();
+    for (size_t i = 0; i < units.size(); i++)
+    {
+      for (size_t j = 0; j < units.size(); j++)
+      {
+        const Unit &from = *units[i];
+        const Unit &to = *units[j];
+        const std::string pair = from.unitID() + "->" + to.unitID();
+        TSM_ASSERT(pair, Unit::hasFusedConversion(from, to));
+
+        std::vector<double> values = createValues(from, 101);
+        std::vector<double> expected(values);
+        for (size_t k = 0; k < expected.size(); k++)
+          expected[k] = to.singleFromTOF(from.singleToTOF(expected[k]));
+
+        Unit::convertViaTOF(from, to, values);
+        for (size_t k = 0; k < values.size(); k++)
+          TSM_ASSERT_DELTA(pair, values[k], expected[k],
+                           1e-12 * std::fabs(expected[k]));
+      }
+    }
+    deleteUnits(units);
+  }
+
+  void test_convertViaTOF_strided()
+  {
+    Units::TOF from;
+    Units::dSpacing to;
+    from.initialize(10.0, 2.0, 1.5, 0, 0.0, 0.0);
+    to.initialize(10.0, 2.0, 1.5, 0, 0.0, 0.0);
+
+    std::vector<StridedEvent> events(10);
+    for (size_t i = 0; i < events.size(); i++)
+    {
+      events[i].tof = 1000.0 * static_cast<double>(i + 1);
+      events[i].pulse = static_cast<int64_t>(i);
+    }
+    Unit::convertViaTOF(from, to, &events[0].tof, events.size(), sizeof(StridedEvent));
+    for (size_t i = 0; i < events.size(); i++)
+    {
+      TS_ASSERT_DELTA(events[i].tof, to.singleFromTOF(1000.0 * static_cast<double>(i + 1)), 1e-12);
+      TS_ASSERT_EQUALS(events[i].pulse, static_cast<int64_t>(i));
+    }
+  }
+
+  void test_convertViaTOF_falls_back_without_kernel()
+  {
+    Units::SpinEchoLength from;
+    Units::TOF to;
+    from.initialize(100, 11, 1.0, 0, 1.0, 1);
+    to.initialize(100, 11, 1.0, 0, 1.0, 1);
+    TS_ASSERT(!Unit::hasFusedConversion(from, to));
+
+    std::vector<double> values(3, 0.5);
+    Unit::convertViaTOF(from, to, values);
+    TS_ASSERT_DELTA(values[2], from.singleToTOF(0.5), 1e-12);
+  }
     
   //----------------------------------------------------------------------
   // TOF tests
@@ -1342,4 +1447,41 @@ private:
   Units::SpinEchoTime tau;
 };
 
+class UnitTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static UnitTestPerformance *createSuite() { return new UnitTestPerformance(); }
+  static void destroySuite(UnitTestPerformance *suite) { delete suite; }
+
+  /// Time the fused kernels against the virtual calls for every pair of units
+  void test_convertViaTOF_all_pairs()
+  {
+    const size_t numValues = 1000000;
+    std::vector<Unit*> units = createFusedUnits();
+    std::cout << "\n";
+    for (size_t i = 0; i < units.size(); i++)
+    {
+      for (size_t j = 0; j < units.size(); j++)
+      {
+        const Unit &from = *units[i];
+        const Unit &to = *units[j];
+        std::vector<double> fused = createValues(from, numValues);
+        std::vector<double> virtualCalls(fused);
+
+        Timer timer;
+        Unit::convertViaTOF(from, to, fused);
+        const float fusedTime = timer.elapsed();
+        for (size_t k = 0; k < numValues; k++)
+          virtualCalls[k] = to.singleFromTOF(from.singleToTOF(virtualCalls[k]));
+        const float virtualTime = timer.elapsed();
+
+        std::cout << from.unitID() << " -> " << to.unitID() << ": fused "
+                  << fusedTime << " s, virtual " << virtualTime << " s\n";
+        TS_ASSERT_DELTA(fused.back(), virtualCalls.back(), 1e-12 * std::fabs(virtualCalls.back()));
+      }
+    }
+    deleteUnits(units);
+  }
+};
+
 #endif /*UNITTEST_H_*/
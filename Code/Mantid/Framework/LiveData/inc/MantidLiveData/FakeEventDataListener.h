@@ -56,6 +56,7 @@ private:
 
   DataObjects::EventWorkspace_sptr
       m_buffer; ///< Used to buffer events between calls to extractData()
+  std::vector<size_t> m_chunkSizes; ///< Events per spectrum in the last chunk
   Kernel::PseudoRandomNumberGenerator *
       m_rand; ///< Used in generation of random events
   Poco::Timer
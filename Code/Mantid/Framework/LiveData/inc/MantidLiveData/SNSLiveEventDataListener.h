@@ -95,6 +95,7 @@ private:
   void initWorkspacePart2();
 
   void initMonitorWorkspace();
+  void reserveEventLists(DataObjects::EventWorkspace &buffer) const;
 
   // Check to see if all the conditions we need for initWorkspacePart2() have
   // been
@@ -130,6 +131,9 @@ private:
   int m_runNumber;
   DataObjects::EventWorkspace_sptr
       m_eventBuffer; ///< Used to buffer events between calls to extractData()
+  /// Number of events in each spectrum of the last chunk returned by
+  /// extractData(). Used to size the event lists of the next buffer.
+  std::vector<size_t> m_chunkSizes;
 
   bool m_workspaceInitialized;
   std::string m_wsName;
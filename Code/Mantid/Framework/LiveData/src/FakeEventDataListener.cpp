@@ -111,6 +111,11 @@ boost::shared_ptr<Workspace> FakeEventDataListener::extractData() {
       WorkspaceFactory::Instance().create("EventWorkspace", 2, 2, 1));
   // Will need an 'initializeFromParent' here later on....
 
+  // Make room for as many events as last time, plus a margin, so that
+  // generateEvents() doesn't have to grow the lists while holding the lock
+  for (size_t i = 0; i < m_chunkSizes.size(); ++i)
+    temp->getEventList(i).reserve(m_chunkSizes[i] + m_chunkSizes[i] / 4);
+
   // Safety considerations suggest I should stop the thread here, but the below
   // methods don't
   // seem to do what I'd expect and I haven't seen any problems from not having
@@ -123,6 +128,10 @@ boost::shared_ptr<Workspace> FakeEventDataListener::extractData() {
   Mutex::ScopedLock _lock(m_mutex);
   std::swap(m_buffer, temp);
 
+  m_chunkSizes.resize(temp->getNumberHistograms());
+  for (size_t i = 0; i < m_chunkSizes.size(); ++i)
+    m_chunkSizes[i] = temp->getEventList(i).getNumberEvents();
+
   // Add a run number
   temp->mutableRun().addLogData(
       new PropertyWithValue<int>("run_number", m_runNumber));
@@ -6,10 +6,13 @@
 #include "MantidAPI/Workspace.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 #include <Poco/Thread.h>
 
 using namespace Mantid::Kernel;
@@ -19,6 +22,17 @@ using namespace Mantid::DataObjects;
 namespace Mantid {
 namespace LiveData {
 
+namespace {
+/** Merge the two TOF-sorted runs [begin, begin+split) and [begin+split, end)
+ * of an event vector in place.
+ * @param events :: event vector, sorted by TOF on either side of split
+ * @param split :: index of the first event of the second run
+ */
+template <class T> void mergeSortedRuns(std::vector<T> &events, size_t split) {
+  std::inplace_merge(events.begin(), events.begin() + split, events.end());
+}
+}
+
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(LoadLiveData)
 
@@ -293,6 +307,10 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
       accumMon += chunkMon;
   }
 
+  // Event data can be appended to the accumulation workspace directly
+  if (addEventChunkInPlace(accumWS, chunkWS))
+    return;
+
   // Now do the main workspace
   IAlgorithm_sptr alg = this->createChildAlgorithm(algoName);
   alg->setProperty("LHSWorkspace", accumWS);
@@ -319,6 +337,70 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Add a chunk of events to the accumulation workspace in place, without
+ * running Plus. Each chunk list is sorted by TOF and merged into the already
+ * sorted accumulation list, so the work per update scales with the size of
+ * the chunk plus a linear merge rather than a copy and re-sort of the whole
+ * accumulation workspace.
+ *
+ * @param accumWS :: accumulation workspace
+ * @param chunkWS :: processed live data chunk workspace
+ * @return true if the chunk was added; false if the workspaces are not both
+ *  EventWorkspaces with the same number of spectra, in which case nothing is
+ *  changed.
+ */
+bool LoadLiveData::addEventChunkInPlace(Workspace_sptr accumWS,
+                                        Workspace_sptr chunkWS) {
+  EventWorkspace_sptr accumEW =
+      boost::dynamic_pointer_cast<EventWorkspace>(accumWS);
+  EventWorkspace_const_sptr chunkEW =
+      boost::dynamic_pointer_cast<const EventWorkspace>(chunkWS);
+  if (!accumEW || !chunkEW)
+    return false;
+  const size_t numSpec = accumEW->getNumberHistograms();
+  if (chunkEW->getNumberHistograms() != numSpec)
+    return false;
+
+  CPUTimer tim;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(numSpec); ++i) {
+    const size_t wi = static_cast<size_t>(i);
+    const EventList &chunkList = chunkEW->getEventList(wi);
+    if (chunkList.empty())
+      continue;
+    EventList &accumList = accumEW->getEventList(wi);
+    const size_t split = accumList.getNumberEvents();
+    const bool wasSorted = (accumList.getSortType() == TOF_SORT);
+    chunkList.sortTof();
+    accumList += chunkList;
+    if (wasSorted) {
+      switch (accumList.getEventType()) {
+      case TOF:
+        mergeSortedRuns(accumList.getEvents(), split);
+        break;
+      case WEIGHTED:
+        mergeSortedRuns(accumList.getWeightedEvents(), split);
+        break;
+      case WEIGHTED_NOTIME:
+        mergeSortedRuns(accumList.getWeightedEventsNoTime(), split);
+        break;
+      }
+      accumList.setSortOrder(TOF_SORT);
+    } else {
+      accumList.sortTof();
+    }
+  }
+  accumEW->clearMRU();
+
+  // Sum the proton charge and append the logs, as Plus would
+  accumEW->mutableRun() += chunkEW->run();
+
+  g_log.debug() << tim << " to add " << chunkEW->getNumberEvents()
+                << " events in place to " << accumWS->name() << std::endl;
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by replacing the output workspace.
  * Sets m_accumWS.
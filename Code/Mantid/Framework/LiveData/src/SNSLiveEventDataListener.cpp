@@ -25,6 +25,7 @@
 #include <Poco/Thread.h>
 #include <Poco/Runnable.h>
 
+#include <algorithm>
 #include <time.h>
 #include <sstream> // for ostringstream
 #include <string>
@@ -1416,15 +1417,41 @@ boost::shared_ptr<Workspace> SNSLiveEventDataListener::extractData() {
                                                     newMonitorBuffer, false);
   temp->setMonitorWorkspace(newMonitorBuffer);
 
+  // Size the new buffer's event lists now, so that the background thread
+  // doesn't have to grow them while it holds the mutex
+  reserveEventLists(*temp);
+
   // Lock the mutex and swap the workspaces
   {
     Poco::ScopedLock<Poco::FastMutex> scopedLock(m_mutex);
     std::swap(m_eventBuffer, temp);
   } // mutex automatically unlocks here
 
+  // Nothing else writes to the chunk now, so record its size for next time
+  m_chunkSizes.resize(temp->getNumberHistograms());
+  for (size_t i = 0; i < m_chunkSizes.size(); ++i) {
+    m_chunkSizes[i] = temp->getEventList(i).getNumberEvents();
+  }
+
   return temp;
 }
 
+/// Reserve space in the event lists of a new buffer workspace
+
+/// Each list is given room for as many events as the same spectrum received
+/// in the previous chunk, plus a margin.  At a steady event rate this means
+/// the event vectors are never reallocated while events are being appended.
+/// @param buffer The new, empty buffer workspace
+void SNSLiveEventDataListener::reserveEventLists(
+    DataObjects::EventWorkspace &buffer) const {
+  const size_t numSpectra =
+      std::min(buffer.getNumberHistograms(), m_chunkSizes.size());
+  for (size_t i = 0; i < numSpectra; ++i) {
+    if (m_chunkSizes[i] > 0)
+      buffer.getEventList(i).reserve(m_chunkSizes[i] + m_chunkSizes[i] / 4);
+  }
+}
+
 /// Check the status of the current run
 
 /// Called by the foreground thread check the status of the current run
@@ -15,6 +15,8 @@
 #include "MantidAPI/LiveListenerFactory.h"
 #include "MantidTestHelpers/FacilityHelper.h"
 #include "TestGroupDataListener.h"
+#include <Poco/Thread.h>
+#include <algorithm>
 
 using namespace Mantid;
 using namespace Mantid::LiveData;
@@ -467,4 +469,70 @@ public:
 };
 
 
+class LoadLiveDataTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static LoadLiveDataTestPerformance *createSuite() { return new LoadLiveDataTestPerformance(); }
+  static void destroySuite( LoadLiveDataTestPerformance *suite ) { delete suite; }
+
+  void setUp()
+  {
+    FrameworkManager::Instance();
+    AnalysisDataService::Instance().clear();
+    m_oldDataRate = ConfigService::Instance().getString("fakeeventdatalistener.datarate");
+  }
+
+  void tearDown()
+  {
+    ConfigService::Instance().setString("fakeeventdatalistener.datarate", m_oldDataRate);
+    AnalysisDataService::Instance().clear();
+  }
+
+  /** Accumulate events arriving at 10^7 events/sec with repeated "Add" updates.
+   * Each update should only cost as much as the new chunk, however large the
+   * accumulation workspace has grown. */
+  void test_add_FakeEventDataListener_1e7_events_per_sec()
+  {
+    ConfigService::Instance().setString("fakeeventdatalistener.datarate", "10000000");
+    ILiveListener_sptr listener = LiveListenerFactory::Instance().create("FakeEventDataListener", true);
+    listener->start(0);
+
+    FacilityHelper::ScopedFacilities loadTESTFacility("IDFs_for_UNIT_TESTING/UnitTestFacilities.xml", "TEST");
+    const int numUpdates = 20;
+    EventWorkspace_sptr first;
+    size_t previousEvents = 0;
+    double maxUpdate = 0;
+    Timer total;
+    for (int i = 0; i < numUpdates; ++i)
+    {
+      Poco::Thread::sleep(100);
+      LoadLiveData alg;
+      alg.initialize();
+      alg.setPropertyValue("Instrument", "TestDataListener");
+      alg.setPropertyValue("AccumulationMethod", "Add");
+      alg.setPropertyValue("OutputWorkspace", "fake");
+      alg.setLiveListener(listener);
+      Timer update;
+      TS_ASSERT_THROWS_NOTHING( alg.execute() );
+      maxUpdate = std::max(maxUpdate, static_cast<double>(update.elapsed()));
+
+      EventWorkspace_sptr ws = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("fake");
+      if (!first)
+        first = ws;
+      TSM_ASSERT( "Workspace is accumulated in place", ws == first );
+      TS_ASSERT_LESS_THAN_EQUALS( previousEvents, ws->getNumberEvents() );
+      previousEvents = ws->getNumberEvents();
+    }
+    TSM_ASSERT( "Events are sorted", first->getEventList(0).isSortedByTof() );
+    TSM_ASSERT( "Events are sorted", first->getEventList(1).isSortedByTof() );
+    std::cout << previousEvents << " events accumulated in " << numUpdates
+              << " updates over " << total.elapsed() << " s. Slowest update took "
+              << maxUpdate << " s." << std::endl;
+  }
+
+private:
+  std::string m_oldDataRate;
+};
+
+
 #endif /* MANTID_LIVEDATA_LOADLIVEDATATEST_H_ */
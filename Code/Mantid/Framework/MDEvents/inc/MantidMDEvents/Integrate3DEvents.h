@@ -70,12 +70,15 @@ public:
   /// Add event Q's to lists of events near peaks
   void addEvents(std::vector<V3D> const &event_qs);
 
+  /// Add a block of lists of event Q's to lists of events near peaks
+  void addEvents(std::vector<std::vector<V3D>> const &event_qs);
+
   /// Find the net integrated intensity of a peak, using ellipsoidal volumes
   boost::shared_ptr<const Mantid::Geometry::PeakShape> ellipseIntegrateEvents(V3D const &peak_q, bool specify_size,
                               double peak_radius, double back_inner_radius,
                               double back_outer_radius,
                               std::vector<double> &axes_radii, double &inti,
-                              double &sigi);
+                              double &sigi) const;
 
 private:
   /// Calculate the number of events in an ellipsoid centered at 0,0,0
@@ -99,17 +102,17 @@ private:
   static int64_t getHklKey(int h, int k, int l);
 
   /// Form a map key for the specified q_vector.
-  int64_t getHklKey(V3D const &q_vector);
+  int64_t getHklKey(V3D const &q_vector) const;
 
-  /// Add an event to the vector of events for the closest h,k,l
-  void addEvent(V3D event_Q);
+  /// Find the peak an event belongs to and shift the event to that peak
+  int64_t shiftToPeak(V3D &event_Q) const;
 
   /// Find the net integrated intensity of a list of Q's using ellipsoids
   boost::shared_ptr<const Mantid::DataObjects::PeakShapeEllipsoid> ellipseIntegrateEvents(
       std::vector<V3D> const &ev_list, std::vector<V3D> const &directions,
       std::vector<double> const &sigmas, bool specify_size, double peak_radius,
       double back_inner_radius, double back_outer_radius,
-      std::vector<double> &axes_radii, double &inti, double &sigi);
+      std::vector<double> &axes_radii, double &inti, double &sigi) const;
 
   // Private data members
   PeakQMap peak_qs;         // hashtable with peak Q-vectors
@@ -3,10 +3,12 @@
 
 #include "MantidAPI/Algorithm.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Peak.h"
 #include "MantidMDEvents/MDWSDescription.h"
 
 namespace Mantid {
 namespace MDEvents {
+class Integrate3DEvents;
 
 class DLLExport IntegrateEllipsoids : public API::Algorithm {
 public:
@@ -30,6 +32,14 @@ private:
   MDWSDescription m_targWSDescr;
 
   void initTargetWSDescr(DataObjects::EventWorkspace_sptr wksp);
+
+  /// Integrate the indexed peaks in parallel
+  void integratePeaks(const Integrate3DEvents &integrator,
+                      std::vector<DataObjects::Peak> &peaks, bool specify_size,
+                      double peak_radius, double back_inner_radius,
+                      double back_outer_radius,
+                      std::vector<std::vector<double>> &axes_radii,
+                      std::vector<Geometry::PeakShape_const_sptr> &shapes);
 };
 
 } // namespace MDEvents
@@ -201,6 +201,12 @@ public:
     return extents[dim];
   }
 
+  /** Get the extents for this box */
+  const Mantid::Geometry::MDDimensionExtents<coord_t> &
+  getExtents(size_t dim) const {
+    return extents[dim];
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Returns the extents as a string, for convenience */
   std::string getExtentsStr() const {
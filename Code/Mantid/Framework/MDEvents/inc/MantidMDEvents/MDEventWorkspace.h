@@ -68,6 +68,12 @@ public:
                            std::vector<coord_t> &x, std::vector<signal_t> &y,
                            std::vector<signal_t> &e) const;
 
+  virtual void getPlanePlot(const Mantid::Kernel::VMD &origin,
+                            const Mantid::Kernel::VMD &xStep,
+                            const Mantid::Kernel::VMD &yStep, size_t numX,
+                            size_t numY, API::MDNormalization normalize,
+                            std::vector<signal_t> &signal) const;
+
   //------------------------ (END) IMDWorkspace Methods
   //-----------------------------------------
 
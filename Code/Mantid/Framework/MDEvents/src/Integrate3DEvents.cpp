@@ -6,6 +6,7 @@
 #include "MantidDataObjects/NoShape.h"
 #include "MantidDataObjects/PeakShapeEllipsoid.h"
 #include "MantidMDEvents/Integrate3DEvents.h"
+#include "MantidKernel/MultiThreaded.h"
 
 
 extern "C" {
@@ -68,7 +69,47 @@ Integrate3DEvents::~Integrate3DEvents() {}
  */
 void Integrate3DEvents::addEvents(std::vector<V3D> const &event_qs) {
   for (size_t i = 0; i < event_qs.size(); i++) {
-    addEvent(event_qs[i]);
+    V3D event_Q(event_qs[i]);
+    int64_t hkl_key = shiftToPeak(event_Q);
+    if (hkl_key != 0)
+      event_lists[hkl_key].push_back(event_Q);
+  }
+}
+
+/**
+ * Add a block of lists of event Q's to lists of events near peaks, as
+ * addEvents() does for a single list.  Finding the peak of each event only
+ * reads the peak map, so for a large block it is done in parallel, a list at
+ * a time.  The events are then appended in their original order, so the
+ * lists of events near each peak do not depend on the number of threads.
+ *
+ * @param event_qs   Lists of event Q vectors to add to lists of Q's
+ *                   associated with peaks.
+ */
+void Integrate3DEvents::addEvents(
+    std::vector<std::vector<V3D>> const &event_qs) {
+  const int numLists = static_cast<int>(event_qs.size());
+  size_t numEvents = 0;
+  for (size_t j = 0; j < event_qs.size(); j++) {
+    numEvents += event_qs[j].size();
+  }
+
+  std::vector<std::vector<V3D>> shifted_qs(event_qs);
+  std::vector<std::vector<int64_t>> hkl_keys(event_qs.size());
+  PRAGMA_OMP(parallel for schedule(dynamic) if (numEvents > 10000))
+  for (int j = 0; j < numLists; j++) {
+    std::vector<V3D> &list = shifted_qs[j];
+    hkl_keys[j].resize(list.size());
+    for (size_t i = 0; i < list.size(); i++) {
+      hkl_keys[j][i] = shiftToPeak(list[i]);
+    }
+  }
+
+  for (size_t j = 0; j < shifted_qs.size(); j++) {
+    for (size_t i = 0; i < shifted_qs[j].size(); i++) {
+      if (hkl_keys[j][i] != 0)
+        event_lists[hkl_keys[j][i]].push_back(shifted_qs[j][i]);
+    }
   }
 }
 
@@ -110,7 +151,7 @@ void Integrate3DEvents::addEvents(std::vector<V3D> const &event_qs) {
 Mantid::Geometry::PeakShape_const_sptr Integrate3DEvents::ellipseIntegrateEvents(
     V3D const &peak_q, bool specify_size, double peak_radius,
     double back_inner_radius, double back_outer_radius,
-    std::vector<double> &axes_radii, double &inti, double &sigi) {
+    std::vector<double> &axes_radii, double &inti, double &sigi) const {
   inti = 0.0; // default values, in case something
   sigi = 0.0; // is wrong with the peak.
 
@@ -119,7 +160,12 @@ Mantid::Geometry::PeakShape_const_sptr Integrate3DEvents::ellipseIntegrateEvents
     return boost::make_shared<NoShape>();
   }
 
-  std::vector<V3D> &some_events = event_lists[hkl_key];
+  // Only look the list up, so that peaks can be integrated concurrently
+  auto list_it = event_lists.find(hkl_key);
+  if (list_it == event_lists.end()) {
+    return boost::make_shared<NoShape>();
+  }
+  std::vector<V3D> const &some_events = list_it->second;
 
   if (some_events.size() < 3) // if there are not enough events to
   {                           // find covariance matrix, return
@@ -315,7 +361,7 @@ int64_t Integrate3DEvents::getHklKey(int h, int k, int l) {
  *
  *  @param q_vector  The q_vector to be mapped to h,k,l
  */
-int64_t Integrate3DEvents::getHklKey(V3D const &q_vector) {
+int64_t Integrate3DEvents::getHklKey(V3D const &q_vector) const {
   V3D hkl = UBinv * q_vector;
   int h = boost::math::iround<double>(hkl[0]);
   int k = boost::math::iround<double>(hkl[1]);
@@ -324,34 +370,33 @@ int64_t Integrate3DEvents::getHklKey(V3D const &q_vector) {
 }
 
 /**
- * Add an event to the appropriate vector of events for the closest h,k,l,
- * if it is within the required radius of the corresponding peak in the
- * PeakQMap.
- *
- * NOTE: The event passed in may be modified by this method.  In particular,
- * if it corresponds to one of the specified peak_qs, the corresponding peak q
- * will be subtracted from the event and the event will be added to that
- * peak's vector in the event_lists map.
+ * Find the peak with the h,k,l closest to the specified event Q and shift
+ * the event Q by the center Q of that peak. This does not modify the
+ * object, so it can be called from several threads at once.
  *
- * @param event_Q      The Q-vector for the event that may be added to the
- *                     event_lists map, if it is close enough to some peak
+ * @param event_Q   The Q-vector for the event, replaced by its offset from
+ *                  the peak center if the event belongs to a peak.
+ * @return The key of the peak, or 0 if the event is not within the radius
+ *         of any peak.
  */
-void Integrate3DEvents::addEvent(V3D event_Q) {
+int64_t Integrate3DEvents::shiftToPeak(V3D &event_Q) const {
   int64_t hkl_key = getHklKey(event_Q);
 
   if (hkl_key == 0) // don't keep events associated with 0,0,0
-    return;
+    return 0;
 
   auto peak_it = peak_qs.find(hkl_key);
   if (peak_it != peak_qs.end())
   {
     if (!peak_it->second.nullVector()) {
-      event_Q = event_Q - peak_it->second;
-      if (event_Q.norm() < radius) {
-        event_lists[hkl_key].push_back(event_Q);
+      V3D shifted = event_Q - peak_it->second;
+      if (shifted.norm() < radius) {
+        event_Q = shifted;
+        return hkl_key;
       }
     }
   }
+  return 0;
 }
 
 /**
@@ -393,7 +438,7 @@ PeakShapeEllipsoid_const_sptr Integrate3DEvents::ellipseIntegrateEvents(
     std::vector<V3D> const &ev_list, std::vector<V3D> const &directions,
     std::vector<double> const &sigmas, bool specify_size, double peak_radius,
     double back_inner_radius, double back_outer_radius,
-    std::vector<double> &axes_radii, double &inti, double &sigi) {
+    std::vector<double> &axes_radii, double &inti, double &sigi) const {
   // r1, r2 and r3 will give the sizes of the major axis of
   // the peak ellipsoid, and of the inner and outer surface
   // of the background ellipsoidal shell, respectively.
@@ -11,6 +11,7 @@
 #include "MantidGeometry/Crystal/IndexingUtils.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidMDEvents/MDTransfFactory.h"
 #include "MantidMDEvents/UnitsConversionHelper.h"
 #include "MantidMDEvents/Integrate3DEvents.h"
@@ -37,6 +38,10 @@ const std::string ELASTIC("Elastic");
 /// Only convert to Q-vector.
 const std::string Q3D("Q3D");
 
+/// Number of events converted to Q at a time before they are added to the
+/// integrator, to bound the memory used for the Q-vectors.
+const size_t MAX_BLOCK_EVENTS = 10000000;
+
 /// Q-vector is always three dimensional.
 const std::size_t DIMS(3);
 
@@ -220,84 +225,93 @@ void IntegrateEllipsoids::exec() {
       MDTransfFactory::Instance().create(m_targWSDescr.AlgID);
   q_converter->initialize(m_targWSDescr);
 
+  // The converters keep the state of the current pixel, so each thread works
+  // on its own copy
+  const int numThreads = PARALLEL_GET_MAX_THREADS;
+  std::vector<UnitsConversionHelper> threadUnitConv(numThreads, unitConv);
+  std::vector<MDTransf_sptr> threadConverter(numThreads);
+  for (int k = 0; k < numThreads; ++k) {
+    threadConverter[k] = MDTransf_sptr(q_converter->clone());
+  }
+
   // set up the progress bar
   const size_t numSpectra = wksp->getNumberHistograms();
   Progress prog(this, 0.5, 1.0, numSpectra);
 
-  // loop through the eventlists
-  std::vector<double> buffer(DIMS);
-
-  std::vector<V3D> event_qs;
-  for (std::size_t i = 0; i < numSpectra; ++i) {
-    // get a reference to the event list
-    EventList &events = wksp->getEventList(i);
-
-    events.switchTo(WEIGHTED_NOTIME);
-
-    // check to see if the event list is empty
-    if (events.empty()) {
-      prog.report();
-      continue; // nothing to do
+  // The events are converted to Q in parallel, a block of spectra at a time,
+  // and the block is handed to the integrator in spectrum order so that the
+  // lists of events near each peak do not depend on the number of threads.
+  size_t block_start = 0;
+  while (block_start < numSpectra) {
+    size_t block_end = block_start;
+    size_t block_events = 0;
+    while (block_end < numSpectra && block_events < MAX_BLOCK_EVENTS) {
+      block_events += wksp->getEventList(block_end).getNumberEvents();
+      ++block_end;
     }
 
-    // update which pixel is being converted
-    std::vector<coord_t> locCoord(DIMS, 0.);
-    unitConv.updateConversion(i);
-    q_converter->calcYDepCoordinates(locCoord, i);
-
-    // loop over the events
-    double signal(1.);  // ignorable garbage
-    double errorSq(1.); // ignorable garbage
-    const std::vector<WeightedEventNoTime> &raw_events =
-        events.getWeightedEventsNoTime();
-    event_qs.clear();
-    for (auto event = raw_events.begin(); event != raw_events.end(); ++event) {
-      double val = unitConv.convertUnits(event->tof());
-      q_converter->calcMatrixCoord(val, locCoord, signal, errorSq);
-      for (size_t dim = 0; dim < DIMS; ++dim) {
-        buffer[dim] = locCoord[dim];
+    const int block_size = static_cast<int>(block_end - block_start);
+    std::vector<std::vector<V3D>> block_qs(block_size);
+    PARALLEL_FOR1(wksp)
+    for (int j = 0; j < block_size; ++j) {
+      PARALLEL_START_INTERUPT_REGION
+      const size_t i = block_start + static_cast<size_t>(j);
+      // get a reference to the event list
+      EventList &events = wksp->getEventList(i);
+
+      events.switchTo(WEIGHTED_NOTIME);
+
+      // check to see if the event list is empty
+      if (!events.empty()) {
+        // update which pixel is being converted
+        UnitsConversionHelper &localUnitConv =
+            threadUnitConv[PARALLEL_THREAD_NUMBER];
+        MDTransf_sptr &localConverter = threadConverter[PARALLEL_THREAD_NUMBER];
+        std::vector<coord_t> locCoord(DIMS, 0.);
+        localUnitConv.updateConversion(i);
+        localConverter->calcYDepCoordinates(locCoord, i);
+
+        // loop over the events
+        double signal(1.);  // ignorable garbage
+        double errorSq(1.); // ignorable garbage
+        const std::vector<WeightedEventNoTime> &raw_events =
+            events.getWeightedEventsNoTime();
+        std::vector<V3D> &event_qs = block_qs[j];
+        event_qs.reserve(raw_events.size());
+        for (auto event = raw_events.begin(); event != raw_events.end();
+             ++event) {
+          double val = localUnitConv.convertUnits(event->tof());
+          localConverter->calcMatrixCoord(val, locCoord, signal, errorSq);
+          event_qs.push_back(V3D(locCoord[0], locCoord[1], locCoord[2]));
+        } // end of loop over events in list
       }
-      V3D q_vec(buffer[0], buffer[1], buffer[2]);
-      event_qs.push_back(q_vec);
-    } // end of loop over events in list
 
-    integrator.addEvents(event_qs);
+      prog.report();
+      PARALLEL_END_INTERUPT_REGION
+    } // end of loop over spectra
+    PARALLEL_CHECK_INTERUPT_REGION
 
-    prog.report();
-  } // end of loop over spectra
+    integrator.addEvents(block_qs);
+    block_start = block_end;
+  }
 
-  double inti;
-  double sigi;
+  std::vector<std::vector<double>> axes_radii;
+  std::vector<Mantid::Geometry::PeakShape_const_sptr> shapes;
+  integratePeaks(integrator, peaks, specify_size, peak_radius,
+                 back_inner_radius, back_outer_radius, axes_radii, shapes);
   std::vector<double> r1,r2,r3;
   for (size_t i = 0; i < n_peaks; i++) {
-    V3D hkl(peaks[i].getH(), peaks[i].getK(), peaks[i].getL());
-    if (Geometry::IndexingUtils::ValidIndex(hkl, 1.0)) {
-      V3D peak_q(peaks[i].getQLabFrame());
-      std::vector<double> axes_radii;
-      Mantid::Geometry::PeakShape_const_sptr shape = integrator.ellipseIntegrateEvents(peak_q, specify_size, peak_radius,
-                                        back_inner_radius, back_outer_radius,
-                                        axes_radii, inti, sigi);
-      peaks[i].setIntensity(inti);
-      peaks[i].setSigmaIntensity(sigi);
-      peaks[i].setPeakShape(shape);
-      if (axes_radii.size() == 3) {
-        if (inti/sigi > cutoffIsigI && !specify_size)
-        {
-        r1.push_back(axes_radii[0]);
-        r2.push_back(axes_radii[1]);
-        r3.push_back(axes_radii[2]);
-        }
-        g_log.notice()
-            << "Radii of three axes of ellipsoid for integrating peak " << i
-            << " = ";
-        for (int i3 = 0; i3 < 3; i3++) {
-          g_log.notice() << axes_radii[i3] << "  ";
-        }
-        g_log.notice() << std::endl;
+    if (shapes[i])
+      peaks[i].setPeakShape(shapes[i]);
+    if (axes_radii[i].size() == 3) {
+      double inti = peaks[i].getIntensity();
+      double sigi = peaks[i].getSigmaIntensity();
+      if (inti/sigi > cutoffIsigI && !specify_size)
+      {
+        r1.push_back(axes_radii[i][0]);
+        r2.push_back(axes_radii[i][1]);
+        r3.push_back(axes_radii[i][2]);
       }
-    } else {
-      peaks[i].setIntensity(0.0);
-      peaks[i].setSigmaIntensity(0.0);
     }
   }
   if (r1.size() > 1 && !specify_size)
@@ -328,31 +342,8 @@ void IntegrateEllipsoids::exec() {
     back_inner_radius = peak_radius;
     back_outer_radius = peak_radius * 1.25992105; // A factor of 2 ^ (1/3) will make the background
     // shell volume equal to the peak region volume.
-    for (size_t i = 0; i < n_peaks; i++) {
-      V3D hkl(peaks[i].getH(), peaks[i].getK(), peaks[i].getL());
-      if (Geometry::IndexingUtils::ValidIndex(hkl, 1.0)) {
-        V3D peak_q(peaks[i].getQLabFrame());
-        std::vector<double> axes_radii;
-        integrator.ellipseIntegrateEvents(peak_q, specify_size, peak_radius,
-                                          back_inner_radius, back_outer_radius,
-                                          axes_radii, inti, sigi);
-        peaks[i].setIntensity(inti);
-        peaks[i].setSigmaIntensity(sigi);
-        if (axes_radii.size() == 3) {
-          g_log.notice()
-              << "Radii of three axes of ellipsoid for integrating peak " << i
-              << " = ";
-          for (int i3 = 0; i3 < 3; i3++) {
-            g_log.notice() << axes_radii[i3] << "  ";
-          }
-          g_log.notice() << std::endl;
-        }
-      } else {
-        peaks[i].setIntensity(0.0);
-        peaks[i].setSigmaIntensity(0.0);
-      }
-    }
-
+    integratePeaks(integrator, peaks, specify_size, peak_radius,
+                   back_inner_radius, back_outer_radius, axes_radii, shapes);
   }
   // This flag is used by the PeaksWorkspace to evaluate whether it has been
   // integrated.
@@ -367,6 +358,70 @@ void IntegrateEllipsoids::exec() {
   setProperty("OutputWorkspace", peak_ws);
 }
 
+/**
+ * Integrate the indexed peaks in parallel and set their intensities. Peaks
+ * that are not indexed get zero intensity.
+ *
+ * @param integrator          The integrator holding the events near each peak
+ * @param peaks               The peaks to integrate
+ * @param specify_size        If true use the given radii, otherwise size the
+ *                            ellipsoids from the spread of the events
+ * @param peak_radius         Size of half the major axis of the peak region
+ * @param back_inner_radius   Size of half the major axis of the inner
+ *                            boundary of the background region
+ * @param back_outer_radius   Size of half the major axis of the outer
+ *                            boundary of the background region
+ * @param axes_radii          Returns the radii of the three axes of the
+ *                            ellipsoid used for each peak, if any
+ * @param shapes              Returns the shape of each indexed peak, and a
+ *                            null pointer for the other peaks
+ */
+void IntegrateEllipsoids::integratePeaks(
+    const Integrate3DEvents &integrator, std::vector<Peak> &peaks,
+    bool specify_size, double peak_radius, double back_inner_radius,
+    double back_outer_radius, std::vector<std::vector<double>> &axes_radii,
+    std::vector<Mantid::Geometry::PeakShape_const_sptr> &shapes) {
+  const int n_peaks = static_cast<int>(peaks.size());
+  axes_radii.assign(peaks.size(), std::vector<double>());
+  shapes.assign(peaks.size(), Mantid::Geometry::PeakShape_const_sptr());
+
+  // The integrator is only read, so the peaks are independent of each other
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < n_peaks; i++) {
+    PARALLEL_START_INTERUPT_REGION
+    Peak &peak = peaks[i];
+    V3D hkl(peak.getH(), peak.getK(), peak.getL());
+    if (Geometry::IndexingUtils::ValidIndex(hkl, 1.0)) {
+      V3D peak_q(peak.getQLabFrame());
+      double inti;
+      double sigi;
+      shapes[i] = integrator.ellipseIntegrateEvents(
+          peak_q, specify_size, peak_radius, back_inner_radius,
+          back_outer_radius, axes_radii[i], inti, sigi);
+      peak.setIntensity(inti);
+      peak.setSigmaIntensity(sigi);
+    } else {
+      peak.setIntensity(0.0);
+      peak.setSigmaIntensity(0.0);
+    }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Report the sizes in peak order
+  for (size_t i = 0; i < peaks.size(); i++) {
+    if (axes_radii[i].size() == 3) {
+      g_log.notice()
+          << "Radii of three axes of ellipsoid for integrating peak " << i
+          << " = ";
+      for (int i3 = 0; i3 < 3; i3++) {
+        g_log.notice() << axes_radii[i][i3] << "  ";
+      }
+      g_log.notice() << std::endl;
+    }
+  }
+}
+
 /**
  * @brief IntegrateEllipsoids::initTargetWSDescr Initialize the output
  *        information for the MD conversion framework.
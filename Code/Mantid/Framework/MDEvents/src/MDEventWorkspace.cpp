@@ -20,6 +20,7 @@
 #include <algorithm>
 #include "MantidMDEvents/MDBoxIterator.h"
 #include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Exception.h"
 
 using namespace Mantid;
@@ -750,6 +751,84 @@ TMDE(void MDEventWorkspace)::getLinePlot(const Mantid::Kernel::VMD &start,
   x.push_back((end - start).norm());
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Render a 2D slice through the workspace into an image.
+ * Pixel (i, j) of the image samples the workspace at the centre of the pixel,
+ * origin + (i + 0.5) * xStep + (j + 0.5) * yStep.
+ *
+ * Rows are rendered in parallel. Along a row, the box of the previous pixel
+ * is reused while the pixels stay inside it, so the box tree is only
+ * descended once for each box the row crosses instead of once per pixel.
+ *
+ * @param origin :: coordinates of the corner of the image
+ * @param xStep :: size of a pixel along the rows of the image
+ * @param yStep :: size of a pixel along the columns of the image
+ * @param numX :: number of pixels in a row
+ * @param numY :: number of rows
+ * @param normalize :: how to normalize the signal
+ * @param signal :: is set to the normalized signal of each pixel, a row at a
+ *time. Length = numX * numY. Pixels outside the workspace are NaN.
+ * @throw std::invalid_argument if the vectors do not have one coordinate per
+ *dimension of the workspace
+ */
+TMDE(void MDEventWorkspace)::getPlanePlot(const Mantid::Kernel::VMD &origin,
+                                          const Mantid::Kernel::VMD &xStep,
+                                          const Mantid::Kernel::VMD &yStep,
+                                          size_t numX, size_t numY,
+                                          Mantid::API::MDNormalization normalize,
+                                          std::vector<signal_t> &signal) const {
+  if (origin.getNumDims() != nd || xStep.getNumDims() != nd ||
+      yStep.getNumDims() != nd)
+    throw std::invalid_argument("MDEventWorkspace::getPlanePlot(): the origin "
+                                "and steps must have one coordinate per "
+                                "dimension of the workspace.");
+  signal.assign(numX * numY, std::numeric_limits<signal_t>::quiet_NaN());
+
+  const int numRows = static_cast<int>(numY);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int j = 0; j < numRows; ++j) {
+    coord_t coord[nd];
+    const MDBoxBase<MDE, nd> *box = NULL;
+    const double y = static_cast<double>(j) + 0.5;
+    for (size_t i = 0; i < numX; ++i) {
+      const double x = static_cast<double>(i) + 0.5;
+      bool outOfBounds = false;
+      bool inBox = (box != NULL);
+      for (size_t d = 0; d < nd; d++) {
+        coord[d] =
+            static_cast<coord_t>(origin[d] + x * xStep[d] + y * yStep[d]);
+        if (data->getExtents(d).outside(coord[d]))
+          outOfBounds = true;
+        else if (inBox && box->getExtents(d).outside(coord[d]))
+          inBox = false;
+      }
+      if (outOfBounds) {
+        box = NULL;
+        continue;
+      }
+      // Only look the box up again when the row leaves the previous one
+      if (!inBox)
+        box = static_cast<const MDBoxBase<MDE, nd> *>(
+            data->getBoxAtCoord(coord));
+      if (!box)
+        continue;
+
+      signal_t value = box->getSignal();
+      switch (normalize) {
+      case NoNormalization:
+        break;
+      case VolumeNormalization:
+        value *= box->getInverseVolume();
+        break;
+      case NumEventsNormalization:
+        value /= double(box->getNPoints());
+        break;
+      }
+      signal[static_cast<size_t>(j) * numX + i] = value;
+    }
+  }
+}
+
 /**
 Setter for the masking region.
 @param maskingRegion : Implicit function defining mask region.
@@ -120,6 +120,73 @@ public:
     }
   }
 
+  // Adding a long list of events at once, which finds the peaks in parallel,
+  // must give the same event lists as adding the events a few at a time.
+  void test_large_event_list_matches_small_batches()
+  {
+    std::vector<V3D> peak_q_list;
+    peak_q_list.push_back( V3D( 10, 0, 0 ) );
+    peak_q_list.push_back( V3D(  0, 5, 0 ) );
+
+    DblMatrix UBinv(3,3,false);
+    UBinv.setRow( 0, V3D( .1,  0,   0 ) );
+    UBinv.setRow( 1, V3D(  0, .2,   0 ) );
+    UBinv.setRow( 2, V3D(  0,  0, .25 ) );
+
+    std::vector<V3D> event_Qs;
+    for ( int i = 0; i < 30000; i++ )
+    {
+      const V3D offset( (i % 97) / 100.0 - 0.48, (i % 89) / 120.0 - 0.37,
+                        (i % 83) / 150.0 - 0.27 );
+      event_Qs.push_back( peak_q_list[i % 2] + offset );
+    }
+
+    double radius = 1.3;
+    Integrate3DEvents all_at_once( peak_q_list, UBinv, radius );
+    all_at_once.addEvents( event_Qs );
+
+    Integrate3DEvents in_batches( peak_q_list, UBinv, radius );
+    for ( size_t start = 0; start < event_Qs.size(); start += 100 )
+    {
+      std::vector<V3D> batch( event_Qs.begin() + start,
+                              event_Qs.begin() + start + 100 );
+      in_batches.addEvents( batch );
+    }
+
+    std::vector<double> axes_radii;
+    double inti_1, sigi_1, inti_2, sigi_2;
+    for ( size_t i = 0; i < peak_q_list.size(); i++ )
+    {
+      all_at_once.ellipseIntegrateEvents( peak_q_list[i], false, 0.0, 0.0,
+                          0.0, axes_radii, inti_1, sigi_1 );
+      in_batches.ellipseIntegrateEvents( peak_q_list[i], false, 0.0, 0.0,
+                          0.0, axes_radii, inti_2, sigi_2 );
+      TS_ASSERT_LESS_THAN( 0.0, inti_1 );
+      TS_ASSERT_EQUALS( inti_1, inti_2 );
+      TS_ASSERT_EQUALS( sigi_1, sigi_2 );
+    }
+  }
+
+  void test_peak_without_events_has_no_shape()
+  {
+    std::vector<V3D> peak_q_list;
+    peak_q_list.push_back( V3D( 10, 0, 0 ) );
+
+    DblMatrix UBinv(3,3,false);
+    UBinv.setRow( 0, V3D( .1,  0,   0 ) );
+    UBinv.setRow( 1, V3D(  0, .2,   0 ) );
+    UBinv.setRow( 2, V3D(  0,  0, .25 ) );
+
+    const Integrate3DEvents integrator( peak_q_list, UBinv, 1.3 );
+    std::vector<double> axes_radii;
+    double inti = -1;
+    double sigi = -1;
+    auto shape = integrator.ellipseIntegrateEvents( peak_q_list[0], true, 1.2,
+                          1.2, 1.3, axes_radii, inti, sigi );
+    TS_ASSERT_EQUALS( shape->shapeName(), "none" );
+    TS_ASSERT_EQUALS( inti, 0.0 );
+    TS_ASSERT_EQUALS( sigi, 0.0 );
+  }
 
 };
 
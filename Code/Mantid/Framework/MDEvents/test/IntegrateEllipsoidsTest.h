@@ -0,0 +1,122 @@
+#ifndef MANTID_MDEVENTS_INTEGRATEELLIPSOIDSTEST_H_
+#define MANTID_MDEVENTS_INTEGRATEELLIPSOIDSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidAPI/NumericAxis.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/PeaksWorkspace.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidMDEvents/IntegrateEllipsoids.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Geometry;
+using Mantid::MDEvents::IntegrateEllipsoids;
+
+class IntegrateEllipsoidsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static IntegrateEllipsoidsTest *createSuite() {
+    return new IntegrateEllipsoidsTest();
+  }
+  static void destroySuite(IntegrateEllipsoidsTest *suite) { delete suite; }
+
+  void test_Init() {
+    IntegrateEllipsoids alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_parallel_and_serial_runs_give_the_same_intensities() {
+    EventWorkspace_sptr events;
+    PeaksWorkspace_sptr peaks;
+    createPeaksAndEvents(events, peaks);
+
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(1);
+    PeaksWorkspace_sptr serial = integrate(events, peaks);
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    PeaksWorkspace_sptr parallel = integrate(events, peaks);
+
+    TS_ASSERT(serial);
+    TS_ASSERT(parallel);
+    if (!serial || !parallel)
+      return;
+    TS_ASSERT_EQUALS(parallel->getNumberPeaks(), serial->getNumberPeaks());
+    for (int i = 0; i < serial->getNumberPeaks(); ++i) {
+      const IPeak &expected = serial->getPeak(i);
+      const IPeak &actual = parallel->getPeak(i);
+      TS_ASSERT_LESS_THAN(0.0, expected.getIntensity());
+      TS_ASSERT_DELTA(actual.getIntensity(), expected.getIntensity(), 1e-9);
+      TS_ASSERT_DELTA(actual.getSigmaIntensity(),
+                      expected.getSigmaIntensity(), 1e-9);
+    }
+  }
+
+private:
+  /// Three indexed peaks on a 100x100 pixel bank, each with a block of events
+  /// spread over the neighbouring pixels and times-of-flight
+  void createPeaksAndEvents(EventWorkspace_sptr &events,
+                            PeaksWorkspace_sptr &peaks) {
+    events =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(1, 100);
+    events->getAxis(0)->unit() =
+        Mantid::Kernel::UnitFactory::Instance().create("TOF");
+    Instrument_const_sptr inst = events->getInstrument();
+    boost::shared_ptr<const RectangularDetector> bank =
+        boost::dynamic_pointer_cast<const RectangularDetector>(
+            inst->getComponentByName("bank1"));
+    const Mantid::detid2index_map detToIndex =
+        events->getDetectorIDToWorkspaceIndexMap();
+
+    peaks = boost::make_shared<PeaksWorkspace>();
+    peaks->setInstrument(inst);
+    const int pixels[3][2] = {{20, 80}, {80, 20}, {80, 80}};
+    const double wavelengths[3] = {1.5, 2.0, 2.5};
+    for (int p = 0; p < 3; ++p) {
+      const int x = pixels[p][0], y = pixels[p][1];
+      Peak peak(inst, bank->getAtXY(x, y)->getID(), wavelengths[p]);
+      peak.setHKL(p == 0 ? 1 : 0, p == 1 ? 1 : 0, p == 2 ? 1 : 0);
+      peaks->addPeak(peak);
+
+      const double tof = peak.getTOF();
+      for (int dx = -2; dx <= 2; ++dx) {
+        for (int dy = -2; dy <= 2; ++dy) {
+          const Mantid::detid_t id = bank->getAtXY(x + dx, y + dy)->getID();
+          EventList &el = events->getEventList(detToIndex.find(id)->second);
+          const int weight = 3 - std::max(std::abs(dx), std::abs(dy));
+          for (int dt = -5; dt <= 5; ++dt) {
+            for (int n = 0; n < weight * (6 - std::abs(dt)); ++n)
+              el.addEventQuickly(TofEvent(tof * (1.0 + 0.001 * dt)));
+          }
+        }
+      }
+    }
+  }
+
+  PeaksWorkspace_sptr integrate(EventWorkspace_sptr events,
+                                PeaksWorkspace_sptr peaks) {
+    IntegrateEllipsoids alg;
+    alg.setChild(true);
+    alg.initialize();
+    // The events are switched to unit weight events without times, which
+    // leaves them the same for the next run
+    alg.setProperty("InputWorkspace", events);
+    alg.setProperty("PeaksWorkspace", peaks);
+    alg.setProperty("RegionRadius", 0.05);
+    alg.setProperty("SpecifySize", true);
+    alg.setProperty("PeakSize", 0.03);
+    alg.setProperty("BackgroundInnerSize", 0.035);
+    alg.setProperty("BackgroundOuterSize", 0.045);
+    alg.setPropertyValue("OutputWorkspace", "IntegrateEllipsoidsTest_out");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    return alg.getProperty("OutputWorkspace");
+  }
+};
+
+#endif /* MANTID_MDEVENTS_INTEGRATEELLIPSOIDSTEST_H_ */
@@ -272,6 +272,59 @@ public:
     TSM_ASSERT("Out of bounds returns NAN", boost::math::isnan( ew->getSignalAtCoord(coords4, Mantid::API::NoNormalization) ) );
   }
 
+  //-------------------------------------------------------------------------------------
+  /** A tilted plane gives the same signal as looking up each pixel */
+  void test_getPlanePlot()
+  {
+    MDEventWorkspace3Lean::sptr ew = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 1);
+    ew->getBoxController()->setSplitThreshold(20);
+    boost::mt19937 rng(12345);
+    boost::uniform_real<float> u(0.0f, 10.0f);
+    std::vector<MDLeanEvent<3> > events;
+    for (size_t i = 0; i < 20000; i++)
+    {
+      // Cluster the events to get boxes of several depths
+      coord_t centers[3] = {u(rng), u(rng) * 0.3f, u(rng)};
+      events.push_back(MDLeanEvent<3>(1.0, 1.0, centers));
+    }
+    ew->addEvents(events);
+    ew->splitAllIfNeeded(NULL);
+    ew->refreshCache();
+
+    // The plane starts outside the workspace
+    VMD origin(-1.0, 0.3, 2.7);
+    VMD xStep(0.05, 0.013, 0.0);
+    VMD yStep(0.01, 0.06, 0.02);
+    const size_t numX = 240;
+    const size_t numY = 180;
+    std::vector<signal_t> signal;
+    ew->getPlanePlot(origin, xStep, yStep, numX, numY, Mantid::API::VolumeNormalization, signal);
+    TS_ASSERT_EQUALS(signal.size(), numX * numY);
+
+    size_t numNaN = 0;
+    for (size_t j = 0; j < numY; j++)
+      for (size_t i = 0; i < numX; i++)
+      {
+        coord_t coord[3];
+        for (size_t d = 0; d < 3; d++)
+          coord[d] = static_cast<coord_t>(origin[d] + (double(i) + 0.5) * xStep[d] + (double(j) + 0.5) * yStep[d]);
+        const signal_t expected = ew->getSignalAtCoord(coord, Mantid::API::VolumeNormalization);
+        const signal_t actual = signal[j * numX + i];
+        if (boost::math::isnan(expected))
+        {
+          TS_ASSERT(boost::math::isnan(actual));
+          numNaN++;
+        }
+        else
+          TS_ASSERT_EQUALS(actual, expected);
+      }
+    TSM_ASSERT("Some pixels are outside the workspace", numNaN > 0);
+    TSM_ASSERT("Most pixels are inside the workspace", numNaN < numX * numY / 2);
+
+    TS_ASSERT_THROWS(ew->getPlanePlot(VMD(0.0, 0.0), xStep, yStep, numX, numY, Mantid::API::NoNormalization, signal),
+                     std::invalid_argument);
+  }
+
 
   //-------------------------------------------------------------------------------------
   void test_estimateResolution()
@@ -659,6 +712,53 @@ public:
     {
       m_ws.reset();
     }
+  /** Render a slice of a large workspace, and compare with looking up each
+   * pixel separately */
+  void test_getPlanePlot_performance()
+  {
+    MDEventWorkspace3Lean::sptr ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 100.0, 0);
+    ws->getBoxController()->setSplitThreshold(1000);
+    boost::mt19937 rng(12345);
+    boost::uniform_real<float> u(0.0f, 100.0f);
+    const size_t numEvents = 10000000;
+    const size_t chunk = 1000000;
+    for (size_t start = 0; start < numEvents; start += chunk)
+    {
+      std::vector<MDLeanEvent<3> > events;
+      events.reserve(chunk);
+      for (size_t i = 0; i < chunk; i++)
+      {
+        coord_t centers[3] = {u(rng), u(rng), u(rng)};
+        events.push_back(MDLeanEvent<3>(1.0, 1.0, centers));
+      }
+      ws->addEvents(events);
+      ws->splitAllIfNeeded(NULL);
+    }
+    ws->refreshCache();
+
+    const size_t numPixels = 1000;
+    VMD origin(0.0, 0.0, 50.0);
+    VMD xStep(0.1, 0.0, 0.0);
+    VMD yStep(0.0, 0.1, 0.0);
+    std::vector<signal_t> signal;
+    Kernel::Timer clock;
+    ws->getPlanePlot(origin, xStep, yStep, numPixels, numPixels, Mantid::API::VolumeNormalization, signal);
+    std::cout << "Rendered a " << numPixels << "x" << numPixels << " slice of " << numEvents << " events in "
+              << clock.elapsed() << " sec\n";
+
+    double sum = 0;
+    coord_t coord[3] = {0, 0, 50};
+    for (size_t j = 0; j < numPixels; j++)
+      for (size_t i = 0; i < numPixels; i++)
+      {
+        coord[0] = static_cast<coord_t>((double(i) + 0.5) * 0.1);
+        coord[1] = static_cast<coord_t>((double(j) + 0.5) * 0.1);
+        sum += ws->getSignalAtCoord(coord, Mantid::API::VolumeNormalization);
+      }
+    std::cout << "Looked up each pixel in " << clock.elapsed() << " sec\n";
+    TS_ASSERT_LESS_THAN(0.0, sum);
+  }
+
    void test_splitting_performance_single_threaded()
   {
     std::cout<<"Starting Workspace splitting performance test, single threaded with "<<nBoxes <<" events \n";
@@ -20,6 +20,7 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidAPI/NumericAxis.h"
 #include "MantidKernel/PhysicalConstants.h"
+#include "MantidKernel/Tracer.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
@@ -290,6 +291,7 @@ int NexusFileIO::writeNexusProcessedData2D(
     const API::MatrixWorkspace_const_sptr &localworkspace,
     const bool &uniformSpectra, const std::vector<int> &spec,
     const char *group_name, bool write2Ddata) const {
+  Kernel::TraceScope trace("Write " + std::string(group_name), "io");
   NXstatus status;
 
   // write data entry
@@ -743,6 +745,7 @@ int NexusFileIO::writeNexusProcessedDataEventCombined(
     const DataObjects::EventWorkspace_const_sptr &ws,
     std::vector<int64_t> &indices, double *tofs, float *weights,
     float *errorSquareds, int64_t *pulsetimes, bool compress) const {
+  Kernel::TraceScope trace("Write event_workspace", "io");
   NXopengroup(fileID, "event_workspace", "NXdata");
 
   // The array of indices for each event list #
@@ -1,4 +1,6 @@
 #include "MantidAPI/IMDWorkspace.h"
+#include "MantidPythonInterface/kernel/Converters/CArrayToNDArray.h"
+#include "MantidPythonInterface/kernel/Converters/CloneToNumpy.h"
 #include "MantidPythonInterface/kernel/Registry/DataItemInterface.h"
 
 #include <boost/python/class.hpp>
@@ -7,8 +9,35 @@
 
 using namespace Mantid::API;
 using Mantid::PythonInterface::Registry::DataItemInterface;
+namespace Converters = Mantid::PythonInterface::Converters;
 using namespace boost::python;
 
+namespace
+{
+  /**
+   * Renders a 2D slice through the workspace into a numpy array
+   * @param self :: A reference to the calling object
+   * @param origin :: Coordinates of the corner of the image
+   * @param xStep :: Size of a pixel along the rows of the image
+   * @param yStep :: Size of a pixel along the columns of the image
+   * @param numX :: Number of pixels in a row
+   * @param numY :: Number of rows
+   * @param normalization :: How to normalize the signal
+   * @returns A new numpy array of shape (numY, numX)
+   */
+  PyObject *getPlanePlotAsNumpyArray(IMDWorkspace &self, const Mantid::Kernel::VMD &origin,
+                                     const Mantid::Kernel::VMD &xStep, const Mantid::Kernel::VMD &yStep,
+                                     const size_t numX, const size_t numY,
+                                     const MDNormalization normalization)
+  {
+    std::vector<Mantid::signal_t> signal;
+    self.getPlanePlot(origin, xStep, yStep, numX, numY, normalization, signal);
+    Py_intptr_t dims[2] = {static_cast<Py_intptr_t>(numY), static_cast<Py_intptr_t>(numX)};
+    typedef Converters::CArrayToNDArray<Mantid::signal_t, Converters::Clone> CloneNumpy;
+    return CloneNumpy()(signal.data(), 2, dims);
+  }
+}
+
 void export_IMDWorkspace()
 {
   boost::python::enum_<Mantid::API::MDNormalization>("MDNormalization")
@@ -26,7 +55,11 @@ void export_IMDWorkspace()
   class_< IMDWorkspace, bases<Workspace, MDGeometry>, boost::noncopyable >("IMDWorkspace", no_init)
     .def("getNPoints", &IMDWorkspace::getNPoints, args("self"), "Returns the total number of points within the workspace")
     .def("getNEvents", &IMDWorkspace::getNEvents, args("self"), "Returns the total number of events, contributed to the workspace")
-    .def("getSpecialCoordinateSystem", &IMDWorkspace::getSpecialCoordinateSystem, args("self"), "Returns the special coordinate system of the workspace");
+    .def("getSpecialCoordinateSystem", &IMDWorkspace::getSpecialCoordinateSystem, args("self"), "Returns the special coordinate system of the workspace")
+    .def("getPlanePlot", &getPlanePlotAsNumpyArray,
+         (arg("self"), arg("origin"), arg("xStep"), arg("yStep"), arg("numX"), arg("numY"), arg("normalization")),
+         "Returns the signal on a 2D slice through the workspace as a numpy array of shape (numY, numX). "
+         "Pixel (i,j) is sampled at origin + (i+0.5)*xStep + (j+0.5)*yStep");
 
   DataItemInterface<IMDWorkspace>();
 }
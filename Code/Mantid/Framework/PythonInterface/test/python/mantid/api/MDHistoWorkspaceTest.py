@@ -1,6 +1,8 @@
 import unittest
 from testhelpers import run_algorithm
 from mantid import mtd
+from mantid.api import MDNormalization
+from mantid.kernel import VMD
 
 import numpy
 
@@ -81,6 +83,17 @@ class MDHistoWorkspaceTest(unittest.TestCase):
         new_errors = testWS.getErrorSquaredArray()
         self._verify_numpy_data(new_errors, errors)
 
+    def test_plane_plot_matches_signal_array(self):
+        run_algorithm('CreateMDHistoWorkspace', SignalInput='1,2,3,4,5,6,7,8,9',ErrorInput='1,1,1,1,1,1,1,1,1',
+                      Dimensionality='2',Extents='-1,1,-1,1',NumberOfBins='3,3',Names='A,B',Units='U,T',OutputWorkspace='demo')
+        testWS = mtd['demo']
+        image = testWS.getPlanePlot(VMD(-1,-1), VMD(2./3,0), VMD(0,2./3), 3, 3, MDNormalization.NoNormalization)
+        self.assertTrue(isinstance(image, numpy.ndarray))
+        self.assertEquals(image.shape, (3,3))
+        self.assertTrue(numpy.all(numpy.equal(image, testWS.getSignalArray())))
+
+        mtd.remove('demo')
+
     def _verify_numpy_data(self, test_array, expected):
         """Check the correct numpy array has been constructed"""
 
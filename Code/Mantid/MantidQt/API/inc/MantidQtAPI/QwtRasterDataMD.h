@@ -46,6 +46,9 @@ public:
 
   double value(double x, double y) const;
 
+  void initRaster(const QwtDoubleRect &area, const QSize &raster);
+  void discardRaster();
+
   QSize rasterHint(const QwtDoubleRect &) const;
 
   void setFastMode(bool fast);
@@ -59,6 +62,8 @@ protected:
 
   void copyFrom(const QwtRasterDataMD & source, QwtRasterDataMD& dest) const;
 
+  bool rasterValue(double x, double y, Mantid::signal_t & value) const;
+
   /// Workspace being shown
   Mantid::API::IMDWorkspace_const_sptr m_ws;
 
@@ -108,6 +113,13 @@ protected:
 
   /// Normalization of signals
   Mantid::API::MDNormalization m_normalization;
+
+  /// Signal of the workspace over the area being rendered, a row at a time
+  std::vector<Mantid::signal_t> m_raster;
+  /// Area covered by m_raster
+  QwtDoubleRect m_rasterArea;
+  /// Number of pixels in each direction of m_raster
+  QSize m_rasterSize;
 };
 
 } // namespace SliceViewer
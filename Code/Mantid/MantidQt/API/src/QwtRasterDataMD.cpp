@@ -4,6 +4,7 @@
 #include "MantidGeometry/MDGeometry/IMDDimension.h"
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/VMD.h"
 
 namespace MantidQt
 {
@@ -90,7 +91,7 @@ double QwtRasterDataMD::value(double x, double y) const
     // Point is in the overlaid workspace
     value = m_overlayWS->getSignalAtCoord(lookPoint, m_normalization);
   }
-  else
+  else if (!rasterValue(x, y, value))
   {
     // No overlay, or not within range of that workspace
     value = m_ws->getSignalAtCoord(lookPoint, m_normalization);
@@ -105,6 +106,65 @@ double QwtRasterDataMD::value(double x, double y) const
 }
 
 
+//------------------------------------------------------------------------------------------------------
+/** Called by the plot before it asks for the values of an image.
+ * The whole image is rendered from the workspace at once, which is much
+ * faster than looking up every pixel separately.
+ *
+ * @param area :: area of the image in coordinates of the MDWorkspace
+ * @param raster :: number of pixels of the image in each direction
+ */
+void QwtRasterDataMD::initRaster(const QwtDoubleRect &area, const QSize &raster)
+{
+  discardRaster();
+  if (!m_ws || !m_slicePoint || raster.isEmpty())
+    return;
+
+  Mantid::Kernel::VMD origin(m_nd);
+  Mantid::Kernel::VMD xStep(m_nd);
+  Mantid::Kernel::VMD yStep(m_nd);
+  for (size_t d=0; d<m_nd; d++)
+    origin[d] = m_slicePoint[d];
+  origin[m_dimX] = static_cast<coord_t>(area.left());
+  origin[m_dimY] = static_cast<coord_t>(area.top());
+  xStep[m_dimX] = static_cast<coord_t>(area.width() / raster.width());
+  yStep[m_dimY] = static_cast<coord_t>(area.height() / raster.height());
+
+  m_ws->getPlanePlot(origin, xStep, yStep, static_cast<size_t>(raster.width()),
+                     static_cast<size_t>(raster.height()), m_normalization,
+                     m_raster);
+  m_rasterArea = area;
+  m_rasterSize = raster;
+}
+
+//------------------------------------------------------------------------------------------------------
+/** Called by the plot once an image has been rendered. Frees the image. */
+void QwtRasterDataMD::discardRaster()
+{
+  m_raster.clear();
+  m_rasterSize = QSize();
+}
+
+//------------------------------------------------------------------------------------------------------
+/** Look up a value in the image rendered by initRaster()
+ *
+ * @param x :: position in coordinates of the MDWorkspace
+ * @param y :: position in coordinates of the MDWorkspace
+ * @param value :: set to the signal of the pixel containing the position
+ * @return true if the position is inside the rendered image
+ */
+bool QwtRasterDataMD::rasterValue(double x, double y, signal_t & value) const
+{
+  if (m_raster.empty())
+    return false;
+  const int i = static_cast<int>(floor((x - m_rasterArea.left()) / m_rasterArea.width() * m_rasterSize.width()));
+  const int j = static_cast<int>(floor((y - m_rasterArea.top()) / m_rasterArea.height() * m_rasterSize.height()));
+  if (i < 0 || i >= m_rasterSize.width() || j < 0 || j >= m_rasterSize.height())
+    return false;
+  value = m_raster[static_cast<size_t>(j * m_rasterSize.width() + i)];
+  return true;
+}
+
 //------------------------------------------------------------------------------------------------------
 /** Return the data range to show */
 QwtDoubleInterval QwtRasterDataMD::range() const
@@ -4,12 +4,16 @@
 #include "MantidVatesAPI/vtkMDHexFactory.h"
 #include "MantidVatesAPI/Common.h"
 #include "MantidVatesAPI/ProgressAction.h"
+#include <vtkCellArray.h>
 #include <vtkCellData.h>
 #include <vtkFloatArray.h>
 #include <vtkHexahedron.h>
+#include <vtkIdTypeArray.h>
 #include <vtkPoints.h>
 #include <vtkUnstructuredGrid.h>
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ReadLock.h"
+#include <algorithm>
 
 using namespace Mantid::API;
 using namespace Mantid::MDEvents;
@@ -59,132 +63,111 @@ namespace Mantid
       ws->getBox()->getBoxes(boxes, m_maxDepth, true);
 
 
-    vtkIdType numBoxes = boxes.size();
-    vtkIdType imageSizeActual = 0;
+    const int numBoxes = static_cast<int>(boxes.size());
 
     if (VERBOSE) std::cout << tim << " to retrieve the " << numBoxes << " boxes down to depth " << m_maxDepth << std::endl;
 
-    // Create 8 points per box.
+    // First pass: find the boxes that will be drawn and cache their signal
+    std::vector<float> signalArray(boxes.size(), 0.0f);
+    std::vector<char> useBox(boxes.size(), 0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int ii = 0; ii < numBoxes; ii++)
+    {
+      Mantid::signal_t signal_normalized = boxes[ii]->getSignalNormalized();
+      if (!isSpecial( signal_normalized ) && m_thresholdRange->inRange(signal_normalized))
+      {
+        signalArray[ii] = float(signal_normalized);
+        useBox[ii] = 1;
+      }
+    }
+
+    // The position of each drawn box in the data set
+    std::vector<vtkIdType> cellIndex(boxes.size(), 0);
+    vtkIdType imageSizeActual = 0;
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+      cellIndex[i] = imageSizeActual;
+      if (useBox[i])
+        imageSizeActual++;
+    }
+
+    // Create 8 points per drawn box. The default point type is float.
     vtkPoints *points = vtkPoints::New();
-    points->Allocate(numBoxes * 8);
-    points->SetNumberOfPoints(numBoxes * 8);
+    points->SetNumberOfPoints(imageSizeActual * 8);
+    float * pointArray = static_cast<float *>(points->GetVoidPointer(0));
 
     // One scalar per box
     vtkFloatArray * signals = vtkFloatArray::New();
-    signals->Allocate(numBoxes);
     signals->SetName(m_scalarName.c_str());
     signals->SetNumberOfComponents(1);
-    //signals->SetNumberOfValues(numBoxes);
+    signals->SetNumberOfValues(imageSizeActual);
+    float * signalValues = signals->GetPointer(0);
 
-    // To cache the signal
-    float * signalArray = new float[numBoxes];
+    // The cell connectivity: the number of points followed by the 8 point IDs
+    vtkIdTypeArray * connectivity = vtkIdTypeArray::New();
+    connectivity->SetNumberOfValues(imageSizeActual * 9);
+    vtkIdType * cellPoints = connectivity->GetPointer(0);
 
-    // True for boxes that we will use
-    bool * useBox = new bool[numBoxes];
-    memset(useBox, 0, sizeof(bool)*numBoxes);
+    // The order of the vertexes of a box in a VTK hexahedron
+    const vtkIdType hexOrder[8] = {0, 1, 3, 2, 4, 5, 7, 6};
 
-    // Create the data set
-    vtkUnstructuredGrid * visualDataSet = vtkUnstructuredGrid::New();
-    this->dataSet = visualDataSet;
-    visualDataSet->Allocate(numBoxes);
-
-    vtkIdList * hexPointList = vtkIdList::New();
-    hexPointList->SetNumberOfIds(8);
-
-    // This can be parallelized
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP( parallel for schedule (dynamic) )
-      for (int ii=0; ii<int(boxes.size()); ii++)
-      {
-        // Get the box here
-        size_t i = size_t(ii);
-        API::IMDNode * box = boxes[i];
-        Mantid::signal_t signal_normalized= box->getSignalNormalized();
-
-        if (!isSpecial( signal_normalized ) && m_thresholdRange->inRange(signal_normalized))
-        {
-          // Cache the signal and using of it
-          signalArray[i] = float(signal_normalized);
-          useBox[i] = true;
-
-          //Get the coordinates.
-          size_t numVertexes = 0;
-          coord_t * coords;
-
-          // If slicing down to 3D, specify which dimensions to keep.
-          if (this->slice)
-            coords = box->getVertexesArray(numVertexes, 3, this->sliceMask);
-          else
-            coords = box->getVertexesArray(numVertexes);
-
-          if (numVertexes == 8)
-          {
-            //Iterate through all coordinates. Candidate for speed improvement.
-            for(size_t v = 0; v < numVertexes; v++)
-            {
-              coord_t * coord = coords + v*3;
-              // Set the point at that given ID
-              points->SetPoint(i*8 + v, coord[0], coord[1], coord[2]);
-              std::string msg;
-            }
-
-          } // valid number of vertexes returned
-
-          // Free memory
-          delete [] coords;
-        }
-      } // For each box
-
-      if (VERBOSE) std::cout << tim << " to create the necessary points." << std::endl;
-      //Add points
-      visualDataSet->SetPoints(points);
-
-      for (size_t i=0; i<boxes.size(); i++)
-      {
-        if (useBox[i])
-        {
-          // The bare point ID
-          vtkIdType pointIds = i * 8;
+    // Second pass: every drawn box writes its own part of the arrays
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int ii = 0; ii < numBoxes; ii++)
+    {
+      if (!useBox[ii])
+        continue;
 
-          //Add signal
-          signals->InsertNextValue(signalArray[i]);
+      // Get the box here
+      API::IMDNode * box = boxes[ii];
+      const vtkIdType cell = cellIndex[ii];
+      const vtkIdType pointIds = cell * 8;
+      signalValues[cell] = signalArray[ii];
 
-          hexPointList->SetId(0, pointIds + 0); //xyx
-          hexPointList->SetId(1, pointIds + 1); //dxyz
-          hexPointList->SetId(2, pointIds + 3); //dxdyz
-          hexPointList->SetId(3, pointIds + 2); //xdyz
-          hexPointList->SetId(4, pointIds + 4); //xydz
-          hexPointList->SetId(5, pointIds + 5); //dxydz
-          hexPointList->SetId(6, pointIds + 7); //dxdydz
-          hexPointList->SetId(7, pointIds + 6); //xdydz
+      //Get the coordinates.
+      size_t numVertexes = 0;
+      coord_t * coords;
 
-          //Add cells
-          visualDataSet->InsertNextCell(VTK_HEXAHEDRON, hexPointList);
+      // If slicing down to 3D, specify which dimensions to keep.
+      if (this->slice)
+        coords = box->getVertexesArray(numVertexes, 3, this->sliceMask);
+      else
+        coords = box->getVertexesArray(numVertexes);
 
+      float * boxPoints = pointArray + pointIds * 3;
+      if (numVertexes == 8)
+        std::copy(coords, coords + 24, boxPoints);
+      else
+        std::fill(boxPoints, boxPoints + 24, 0.0f);
 
-          double bounds[6];
+      // Free memory
+      delete [] coords;
 
-          visualDataSet->GetCellBounds(imageSizeActual, bounds);
+      vtkIdType * hex = cellPoints + cell * 9;
+      hex[0] = 8;
+      for (size_t v = 0; v < 8; v++)
+        hex[v + 1] = pointIds + hexOrder[v];
+    } // For each box
 
-          if(bounds[0] < -10 || bounds[2] < -10 ||bounds[4]< -10)
-          {
-            std::string msg = "";
-          }
-          imageSizeActual++;
-        }
-      } // for each box.
+    if (VERBOSE) std::cout << tim << " to create the necessary points." << std::endl;
 
-      delete[] signalArray;
-      delete[] useBox;
+    // Assemble the data set
+    vtkCellArray * cells = vtkCellArray::New();
+    cells->SetCells(imageSizeActual, connectivity);
+    connectivity->Delete();
 
-      //Shrink to fit
-      signals->Squeeze();
-      visualDataSet->Squeeze();
+    vtkUnstructuredGrid * visualDataSet = vtkUnstructuredGrid::New();
+    this->dataSet = visualDataSet;
+    visualDataSet->SetPoints(points);
+    visualDataSet->SetCells(VTK_HEXAHEDRON, cells);
+    points->Delete();
+    cells->Delete();
 
-      //Add scalars
-      visualDataSet->GetCellData()->SetScalars(signals);
+    //Add scalars
+    visualDataSet->GetCellData()->SetScalars(signals);
+    signals->Delete();
 
-      if (VERBOSE) std::cout << tim << " to create " << imageSizeActual << " hexahedrons." << std::endl;
+    if (VERBOSE) std::cout << tim << " to create " << imageSizeActual << " hexahedrons." << std::endl;
 
   }
 
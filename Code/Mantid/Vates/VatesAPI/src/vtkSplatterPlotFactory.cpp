@@ -3,14 +3,17 @@
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ReadLock.h"
 #include "MantidMDEvents/MDEventFactory.h"
 #include "MantidVatesAPI/ProgressAction.h"
 #include "MantidVatesAPI/Common.h"
 
+#include <vtkCellArray.h>
 #include <vtkCellData.h>
 #include <vtkFloatArray.h>
 #include <vtkHexahedron.h>
+#include <vtkIdTypeArray.h>
 #include <vtkVertex.h>
 #include <vtkPoints.h>
 #include <vtkPolyVertex.h>
@@ -193,25 +196,19 @@ namespace VATES
       std::cout << "points needed per box     = " << points_per_box << std::endl;
     }
 
-    // First save the events and signals that we actually use.
+    // First choose the boxes and the number of events that we actually use.
     // For each box, get up to the average number of points
     // we want from each box, limited by the number of points
     // in the box.  NOTE: since boxes have different numbers
     // of events, we will not get all the events requested.
     // Also, if we are using a smaller number of points, we
     // won't get points from some of the boxes with lower signal.
-
-    std::vector<float>            saved_signals;
-    std::vector<const coord_t*>   saved_centers;
-    std::vector<size_t>           saved_n_points_in_cell;
-    saved_signals.reserve(numPoints);
-    saved_centers.reserve(numPoints);
-    saved_n_points_in_cell.reserve(numPoints);
-  
+    std::vector<MDBox<MDE,nd> *> used_boxes;
+    // Index of the first point of each used box, and the total at the end
+    std::vector<size_t> first_point;
     size_t pointIndex = 0;
     size_t box_index  = 0;
-    bool   done       = false;
-    while (box_index < num_boxes_to_use && !done)
+    while (box_index < num_boxes_to_use && pointIndex < numPoints)
     {
       MDBox<MDE,nd> *box = dynamic_cast<MDBox<MDE,nd> *>(m_sortedBoxes[box_index]);
       box_index++;
@@ -219,38 +216,16 @@ namespace VATES
       {
         continue;
       }
-      float signal_normalized = static_cast<float>(box->getSignalNormalized());
-      size_t newPoints = box->getNPoints();
-      size_t num_from_this_box = points_per_box;
-      if (num_from_this_box > newPoints)
-      {
-        num_from_this_box = newPoints;
-      }
-      const std::vector<MDE> & events = box->getConstEvents();
-      size_t startPointIndex = pointIndex;
-      size_t event_index = 0;
-      while (event_index < num_from_this_box && !done)
-      {
-        const MDE & ev = events[event_index];
-        event_index++;
-        const coord_t * center = ev.getCenter();
-        // Save location
-        saved_centers.push_back(center);
-        pointIndex++;
-        if (pointIndex >= numPoints)
-        {
-          done = true;
-        }
-      }
-      box->releaseEvents();
-      // Save signal
-      saved_signals.push_back(signal_normalized);
-      // Save cell size
-      saved_n_points_in_cell.push_back(pointIndex-startPointIndex);
-    } 
+      size_t num_from_this_box = std::min(points_per_box, box->getNPoints());
+      num_from_this_box = std::min(num_from_this_box, numPoints - pointIndex);
+      used_boxes.push_back(box);
+      first_point.push_back(pointIndex);
+      pointIndex += num_from_this_box;
+    }
+    first_point.push_back(pointIndex);
 
-    numPoints = saved_centers.size();
-    size_t numCells = saved_signals.size();
+    numPoints = pointIndex;
+    const size_t numCells = used_boxes.size();
 
     if (VERBOSE)
     {
@@ -259,54 +234,72 @@ namespace VATES
       std::cout << "numCells  = " << numCells << std::endl;
     }
 
-    // Create the point list, one position for each point actually used
+    // Create the point list, one position for each point actually used.
+    // The default point type is float.
     vtkPoints *points = vtkPoints::New();
-    points->Allocate(numPoints);
     points->SetNumberOfPoints(numPoints);
-
-    // The list of IDs of points used, one ID per point, since points
-    // are not reused to form polygon facets, etc.
-    vtkIdType *ids = new vtkIdType[numPoints];
+    float *pointArray = static_cast<float *>(points->GetVoidPointer(0));
 
     // Only one scalar for each cell, NOT one per point
     vtkFloatArray *signal = vtkFloatArray::New();
-    signal->Allocate(numCells);
     signal->SetName(m_scalarName.c_str());
-
-    // Create the data set.  Need space for each cell, not for each point
-    vtkUnstructuredGrid *visualDataSet = vtkUnstructuredGrid::New();
-    this->dataSet = visualDataSet;
-    visualDataSet->Allocate(numCells);
-    // Now copy the saved point, cell and signal info into vtk data structures
-    pointIndex = 0;
-    for (size_t cell_i = 0; cell_i < numCells; cell_i++)
-    {
-      size_t startPointIndex = pointIndex;
-      for (size_t point_i = 0; point_i < saved_n_points_in_cell[cell_i]; point_i++)
+    signal->SetNumberOfValues(numCells);
+    float *signalValues = signal->GetPointer(0);
+
+    // The cell connectivity: for each cell the number of points followed by
+    // the IDs of its points. Points are not shared between cells.
+    vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+    connectivity->SetNumberOfValues(numPoints + numCells);
+    vtkIdType *cellPoints = connectivity->GetPointer(0);
+
+    // Now copy the events of each box into its own part of the vtk arrays.
+    // Loading events from a file is not thread safe, so only do this in
+    // parallel for workspaces in memory.
+    const int numUsedBoxes = static_cast<int>(numCells);
+    PARALLEL_FOR_IF(!ws->isFileBacked())
+    for (int ii = 0; ii < numUsedBoxes; ii++)
+    {
+      const size_t cell_i = static_cast<size_t>(ii);
+      MDBox<MDE,nd> *box = used_boxes[cell_i];
+      const size_t start = first_point[cell_i];
+      const size_t num_in_cell = first_point[cell_i + 1] - start;
+      signalValues[cell_i] = static_cast<float>(box->getSignalNormalized());
+
+      vtkIdType *cell = cellPoints + start + cell_i;
+      cell[0] = static_cast<vtkIdType>(num_in_cell);
+      const std::vector<MDE> & events = box->getConstEvents();
+      for (size_t point_i = 0; point_i < num_in_cell; point_i++)
       {
-        points->SetPoint(pointIndex, saved_centers[pointIndex]);
-        ids[pointIndex] = pointIndex;
-        pointIndex++;
+        const coord_t * center = events[point_i].getCenter();
+        float *point = pointArray + 3 * (start + point_i);
+        point[0] = static_cast<float>(center[0]);
+        point[1] = static_cast<float>(center[1]);
+        point[2] = static_cast<float>(center[2]);
+        cell[point_i + 1] = static_cast<vtkIdType>(start + point_i);
       }
-      signal->InsertNextTuple1(saved_signals[cell_i]);
-      visualDataSet->InsertNextCell(VTK_POLY_VERTEX, saved_n_points_in_cell[cell_i], ids+startPointIndex);
+      box->releaseEvents();
     }
 
+    // Assemble the data set
+    vtkCellArray *cells = vtkCellArray::New();
+    cells->SetCells(static_cast<vtkIdType>(numCells), connectivity);
+    connectivity->Delete();
+
+    vtkUnstructuredGrid *visualDataSet = vtkUnstructuredGrid::New();
+    this->dataSet = visualDataSet;
+    visualDataSet->SetPoints(points);
+    visualDataSet->SetCells(VTK_POLY_VERTEX, cells);
+    points->Delete();
+    cells->Delete();
+
     if (VERBOSE)
     {
-      std::cout << tim << " to create " << pointIndex << " points." << std::endl;
+      std::cout << tim << " to create " << numPoints << " points." << std::endl;
     }
 
-    // Shrink to fit
-    //points->Squeeze();
-    signal->Squeeze();
-    visualDataSet->Squeeze();
-
-    // Add points and scalars
-    visualDataSet->SetPoints(points);
+    // Add scalars
     visualDataSet->GetCellData()->SetScalars(signal);
-
-    delete [] ids;
+    signal->Delete();
   }
 
   /**
@@ -6,6 +6,7 @@
 #include "MantidMDEvents/MDEventWorkspace.h"
 #include "MantidMDEvents/MDHistoWorkspace.h"
 #include "MantidDataObjects/TableWorkspace.h"
+#include "MantidKernel/Timer.h"
 #include "MantidTestHelpers/MDEventsTestHelper.h"
 #include "MantidVatesAPI/UserDefinedThresholdRange.h"
 #include "MantidVatesAPI/vtkMDHexFactory.h"
@@ -184,6 +185,43 @@ public:
     product->Delete();
   }
 
+  /* Only the boxes in the threshold range are drawn, with 8 points each */
+  void test_3DWorkspace_with_threshold()
+  {
+    FakeProgressAction progressUpdate;
+
+    Mantid::MDEvents::MDEventWorkspace3Lean::sptr ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 1);
+    // Put a second event in the boxes with x < 5, taking them out of range
+    for (int x = 0; x < 5; x++)
+      for (int y = 0; y < 10; y++)
+        for (int z = 0; z < 10; z++)
+        {
+          coord_t centers[3] = {coord_t(x) + 0.5f, coord_t(y) + 0.5f, coord_t(z) + 0.5f};
+          ws->addEvent(MDLeanEvent<3>(1.0, 1.0, centers));
+        }
+    ws->refreshCache();
+
+    vtkMDHexFactory factory(ThresholdRange_scptr(new UserDefinedThresholdRange(0, 1)), "signal");
+    factory.initialize(ws);
+    vtkDataSet* product = NULL;
+
+    TS_ASSERT_THROWS_NOTHING(product = factory.create(progressUpdate));
+
+    const size_t expected_n_cells = 500;
+    TSM_ASSERT_EQUALS("Wrong number of cells", expected_n_cells, product->GetNumberOfCells());
+    TSM_ASSERT_EQUALS("Wrong number of points to cells. Hexahedron has 8 vertexes.", expected_n_cells * 8,  product->GetNumberOfPoints());
+    TSM_ASSERT_EQUALS("Wrong sized signal Array", expected_n_cells, product->GetCellData()->GetArray(0)->GetSize());
+
+    /*Only the boxes with x >= 5 are drawn*/
+    double* bounds = product->GetBounds();
+    TS_ASSERT_EQUALS(5, bounds[0]);
+    TS_ASSERT_EQUALS(10, bounds[1]);
+    TS_ASSERT_EQUALS(0, bounds[2]);
+    TS_ASSERT_EQUALS(10, bounds[3]);
+
+    product->Delete();
+  }
+
   void test_4DWorkspace()
   {
     MockProgressAction mockProgressAction;
@@ -251,7 +289,10 @@ public :
     factory.initialize(m_ws3);
     vtkDataSet* product = NULL;
 
+    Mantid::Kernel::Timer timer;
     TS_ASSERT_THROWS_NOTHING(product = factory.create(progressUpdate));
+    std::cout << "Created a data set of " << product->GetNumberOfCells() << " hexahedrons in "
+              << timer.elapsed() << " sec\n";
 
     const size_t expected_n_points = 8000000;
     const size_t expected_n_cells = 1000000;
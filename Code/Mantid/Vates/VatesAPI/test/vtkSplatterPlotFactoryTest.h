@@ -5,6 +5,7 @@
 #include "MantidMDEvents/MDEventFactory.h"
 #include "MantidMDEvents/MDEventWorkspace.h"
 #include "MantidMDEvents/MDHistoWorkspace.h"
+#include "MantidKernel/Timer.h"
 #include "MantidTestHelpers/MDEventsTestHelper.h"
 #include "MantidVatesAPI/UserDefinedThresholdRange.h"
 #include "MantidVatesAPI/vtkSplatterPlotFactory.h"
@@ -163,4 +164,44 @@ public:
 
 };
 
+//=====================================================================================
+// Performance tests
+//=====================================================================================
+class vtkSplatterPlotFactoryTestPerformance : public CxxTest::TestSuite
+{
+
+private:
+
+  Mantid::MDEvents::MDEventWorkspace3Lean::sptr m_ws3;
+
+public :
+
+  void setUp()
+  {
+    m_ws3 = MDEventsTestHelper::makeMDEW<3>(100, 0.0, 100.0, 1);
+  }
+
+  /* Create 1E6 points from 1E6 boxes*/
+  void test_CreateDataSet_from3D()
+  {
+    FakeProgressAction progressUpdate;
+
+    vtkSplatterPlotFactory factory(ThresholdRange_scptr(new UserDefinedThresholdRange(0, 1)), "signal", 1000000, 100.0);
+    factory.initialize(m_ws3);
+    vtkDataSet* product = NULL;
+
+    Mantid::Kernel::Timer timer;
+    TS_ASSERT_THROWS_NOTHING(product = factory.create(progressUpdate));
+    std::cout << "Created a data set of " << product->GetNumberOfPoints() << " points in "
+              << timer.elapsed() << " sec\n";
+
+    // All but one of the boxes are used
+    const size_t expected_n_points = 999999;
+    TSM_ASSERT_EQUALS("Wrong number of points", expected_n_points, product->GetNumberOfPoints());
+    TSM_ASSERT_EQUALS("Wrong number of cells", expected_n_points, product->GetNumberOfCells());
+
+    product->Delete();
+  }
+};
+
 #endif